@@ -0,0 +1,16 @@
+#ifndef SYSTEM_EACH_H
+#define SYSTEM_EACH_H
+
+/* This generated file contains includes for project dependencies */
+#include "system_each/bake_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
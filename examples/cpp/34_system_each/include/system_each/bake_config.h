@@ -0,0 +1,44 @@
+/*
+                                   )
+                                  (.)
+                                  .|.
+                                  | |
+                              _.--| |--._
+                           .-';  ;`-'& ; `&.
+                          \   &  ;    &   &_/
+                           |"""---...---"""|
+                           \ | | | | | | | /
+                            `---.|.|.|.---'
+
+ * This file is generated by bake.lang.c for your convenience. Headers of
+ * dependencies will automatically show up in this file. Include bake_config.h
+ * in your main project file. Do not edit! */
+
+#ifndef SYSTEM_EACH_BAKE_CONFIG_H
+#define SYSTEM_EACH_BAKE_CONFIG_H
+
+/* Headers of public dependencies */
+#include <flecs.h>
+
+/* Headers of private dependencies */
+#ifdef SYSTEM_EACH_IMPL
+/* No dependencies */
+#endif
+
+/* Convenience macro for exporting symbols */
+#ifndef SYSTEM_EACH_STATIC
+  #if SYSTEM_EACH_IMPL && (defined(_MSC_VER) || defined(__MINGW32__))
+    #define SYSTEM_EACH_EXPORT __declspec(dllexport)
+  #elif SYSTEM_EACH_IMPL
+    #define SYSTEM_EACH_EXPORT __attribute__((__visibility__("default")))
+  #elif defined _MSC_VER
+    #define SYSTEM_EACH_EXPORT __declspec(dllimport)
+  #else
+    #define SYSTEM_EACH_EXPORT
+  #endif
+#else
+  #define SYSTEM_EACH_EXPORT
+#endif
+
+#endif
+
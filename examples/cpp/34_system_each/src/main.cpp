@@ -0,0 +1,67 @@
+#include <system_each.h>
+#include <iostream>
+
+struct Position {
+    float x;
+    float y;
+};
+
+struct Velocity {
+    float x;
+    float y;
+};
+
+struct Mass {
+    float value;
+};
+
+int main(int argc, char *argv[]) {
+    /* Create the world, pass arguments for overriding the number of threads,fps
+     * or for starting the admin dashboard (see flecs.h for details). */
+    flecs::world world(argc, argv);
+
+    /* Register components */
+    flecs::component<Position>(world, "Position");
+    flecs::component<Velocity>(world, "Velocity");
+    flecs::component<Mass>(world, "Mass");
+
+    /* Each is an alternative to action that is invoked once for every entity,
+     * with the entity and a reference to each component. Column pointers are
+     * resolved once per table, so the function is called in a plain loop. */
+    flecs::system<Position, const Velocity>(world, "Move")
+        .each([](flecs::entity e, Position& p, const Velocity& v) {
+            p.x += v.x;
+            p.y += v.y;
+
+            std::cout << e.name() << " moved to {" << p.x << ", " << p.y
+                << "}" << std::endl;
+        });
+
+    /* These entities are stored in two different tables, one with and one
+     * without Mass. The system iterates both tables. */
+    flecs::entity(world, "E1")
+        .set<Position>({10, 20})
+        .set<Velocity>({1, 2});
+
+    flecs::entity(world, "E2")
+        .set<Position>({30, 40})
+        .set<Velocity>({3, 4})
+        .set<Mass>({100});
+
+    /* The instances of this prefab share its Velocity component. When a column
+     * is shared, each passes the same value to the function for every entity
+     * in the table. */
+    auto Fast = flecs::prefab(world, "Fast")
+        .set<Velocity>({10, 10});
+
+    flecs::entity(world, "E3")
+        .add_instanceof(Fast)
+        .set<Position>({50, 60});
+
+    flecs::entity(world, "E4")
+        .add_instanceof(Fast)
+        .set<Position>({70, 80});
+
+    /* Run systems */
+    world.progress();
+}
@@ -44,6 +44,7 @@ typedef struct ecs_world_t ecs_world_t;
 typedef struct ecs_rows_t ecs_rows_t;
 typedef struct ecs_reference_t ecs_reference_t;
 typedef struct ecs_snapshot_t ecs_snapshot_t;
+typedef struct ecs_snapshot_ring_t ecs_snapshot_ring_t;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -86,6 +87,39 @@ typedef void (*ecs_module_init_action_t)(
     ecs_world_t *world,
     int flags);    
 
+/** Constructor/destructor of component values.
+ * Invoked for count values of a component, stored contiguously at ptr. */
+typedef void (*ecs_xtor_t)(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx);
+
+/** Copy count component values from src_ptr to dst_ptr. The values at dst_ptr
+ * have been constructed. */
+typedef void (*ecs_copy_t)(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *dst_ptr,
+    const void *src_ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx);
+
+/** Move count component values from src_ptr to dst_ptr. The values at dst_ptr
+ * have been constructed, and the values at src_ptr are destructed after the
+ * move. */
+typedef void (*ecs_move_t)(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *dst_ptr,
+    void *src_ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx);
+
 /** Types that describe a type filter.
  * Filters provide a quick mechanism to query entities or run operations on
  * entities of one or more types. Filters contain a components to include and
@@ -151,6 +185,7 @@ struct ecs_rows_t {
     ecs_entity_t *entities;      /* Entity row */
 
     void *param;                 /* Userdata passed to on-demand system */
+    void *system_ctx;            /* Context set with ecs_set_system_context */
     float delta_time;            /* Time elapsed since last frame */
     float world_time;            /* Time elapsed since start of simulation */
     uint32_t frame_offset;       /* Offset relative to frame */
@@ -174,6 +209,15 @@ typedef struct EcsComponent {
     uint32_t size;
 } EcsComponent;
 
+/** Lifecycle callbacks of a component (see ecs_set_component_lifecycle) */
+typedef struct EcsComponentLifecycle {
+    ecs_xtor_t ctor;    /* Invoked when values are added to a table */
+    ecs_xtor_t dtor;    /* Invoked when values are removed from a table */
+    ecs_copy_t copy;    /* Invoked when values are copied (set, clone) */
+    ecs_move_t move;    /* Invoked when values move to another location */
+    void *ctx;          /* Passed to all callbacks */
+} EcsComponentLifecycle;
+
 /** Metadata of an explicitly created type (ECS_TYPE or ecs_new_type) */
 typedef struct EcsTypeComponent {
     ecs_type_t type;    /* Preserved nested types */
@@ -196,6 +240,13 @@ typedef struct EcsPrefab {
 #define ECS_INSTANCEOF ((ecs_entity_t)1 << 63)
 #define ECS_CHILDOF ((ecs_entity_t)1 << 62) 
 
+/* Ids of deleted entities are recycled. To detect handles to deleted entities,
+ * a recycled id stores its generation in the bits below the type masks. */
+#define ECS_GENERATION_SHIFT (46)
+#define ECS_GENERATION_MASK ((ecs_entity_t)0xFFFF << ECS_GENERATION_SHIFT)
+#define ECS_GENERATION(e) (((e) & ECS_GENERATION_MASK) >> ECS_GENERATION_SHIFT)
+#define ECS_ENTITY_ID(e) ((e) & ~(ECS_ENTITY_FLAGS_MASK | ECS_GENERATION_MASK))
+
 /** Type handles to builtin components */
 FLECS_EXPORT
 extern ecs_type_t 
@@ -352,6 +403,15 @@ extern ecs_type_t
  * - A CASCADE expression ('CASCADE.Position')
  * - An entity expression ('MyEntity.Position')
  * - An empty expression ('.Position')
+ *
+ * Columns can be preceded by annotations. The '[in]' and '[out]' annotations
+ * specify whether a system only reads or only writes a column. The '[changed]'
+ * annotation specifies that the system only runs on tables in which the column
+ * changed since the system last ran on the table, which can be combined with
+ * other annotations ('[in, changed] Position'). A column changes when a system
+ * that does not have it as '[in]' runs on the table, when it is set with
+ * ecs_set, or when entities are added to or removed from the table. Writes
+ * through pointers returned by ecs_get_ptr are not detected.
  * 
  * The systen kind specifies the phase in which the system is ran.
  *
@@ -832,6 +892,10 @@ ecs_entity_t ecs_clone(
  * As a result of a delete operation, EcsOnRemove systems will be invoked if
  * applicable for any of the removed components.
  *
+ * The id of a deleted entity will be recycled by a future call to ecs_new. The
+ * recycled id has a higher generation, which ensures that the handle of the
+ * deleted entity is not valid for the new entity.
+ *
  * @param world The world.
  * @param entity The entity to empty.
  */
@@ -840,6 +904,23 @@ void ecs_delete(
     ecs_world_t *world,
     ecs_entity_t entity);
 
+/** Test whether an entity is alive.
+ * An entity is alive when it has been created, and has not been deleted. When
+ * the id of a deleted entity is recycled, the handle of the deleted entity will
+ * not be alive, as its generation is no longer current.
+ *
+ * Deletes that are performed while iterating are not visible to this operation
+ * until the stage is merged.
+ *
+ * @param world The world.
+ * @param entity The entity to test.
+ * @return true if the entity is alive, false if it is not.
+ */
+FLECS_EXPORT
+bool ecs_is_alive(
+    ecs_world_t *world,
+    ecs_entity_t entity);
+
 /** Delete all entities containing a (set of) component(s). 
  * This operation provides a more efficient alternative to deleting entities one
  * by one by deleting an entire table or set of tables in a single operation.
@@ -1020,6 +1101,12 @@ void ecs_disinherit(
  * and only one of the components occurs in a table, that component will be
  * added/removed from the entities in the table.
  *
+ * All entities of a matching table are moved to the destination table at once.
+ * Component values are moved column by column, and when the destination table
+ * is empty, the columns of the source table are handed over without copying.
+ * Values of added components are initialized with the constructor of the
+ * component, if one is registered.
+ *
  * @param world The world.
  * @param to_add The components to add.
  * @param to_remove The components to remove.
@@ -1278,9 +1365,9 @@ uint32_t ecs_count_w_filter(
 
 /** Lookup an entity by id.
  * This operation is a convenient way to lookup entities by string identifier
- * that have the EcsId component. It is recommended to cache the result of this
- * function, as the function must iterates over all entities and all components
- * in an entity.
+ * that have the EcsId component. Entities are found with a hash index that is
+ * updated when EcsId is set, which requires that the EcsId component is set
+ * with ecs_set and not by writing to the pointer returned by ecs_get_ptr.
  *
  * @param world The world.
  * @param id The id to lookup.
@@ -1313,6 +1400,59 @@ ecs_entity_t ecs_lookup_child(
     ecs_entity_t parent,
     const char *id);
 
+/** Lookup entity by path.
+ * This operation looks up an entity by a path of ids separated by dots, like
+ * "parent.child.grandchild". Each element in the path is looked up as a child
+ * of the entity found for the previous element, as if by ecs_lookup_child. The
+ * first element is looked up as a child of the specified parent, or in the
+ * whole world if parent is 0.
+ *
+ * Elements in the path may not be longer than 255 characters.
+ *
+ * @param world The world.
+ * @param parent The entity from which to start the lookup, or 0.
+ * @param path The path to lookup.
+ * @return The entity handle if found, or 0 if not found.
+ */
+FLECS_EXPORT
+ecs_entity_t ecs_lookup_path(
+    ecs_world_t *world,
+    ecs_entity_t parent,
+    const char *path);
+
+/** Register lifecycle callbacks for a component.
+ * By default component values are plain data: they are not initialized when a
+ * component is added, they are copied and moved with memcpy, and nothing is
+ * done when they are removed. Components that own resources, like C++ types
+ * that own heap memory, can register callbacks that are invoked instead.
+ *
+ * Callbacks are invoked for ranges of values where possible, for example once
+ * per column when entities are moved to another table in bulk. Values are
+ * constructed when rows are added to a table, including the rows of a stage,
+ * and destructed when rows are deleted or tables are cleared. Values that move
+ * to another row or table, or that move when the storage of a column grows,
+ * are moved with the move callback, after which the source value is
+ * destructed. Values are copied with the copy callback by ecs_set, ecs_clone,
+ * prefab overrides and when columns that are shared with a snapshot are copied.
+ * Values of a component without a constructor are zero-initialized once
+ * callbacks are registered. Without a move callback a value is moved by
+ * destructing the destination, copying the bytes and constructing the source
+ * again. Other callbacks that are not set fall back to the default behavior.
+ *
+ * The callbacks must be registered before the component is added to entities.
+ * Data that is serialized with a reader and deserialized with a writer is
+ * copied as raw bytes, which is not valid for components with callbacks.
+ *
+ * @param world The world.
+ * @param component The component.
+ * @param lifecycle The callbacks.
+ */
+FLECS_EXPORT
+void ecs_set_component_lifecycle(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const EcsComponentLifecycle *lifecycle);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 //// Rows API
@@ -1489,7 +1629,10 @@ FLECS_EXPORT
 ecs_type_t ecs_table_type(
     const ecs_rows_t *rows);
 
-/** Get column using the table index. */
+/** Get column using the table index. 
+ * The returned pointer points to the first row of the rows object, which is
+ * not the first row of the table when the rows object contains a slice of the
+ * table (as is the case for jobs that run on worker threads). */
 FLECS_EXPORT
 void* ecs_table_column(
     const ecs_rows_t *rows,
@@ -1530,6 +1673,7 @@ typedef struct ecs_filter_iter_t {
     ecs_filter_t filter;
     ecs_chunked_t *tables;
     uint32_t index;
+    uint64_t bloom;
     ecs_rows_t rows;
 } ecs_filter_iter_t;
 
@@ -1577,6 +1721,35 @@ FLECS_EXPORT
 bool ecs_filter_next(
     ecs_filter_iter_t *iter);
 
+/** Run a callback for the tables matched by a filter on the worker threads.
+ * This operation divides the rows of the tables that match the filter in jobs,
+ * and runs the jobs on the worker threads created with ecs_set_threads. The
+ * callback is invoked with an ecs_rows_t object for each slice of a table. A
+ * slice starts at rows->offset in the table, which is taken into account by
+ * ecs_table_column. The size of the jobs is determined by ecs_set_job_size.
+ *
+ * The callback may be invoked from multiple threads at the same time, and
+ * should only write the rows it is passed. Operations that mutate the world
+ * should use rows->world, which causes them to be staged in the stage of the
+ * thread. When the operation is invoked outside of ecs_progress, the stages are
+ * merged (if automerging is enabled) before the operation returns. Otherwise
+ * they are merged at the end of the current phase.
+ *
+ * If no worker threads have been created, the callback is invoked on the
+ * calling thread. The operation cannot be called from a worker thread.
+ *
+ * @param world The world.
+ * @param filter The filter to match tables with (may be NULL).
+ * @param action The callback to invoke for matched rows.
+ * @param param A user parameter that is passed to the callback in rows->param.
+ */
+FLECS_EXPORT
+void ecs_filter_run(
+    ecs_world_t *world,
+    const ecs_filter_t *filter,
+    ecs_system_action_t action,
+    void *param);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 //// System API
@@ -1803,6 +1976,29 @@ ecs_snapshot_t* ecs_snapshot_take(
     ecs_world_t *world,
     const ecs_filter_t *filter);
 
+/** Create a snapshot that shares data with the world.
+ * This operation creates a snapshot without copying component data. Columns
+ * are shared between the world and the snapshot, and are only copied when the
+ * world writes to them, which happens when entities are added to or removed
+ * from a table, when a system accesses a column that is not [in], or when a
+ * component is set with ecs_set. The cost of taking a snapshot is therefore
+ * proportional to the data that changes after the snapshot is taken.
+ *
+ * Writes through pointers returned by ecs_get_ptr are not detected, and will
+ * also change the data in the snapshot. Use ecs_set to modify components in
+ * worlds with shared snapshots.
+ *
+ * A shared snapshot is restored, copied and freed like a regular snapshot.
+ *
+ * @param world The world to snapshot.
+ * @param filter A filter that specifies which components to snapshot.
+ * @param return The snapshot.
+ */
+FLECS_EXPORT
+ecs_snapshot_t* ecs_snapshot_take_shared(
+    ecs_world_t *world,
+    const ecs_filter_t *filter);
+
 /** Restore a snapshot.
  * This operation restores the world to the state it was in when the specified
  * snapshot was taken. A snapshot can only be used once for restoring, as its
@@ -1848,6 +2044,68 @@ void ecs_snapshot_free(
     ecs_world_t *world,
     ecs_snapshot_t *snapshot);
 
+/** Create a snapshot ring.
+ * A snapshot ring stores the last N shared snapshots of a world, and can be 
+ * used to roll a world back to one of the previous frames, for example when a
+ * networked game receives input that is older than the current frame.
+ *
+ * @param size The maximum number of snapshots in the ring.
+ * @return The snapshot ring.
+ */
+FLECS_EXPORT
+ecs_snapshot_ring_t* ecs_snapshot_ring_new(
+    uint32_t size);
+
+/** Push a snapshot of the world to a snapshot ring.
+ * This operation takes a shared snapshot (see ecs_snapshot_take_shared) and
+ * adds it to the ring. If the ring is full, the oldest snapshot is freed.
+ *
+ * @param world The world to snapshot.
+ * @param ring The snapshot ring.
+ */
+FLECS_EXPORT
+void ecs_snapshot_ring_push(
+    ecs_world_t *world,
+    ecs_snapshot_ring_t *ring);
+
+/** Return the number of snapshots in a snapshot ring.
+ *
+ * @param ring The snapshot ring.
+ * @return The number of snapshots in the ring.
+ */
+FLECS_EXPORT
+uint32_t ecs_snapshot_ring_count(
+    ecs_snapshot_ring_t *ring);
+
+/** Roll back the world to a snapshot in a snapshot ring.
+ * This operation restores the snapshot that was pushed 'age' pushes ago, where
+ * an age of 0 restores the last pushed snapshot. Snapshots that were pushed 
+ * after the restored snapshot are freed. The restored snapshot stays in the
+ * ring, so the world can be rolled back to it again.
+ *
+ * @param world The world to restore the snapshot to.
+ * @param ring The snapshot ring.
+ * @param age The number of pushes ago the snapshot was taken.
+ * @return true if the snapshot was restored, false if the ring has no snapshot
+ *         of that age.
+ */
+FLECS_EXPORT
+bool ecs_snapshot_ring_rollback(
+    ecs_world_t *world,
+    ecs_snapshot_ring_t *ring,
+    uint32_t age);
+
+/** Free a snapshot ring.
+ * This frees the snapshot ring and the snapshots stored in it.
+ *
+ * @param world The world.
+ * @param ring The snapshot ring.
+ */
+FLECS_EXPORT
+void ecs_snapshot_ring_free(
+    ecs_world_t *world,
+    ecs_snapshot_ring_t *ring);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 //// Reader/writer API
@@ -1879,6 +2137,29 @@ ecs_reader_t ecs_snapshot_reader_init(
     ecs_world_t *world,
     const ecs_snapshot_t *snapshot);
 
+/** Initialize a delta reader.
+ * A delta reader serializes the changes in a world since a snapshot was taken.
+ * The delta contains the entities that are no longer stored in a table, tables
+ * that store different entities than in the snapshot, and the chunks of column
+ * data that changed in tables that store the same entities.
+ *
+ * A delta is applied in place by a regular writer, to a world that contains the
+ * same data as the snapshot, for example because the snapshot was serialized to
+ * the world before. Component data that is shared between the world and the
+ * snapshot is not compared, which makes deltas of shared snapshots cheap.
+ *
+ * The snapshot must not be filtered, and must stay alive while the delta is
+ * read.
+ *
+ * @param world The world to serialize.
+ * @param base The snapshot that the delta is computed against.
+ * @return The reader.
+ */
+FLECS_EXPORT
+ecs_reader_t ecs_delta_reader_init(
+    ecs_world_t *world,
+    const ecs_snapshot_t *base);
+
 /** Read from a reader.
  * This operation reads a specified number of bytes from a reader and stores it
  * in the specified buffer. When there are no more bytes to read from the reader
@@ -1886,7 +2167,12 @@ ecs_reader_t ecs_snapshot_reader_init(
  * read.
  *
  * The specified buffer must be at least as big as the specified size, and the
- * specified size must be a multiple of 4.
+ * specified size must be a multiple of 4. The reader fills the buffer unless
+ * there is no more data to read.
+ *
+ * Serialized data starts with ECS_BLOB_VERSION, followed by a header for each
+ * table and the table columns. Columns are copied as a whole, so reading large
+ * tables is not much slower than copying their memory.
  *
  * @param buffer The buffer in which to store the read bytes.
  * @param size The maximum number of bytes to read.
@@ -1928,7 +2214,8 @@ ecs_writer_t ecs_writer_init(
  * the data contains conflicts with the world, the operation will fail. The
  * data must be provided in the same order as produced by ecs_reader_read,
  * but the used buffer size does not have to be the same as the one used by
- * ecs_reader_read. The buffer size must be a multiple of 4.
+ * ecs_reader_read. The buffer size must be a multiple of 4. Data that was
+ * serialized with a different format version is rejected.
  * 
  * @param buffer The buffer to deserialize.
  * @param size The maximum number of bytes.
@@ -1941,6 +2228,43 @@ int ecs_writer_write(
     size_t size,
     ecs_writer_t *writer);
 
+/** Save a world to a file.
+ * This operation serializes the world with a reader, and aligns table columns
+ * in the file so that the file can be loaded with ecs_load_file without copying
+ * the columns. Columns of one page or larger start at a page boundary. The file
+ * can also be deserialized with a regular writer.
+ *
+ * @param world The world to save.
+ * @param filename The file to write to.
+ * @return Zero if success, non-zero if failed to write the file.
+ */
+FLECS_EXPORT
+int ecs_save_file(
+    ecs_world_t *world,
+    const char *filename);
+
+/** Load a world from a file.
+ * This operation maps a file that was created with ecs_save_file into memory,
+ * and uses the columns in the file as table storage. Loading a world therefore
+ * only touches the pages that contain the entity ids, and the pages of other
+ * columns are read when they are accessed.
+ *
+ * The file is mapped copy-on-write with the map_file operation of the OS API,
+ * so changes to components are never written back to the file. A table copies
+ * its columns to regular memory the first time it needs to grow them. The file
+ * stays mapped until the world is deleted.
+ *
+ * The same restrictions that apply to ecs_writer_init apply to the world.
+ *
+ * @param world The world in which to load the data.
+ * @param filename The file to load.
+ * @return Zero if success, non-zero if failed to load the file.
+ */
+FLECS_EXPORT
+int ecs_load_file(
+    ecs_world_t *world,
+    const char *filename);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 //// Module API
@@ -2301,6 +2625,13 @@ int16_t ecs_type_index_of(
  * The initial value is zero, which means that ecs_progress will only use the
  * mainthread.
  *
+ * When running on multiple threads, systems in the same phase that do not
+ * access the same components run concurrently. Systems that do, where at least
+ * one of them writes the component, run in the order in which they were
+ * declared. Components are considered written unless they are marked with the
+ * [in] modifier in the system signature. Systems that do not access any
+ * components never run concurrently with other systems.
+ *
  * @param world The world.
  * @param threads: The number of threads.
  * @return 0 if successful, or -1 if failed.
@@ -2320,6 +2651,45 @@ FLECS_EXPORT
 uint32_t ecs_get_threads(
     ecs_world_t *world);
 
+/** Set number of rows per job.
+ * When systems run on multiple threads, the entities matched by a system are
+ * divided into jobs. Each thread starts with an equal share of the jobs, and
+ * threads that run out of jobs steal jobs from other threads. Smaller jobs
+ * balance work better when the cost per entity varies, at the cost of more
+ * scheduling overhead.
+ *
+ * The initial value is zero, which divides each system into a small number of
+ * jobs per thread.
+ *
+ * @param world The world.
+ * @param rows The number of rows per job.
+ */
+FLECS_EXPORT
+void ecs_set_job_size(
+    ecs_world_t *world,
+    uint32_t rows);
+
+/** Set number of iterations threads spin before blocking.
+ * When systems run on multiple threads, worker threads wait for the next phase
+ * to start, and the main thread waits for worker threads to finish. Threads
+ * can busy-wait for a number of iterations before they block on a condition
+ * variable. This avoids the latency of waking up threads when phases follow
+ * each other quickly, at the cost of CPU time spent spinning. Spinning should
+ * only be enabled when there are at least as many cores as threads, as a
+ * spinning thread otherwise takes time away from threads that are working.
+ *
+ * The initial value is zero, which means that threads block right away. Worker
+ * threads pick up a new value when the next phase starts. This function must
+ * not be called while systems are running.
+ *
+ * @param world The world.
+ * @param spin_count The number of iterations to spin before blocking.
+ */
+FLECS_EXPORT
+void ecs_set_thread_spin(
+    ecs_world_t *world,
+    uint32_t spin_count);
+
 /** Get index of current worker thread.
  * While iterting, a system can invoke this operation to obtain a number that
  * uniquely identifies the thread from which the operation is invoked.
@@ -2371,6 +2741,48 @@ void ecs_set_automerge(
     ecs_world_t *world,
     bool auto_merge);
 
+/** Set whether tables store their columns in a single block.
+ * By default, each column of a table is allocated separately, and is grown
+ * separately when entities are added to the table. When this option is enabled,
+ * all columns of a table are stored in a single block, which is grown with a
+ * single allocation. The data of each column is aligned to 64 bytes, which
+ * allows systems to use aligned SIMD loads and stores on columns.
+ *
+ * This option only applies to tables that are created after it is enabled. It
+ * should be enabled right after creating the world, before entities are added.
+ *
+ * @param world The world.
+ * @param enable: When true, new tables store their columns in a single block.
+ */
+FLECS_EXPORT
+void ecs_set_table_arena(
+    ecs_world_t *world,
+    bool enable);
+
+/** Set the allocator for block storage owned by the world.
+ * The allocator is only used for block storage: the blocks that store the
+ * columns of tables when the table arena is enabled (see ecs_set_table_arena),
+ * the blocks of tables loaded with ecs_load_file, and the blocks in which
+ * stages store data until they are merged.
+ *
+ * All other memory, including the columns of tables that are not stored in a
+ * block (the default), is allocated with the functions of the OS API and is
+ * not passed to this allocator.
+ *
+ * Each world can have its own allocator, which for example allows worlds to
+ * allocate blocks from their own memory pool. Block allocations are counted per
+ * world, and are reported by the EcsAllocStats component of the stats module.
+ * The allocator must be set right after creating the world, while no memory is
+ * allocated from the previous allocator.
+ *
+ * @param world The world.
+ * @param allocator The allocator, or NULL to use the OS API allocator.
+ */
+FLECS_EXPORT
+void ecs_set_allocator(
+    ecs_world_t *world,
+    const ecs_os_allocator_t *allocator);
+
 ////////////////////////////////////////////////////////////////////////////////
 //// Utilities
 ////////////////////////////////////////////////////////////////////////////////
@@ -3,6 +3,9 @@
 #include <string>
 #include <sstream>
 #include <array>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace flecs {
 
@@ -868,6 +871,118 @@ template <typename T> type_t component_base<T>::s_type( nullptr );
 template <typename T> const char* component_base<T>::s_name( nullptr );
 
 
+////////////////////////////////////////////////////////////////////////////////
+//// Lifecycle callbacks that invoke the constructors and operators of a type
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class component_lifecycle final {
+public:
+    static void ctor(world_t*, entity_t, void *ptr, size_t size, uint32_t count, void*) {
+        ecs_assert(size == sizeof(T), ECS_INTERNAL_ERROR, NULL);
+        T *arr = static_cast<T*>(ptr);
+        for (uint32_t i = 0; i < count; i ++) {
+            new (&arr[i]) T();
+        }
+    }
+
+    static void dtor(world_t*, entity_t, void *ptr, size_t size, uint32_t count, void*) {
+        ecs_assert(size == sizeof(T), ECS_INTERNAL_ERROR, NULL);
+        T *arr = static_cast<T*>(ptr);
+        for (uint32_t i = 0; i < count; i ++) {
+            arr[i].~T();
+        }
+    }
+
+    static void copy(world_t*, entity_t, void *dst_ptr, const void *src_ptr, size_t size, uint32_t count, void*) {
+        ecs_assert(size == sizeof(T), ECS_INTERNAL_ERROR, NULL);
+        T *dst = static_cast<T*>(dst_ptr);
+        const T *src = static_cast<const T*>(src_ptr);
+        for (uint32_t i = 0; i < count; i ++) {
+            dst[i] = src[i];
+        }
+    }
+
+    static void move(world_t*, entity_t, void *dst_ptr, void *src_ptr, size_t size, uint32_t count, void*) {
+        ecs_assert(size == sizeof(T), ECS_INTERNAL_ERROR, NULL);
+        T *dst = static_cast<T*>(dst_ptr);
+        T *src = static_cast<T*>(src_ptr);
+        for (uint32_t i = 0; i < count; i ++) {
+            dst[i] = std::move(src[i]);
+        }
+    }
+
+    /* Types that cannot be move assigned, for example because they have const
+     * members, are moved by destructing and move constructing the value */
+    static void move_construct(world_t*, entity_t, void *dst_ptr, void *src_ptr, size_t size, uint32_t count, void*) {
+        ecs_assert(size == sizeof(T), ECS_INTERNAL_ERROR, NULL);
+        T *dst = static_cast<T*>(dst_ptr);
+        T *src = static_cast<T*>(src_ptr);
+        for (uint32_t i = 0; i < count; i ++) {
+            dst[i].~T();
+            new (&dst[i]) T(std::move(src[i]));
+        }
+    }
+
+    /* Types that cannot be copied can only be added, not set or cloned */
+    static void copy_invalid(world_t*, entity_t, void*, const void*, size_t, uint32_t, void*) {
+        ecs_abort(ECS_INVALID_PARAMETER, "component is not copy assignable");
+    }
+
+    template <typename U = T,
+        typename std::enable_if<std::is_copy_assignable<U>::value, void>::type* = nullptr>
+    static ecs_copy_t copy_action() {
+        return copy;
+    }
+
+    template <typename U = T,
+        typename std::enable_if<std::is_copy_assignable<U>::value == false, void>::type* = nullptr>
+    static ecs_copy_t copy_action() {
+        return copy_invalid;
+    }
+
+    template <typename U = T,
+        typename std::enable_if<std::is_move_assignable<U>::value, void>::type* = nullptr>
+    static ecs_move_t move_action() {
+        return move;
+    }
+
+    template <typename U = T,
+        typename std::enable_if<std::is_move_assignable<U>::value == false && 
+            std::is_move_constructible<U>::value, void>::type* = nullptr>
+    static ecs_move_t move_action() {
+        return move_construct;
+    }
+
+    /* Without a move callback values are moved with memcpy */
+    template <typename U = T,
+        typename std::enable_if<std::is_move_assignable<U>::value == false && 
+            std::is_move_constructible<U>::value == false, void>::type* = nullptr>
+    static ecs_move_t move_action() {
+        return nullptr;
+    }
+
+    /* Trivial types are copied and moved with memcpy. Types that cannot be 
+     * default constructed, like modules, are plain data as well. */
+    template <typename U = T,
+        typename std::enable_if<std::is_trivial<U>::value || 
+            std::is_default_constructible<U>::value == false, void>::type* = nullptr>
+    static void init(const world&, entity_t) { }
+
+    template <typename U = T,
+        typename std::enable_if<std::is_trivial<U>::value == false && 
+            std::is_default_constructible<U>::value, void>::type* = nullptr>
+    static void init(const world& world, entity_t component) {
+        EcsComponentLifecycle lifecycle = {};
+        lifecycle.ctor = ctor;
+        lifecycle.dtor = dtor;
+        lifecycle.copy = copy_action();
+        lifecycle.move = move_action();
+        ecs_set_component_lifecycle(world.c_ptr(), component, &lifecycle);
+    }
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //// Register a component with flecs
 ////////////////////////////////////////////////////////////////////////////////
@@ -877,6 +992,7 @@ class component : public entity {
 public:
     component(const world& world, const char *name) { 
         component_base<T>::init(world, name);
+        component_lifecycle<T>::init(world, component_base<T>::s_entity);
 
         /* Register as well for both const and reference versions of type */
         component_base<const T>::init_existing(
@@ -1098,8 +1214,8 @@ public:
     template <typename... Targs,
         typename std::enable_if<sizeof...(Targs) == sizeof...(Components), void>::type* = nullptr>
     static void call_system(ecs_rows_t *rows, int index, columns& columns, Targs... comps) {
-        system_ctx *self = (system_ctx*)
-            ecs_get_system_context(rows->world, rows->system);
+        /* Use system_ctx, as param can be set by the application */
+        system_ctx *self = static_cast<system_ctx*>(rows->system_ctx);
 
         Func func = self->m_func;
 
@@ -1128,6 +1244,84 @@ private:
 };
 
 
+////////////////////////////////////////////////////////////////////////////////
+//// Utility class to invoke a system action for each entity
+////////////////////////////////////////////////////////////////////////////////
+
+template <std::size_t... Is>
+struct column_indices { };
+
+template <std::size_t N, std::size_t... Is>
+struct make_column_indices : make_column_indices<N - 1, N - 1, Is...> { };
+
+template <std::size_t... Is>
+struct make_column_indices<0, Is...> {
+    using type = column_indices<Is...>;
+};
+
+template <typename Func, typename ... Components>
+class each_ctx {
+    using columns = std::array<void*, sizeof...(Components)>;
+    using indices = typename make_column_indices<sizeof...(Components)>::type;
+
+    template <typename T>
+    using column_type = typename std::remove_reference<T>::type;
+
+public:
+    explicit each_ctx(Func func) : m_func(func) { }
+
+    /** Callback provided to flecs */
+    static void run(ecs_rows_t *rows) {
+        /* Use system_ctx, as param can be set by the application */
+        each_ctx *self = static_cast<each_ctx*>(rows->system_ctx);
+        self->invoke(rows, indices());
+    }
+
+private:
+    /* Column pointers are resolved once per table. Shared columns store a
+     * single value, which is used for all entities. */
+    template <typename T>
+    static void* column_ptr(ecs_rows_t *rows, uint32_t column) {
+        ecs_assert(ecs_column_entity(rows, column) == component_base<T>::s_entity, 
+            ECS_COLUMN_TYPE_MISMATCH, NULL);
+        return _ecs_column(rows, sizeof(column_type<T>), column);
+    }
+
+    template <std::size_t... Is>
+    void invoke(ecs_rows_t *rows, column_indices<Is...>) {
+        columns ptrs = {{ column_ptr<Components>(rows, Is + 1)... }};
+        std::array<uint32_t, sizeof...(Components)> strides = {{
+            static_cast<uint32_t>(!ecs_is_shared(rows, Is + 1))...
+        }};
+
+        world_t *world = rows->world;
+        ecs_entity_t *entities = rows->entities;
+        uint32_t count = rows->count;
+
+        bool is_shared = false;
+        for (auto stride : strides) {
+            is_shared |= !stride;
+        }
+
+        if (!is_shared) {
+            for (uint32_t i = 0; i < count; i ++) {
+                m_func(flecs::entity(world, entities[i]), 
+                    static_cast<column_type<Components>*>(ptrs[Is])[i]...);
+            }
+        } else {
+            for (uint32_t i = 0; i < count; i ++) {
+                m_func(flecs::entity(world, entities[i]), 
+                    static_cast<column_type<Components>*>(ptrs[Is])[i * strides[Is]]...);
+            }
+        }
+
+        (void)ptrs;
+    }
+
+    Func m_func;
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //// Fluent interface to run a system manually
 ////////////////////////////////////////////////////////////////////////////////
@@ -1243,7 +1437,24 @@ public:
     template <typename Func>
     system& action(Func func) {
         auto ctx = new system_ctx<Func, Components...>(func);
+        create_system(system_ctx<Func, Components...>::run, ctx);
+        return *this;
+    }
+
+    /* Each is an alternative to action that is invoked for each entity, with
+     * the entity and a reference to each of the components. Column pointers
+     * are resolved once per table, after which the function is invoked in a 
+     * loop over the entities. */
+    template <typename Func>
+    system& each(Func func) {
+        auto ctx = new each_ctx<Func, Components...>(func);
+        create_system(each_ctx<Func, Components...>::run, ctx);
+        return *this;
+    }
 
+    ~system() = default;
+private:
+    void create_system(ecs_system_action_t action, void *ctx) {
         std::stringstream str;
         std::array<const char*, sizeof...(Components)> ids = {
             component_base<Components>::s_name...
@@ -1295,18 +1506,13 @@ public:
             m_name, 
             m_kind, 
             signature.c_str(), 
-            system_ctx<Func, Components...>::run);
+            action);
 
         ecs_set_system_context(m_world, e, ctx);
 
         m_id = e;
-
-        return *this;
     }
 
-    ~system() = default;
-private:
-
     /** Utilities to convert type trait to flecs signature syntax */
     template <typename T,
         typename std::enable_if< std::is_const<T>::value == true, void>::type* = nullptr>
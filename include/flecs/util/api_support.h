@@ -16,6 +16,18 @@ typedef struct ecs_table_column_t ecs_table_column_t;
 //// Private datatypes
 ////////////////////////////////////////////////////////////////////////////////
 
+/* Identifies the format of serialized data. This is the first word of the
+ * data produced by a reader. */
+#define ECS_BLOB_VERSION (0x464c0003)
+
+/* Column data that is at least a page large is aligned to a page boundary when
+ * a reader aligns columns, so that a mapped column only touches its own pages */
+#define ECS_BLOB_PAGE_SIZE (4096)
+
+/* A delta compares columns in chunks of this many bytes, and only serializes
+ * chunks that are different from the base snapshot */
+#define ECS_BLOB_CHUNK_SIZE (512)
+
 typedef enum ecs_blob_header_kind_t {
     EcsStreamHeader,
 
@@ -26,29 +38,76 @@ typedef enum ecs_blob_header_kind_t {
 
     /* Component segment */
     EcsComponentHeader,
-    EcsComponentId,
-    EcsComponentSize,
-    EcsComponentNameLength,
     EcsComponentName,
 
     /* Table segment */
     EcsTableHeader,
-    EcsTableTypeSize,
     EcsTableType,
-    EcsTableSize,
-    EcsTableColumn,
     EcsTableColumnHeader,
-    EcsTableColumnSize,
     EcsTableColumnData,
 
+    /* Aligned column that is preceded by a vector header */
+    EcsTableColumnVectorHeader,
+    EcsTableColumnVector,
+
     /* Name column (EcsId) */
     EcsTableColumnNameHeader,
-    EcsTableColumnNameLength,
     EcsTableColumnName,
 
+    /* Delta segment, with entities that are no longer stored in a table */
+    EcsDeltaSegment,
+    EcsDeltaDeleteHeader,
+    EcsDeltaDeleteEntity,
+
+    /* Table that has the same entities as in the base snapshot, followed by
+     * the chunks of column data that changed */
+    EcsTableDeltaHeader,
+    EcsTableDeltaType,
+    EcsTableChunkHeader,
+    EcsTableChunkData,
+
     EcsStreamFooter  
 } ecs_blob_header_kind_t;
 
+/* Serialized component, followed by the component name */
+typedef struct ecs_blob_component_t {
+    ecs_entity_t id;
+    int32_t size;
+    int32_t name_len;
+} ecs_blob_component_t;
+
+/* Serialized table, followed by the type and the table columns */
+typedef struct ecs_blob_table_t {
+    int32_t type_count;
+    int32_t row_count;
+} ecs_blob_table_t;
+
+/* Serialized column, followed by padding bytes and the column data. For name
+ * columns the size is the number of bytes of all names, otherwise it is the
+ * component size. For vector columns the padding is followed by a vector
+ * header, so that the column can be used without copying it. */
+typedef struct ecs_blob_column_t {
+    int32_t kind;
+    int32_t size;
+    int32_t padding;
+} ecs_blob_column_t;
+
+/* Serialized entities that are no longer stored in a table, followed by the
+ * entity ids. If is_deleted is set, the entities are deleted, otherwise they no
+ * longer have components. */
+typedef struct ecs_blob_delete_t {
+    int32_t count;
+    int32_t is_deleted;
+} ecs_blob_delete_t;
+
+/* Serialized chunk of rows in a column of a delta table, followed by the
+ * column data of the rows */
+typedef struct ecs_blob_chunk_t {
+    int32_t column;
+    int32_t row;
+    int32_t count;
+} ecs_blob_chunk_t;
+
 typedef struct ecs_component_reader_t {
     ecs_blob_header_kind_t state;
 
@@ -60,11 +119,6 @@ typedef struct ecs_component_reader_t {
     /* Current component & total number of components */
     int32_t index;
     int32_t count;
-
-    /* Keep track how much of the component name has been written */
-    const char *name;
-    size_t len;
-    size_t written;
 } ecs_component_reader_t;
 
 typedef struct ecs_table_reader_t {
@@ -73,29 +127,24 @@ typedef struct ecs_table_reader_t {
     uint32_t table_index;
     ecs_table_t *table;
     ecs_table_column_t *columns;
-
-    /* Current index in type */
-    int32_t type_written;
     ecs_type_t type;
 
     /* Current column */
-    ecs_table_column_t *column;
     int32_t column_index;
     int32_t total_columns;
 
-    /* Keep track of how much of the component column has been written */
-    void *column_data;
-    size_t column_size;
-    size_t column_written;
-
     /* Keep track of row when writing non-blittable data */
     int32_t row_index;
-    uint32_t row_count;
+    int32_t row_count;
+
+    /* Total number of bytes of names in name column */
+    size_t names_size;
+
+    /* Table in base snapshot, if the table is serialized as delta */
+    ecs_table_t *base;
 
-    /* Keep track of how much of an entity name has been written */
-    const char *name;
-    size_t name_len;
-    size_t name_written;
+    /* Entities that are no longer stored in a table */
+    ecs_entity_t *deleted;
 } ecs_table_reader_t;
 
 typedef struct ecs_reader_t {
@@ -104,43 +153,63 @@ typedef struct ecs_reader_t {
     ecs_chunked_t *tables;
     ecs_component_reader_t component;
     ecs_table_reader_t table;
+
+    /* If set, only data that changed since the snapshot is serialized */
+    const ecs_snapshot_t *base;
+
+    /* Data that is being copied to the output, followed by padding bytes */
+    const void *data;
+    size_t data_size;
+    size_t data_padding;
+    size_t data_read;
+    int64_t header[3];
+
+    /* If set, column data is aligned in the output so it can be mapped */
+    size_t alignment;
+    size_t offset;
 } ecs_reader_t;
 
 typedef struct ecs_name_writer_t {
     char *name;
-    int32_t written;
     int32_t len;
     int32_t max_len;
 } ecs_name_writer_t;
 
 typedef struct ecs_component_writer_t {
-    ecs_blob_header_kind_t state;
-
-    int32_t id;
+    ecs_entity_t id;
     size_t size;
     ecs_name_writer_t name;
 } ecs_component_writer_t;
 
 typedef struct ecs_table_writer_t {
-    ecs_blob_header_kind_t state;
-
     ecs_table_t *table;
+    ecs_table_column_t *columns;
     ecs_table_column_t *column;
 
+    /* Block for columns of a mapped table that are not stored in the input */
+    void *arena;
+    size_t arena_size;
+
     /* Keep state for parsing type */
     uint32_t type_count;
     uint32_t type_max_count;
-    uint32_t type_written;
     ecs_entity_t *type_array;
     
     uint32_t column_index;
-    uint32_t column_size;
-    uint32_t column_written;
-    void *column_data;
-
     uint32_t row_count;
-    int32_t row_index;
-    ecs_name_writer_t name; 
+
+    /* Number of rows in the table before it was written */
+    uint32_t prev_count;
+
+    /* Buffer that contains the names of a name column */
+    ecs_name_writer_t names;
+
+    /* Set when the table is a delta, which is followed by chunks */
+    bool is_delta;
+
+    /* Remaining entities of a delete header */
+    int32_t delete_count;
+    bool is_deleted;
 } ecs_table_writer_t;
 
 typedef struct ecs_writer_t {
@@ -148,7 +217,22 @@ typedef struct ecs_writer_t {
     ecs_blob_header_kind_t state;
     ecs_component_writer_t component;
     ecs_table_writer_t table;
+    int32_t version;
     int error;
+
+    /* Destination of data that is being copied from the input, followed by
+     * padding bytes that are skipped */
+    void *data;
+    size_t data_size;
+    size_t data_padding;
+    size_t data_written;
+    int64_t header[3];
+
+    /* Input that has not been consumed yet. If map is set, the input stays
+     * valid for the lifetime of the world and columns are not copied. */
+    const char *input;
+    size_t input_size;
+    bool map;
 } ecs_writer_t;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -18,7 +18,7 @@ typedef struct ecs_time_t {
     uint32_t nanosec;
 } ecs_time_t;
 
-/* Allocation counters (not thread safe) */
+/* Allocation counters (updated atomically) */
 extern uint64_t ecs_os_api_malloc_count;
 extern uint64_t ecs_os_api_realloc_count;
 extern uint64_t ecs_os_api_calloc_count;
@@ -56,6 +56,43 @@ typedef
 char* (*ecs_os_api_strdup_t)(
     const char *str);
 
+/* Allocate memory with an alignment that is a power of two. Memory returned by
+ * aligned_alloc is released with free_sized, which receives the size that was
+ * passed to aligned_alloc. This lets an allocator find the size class of the
+ * memory without storing a header. */
+typedef
+void* (*ecs_os_api_aligned_alloc_t)(
+    size_t alignment,
+    size_t size);
+
+typedef
+void (*ecs_os_api_free_sized_t)(
+    void *ptr,
+    size_t size);
+
+/* Allocator for memory that is owned by a single world. The allocator receives
+ * the ctx member of the allocator as first argument, which lets each world use
+ * its own memory pool. Memory is released with the size and alignment that was
+ * passed to alloc. */
+typedef
+void* (*ecs_os_allocator_alloc_t)(
+    void *ctx,
+    size_t alignment,
+    size_t size);
+
+typedef
+void (*ecs_os_allocator_free_t)(
+    void *ctx,
+    void *ptr,
+    size_t alignment,
+    size_t size);
+
+typedef struct ecs_os_allocator_t {
+    ecs_os_allocator_alloc_t alloc;
+    ecs_os_allocator_free_t free;
+    void *ctx;
+} ecs_os_allocator_t;
+
 /* Threads */
 typedef
 void* (*ecs_os_thread_callback_t)(
@@ -110,6 +147,25 @@ void (*ecs_os_api_cond_wait_t)(
     ecs_os_cond_t cond,
     ecs_os_mutex_t mutex);
 
+/* Atomic operations (return the new value) */
+typedef
+int32_t (*ecs_os_api_ainc_t)(
+    int32_t *value);
+
+typedef
+int32_t (*ecs_os_api_adec_t)(
+    int32_t *value);
+
+typedef
+uint64_t (*ecs_os_api_aadd64_t)(
+    uint64_t *value,
+    int64_t add);
+
+/* Atomic load with acquire semantics (returns the current value) */
+typedef
+int32_t (*ecs_os_api_aload_t)(
+    int32_t *value);
+
 
 typedef 
 void (*ecs_os_api_sleep_t)(
@@ -149,6 +205,18 @@ typedef
 char* (*ecs_os_api_module_to_dl_t)(
     const char *module_id);
 
+/* Memory mapped files. A file is mapped copy-on-write, so that changes to the
+ * mapped memory are not written back to the file. */
+typedef
+void* (*ecs_os_api_map_file_t)(
+    const char *filename,
+    size_t *size_out);
+
+typedef
+void (*ecs_os_api_unmap_file_t)(
+    void *data,
+    size_t size);
+
 typedef struct ecs_os_api_t {
     /* Memory management */
     ecs_os_api_malloc_t malloc;
@@ -156,6 +224,8 @@ typedef struct ecs_os_api_t {
     ecs_os_api_calloc_t calloc;
     ecs_os_api_free_t free;
     ecs_os_api_strdup_t strdup;
+    ecs_os_api_aligned_alloc_t aligned_alloc;
+    ecs_os_api_free_sized_t free_sized;
 
     /* Threads */
     ecs_os_api_thread_new_t thread_new;
@@ -174,6 +244,12 @@ typedef struct ecs_os_api_t {
     ecs_os_api_cond_broadcast_t cond_broadcast;
     ecs_os_api_cond_wait_t cond_wait;
 
+    /* Atomic operations */
+    ecs_os_api_ainc_t ainc;
+    ecs_os_api_adec_t adec;
+    ecs_os_api_aadd64_t aadd64;
+    ecs_os_api_aload_t aload;
+
     /* Time */
     ecs_os_api_sleep_t sleep;
     ecs_os_api_get_time_t get_time;
@@ -195,6 +271,10 @@ typedef struct ecs_os_api_t {
     /* Overridable function that translates from a logical module id to the
      * a shared library filename */
     ecs_os_api_module_to_dl_t module_to_dl;
+
+    /* Memory mapped files */
+    ecs_os_api_map_file_t map_file;
+    ecs_os_api_unmap_file_t unmap_file;
 } ecs_os_api_t;
 
 FLECS_EXPORT
@@ -213,6 +293,8 @@ void ecs_os_set_api_defaults(void);
 #define ecs_os_realloc(ptr, size) ecs_os_api.realloc(ptr, size)
 #define ecs_os_calloc(num, size) ecs_os_api.calloc(num, size)
 #define ecs_os_strdup(str) ecs_os_api.strdup(str)
+#define ecs_os_aligned_alloc(alignment, size) ecs_os_api.aligned_alloc(alignment, size)
+#define ecs_os_free_sized(ptr, size) ecs_os_api.free_sized(ptr, size)
 
 #if defined(_MSC_VER) || defined(__MINGW32__)
 #define ecs_os_alloca(type, count) _alloca(sizeof(type) * (count))
@@ -239,6 +321,12 @@ void ecs_os_set_api_defaults(void);
 #define ecs_os_cond_broadcast(cond) ecs_os_api.cond_broadcast(cond)
 #define ecs_os_cond_wait(cond, mutex) ecs_os_api.cond_wait(cond, mutex)
 
+/* Atomic operations */
+#define ecs_os_ainc(value) ecs_os_api.ainc(value)
+#define ecs_os_adec(value) ecs_os_api.adec(value)
+#define ecs_os_aadd64(value, add) ecs_os_api.aadd64(value, add)
+#define ecs_os_aload(value) ecs_os_api.aload(value)
+
 /* Time */
 #define ecs_os_sleep(sec, nanosec) ecs_os_api.sleep(sec, nanosec)
 #define ecs_os_get_time(time_out) ecs_os_api.get_time(time_out)
@@ -273,6 +361,10 @@ bool ecs_os_dbg_enabled(void);
 /* Module id translation */
 #define ecs_os_module_to_dl(lib) ecs_os_api.module_to_dl(lib)
 
+/* Memory mapped files */
+#define ecs_os_map_file(filename, size_out) ecs_os_api.map_file(filename, size_out)
+#define ecs_os_unmap_file(data, size) ecs_os_api.unmap_file(data, size)
+
 /* Sleep with floating point time */
 FLECS_EXPORT
 void ecs_sleepf(
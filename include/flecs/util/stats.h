@@ -21,12 +21,18 @@ typedef struct ecs_memory_stat_t {
     uint32_t used_bytes;              /* Memory in use */
 } ecs_memory_stat_t;
 
-/* Global statistics on memory allocations */
+/* Statistics on memory allocations. The OS API counters are global, the other
+ * counters are specific to the world. */
 typedef struct EcsAllocStats {
     uint64_t malloc_count_total;      /* Total number of times malloc was invoked */
     uint64_t realloc_count_total;     /* Total number of times realloc was invoked */
     uint64_t calloc_count_total;      /* Total number of times calloc was invoked */
     uint64_t free_count_total;        /* Total number of times free was invoked */
+    uint64_t stage_alloc_count_total; /* Total number of allocations from stage arenas */
+    uint64_t stage_block_count_total; /* Total number of blocks allocated by stage arenas */
+    uint64_t world_alloc_count_total; /* Total number of allocations by world allocator */
+    uint64_t world_free_count_total;  /* Total number of frees by world allocator */
+    uint64_t world_allocd_bytes;      /* Memory currently allocated by world allocator */
 } EcsAllocStats;
 
 /* Memory statistics on row (reactive) systems */
@@ -19,6 +19,9 @@ typedef void (*EcsMove)(
     void *from,
     void *ctx);
 
+/* Size of the header that is stored in front of the vector elements */
+#define ECS_VECTOR_HEADER_SIZE (8)
+
 struct ecs_vector_params_t {
     EcsMove move_action; /* Invoked when moving elements */
     void *move_ctx;
@@ -37,6 +40,15 @@ ecs_vector_t* ecs_vector_new_from_buffer(
     uint32_t size,
     void *buffer);
 
+/* Create an empty vector in memory owned by the application. The memory must
+ * hold ECS_VECTOR_HEADER_SIZE + size * element_size bytes. The vector must not
+ * be freed, and must not be used with operations that grow it past its size. */
+FLECS_EXPORT
+ecs_vector_t* ecs_vector_new_in_place(
+    const ecs_vector_params_t *params,
+    uint32_t size,
+    void *memory);
+
 FLECS_EXPORT
 void ecs_vector_free(
     ecs_vector_t *array);
@@ -32,7 +32,7 @@ ecs_entity_t components_contains(
 
         if (entity & ECS_CHILDOF) {
             entity &= ECS_ENTITY_MASK;
-            ecs_row_t *row = ecs_map_get_ptr(world->main_stage.entity_index, entity);
+            ecs_row_t *row = ecs_ei_get(world->main_stage.entity_index, entity);
             ecs_assert(row != 0, ECS_INTERNAL_ERROR, NULL);
 
             ecs_entity_t component = ecs_type_contains(
@@ -56,7 +56,7 @@ ecs_entity_t ecs_get_entity_for_component(
     ecs_entity_t component)
 {
     if (entity) {
-        ecs_row_t *row = ecs_map_get_ptr(world->main_stage.entity_index, entity);
+        ecs_row_t *row = ecs_ei_get(world->main_stage.entity_index, entity);
         ecs_assert(row != NULL, ECS_INTERNAL_ERROR, NULL);
         type = row->type;
     }
@@ -77,6 +77,42 @@ ecs_entity_t ecs_get_entity_for_component(
     return entity;
 }
 
+/** Store where a matched table is stored in the system. Active tables are
+ * stored with their index, inactive tables with -index - 1. */
+static
+void index_matched_table(
+    EcsColSystem *system_data,
+    ecs_table_t *table,
+    int32_t index,
+    bool active)
+{
+    int32_t value = active ? index : -index - 1;
+    ecs_map_set(system_data->table_index, (uintptr_t)table, &value);
+}
+
+/** Check if a table was matched with the system. Returns the index of the
+ * table in the active or inactive tables of the system, or -1 if the table was
+ * not matched. */
+static
+int32_t table_matched(
+    EcsColSystem *system_data,
+    ecs_table_t *table,
+    bool *active_out)
+{
+    int32_t value;
+    if (!ecs_map_has(system_data->table_index, (uintptr_t)table, &value)) {
+        return -1;
+    }
+
+    if (value >= 0) {
+        *active_out = true;
+        return value;
+    } else {
+        *active_out = false;
+        return -value - 1;
+    }
+}
+
 /** Add table to system, compute offsets for system components in table rows */
 static
 void add_table(
@@ -95,6 +131,8 @@ void add_table(
     if (table) {
         table_data = ecs_vector_add(
             &system_data->inactive_tables, &matched_table_params);
+        index_matched_table(system_data, table, 
+            ecs_vector_count(system_data->inactive_tables) - 1, false);
     } else {
         /* If no table is provided to function, this is a system that contains
          * no columns that require table matching. In this case, the system will
@@ -107,9 +145,12 @@ void add_table(
 
     table_data->table = table;
     table_data->references = NULL;
+    table_data->monitor = -1;
+    table_data->skip = false;
 
-    /* Array that contains the system column to table column mapping */
-    table_data->columns = ecs_os_malloc(sizeof(uint32_t) * column_count);
+    /* Array that contains the system column to table column mapping. Columns
+     * without data keep index 0. */
+    table_data->columns = ecs_os_calloc(sizeof(int32_t), column_count);
     ecs_assert(table_data->columns != NULL, ECS_OUT_OF_MEMORY, NULL);
 
     /* Store the components of the matched table. In the case of OR expressions,
@@ -266,6 +307,12 @@ void add_table(
                     if (e != ECS_INVALID_ENTITY) {
                         ecs_entity_info_t info = {.entity = e};
 
+                        /* A system that writes to a reference needs its own
+                         * copy of the data if it is shared with a snapshot */
+                        if (column->inout_kind != EcsIn) {
+                            ecs_unshare_component(world, e, component);
+                        }
+
                         ref->cached_ptr = ecs_get_ptr_intern(
                             world, 
                             &world->main_stage,
@@ -298,12 +345,36 @@ void add_table(
 /* Remove table */
 static
 void remove_table(
+    ecs_world_t *world,
+    ecs_entity_t system,
     EcsColSystem *system_data,
     ecs_vector_t *tables,
     int32_t index)
 {
-    (void)system_data;
-    ecs_vector_remove_index(tables, &matched_table_params, index);
+    bool active = tables == system_data->tables;
+    ecs_matched_table_t *table_data = ecs_vector_first(tables);
+    ecs_table_t *table = table_data[index].table;
+
+    ecs_os_free(table_data[index].columns);
+    ecs_os_free(table_data[index].components);
+    ecs_vector_free(table_data[index].references);
+
+    ecs_map_remove(system_data->table_index, (uintptr_t)table);
+    ecs_table_unregister_system(world, table, system);
+
+    /* The last table is moved to the index of the removed table */
+    uint32_t count = ecs_vector_remove_index(
+        tables, &matched_table_params, index);
+    if ((uint32_t)index != count) {
+        index_matched_table(
+            system_data, table_data[index].table, index, active);
+    }
+
+    /* Deactivate system if it has no more active tables */
+    if (active && !count) {
+        ecs_world_activate_system(
+            world, system, system_data->base.kind, false);
+    }
 }
 
 /* Match table with system */
@@ -352,6 +423,19 @@ bool match_table(
     /* Only do quick checks if failure info is not requested. These checks do
      * not provide information about which column caused the match failure. */
     if (failure_info == &tmp_failure_info) {
+        /* Reject tables that miss bits of the signature before comparing
+         * types. SELF columns can be inherited from prefabs, which are not in
+         * the table signature, so they are only tested for tables without
+         * prefabs. */
+        uint64_t bloom = system_data->owned_bloom;
+        if (!(table->flags & EcsTableHasPrefab)) {
+            bloom |= system_data->self_bloom;
+        }
+
+        if ((table->bloom & bloom) != bloom) {
+            return false;
+        }
+
         /* Test if table has SELF columns in either owned or inherited components */
         type = system_data->base.and_from_self;
         if (type && !ecs_type_contains(
@@ -538,49 +622,187 @@ void order_cascade_tables(
     }
 
     ecs_vector_sort(system_data->tables, &matched_table_params, table_compare);
+
+    ecs_matched_table_t *tables = ecs_vector_first(system_data->tables);
+    for (i = 0; i < count; i ++) {
+        index_matched_table(system_data, tables[i].table, i, true);
+    }
 }
 
-/** Match existing tables against system (table is created before system) */
+/* Iterator over the tables that can match a system. If a system has a match
+ * key, only tables that have the key, and tables that could inherit the key
+ * from a prefab, can match. Both lists are sorted, so the iterator merges them
+ * and returns tables in the order in which they were created. */
+typedef struct candidate_iter_t {
+    ecs_chunked_t *tables;
+    uint32_t *with_key;
+    uint32_t *with_prefab;
+    uint32_t key_count;
+    uint32_t prefab_count;
+    uint32_t key_index;
+    uint32_t prefab_index;
+    bool all;
+} candidate_iter_t;
+
+/* Get tables that have a component, or inherit it from a prefab */
 static
-void match_tables(
+uint32_t count_candidates(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    bool inherited)
+{
+    ecs_vector_t *tables = NULL;
+    ecs_map_has(world->component_tables, component, &tables);
+
+    uint32_t result = ecs_vector_count(tables);
+    if (inherited) {
+        result += ecs_vector_count(world->prefab_tables);
+    }
+
+    return result;
+}
+
+/* Find the AND column with the fewest tables to use as match key. Only SELF
+ * and OWNED columns can be used, as other columns can be matched by tables
+ * that do not have the component. */
+static
+void compute_match_key(
     ecs_world_t *world,
-    ecs_entity_t system,
     EcsColSystem *system_data)
 {
-    uint32_t i, count = ecs_chunked_count(world->main_stage.tables);
+    uint32_t i, count = ecs_vector_count(system_data->base.columns);
+    ecs_system_column_t *buffer = ecs_vector_first(system_data->base.columns);
+    uint32_t min_count = 0;
+
+    system_data->match_key = 0;
+    system_data->match_inherited = false;
 
     for (i = 0; i < count; i ++) {
-        ecs_table_t *table = ecs_chunked_get(
-            world->main_stage.tables, ecs_table_t, i);
+        ecs_system_column_t *elem = &buffer[i];
+        if (elem->oper_kind != EcsOperAnd) {
+            continue;
+        }
 
-        if (match_table(world, table, system, system_data, NULL)) {
-            add_table(world, system, system_data, table);
+        if (elem->kind != EcsFromSelf && elem->kind != EcsFromOwned) {
+            continue;
         }
-    }
 
-    if (system_data->base.cascade_by) {
-        order_cascade_tables(world, system_data);
+        ecs_entity_t component = elem->is.component & ECS_ENTITY_MASK;
+        bool inherited = elem->kind == EcsFromSelf;
+        uint32_t candidates = count_candidates(world, component, inherited);
+
+        if (!system_data->match_key || candidates < min_count) {
+            system_data->match_key = component;
+            system_data->match_inherited = inherited;
+            min_count = candidates;
+        }
     }
 }
 
-/** Check if a table was matched with the system */
 static
-int32_t table_matched(
+void candidates_init(
+    ecs_world_t *world,
     EcsColSystem *system_data,
-    ecs_vector_t *tables,
-    ecs_table_t *table)
+    candidate_iter_t *it)
 {
-    uint32_t i, count = ecs_vector_count(tables);
-    ecs_matched_table_t *table_data = ecs_vector_first(tables);
-    (void)system_data;
+    ecs_vector_t *with_key = NULL;
+    ecs_vector_t *with_prefab = NULL;
 
-    for (i = 0; i < count; i ++) {
-        if (table_data[i].table == table) {
-            return i;
+    *it = (candidate_iter_t){.tables = world->main_stage.tables};
+
+    if (!system_data->match_key) {
+        it->all = true;
+        it->key_count = ecs_chunked_count(it->tables);
+        return;
+    }
+
+    ecs_map_has(world->component_tables, system_data->match_key, &with_key);
+    if (system_data->match_inherited) {
+        with_prefab = world->prefab_tables;
+    }
+
+    it->with_key = ecs_vector_first(with_key);
+    it->key_count = ecs_vector_count(with_key);
+    it->with_prefab = ecs_vector_first(with_prefab);
+    it->prefab_count = ecs_vector_count(with_prefab);
+}
+
+static
+ecs_table_t* candidates_next(
+    candidate_iter_t *it)
+{
+    uint32_t index;
+
+    if (it->all) {
+        if (it->key_index == it->key_count) {
+            return NULL;
         }
+
+        index = it->key_index ++;
+    } else {
+        bool has_key = it->key_index < it->key_count;
+        bool has_prefab = it->prefab_index < it->prefab_count;
+
+        if (has_key && (!has_prefab || 
+            it->with_key[it->key_index] <= it->with_prefab[it->prefab_index]))
+        {
+            index = it->with_key[it->key_index ++];
+
+            /* Table has the key and a prefab, don't return it twice */
+            if (has_prefab && it->with_prefab[it->prefab_index] == index) {
+                it->prefab_index ++;
+            }
+        } else if (has_prefab) {
+            index = it->with_prefab[it->prefab_index ++];
+        } else {
+            return NULL;
+        }
+    }
+
+    return ecs_chunked_get(it->tables, ecs_table_t, index);
+}
+
+/** Add system to the index that finds systems for new tables */
+static
+void index_system(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    EcsColSystem *system_data)
+{
+    ecs_entity_t *elem;
+
+    if (system_data->match_key) {
+        ecs_vector_t *systems = NULL;
+        ecs_map_has(world->component_systems, system_data->match_key, &systems);
+        elem = ecs_vector_add(&systems, &handle_arr_params);
+        ecs_map_set(world->component_systems, system_data->match_key, &systems);
+    } else {
+        elem = ecs_vector_add(&world->unkeyed_systems, &handle_arr_params);
     }
 
-    return -1;
+    *elem = system;
+}
+
+/** Match existing tables against system (table is created before system) */
+static
+void match_tables(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    EcsColSystem *system_data)
+{
+    candidate_iter_t it;
+    candidates_init(world, system_data, &it);
+
+    ecs_table_t *table;
+    while ((table = candidates_next(&it))) {
+        if (match_table(world, table, system, system_data, NULL)) {
+            add_table(world, system, system_data, table);
+        }
+    }
+
+    if (system_data->base.cascade_by) {
+        order_cascade_tables(world, system_data);
+    }
 }
 
 static
@@ -623,6 +845,44 @@ void resolve_cascade_container(
     }
 }
 
+/** Rematch system with a table that has a changed container or prefab */
+static
+void rematch_table(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    EcsColSystem *system_data,
+    ecs_table_t *table)
+{
+    /* Is the system currently matched with the table? */
+    bool active = false;
+    int32_t match = table_matched(system_data, table, &active);
+
+    if (match_table(world, table, system, system_data, NULL)) {
+        /* If the table matches, and it is not currently matched, add */
+        if (match == -1) {
+            add_table(world, system, system_data, table);
+
+        /* If table still matches and has cascade column, reevaluate the
+         * sources of references. This may have changed in case components
+         * were added/removed to container entities */ 
+        } else if (active && system_data->base.cascade_by) {
+            resolve_cascade_container(
+                world, system_data, match, table->type);
+        }
+
+    /* If table no longer matches, remove it */
+    } else if (match != -1) {
+        if (active) {
+            remove_table(
+                world, system, system_data, system_data->tables, match);
+        } else {
+            remove_table(
+                world, system, system_data, system_data->inactive_tables, 
+                match);
+        }
+    }
+}
+
 /* -- Private API -- */
 
 /* Rematch system with tables after a change happened to a container or prefab */
@@ -633,42 +893,14 @@ void ecs_rematch_system(
     EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
     ecs_assert(system_data != NULL, ECS_INTERNAL_ERROR, 0);
 
-    ecs_chunked_t *tables = world->main_stage.tables;
-    uint32_t i, count = ecs_chunked_count(tables);
+    /* Tables that don't have the match key were not matched before, and can't
+     * be matched now, so only candidate tables have to be evaluated. */
+    candidate_iter_t it;
+    candidates_init(world, system_data, &it);
 
-    for (i = 0; i < count; i ++) {
-        /* Is the system currently matched with the table? */
-        ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, i);
-        int32_t match = table_matched(system_data, system_data->tables, table);
-
-        if (match_table(world, table, system, system_data, NULL)) {
-            /* If the table matches, and it is not currently matched, add */
-            if (match == -1) {
-                if (table_matched(system_data, system_data->inactive_tables, table) == -1) {
-                    add_table(world, system, system_data, table);
-                }
-
-            /* If table still matches and has cascade column, reevaluate the
-                * sources of references. This may have changed in case 
-                * components were added/removed to container entities */ 
-            } else if (system_data->base.cascade_by) {
-                resolve_cascade_container(
-                    world, system_data, match, table->type);
-            }
-        } else {
-            /* If table no longer matches, remove it */
-            if (match != -1) {
-                remove_table(system_data, system_data->tables, match);
-            } else {
-                /* Make sure the table is removed if it was inactive */
-                match = table_matched(
-                    system_data, system_data->inactive_tables, table);
-                if (match != -1) {
-                    remove_table(
-                        system_data, system_data->inactive_tables, match);
-                }
-            }
-        }
+    ecs_table_t *table;
+    while ((table = candidates_next(&it))) {
+        rematch_table(world, system, system_data, table);
     }
 
     /* If the system has a CASCADE column and modifications were made, 
@@ -683,6 +915,32 @@ void ecs_rematch_system(
         ecs_check_column_constraints(world, (EcsSystem*)system_data));
 }
 
+/* Rematch system with a single table after a change happened to a container or
+ * prefab of the table */
+void ecs_rematch_system_w_table(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    ecs_table_t *table)
+{
+    EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
+    ecs_assert(system_data != NULL, ECS_INTERNAL_ERROR, 0);
+
+    rematch_table(world, system, system_data, table);
+}
+
+/* Restore the depth order of tables after rematching a system with tables */
+void ecs_order_system_tables(
+    ecs_world_t *world,
+    ecs_entity_t system)
+{
+    EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
+    ecs_assert(system_data != NULL, ECS_INTERNAL_ERROR, 0);
+
+    if (system_data->base.cascade_by) {
+        order_cascade_tables(world, system_data);
+    }
+}
+
 /** Revalidate references after a realloc occurred in a table */
 void ecs_revalidate_system_refs(
     ecs_world_t *world,
@@ -697,6 +955,8 @@ void ecs_revalidate_system_refs(
 
     uint32_t i, count = ecs_vector_count(system_data->tables);
     ecs_matched_table_t *table_data = ecs_vector_first(system_data->tables);
+    uint32_t c, column_count = ecs_vector_count(system_data->base.columns);
+    ecs_system_column_t *columns = ecs_vector_first(system_data->base.columns);
 
     for (i = 0; i < count; i ++) {
         if (!table_data[i].references) {
@@ -706,6 +966,21 @@ void ecs_revalidate_system_refs(
         uint32_t r, ref_count = ecs_vector_count(table_data[i].references);
         ecs_reference_t *refs = ecs_vector_first(table_data[i].references);
 
+        /* Copy data that the system writes to if it is shared with a snapshot.
+         * This moves the data, so if a column is copied the world resolves the
+         * references of all systems again. */
+        for (c = 0; c < column_count; c ++) {
+            int32_t index = table_data[i].columns[c];
+            if (index >= 0 || columns[c].inout_kind == EcsIn) {
+                continue;
+            }
+
+            ecs_reference_t *ref = &refs[-index - 1];
+            if (ref->entity) {
+                ecs_unshare_component(world, ref->entity, ref->component);
+            }
+        }
+
         for (r = 0; r < ref_count; r ++) {
             ecs_reference_t ref = refs[r];
             ecs_entity_info_t info = {.entity = ref.entity};
@@ -715,42 +990,139 @@ void ecs_revalidate_system_refs(
     }
 }
 
-/** Match new table against system (table is created after system) */
-void ecs_col_system_notify_of_table(
+/** Copy columns of a matched table that the system writes to, if they are
+ * shared with a snapshot */
+static
+void unshare_table_columns(
     ecs_world_t *world,
-    ecs_entity_t system,
-    ecs_table_t *table)
+    EcsColSystem *system_data,
+    ecs_matched_table_t *table)
+{
+    uint32_t c, column_count = ecs_vector_count(system_data->base.columns);
+    ecs_system_column_t *columns = ecs_vector_first(system_data->base.columns);
+
+    for (c = 0; c < column_count; c ++) {
+        int32_t index = table->columns[c];
+        if (index > 0 && columns[c].inout_kind != EcsIn) {
+            ecs_table_unshare_column(world, table->table, index);
+        }
+    }
+}
+
+void ecs_col_system_unshare(
+    ecs_world_t *world,
+    ecs_entity_t system)
 {
     EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
-    assert(system_data != NULL);
+    ecs_assert(system_data != NULL, ECS_INTERNAL_ERROR, 0);
 
-    if (match_table(world, table, system, system_data, NULL)) {
-        add_table(world, system, system_data, table);
+    uint32_t i, count = ecs_vector_count(system_data->tables);
+    ecs_matched_table_t *tables = ecs_vector_first(system_data->tables);
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = tables[i].table;
+        if (table && table->flags & EcsTableIsShared) {
+            unshare_table_columns(world, system_data, &tables[i]);
+        }
     }
 }
 
-/** Get index of table in system's matched tables */
+/** Sum of the change counters of the [changed] columns in a matched table.
+ * Columns that are not stored in the table, like columns from a prefab, are not
+ * tracked, so if a [changed] column is a reference this returns -1. */
 static
-int32_t get_table_param_index(
-    ecs_world_t *world,
+int64_t monitored_count(
     EcsColSystem *system_data,
-    ecs_table_t *table,
-    ecs_vector_t *tables)
+    ecs_matched_table_t *table)
 {
-    uint32_t i, count = ecs_vector_count(tables);
-    ecs_matched_table_t *table_data = ecs_vector_first(tables);
-    (void)world;
-    (void)system_data;
+    uint32_t c, column_count = ecs_vector_count(system_data->base.columns);
+    ecs_system_column_t *columns = ecs_vector_first(system_data->base.columns);
+    ecs_table_column_t *table_columns = table->table->columns;
+    int64_t result = 0;
+
+    for (c = 0; c < column_count; c ++) {
+        if (!columns[c].if_changed) {
+            continue;
+        }
+
+        int32_t index = table->columns[c];
+        if (index > 0) {
+            result += table_columns[index].change_count;
+        } else if (index < 0) {
+            return -1;
+        }
+    }
+
+    return result;
+}
+
+/** Test whether a system should run on a matched table. A system with [changed]
+ * columns only runs on a table when one of these columns changed since the
+ * system last ran on the table. If the system runs, the columns it writes are
+ * marked as changed. */
+static
+bool track_changes(
+    EcsColSystem *system_data,
+    ecs_matched_table_t *table)
+{
+    bool if_changed = system_data->base.if_changed;
+
+    if (if_changed) {
+        int64_t count = monitored_count(system_data, table);
+        if (count != -1 && count == table->monitor) {
+            return false;
+        }
+    }
+
+    uint32_t c, column_count = ecs_vector_count(system_data->base.columns);
+    ecs_system_column_t *columns = ecs_vector_first(system_data->base.columns);
+    ecs_table_column_t *table_columns = table->table->columns;
+
+    for (c = 0; c < column_count; c ++) {
+        int32_t index = table->columns[c];
+        if (index > 0 && columns[c].inout_kind != EcsIn) {
+            table_columns[index].change_count ++;
+        }
+    }
+
+    /* Store counters after marking columns, so that the system does not run
+     * again because of its own writes */
+    if (if_changed) {
+        table->monitor = monitored_count(system_data, table);
+    }
+
+    return true;
+}
+
+void ecs_col_system_track_changes(
+    ecs_world_t *world,
+    ecs_entity_t system)
+{
+    EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
+    ecs_assert(system_data != NULL, ECS_INTERNAL_ERROR, 0);
+
+    uint32_t i, count = ecs_vector_count(system_data->tables);
+    ecs_matched_table_t *tables = ecs_vector_first(system_data->tables);
 
     for (i = 0; i < count; i ++) {
-        if (table_data[i].table == table) {
-            break;
+        if (tables[i].table) {
+            tables[i].skip = !track_changes(system_data, &tables[i]);
         }
     }
+}
 
-    ecs_assert(i != count, ECS_INTERNAL_ERROR, NULL);
+/** Match new table against system (table is created after system) */
+void ecs_col_system_notify_of_table(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    ecs_table_t *table)
+{
+    EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
+    assert(system_data != NULL);
 
-    return i;
+    if (match_table(world, table, system, system_data, NULL)) {
+        add_table(world, system, system_data, table);
+    }
 }
 
 /** Table activation happens when a table was or becomes empty. Deactivated
@@ -776,11 +1148,24 @@ void ecs_system_activate_table(
         dst_array = system_data->inactive_tables;
     }
 
-    int32_t i = get_table_param_index(world, system_data, table, src_array);
+    bool is_active = false;
+    int32_t i = table_matched(system_data, table, &is_active);
+    ecs_assert(i != -1, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(is_active != active, ECS_INTERNAL_ERROR, NULL);
 
     uint32_t src_count = ecs_vector_move_index(
         &dst_array, src_array, &matched_table_params, i);
 
+    /* Table is added to the end of the destination array, and the last table
+     * of the source array is moved to the index of the table */
+    index_matched_table(
+        system_data, table, ecs_vector_count(dst_array) - 1, active);
+
+    if ((uint32_t)i != src_count) {
+        ecs_matched_table_t *src_tables = ecs_vector_first(src_array);
+        index_matched_table(system_data, src_tables[i].table, i, !active);
+    }
+
     if (active) {
         uint32_t dst_count = ecs_vector_count(dst_array);
         if (dst_count == 1 && system_data->base.enabled) {
@@ -797,6 +1182,70 @@ void ecs_system_activate_table(
     }
 }
 
+/** Collect the components a system reads and writes from its signature, which
+ * is used to determine which systems can run concurrently. */
+static
+void compute_access(
+    ecs_world_t *world,
+    EcsColSystem *system_data)
+{
+    ecs_system_column_t *columns = ecs_vector_first(system_data->base.columns);
+    uint32_t i, count = ecs_vector_count(system_data->base.columns);
+
+    for (i = 0; i < count; i ++) {
+        ecs_system_column_t *column = &columns[i];
+
+        /* Not and handle-only columns don't access component data, and system
+         * components are only accessible by the system itself */
+        if (column->oper_kind == EcsOperNot || column->kind == EcsFromEmpty ||
+            column->kind == EcsFromSystem)
+        {
+            continue;
+        }
+
+        ecs_type_t *access = &system_data->writes;
+        if (column->inout_kind == EcsIn) {
+            access = &system_data->reads;
+        }
+
+        if (column->oper_kind == EcsOperOr) {
+            ecs_entity_t *components = ecs_vector_first(column->is.type);
+            uint32_t c, c_count = ecs_vector_count(column->is.type);
+            for (c = 0; c < c_count; c ++) {
+                *access = ecs_type_add_intern(
+                    world, NULL, *access, components[c]);
+            }
+        } else {
+            *access = ecs_type_add_intern(
+                world, NULL, *access, column->is.component);
+        }
+    }
+}
+
+/** Test whether two sorted types have a component in common */
+static
+bool types_intersect(
+    ecs_type_t type_1,
+    ecs_type_t type_2)
+{
+    ecs_entity_t *array_1 = ecs_vector_first(type_1);
+    ecs_entity_t *array_2 = ecs_vector_first(type_2);
+    uint32_t i_1 = 0, count_1 = ecs_vector_count(type_1);
+    uint32_t i_2 = 0, count_2 = ecs_vector_count(type_2);
+
+    while (i_1 < count_1 && i_2 < count_2) {
+        if (array_1[i_1] < array_2[i_2]) {
+            i_1 ++;
+        } else if (array_1[i_1] > array_2[i_2]) {
+            i_2 ++;
+        } else {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 ecs_entity_t ecs_new_col_system(
     ecs_world_t *world,
     const char *id,
@@ -813,6 +1262,9 @@ ecs_entity_t ecs_new_col_system(
     EcsId *id_data = ecs_get_ptr(world, result, EcsId);
     *id_data = id;
 
+    ecs_world_t *real_world = world;
+    ecs_name_index_add(world, ecs_get_stage(&real_world), result, id);
+
     EcsColSystem *system_data = ecs_get_ptr(world, result, EcsColSystem);
     memset(system_data, 0, sizeof(EcsColSystem));
     system_data->base.action = action;
@@ -836,16 +1288,24 @@ ecs_entity_t ecs_new_col_system(
         &matched_table_params, ECS_SYSTEM_INITIAL_TABLE_COUNT);
     system_data->inactive_tables = ecs_vector_new(
         &matched_table_params, ECS_SYSTEM_INITIAL_TABLE_COUNT);
+    system_data->table_index = ecs_map_new(0, sizeof(int32_t));
 
     ecs_parse_component_expr(
         world, sig, ecs_parse_signature_action, id, system_data);
 
     ecs_system_compute_and_families(world, &system_data->base);
 
+    system_data->self_bloom = ecs_type_bloom(system_data->base.and_from_self);
+    system_data->owned_bloom = ecs_type_bloom(system_data->base.and_from_owned);
+
     ecs_system_init_base(world, &system_data->base);
 
+    compute_access(world, system_data);
+
     if (system_data->base.needs_tables) {
+        compute_match_key(world, system_data);
         match_tables(world, result, system_data);
+        index_system(world, result, system_data);
     } else {
         /* If this system does not match with tables, for example, because it
          * does not have any SELF columns, add a single "matched" table that
@@ -886,9 +1346,28 @@ ecs_entity_t ecs_new_col_system(
 
     *elem = result;
 
+    world->valid_system_batches = false;
+
     return result;
 }
 
+bool ecs_col_system_conflicts(
+    EcsColSystem *system_1,
+    EcsColSystem *system_2)
+{
+    /* If a system does not access any components, we can't tell what it does
+     * so it must not run concurrently with other systems */
+    if ((!system_1->reads && !system_1->writes) ||
+        (!system_2->reads && !system_2->writes))
+    {
+        return true;
+    }
+
+    return types_intersect(system_1->writes, system_2->writes) ||
+           types_intersect(system_1->writes, system_2->reads) ||
+           types_intersect(system_1->reads, system_2->writes);
+}
+
 /* -- Public API -- */
 
 static
@@ -971,14 +1450,16 @@ ecs_entity_t _ecs_run_w_filter(
     ecs_system_action_t action = system_data->base.action;
     bool offset_limit = (offset | limit) != 0;
     bool limit_set = limit != 0;
+    uint64_t filter_bloom = ecs_type_bloom(filter);
 
     ecs_rows_t info = {
         .world = world,
         .system = system,
         .param = param,
+        .system_ctx = system_data->base.ctx,
         .column_count = column_count,
         .delta_time = system_delta_time,
-        .world_time = world->world_time_total,
+        .world_time = real_world->world_time_total,
         .frame_offset = offset,
         .table_offset = 0,
         .system_data = &system_data->base
@@ -991,10 +1472,23 @@ ecs_entity_t _ecs_run_w_filter(
         uint32_t first = 0, count = 0;
 
         if (world_table) {
+            /* Workers run after the world copied shared columns */
+            if (world_table->flags & EcsTableIsShared && 
+                world->magic != ECS_THREAD_MAGIC) 
+            {
+                unshare_table_columns(real_world, system_data, table);
+            }
+
             table_data = world_table->columns;
             count = ecs_table_count(world_table);
 
             if (filter) {
+                if (!(world_table->flags & EcsTableHasPrefab) &&
+                    (world_table->bloom & filter_bloom) != filter_bloom)
+                {
+                    continue;
+                }
+
                 if (!ecs_type_contains(
                     real_world, world_table->type, filter, true, true))
                 {
@@ -1030,6 +1524,15 @@ ecs_entity_t _ecs_run_w_filter(
                 continue;
             }
 
+            /* Workers run after the world tracked changes for all jobs */
+            if (world->magic == ECS_THREAD_MAGIC) {
+                if (table->skip) {
+                    continue;
+                }
+            } else if (!track_changes(system_data, table)) {
+                continue;
+            }
+
             ecs_entity_t *entity_buffer = 
                     ecs_vector_first(table_data[0].data);
             info.entities = &entity_buffer[first];            
@@ -6,7 +6,8 @@ void copy_column(
     ecs_table_column_t *new_column,
     int32_t new_index,
     ecs_table_column_t *old_column,
-    int32_t old_index)
+    int32_t old_index,
+    bool move)
 {
     ecs_assert(new_index > 0, ECS_INTERNAL_ERROR, NULL);
 
@@ -23,7 +24,13 @@ void copy_column(
         ecs_assert(dst != NULL, ECS_INTERNAL_ERROR, NULL);
         ecs_assert(src != NULL, ECS_INTERNAL_ERROR, NULL);
 
-        memcpy(dst, src, param.element_size);
+        if (move) {
+            ecs_lifecycle_move(new_column->lifecycle, dst, src, size, 1);
+        } else {
+            ecs_lifecycle_copy(new_column->lifecycle, dst, src, size, 1);
+        }
+
+        new_column->change_count ++;
     }
 }
 
@@ -34,7 +41,8 @@ void copy_row(
     int32_t new_index,
     ecs_type_t old_type,
     ecs_table_column_t *old_columns,
-    int32_t old_index)
+    int32_t old_index,
+    bool move)
 {
     uint16_t i_new, new_component_count = ecs_vector_count(new_type);
     uint16_t i_old = 0, old_component_count = ecs_vector_count(old_type);
@@ -61,7 +69,78 @@ void copy_row(
         }
 
         if (new_component == old_component) {
-            copy_column(&new_columns[i_new + 1], new_index, &old_columns[i_old + 1], old_index);
+            copy_column(&new_columns[i_new + 1], new_index, 
+                &old_columns[i_old + 1], old_index, move);
+            i_new ++;
+            i_old ++;
+        } else if (new_component < old_component) {
+            i_new ++;
+        } else if (new_component > old_component) {
+            i_old ++;
+        }
+    }
+}
+
+/** Move components of multiple rows, one column at a time */
+static
+void move_rows(
+    ecs_type_t new_type,
+    ecs_table_column_t *new_columns,
+    int32_t *new_indices,
+    ecs_type_t old_type,
+    ecs_table_column_t *old_columns,
+    int32_t *old_indices,
+    uint32_t count)
+{
+    uint16_t i_new, new_component_count = ecs_vector_count(new_type);
+    uint16_t i_old = 0, old_component_count = ecs_vector_count(old_type);
+    ecs_entity_t *new_components = ecs_vector_first(new_type);
+    ecs_entity_t *old_components = ecs_vector_first(old_type);
+
+    for (i_new = 0; i_new < new_component_count; ) {
+        if (i_old == old_component_count) {
+            break;
+        }
+
+        ecs_entity_t new_component = new_components[i_new];
+        ecs_entity_t old_component = old_components[i_old];
+
+        if ((new_component & ECS_ENTITY_FLAGS_MASK) || 
+            (old_component & ECS_ENTITY_FLAGS_MASK)) 
+        {
+            break;
+        }
+
+        if (new_component == old_component) {
+            ecs_table_column_t *new_column = &new_columns[i_new + 1];
+            ecs_table_column_t *old_column = &old_columns[i_old + 1];
+            uint32_t size = new_column->size;
+
+            if (size) {
+                char *dst = ecs_vector_first(new_column->data);
+                char *src = ecs_vector_first(old_column->data);
+                uint32_t i;
+
+                ecs_assert(dst != NULL, ECS_INTERNAL_ERROR, NULL);
+                ecs_assert(src != NULL, ECS_INTERNAL_ERROR, NULL);
+
+                if (new_column->lifecycle) {
+                    ecs_lifecycle_t *lc = new_column->lifecycle;
+                    for (i = 0; i < count; i ++) {
+                        ecs_lifecycle_move(lc, 
+                            dst + (new_indices[i] - 1) * size, 
+                            src + (old_indices[i] - 1) * size, size, 1);
+                    }
+                } else {
+                    for (i = 0; i < count; i ++) {
+                        memcpy(dst + (new_indices[i] - 1) * size, 
+                               src + (old_indices[i] - 1) * size, size);
+                    }
+                }
+
+                new_column->change_count ++;
+            }
+
             i_new ++;
             i_old ++;
         } else if (new_component < old_component) {
@@ -107,7 +186,7 @@ ecs_row_t row_from_stage(
     ecs_entity_t entity)
 {
     ecs_row_t row;
-    if (ecs_map_has(stage->entity_index, entity, &row)) {
+    if (ecs_ei_has(stage->entity_index, entity, &row)) {
         return row;
     } else {
         return (ecs_row_t){0, 0};
@@ -122,7 +201,7 @@ bool stage_has_entity(
 {
     ecs_row_t row;
 
-    if (ecs_map_has(stage->entity_index, entity, &row)) {
+    if (ecs_ei_has(stage->entity_index, entity, &row)) {
         if (row.index) {
             *row_out = row;
             return true;
@@ -431,9 +510,10 @@ ecs_type_t copy_from_prefab(
             void *dst_ptr = ECS_OFFSET(
                 dst_column_data, size * (info->index - 1 + offset));
 
+            ecs_lifecycle_t *lc = dst_column->lifecycle;
             uint32_t i;
             for (i = 0; i < limit; i ++) {
-                memcpy(dst_ptr, src_ptr, size);
+                ecs_lifecycle_copy(lc, dst_ptr, src_ptr, size, 1);
                 dst_ptr = ECS_OFFSET(dst_ptr, size);
             }
         }
@@ -542,21 +622,40 @@ bool notify_after_commit(
     return modified != NULL;
 }
 
+/* Remove name of entity in main stage table from the name index, before the
+ * entity loses its name or a name set in a stage is merged */
+static
+void unindex_name(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_entity_t entity,
+    int32_t index)
+{
+    EcsId *id = get_row_ptr(table->type, table->columns, index, EEcsId);
+    if (id) {
+        ecs_name_index_remove(
+            world, &world->main_stage, entity, table->type, *id);
+    }
+}
+
 /** Commit an entity with a specified type to a table (probably the most 
- * important function in flecs). */
+ * important function in flecs). If the caller already knows the table for the
+ * type (for example from a table edge), it is passed in new_table so that it
+ * does not have to be looked up. */
 static
 uint32_t commit(
     ecs_world_t *world,
     ecs_stage_t *stage,
     ecs_entity_info_t *info,
     ecs_type_t type,
+    ecs_table_t *new_table,
     ecs_type_t to_add,
     ecs_type_t to_remove,
     bool do_set)
 {
-    ecs_table_t *new_table = NULL, *old_table;
+    ecs_table_t *old_table;
     ecs_table_column_t *new_columns = NULL, *old_columns;
-    ecs_map_t *entity_index = stage->entity_index;
+    ecs_ei_t *entity_index = stage->entity_index;
     ecs_type_t old_type = NULL;
     int32_t new_index = 0, old_index = 0;
     bool in_progress = world->in_progress;
@@ -630,8 +729,8 @@ uint32_t commit(
          * is merged, which will invoke commit again. */
 
         if (stage->range_check_enabled) {
-            ecs_assert(!world->max_handle || entity <= world->max_handle, ECS_OUT_OF_RANGE, 0);
-            ecs_assert(entity >= world->min_handle, ECS_OUT_OF_RANGE, 0);
+            ecs_assert(!world->max_handle || ECS_ENTITY_ID(entity) <= world->max_handle, ECS_OUT_OF_RANGE, 0);
+            ecs_assert(ECS_ENTITY_ID(entity) >= world->min_handle, ECS_OUT_OF_RANGE, 0);
         }
     }
 
@@ -641,20 +740,23 @@ uint32_t commit(
      * update the matched tables when the application adds or removes a 
      * component from, for example, a container. */
     if (info->is_watched) {
-        world->should_match = true;
+        ecs_watched_changed(world, stage, info->entity);
     }
 
     /* If the new type contains components (that is, it is not 0) obtain the new
      * table and new columns. */
     if (type) {
-        new_table = ecs_world_get_table(world, stage, type);
+        if (!new_table) {
+            new_table = ecs_world_get_table(world, stage, type);
+        }
+        ecs_assert(new_table->type == type, ECS_INTERNAL_ERROR, NULL);
 
         /* This operation will automatically obtain components from the stage if
          * the application is iterating. */
         new_columns = ecs_table_get_columns(world, stage, new_table);
         ecs_assert(new_columns != NULL, ECS_INTERNAL_ERROR, 0);
 
-        new_index = ecs_table_insert(world, new_table, new_columns, entity);
+        new_index = ecs_table_insert(world, stage, new_table, new_columns, entity);
         ecs_assert(new_index != 0, ECS_INTERNAL_ERROR, 0);
     }
 
@@ -662,7 +764,7 @@ uint32_t commit(
      * empty, and will not be empty */
     if (old_type && type) {
         copy_row(new_table->type, new_columns, new_index, 
-            old_type, old_columns, old_index);
+            old_type, old_columns, old_index, true);
     }
 
     /* Update the entity index so that it points to the new table */
@@ -674,14 +776,14 @@ uint32_t commit(
             new_row.index *= -1;
         }
 
-        ecs_map_set(entity_index, entity, &new_row);
+        ecs_ei_set(entity_index, entity, &new_row);
     } else {
         if (in_progress) {
             /* The entity must be kept in the stage index because otherwise the
              * merge doesn't know that it needs to merge data for the entity */
-            ecs_map_set(entity_index, entity, &((ecs_row_t){0, 0}));
+            ecs_ei_set(entity_index, entity, &((ecs_row_t){0, 0}));
         } else {
-            ecs_map_remove(entity_index, entity);
+            ecs_ei_remove(entity_index, entity);
         }
     }
 
@@ -707,6 +809,14 @@ uint32_t commit(
          * before this commit, we also don't need to perform the delete. */
 
         if (old_type) {
+            /* Remove the entity from the name index if it loses its name */
+            if (old_table->flags & EcsTableHasId &&
+                (!type || ecs_type_index_of(type, EEcsId) == -1))
+            {
+                unindex_name(world, old_table, entity, 
+                    old_index < 0 ? -old_index : old_index);
+            }
+
             ecs_table_delete(world, NULL, old_table, old_columns, old_index);
         }
     }
@@ -793,8 +903,43 @@ void* get_ptr_from_prefab(
     return ptr;
 }
 
+/** Issue a new entity handle. Ids of deleted entities are recycled, except
+ * when an entity range is set (recycled ids could be outside of the range) or
+ * when worker threads are creating entities. */
+static
+ecs_entity_t new_entity_handle(
+    ecs_world_t *world)
+{
+    ecs_entity_t entity = 0;
+
+    if (!world->max_handle && 
+        (!world->in_progress || !ecs_vector_count(world->worker_threads))) 
+    {
+        entity = ecs_ei_recycle(world->main_stage.entity_index);
+    }
+
+    if (!entity) {
+        entity = ++ world->last_handle;
+    }
+
+    return entity;
+}
+
 /* -- Private functions -- */
 
+void ecs_free_entity(
+    ecs_world_t *world,
+    ecs_entity_t entity)
+{
+    /* Ids that have not been issued yet must not end up in the free list, as
+     * they would be issued twice. */
+    if (ECS_ENTITY_ID(entity) <= world->last_handle) {
+        ecs_ei_delete(world->main_stage.entity_index, entity);
+    } else {
+        ecs_ei_remove(world->main_stage.entity_index, entity);
+    }
+}
+
 void* ecs_get_ptr_intern(
     ecs_world_t *world,
     ecs_stage_t *stage,
@@ -859,6 +1004,44 @@ void* ecs_get_ptr_intern(
     return ptr;
 }
 
+bool ecs_unshare_component(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_entity_t component)
+{
+    ecs_row_t *row = ecs_ei_get(world->main_stage.entity_index, entity);
+    if (!row || !row->type) {
+        return false;
+    }
+
+    /* The component may be stored on a prefab of the entity */
+    ecs_entity_t owner = ecs_get_entity_for_component(
+        world, entity, NULL, component);
+    if (!owner) {
+        return false;
+    }
+
+    if (owner != entity) {
+        row = ecs_ei_get(world->main_stage.entity_index, owner);
+        if (!row || !row->type) {
+            return false;
+        }
+    }
+
+    ecs_table_t *table = ecs_world_get_table(
+        world, &world->main_stage, row->type);
+    if (!(table->flags & EcsTableIsShared)) {
+        return false;
+    }
+
+    int16_t index = ecs_type_index_of(table->type, component);
+    if (index < 0) {
+        return false;
+    }
+
+    return ecs_table_unshare_column(world, table, index + 1);
+}
+
 ecs_type_t ecs_notify(
     ecs_world_t *world,
     ecs_stage_t *stage,
@@ -892,6 +1075,61 @@ ecs_type_t ecs_notify(
     return modified;
 }
 
+/* Copy main stage columns that are shared with a snapshot before staged
+ * components are written to them */
+static
+void unshare_staged_columns(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_type_t staged_type)
+{
+    if (!(table->flags & EcsTableIsShared)) {
+        return;
+    }
+
+    ecs_entity_t *array = ecs_vector_first(staged_type);
+    uint32_t i, count = ecs_vector_count(staged_type);
+
+    for (i = 0; i < count; i ++) {
+        int16_t index = ecs_type_index_of(table->type, array[i]);
+        if (index >= 0) {
+            ecs_table_unshare_column(world, table, index + 1);
+        }
+    }
+}
+
+/* Add names of a range of rows to the name index */
+static
+void index_names(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_type_t type,
+    ecs_table_column_t *columns,
+    uint32_t offset,
+    uint32_t count)
+{
+    ecs_entity_t *entities = ecs_vector_first(columns[0].data);
+    uint32_t i;
+
+    for (i = 0; i < count; i ++) {
+        EcsId *id = get_row_ptr(type, columns, offset + i + 1, EEcsId);
+        ecs_name_index_add(world, stage, entities[offset + i], *id);
+    }
+}
+
+/* Add name that was set in a stage to the name index */
+static
+void index_staged_name(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_entity_t entity,
+    int32_t index)
+{
+    EcsId *id = get_row_ptr(table->type, table->columns, index, EEcsId);
+    ecs_assert(id != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_name_index_add(world, &world->main_stage, entity, *id);
+}
+
 void ecs_merge_entity(
     ecs_world_t *world,
     ecs_stage_t *stage,
@@ -928,8 +1166,17 @@ void ecs_merge_entity(
         info.is_watched = true;
     }
 
+    /* If the entity gets a name from the stage, remove its current name. If 
+     * the entity loses its name, commit removes it. */
+    if (old_table && staged_type && 
+        ecs_type_index_of(staged_type, EEcsId) != -1) 
+    {
+        unindex_name(world, old_table, entity, 
+            old_row.index < 0 ? -old_row.index : old_row.index);
+    }
+
     int32_t new_index = commit(
-        world, &world->main_stage, &info, type, 0, to_remove, false);
+        world, &world->main_stage, &info, type, NULL, 0, to_remove, false);
     
     if (type && staged_type) {
         ecs_table_t *new_table = ecs_world_get_table(world, &world->main_stage, type);
@@ -940,8 +1187,189 @@ void ecs_merge_entity(
         ecs_map_has(stage->data_stage, (uintptr_t)staged_row.type, &staged_columns);
         ecs_assert(staged_columns != NULL, ECS_INTERNAL_ERROR, NULL);
 
+        unshare_staged_columns(world, new_table, staged_type);
+
         copy_row( new_table->type, new_table->columns, new_index,
-                staged_table->type, staged_columns, staged_row.index); 
+                staged_table->type, staged_columns, staged_row.index, true);
+
+        if (ecs_type_index_of(staged_type, EEcsId) != -1) {
+            index_staged_name(world, new_table, entity, new_index);
+        }
+    }
+}
+
+static
+int compare_index_desc(
+    const void *p1,
+    const void *p2)
+{
+    int32_t i1 = *(int32_t*)p1;
+    int32_t i2 = *(int32_t*)p2;
+    return (i1 < i2) - (i1 > i2);
+}
+
+void ecs_merge_entities(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_staged_entity_t *entities,
+    uint32_t count)
+{
+    ecs_stage_t *main_stage = &world->main_stage;
+    ecs_type_t old_type = entities[0].main_row.type;
+    ecs_type_t staged_type = entities[0].staged_row.type;
+    ecs_type_t to_remove = entities[0].to_remove;
+    uint32_t i;
+
+    ecs_type_t type = ecs_type_merge_intern(
+        world, stage, old_type, staged_type, to_remove);
+
+    /* Entities that end up without components are removed from the entity
+     * index one by one. This is rare, so not worth optimizing for. */
+    if (count == 1 || !type) {
+        for (i = 0; i < count; i ++) {
+            ecs_merge_entity(
+                world, stage, entities[i].entity, entities[i].staged_row);
+        }
+        return;
+    }
+
+    ecs_table_t *old_table = NULL;
+    if (old_type) {
+        old_table = ecs_world_get_table(world, main_stage, old_type);
+    }
+
+    ecs_table_t *new_table = ecs_world_get_table(world, main_stage, type);
+    ecs_assert(new_table != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    /* Row indices in the old table, the new table and the staged table */
+    int32_t *indices = ecs_os_malloc(sizeof(int32_t) * count * 3);
+    int32_t *old_indices = indices;
+    int32_t *new_indices = &indices[count];
+    int32_t *staged_indices = &indices[count * 2];
+
+    for (i = 0; i < count; i ++) {
+        /* Merging earlier entities may have moved rows in the old table, so
+         * get the current index from the entity index */
+        if (old_table) {
+            ecs_row_t *row = ecs_ei_get(
+                main_stage->entity_index, entities[i].entity);
+            ecs_assert(row != NULL, ECS_INTERNAL_ERROR, NULL);
+            entities[i].main_row = *row;
+        }
+
+        int32_t old_index = entities[i].main_row.index;
+        int32_t staged_index = entities[i].staged_row.index;
+        old_indices[i] = old_index < 0 ? -old_index : old_index;
+        staged_indices[i] = staged_index < 0 ? -staged_index : staged_index;
+
+        /* Watched entities require rematching systems, see commit */
+        if (old_index < 0) {
+            ecs_watched_changed(world, main_stage, entities[i].entity);
+        }
+    }
+
+    /* Remove current names of entities that lose their name, or that get a
+     * name from the stage */
+    if (old_table && ecs_type_index_of(old_type, EEcsId) != -1 &&
+       (ecs_type_index_of(type, EEcsId) == -1 || 
+       (staged_type && ecs_type_index_of(staged_type, EEcsId) != -1)))
+    {
+        for (i = 0; i < count; i ++) {
+            unindex_name(world, old_table, entities[i].entity, old_indices[i]);
+        }
+    }
+
+    if (old_table == new_table) {
+        /* Entities stay in the same table, only staged data is copied */
+        memcpy(new_indices, old_indices, sizeof(int32_t) * count);
+    } else {
+        if (!old_table && main_stage->range_check_enabled) {
+            for (i = 0; i < count; i ++) {
+                ecs_entity_t entity = entities[i].entity;
+                ecs_assert(!world->max_handle || ECS_ENTITY_ID(entity) <= world->max_handle, ECS_OUT_OF_RANGE, 0);
+                ecs_assert(ECS_ENTITY_ID(entity) >= world->min_handle, ECS_OUT_OF_RANGE, 0);
+            }
+        }
+
+        /* Add all entities to the new table at once */
+        int32_t first = ecs_table_grow(
+            world, &world->main_stage, new_table, new_table->columns, count, 0);
+
+        ecs_entity_t *new_entities = ecs_vector_first(
+            new_table->columns[0].data);
+
+        for (i = 0; i < count; i ++) {
+            ecs_entity_t entity = entities[i].entity;
+            new_indices[i] = first + i;
+            new_entities[first + i - 1] = entity;
+
+            ecs_row_t new_row = {.type = type, .index = first + i};
+            if (entities[i].main_row.index < 0) {
+                new_row.index *= -1;
+            }
+
+            ecs_ei_set(main_stage->entity_index, entity, &new_row);
+        }
+
+        if (old_table) {
+            move_rows(type, new_table->columns, new_indices, 
+                old_type, old_table->columns, old_indices, count);
+
+            /* Invoke OnRemove handlers after the entity index is updated, but
+             * while the components are still stored in the old table */
+            if (to_remove) {
+                for (i = 0; i < count; i ++) {
+                    notify_post_merge(world, main_stage, old_table, 
+                        old_table->columns, old_indices[i] - 1, 1, to_remove);
+                }
+            }
+
+            /* Delete from the back so that rows that are moved into deleted
+             * rows never belong to entities that still have to be deleted */
+            qsort(old_indices, count, sizeof(int32_t), compare_index_desc);
+            for (i = 0; i < count; i ++) {
+                ecs_table_delete(
+                    world, NULL, old_table, NULL, old_indices[i]);
+            }
+        }
+
+        main_stage->commit_count ++;
+        main_stage->from_type = old_type;
+        main_stage->to_type = type;
+        world->valid_schedule = false;
+    }
+
+    if (staged_type) {
+        ecs_table_t *staged_table = ecs_world_get_table(
+            world, stage, staged_type);
+        ecs_table_column_t *staged_columns = NULL;
+        ecs_map_has(stage->data_stage, (uintptr_t)staged_type, &staged_columns);
+        ecs_assert(staged_columns != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        unshare_staged_columns(world, new_table, staged_type);
+
+        move_rows(type, new_table->columns, new_indices, 
+            staged_table->type, staged_columns, staged_indices, count);
+
+        if (ecs_type_index_of(staged_type, EEcsId) != -1) {
+            for (i = 0; i < count; i ++) {
+                index_staged_name(
+                    world, new_table, entities[i].entity, new_indices[i]);
+            }
+        }
+    }
+
+    ecs_os_free(indices);
+}
+
+void ecs_watched_changed(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_entity_t entity)
+{
+    /* Changes in a stage are added when the stage is merged */
+    if (stage == &world->main_stage) {
+        ecs_map_set(world->watched_changes, entity, &entity);
     }
 }
 
@@ -962,7 +1390,7 @@ void ecs_set_watch(
         row.type = NULL;
     }
 
-    ecs_map_set(stage->entity_index, entity, &row);
+    ecs_ei_set(stage->entity_index, entity, &row);
 }
 
 bool ecs_components_contains_component(
@@ -1007,16 +1435,20 @@ void ecs_add_remove_intern(
     ecs_stage_t *stage = ecs_get_stage(&world);
     ecs_assert(!world->is_merging, ECS_INVALID_WHILE_MERGING, NULL);
     
-    ecs_type_t dst_type = 0;
+    ecs_table_t *dst_table = NULL;
+    ecs_type_t dst_type = NULL;
 
     if (populate_info(world, stage, info)) {
-        dst_type = ecs_type_merge_intern(
-            world, stage, info->table->type, to_add, to_remove);
+        dst_table = ecs_table_traverse(
+            world, stage, info->table, to_add, to_remove);
+        if (dst_table) {
+            dst_type = dst_table->type;
+        }
     } else {
         dst_type = to_add;
     }
 
-    commit(world, stage, info, dst_type, to_add, to_remove, do_set);
+    commit(world, stage, info, dst_type, dst_table, to_add, to_remove, do_set);
 }
 
 /* -- Public functions -- */
@@ -1031,7 +1463,7 @@ ecs_entity_t _ecs_new(
 
     ecs_assert(!world->is_merging, ECS_INVALID_WHILE_MERGING, NULL);
 
-    ecs_entity_t entity = ++ world->last_handle;
+    ecs_entity_t entity = new_entity_handle(world);
 
     ecs_assert(!world->max_handle || entity <= world->max_handle, 
         ECS_OUT_OF_RANGE, NULL);
@@ -1041,7 +1473,7 @@ ecs_entity_t _ecs_new(
             .entity = entity
         };
 
-        commit(world, stage, &info, type, type, 0, true);
+        commit(world, stage, &info, type, NULL, type, 0, true);
     }
 
     return entity;
@@ -1107,11 +1539,15 @@ void copy_column_data(
         if (size) { 
             void *column_data = ecs_vector_first(columns[column + 1].data);
 
-            memcpy(
+            ecs_lifecycle_copy(
+                columns[column + 1].lifecycle,
                 ECS_OFFSET(column_data, (start_row) * size),
                 data->columns[i],
-                data->row_count * size
+                size,
+                data->row_count
             );
+
+            columns[column + 1].change_count ++;
         }
     }
 }
@@ -1221,7 +1657,7 @@ uint32_t update_entity_index(
     int32_t src_first_contiguous_row = 0;
 
     /* Obtain the entity index in the current stage */
-    ecs_map_t *entity_index = stage->entity_index;
+    ecs_ei_t *entity_index = stage->entity_index;
     ecs_entity_t e;
 
     /* We need to commit each entity individually in order to populate
@@ -1250,14 +1686,14 @@ uint32_t update_entity_index(
 
             /* Ensure that the last issued handle will always be ahead of the
              * entities created by this operation */
-            if (e > world->last_handle) {
-                world->last_handle = e + 1;
+            if (ECS_ENTITY_ID(e) > world->last_handle) {
+                world->last_handle = ECS_ENTITY_ID(e) + 1;
             }                            
         } else {
             e = i + start_entity;
         }
 
-        ecs_row_t *row_ptr = ecs_map_get_ptr(entity_index, e);
+        ecs_row_t *row_ptr = ecs_ei_get_mut(entity_index, e);
         if (row_ptr) {
             src_row = row_ptr->index;
             uint8_t is_monitored = 1 - (src_row < 0) * 2;
@@ -1301,7 +1737,7 @@ uint32_t update_entity_index(
 
                     /* Insert new row into destination table */
                     uint32_t dst_row = ecs_table_insert(
-                        world, table, columns, e) - 1;
+                        world, stage, table, columns, e) - 1;
                     if (!i) {
                         dst_start_row = dst_row;
                         dst_first_contiguous_row = dst_row;
@@ -1318,7 +1754,8 @@ uint32_t update_entity_index(
 
                     if (has_unset) {
                         copy_row(type, columns, dst_row + 1, 
-                            old_table->type, old_columns, row_ptr->index);
+                            old_table->type, old_columns, row_ptr->index, 
+                            true);
                     }
 
                     /* Actual deletion of the entity from the source table
@@ -1381,10 +1818,10 @@ uint32_t update_entity_index(
                 .type = type, .index = dst_start_row + i + 1
             };
 
-            ecs_map_set(entity_index, e, &new_row);
+            ecs_ei_set(entity_index, e, &new_row);
 
             if (data->entities) {
-                ecs_table_insert(world, table, columns, e);
+                ecs_table_insert(world, stage, table, columns, e);
 
                 /* Entities array may have been reallocated */
                 entities = ecs_vector_first(columns[0].data);
@@ -1508,16 +1945,21 @@ ecs_entity_t set_w_data_intern(
         ecs_assert(columns != NULL, ECS_INTERNAL_ERROR, 0);
         uint32_t start_row = 0;
 
+        /* Existing rows may be overwritten, which is not allowed while the
+         * columns are shared with a snapshot */
+        if (columns == table->columns && table->flags & EcsTableIsShared) {
+            ecs_table_unshare(world, table);
+        }
+
         /* Obtain the entity index in the current stage */
-        ecs_map_t *entity_index = stage->entity_index;
+        ecs_ei_t *entity_index = stage->entity_index;
 
         /* Grow world entity index only if no entity ids are provided. If ids
          * are provided, it is possible that they already appear in the entity
          * index, in which case they will be overwritten. */
-        uint32_t cur_index_count = ecs_map_count(entity_index);
         if (!data->entities) {
-            start_row = ecs_table_grow(world, table, columns, count, result) - 1;
-            ecs_map_grow(entity_index, cur_index_count + count);
+            start_row = ecs_table_grow(world, stage, table, columns, count, result) - 1;
+            ecs_ei_grow(entity_index, result, count);
         }
 
         /* Obtain list of entities */
@@ -1527,7 +1969,7 @@ ecs_entity_t set_w_data_intern(
          * row_count number of rows, which will give a perf boost the first time
          * the entities are inserted. */
         if (!entities) {
-            ecs_table_dim(table, columns, count);
+            ecs_table_dim(world, stage, table, columns, count);
             entities = ecs_vector_first(columns[0].data);
             ecs_assert(entities != NULL, ECS_INTERNAL_ERROR, NULL);
         }
@@ -1558,6 +2000,10 @@ ecs_entity_t set_w_data_intern(
          * data into each column with a single memcpy. */
         if (data->columns) {
             copy_column_data(type, columns, start_row, data);
+
+            if (ecs_type_index_of(type, EEcsId) != -1) {
+                index_names(world, stage, type, columns, start_row, count);
+            }
         }
 
         /* Invoke OnSet systems */
@@ -1686,10 +2132,10 @@ void ecs_delete(
                 .table = ecs_world_get_table(world, stage, row.type)
             };
 
-            commit(world, stage, &info, 0, 0, row.type, false);
-
-            ecs_map_remove(world->main_stage.entity_index, entity);
+            commit(world, stage, &info, 0, NULL, 0, row.type, false);
         }
+
+        ecs_free_entity(world, entity);
     } else {
         /* Mark components of the entity in the main stage as removed. This will
          * ensure that subsequent calls to ecs_has, ecs_get and ecs_is_empty will
@@ -1700,10 +2146,34 @@ void ecs_delete(
 
         /* Remove the entity from the staged index. Any added components while
          * in progress will be discarded as a result. */
-        ecs_map_set(stage->entity_index, entity, &((ecs_row_t){0, 0}));
+        ecs_ei_set(stage->entity_index, entity, &((ecs_row_t){0, 0}));
+
+        /* Free the entity id when merging */
+        ecs_entity_t *e = ecs_vector_add(&stage->delete_merge, &handle_arr_params);
+        *e = entity;
     }
 }
 
+bool ecs_is_alive(
+    ecs_world_t *world,
+    ecs_entity_t entity)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_get_stage(&world);
+
+    ecs_ei_t *entity_index = world->main_stage.entity_index;
+
+    /* Entities with components are always alive. Otherwise the entity is
+     * alive if its id has been issued, and its generation is current. */
+    if (ecs_ei_get(entity_index, entity)) {
+        return true;
+    }
+
+    ecs_entity_t id = ECS_ENTITY_ID(entity);
+    return id && id <= world->last_handle && 
+        ecs_ei_is_alive(entity_index, entity);
+}
+
 void ecs_delete_w_filter_intern(
     ecs_world_t *world,
     const ecs_filter_t *filter,
@@ -1716,16 +2186,16 @@ void ecs_delete_w_filter_intern(
         "delete_w_filter currently only supported on main stage");
 
     uint32_t i, count = ecs_chunked_count(stage->tables);
+    uint64_t bloom = ecs_filter_bloom(filter);
 
     for (i = 0; i < count; i ++) {
         ecs_table_t *table = ecs_chunked_get(stage->tables, ecs_table_t, i);
-        ecs_type_t type = table->type;
 
         if (table->flags & EcsTableHasBuiltins) {
             continue;
         }
 
-        if (!ecs_type_match_w_filter(world, type, filter)) {
+        if (!ecs_table_match_filter(world, table, filter, bloom)) {
             continue;
         }
 
@@ -1734,9 +2204,11 @@ void ecs_delete_w_filter_intern(
         ecs_entity_t *array = ecs_vector_first(entities);
         uint32_t j, row_count = ecs_vector_count(entities);
         for (j = 0; j < row_count; j ++) {
-            ecs_map_remove(world->main_stage.entity_index, array[j]);
+            ecs_free_entity(world, array[j]);
         }
 
+        ecs_name_index_remove_table(world, table);
+
         /* Both filters passed, clear table */
         if (is_delete) {
             ecs_table_delete_all(world, table);
@@ -1773,41 +2245,44 @@ void _ecs_add_remove_w_filter(
         "remove_w_filter currently only supported on main stage");
 
     uint32_t i, count = ecs_chunked_count(stage->tables);
+    uint64_t bloom = ecs_filter_bloom(filter);
 
     for (i = 0; i < count; i ++) {
         ecs_table_t *table = ecs_chunked_get(stage->tables, ecs_table_t, i);
         ecs_type_t type = table->type;
 
-        /* Skip if the type contains none of the components in to_remove */
-        if (to_remove) {
-            if (!ecs_type_contains(world, type, to_remove, false, false)) {
-                continue;
-            }
+        /* Empty tables do not have to be moved */
+        if (!table->columns || !ecs_vector_count(table->columns[0].data)) {
+            continue;
         }
 
-        /* Skip if the type already contains all of the components in to_add */
-        if (to_add) {
-            if (ecs_type_contains(world, type, to_add, true, false)) {
-                continue;
-            }            
+        /* Skip if the type contains none of the components in to_remove, and
+         * already contains all of the components in to_add */
+        bool has_remove = to_remove && 
+            ecs_type_contains(world, type, to_remove, false, false);
+        bool has_add = !to_add || 
+            ecs_type_contains(world, type, to_add, true, false);
+
+        if (!has_remove && has_add) {
+            continue;
         }
 
-        if (!ecs_type_match_w_filter(world, type, filter)) {
+        if (!ecs_table_match_filter(world, table, filter, bloom)) {
             continue;
         }
 
-        /* Component(s) must be removed, find table */
-        ecs_type_t dst_type = ecs_type_merge(world, type, to_add, to_remove);
-        if (!dst_type) {
-            /* If this removes all components, clear table */
-            ecs_table_merge(world, NULL, table);
-        } else {
-            ecs_table_t *dst_table = ecs_world_get_table(world, stage, dst_type);
-            ecs_assert(dst_table != NULL, ECS_INTERNAL_ERROR, NULL);
+        /* Find table to move entities to. When a single component is added or
+         * removed, this uses the edges of the table. If this removes all
+         * components, dst_table is NULL and the table is cleared. */
+        ecs_table_t *dst_table = ecs_table_traverse(
+            world, stage, table, to_add, to_remove);
 
-            /* Merge table into dst_table */
-            ecs_table_merge(world, dst_table, table);
+        if (dst_table == table) {
+            continue;
         }
+
+        /* Move all entities of table to dst_table */
+        ecs_table_merge(world, dst_table, table);
     }    
 }
 
@@ -1833,22 +2308,32 @@ ecs_entity_t copy_from_stage(
 
         ecs_assert(!dst_entity, ECS_INTERNAL_ERROR, NULL);
 
-        dst_entity = ++ world->last_handle;
+        dst_entity = new_entity_handle(world);
         new_type = src_info.type;
 
         ecs_entity_info_t info = {
             .entity = dst_entity
         };
 
-        commit(world, stage, &info, new_type, src_info.type, 0, false);
+        commit(world, stage, &info, new_type, NULL, src_info.type, 0, false);
+
+        EcsId *id = get_row_ptr(
+            info.table->type, info.columns, info.index, EEcsId);
 
         if (copy_value) {
             copy_row(info.table->type, info.columns, info.index,
-                src_info.type, src_info.columns, src_info.index);
+                src_info.type, src_info.columns, src_info.index, false);
+
+            if (id) {
+                ecs_name_index_add(world, stage, dst_entity, *id);
+            }
 
             ecs_notify(
                 world_arg, stage, world->type_sys_set_index, 
                 info.type, info.table, info.columns, info.index - 1, 1);                
+        } else if (id) {
+            /* Don't leave name of clone uninitialized */
+            *id = NULL;
         }
     }
 
@@ -1873,7 +2358,7 @@ ecs_entity_t ecs_clone(
     }
 
     if (!result) {
-        result = ++ world->last_handle;
+        result = new_entity_handle(world);
     }
 
     return result;
@@ -2019,6 +2504,7 @@ ecs_entity_t _ecs_set_ptr_intern(
 
     /* If component hasn't been added to entity yet, add it */
     int *dst = ecs_get_ptr_intern(world, stage, &info, component, true, false);
+    bool is_new = dst == NULL;
     if (!dst) {
         ecs_add_remove_intern(world_arg, &info, type, 0, false);
         dst = ecs_get_ptr_intern(world, stage, &info, component, true, false);
@@ -2029,6 +2515,15 @@ ecs_entity_t _ecs_set_ptr_intern(
         }
     }
 
+    /* If the column shares data with a snapshot, copy it before writing */
+    if (!world->in_progress && info.table->flags & EcsTableIsShared) {
+        int16_t index = ecs_type_index_of(info.table->type, component);
+        if (ecs_table_unshare_column(world, info.table, index + 1)) {
+            dst = get_row_ptr(
+                info.table->type, info.columns, info.index, component);
+        }
+    }
+
 #ifndef NDEBUG
     ecs_entity_info_t cinfo = {.entity = component};
     EcsComponent *cdata = ecs_get_ptr_intern(
@@ -2036,14 +2531,41 @@ ecs_entity_t _ecs_set_ptr_intern(
     ecs_assert(cdata->size == size, ECS_INVALID_COMPONENT_SIZE, NULL);
 #endif
 
+    int16_t column = ecs_type_index_of(info.table->type, component);
+    ecs_lifecycle_t *lc = NULL;
+    if (column >= 0) {
+        lc = info.columns[column + 1].lifecycle;
+    }
+
+    /* Remove current name from the name index before it is overwritten */
+    if (component == EEcsId && !is_new && stage == &world->main_stage && 
+        *(EcsId*)dst) 
+    {
+        ecs_name_index_remove(
+            world, stage, entity, info.type, *(EcsId*)dst);
+    }
+
     if (dst != ptr) {
         if (ptr) {
-            memcpy(dst, ptr, size);
+            ecs_lifecycle_copy(lc, dst, ptr, size, 1);
+        } else if (lc) {
+            /* Reset value to its constructed state */
+            ecs_lifecycle_dtor(lc, dst, size, 1);
+            ecs_lifecycle_ctor(lc, dst, size, 1);
         } else if (size) {
             memset(dst, 0, size);
         }
     }
 
+    /* Systems with [changed] columns run on the table again */
+    if (column >= 0) {
+        info.columns[column + 1].change_count ++;
+    }
+
+    if (component == EEcsId) {
+        ecs_name_index_add(world, stage, entity, *(EcsId*)dst);
+    }
+
     notify_pre_merge(
         world_arg, stage, info.table, info.columns, info.index - 1, 1, type,
         world->type_sys_set_index);
@@ -2305,11 +2827,12 @@ uint32_t ecs_count_w_filter(
     ecs_chunked_t *tables = world->main_stage.tables;
     uint32_t i, count = ecs_chunked_count(tables);
     uint32_t result = 0;
+    uint64_t bloom = ecs_filter_bloom(filter);
 
     for (i = 0; i < count; i ++) {
         ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, i);
 
-        if (!filter || ecs_type_match_w_filter(world, table->type, filter)) {
+        if (ecs_table_match_filter(world, table, filter, bloom)) {
             result += ecs_vector_count(table->columns[0].data); 
         }
     }
@@ -2350,6 +2873,55 @@ ecs_entity_t ecs_new_component(
     return result;
 }
 
+void ecs_set_component_lifecycle(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const EcsComponentLifecycle *lifecycle)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_FROM_WORKER, NULL);
+    ecs_assert(!world->in_progress, ECS_INVALID_WHILE_ITERATING, NULL);
+    ecs_assert(lifecycle != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    EcsComponent *cdata = ecs_get_ptr(world, component, EcsComponent);
+    ecs_assert(cdata != NULL, ECS_NOT_A_COMPONENT, NULL);
+    ecs_assert(cdata->size != 0, ECS_INVALID_COMPONENT_SIZE, NULL);
+    (void)cdata;
+
+    ecs_lifecycle_t *lc = NULL;
+    if (!ecs_map_has(world->component_lifecycle, component, &lc)) {
+        lc = ecs_os_malloc(sizeof(ecs_lifecycle_t));
+        ecs_map_set(world->component_lifecycle, component, &lc);
+    }
+
+    *lc = (ecs_lifecycle_t){
+        .callbacks = *lifecycle,
+        .world = world,
+        .component = component
+    };
+
+    /* Tables created from here on will get the callbacks when initializing
+     * their columns. Existing tables must not yet contain values that were
+     * created without them. */
+    ecs_chunked_t *tables = world->main_stage.tables;
+    uint32_t i, count = ecs_chunked_count(tables);
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, i);
+        int32_t index = ecs_type_index_of(table->type, component);
+        if (index == -1) {
+            continue;
+        }
+
+        ecs_table_column_t *column = &table->columns[index + 1];
+        if (column->lifecycle != lc) {
+            ecs_assert(!ecs_vector_count(column->data), 
+                ECS_INVALID_PARAMETER, NULL);
+            column->lifecycle = lc;
+        }
+    }
+}
+
 /* -- Debug functionality -- */
 
 void ecs_dbg_entity(
@@ -0,0 +1,425 @@
+#include "flecs_private.h"
+
+/* The entity index maps entity ids to (type, row) pairs. The main stage looks
+ * up entities on nearly every operation, so entity ids below
+ * ECS_EI_MAX_PAGED_ENTITY are stored in pages of ECS_EI_PAGE_SIZE rows, which
+ * are indexed directly by the entity id. Pages are only allocated when an id
+ * in their range is set. Ids that are too large to be stored in pages (like
+ * EcsSingleton) are stored in a hashmap.
+ *
+ * Temporary and worker stages only store deltas for a small subset of
+ * entities, and need to be able to iterate over them when merging. These
+ * stages do not use pages, and store all rows in the hashmap.
+ *
+ * Ids of deleted entities in pages are added to a free list, so they can be
+ * recycled by ecs_new. Each time an id is deleted its generation is increased,
+ * and handles with an older generation are no longer found in the index.
+ *
+ * Copies of an index (made by snapshots) share pages with the original index.
+ * A shared page is copied when either index modifies it, so that a copy of the
+ * index only costs as much as the pages that change after it is made. */
+
+static
+ecs_vector_params_t page_arr_params = {
+    .element_size = sizeof(ecs_ei_page_t*)
+};
+
+static
+ecs_vector_params_t free_arr_params = {
+    .element_size = sizeof(ecs_entity_t)
+};
+
+static
+bool row_is_empty(
+    const ecs_row_t *row)
+{
+    return !row->type && !row->index;
+}
+
+static
+ecs_ei_page_t* get_page(
+    ecs_ei_t *ei,
+    uint32_t page_index)
+{
+    if (page_index >= ecs_vector_count(ei->pages)) {
+        return NULL;
+    }
+
+    ecs_ei_page_t **pages = ecs_vector_first(ei->pages);
+    return pages[page_index];
+}
+
+/** Get page that can be modified. If the page is shared with another index,
+ * the page is copied. */
+static
+ecs_ei_page_t* get_mut_page(
+    ecs_ei_t *ei,
+    uint32_t page_index)
+{
+    if (page_index >= ecs_vector_count(ei->pages)) {
+        return NULL;
+    }
+
+    ecs_ei_page_t **pages = ecs_vector_first(ei->pages);
+    ecs_ei_page_t *page = pages[page_index];
+    if (page && page->shared) {
+        page->shared --;
+        page = ecs_os_memdup(page, sizeof(ecs_ei_page_t));
+        ecs_assert(page != NULL, ECS_OUT_OF_MEMORY, NULL);
+        page->shared = 0;
+        pages[page_index] = page;
+    }
+
+    return page;
+}
+
+static
+ecs_ei_page_t* get_or_create_page(
+    ecs_ei_t *ei,
+    uint32_t page_index)
+{
+    uint32_t count = ecs_vector_count(ei->pages);
+
+    if (page_index >= count) {
+        ecs_vector_set_count(&ei->pages, &page_arr_params, page_index + 1);
+        ecs_ei_page_t **pages = ecs_vector_first(ei->pages);
+        memset(&pages[count], 0,
+            (page_index + 1 - count) * sizeof(ecs_ei_page_t*));
+    }
+
+    ecs_ei_page_t *page = get_mut_page(ei, page_index);
+    if (!page) {
+        page = ecs_os_calloc(1, sizeof(ecs_ei_page_t));
+        ecs_assert(page != NULL, ECS_OUT_OF_MEMORY, NULL);
+        ecs_ei_page_t **pages = ecs_vector_first(ei->pages);
+        pages[page_index] = page;
+    }
+
+    return page;
+}
+
+static
+bool is_paged(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    return ei->is_paged && ECS_ENTITY_ID(entity) < ECS_EI_MAX_PAGED_ENTITY;
+}
+
+/* -- Private functions -- */
+
+ecs_ei_t* ecs_ei_new(
+    bool paged)
+{
+    ecs_ei_t *result = ecs_os_calloc(1, sizeof(ecs_ei_t));
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    result->hi = ecs_map_new(0, sizeof(ecs_row_t));
+    result->is_paged = paged;
+
+    return result;
+}
+
+void ecs_ei_clear(
+    ecs_ei_t *ei)
+{
+    ecs_ei_page_t **pages = ecs_vector_first(ei->pages);
+    uint32_t i, count = ecs_vector_count(ei->pages);
+
+    for (i = 0; i < count; i ++) {
+        ecs_ei_page_t *page = pages[i];
+        if (page && page->shared) {
+            page->shared --;
+        } else {
+            ecs_os_free(page);
+        }
+    }
+
+    ecs_vector_free(ei->pages);
+    ecs_vector_free(ei->free_list);
+    ei->pages = NULL;
+    ei->free_list = NULL;
+    ei->count = 0;
+
+    ecs_map_clear(ei->hi);
+}
+
+void ecs_ei_free(
+    ecs_ei_t *ei)
+{
+    ecs_ei_clear(ei);
+    ecs_map_free(ei->hi);
+    ecs_os_free(ei);
+}
+
+ecs_ei_t* ecs_ei_copy(
+    const ecs_ei_t *ei)
+{
+    ecs_ei_t *result = ecs_os_memdup(ei, sizeof(ecs_ei_t));
+    result->pages = ecs_vector_copy(ei->pages, &page_arr_params);
+    result->free_list = ecs_vector_copy(ei->free_list, &free_arr_params);
+    result->hi = ecs_map_copy(ei->hi);
+
+    ecs_ei_page_t **pages = ecs_vector_first(result->pages);
+    uint32_t i, count = ecs_vector_count(result->pages);
+
+    /* Pages are copied when they are modified */
+    for (i = 0; i < count; i ++) {
+        if (pages[i]) {
+            pages[i]->shared ++;
+        }
+    }
+
+    return result;
+}
+
+ecs_row_t* ecs_ei_get(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    if (is_paged(ei, entity)) {
+        ecs_entity_t id = ECS_ENTITY_ID(entity);
+        ecs_ei_page_t *page = get_page(ei, id >> ECS_EI_PAGE_BITS);
+        if (page) {
+            uint32_t i = id & (ECS_EI_PAGE_SIZE - 1);
+            ecs_row_t *row = &page->rows[i];
+            if (!row_is_empty(row) &&
+                page->generation[i] == ECS_GENERATION(entity))
+            {
+                return row;
+            }
+        }
+
+        return NULL;
+    } else {
+        return ecs_map_get_ptr(ei->hi, entity);
+    }
+}
+
+ecs_row_t* ecs_ei_get_mut(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    if (is_paged(ei, entity)) {
+        ecs_entity_t id = ECS_ENTITY_ID(entity);
+        ecs_ei_page_t *page = get_page(ei, id >> ECS_EI_PAGE_BITS);
+        if (page && page->shared) {
+            get_mut_page(ei, id >> ECS_EI_PAGE_BITS);
+        }
+    }
+
+    return ecs_ei_get(ei, entity);
+}
+
+bool ecs_ei_has(
+    ecs_ei_t *ei,
+    ecs_entity_t entity,
+    ecs_row_t *row_out)
+{
+    ecs_row_t *row = ecs_ei_get(ei, entity);
+    if (row) {
+        if (row_out) {
+            *row_out = *row;
+        }
+        return true;
+    } else {
+        return false;
+    }
+}
+
+void ecs_ei_set(
+    ecs_ei_t *ei,
+    ecs_entity_t entity,
+    const ecs_row_t *row)
+{
+    if (is_paged(ei, entity)) {
+        /* An empty row in a paged index is the same as no row */
+        if (row_is_empty(row)) {
+            ecs_ei_remove(ei, entity);
+            return;
+        }
+
+        ecs_entity_t id = ECS_ENTITY_ID(entity);
+        ecs_ei_page_t *page = get_or_create_page(ei, id >> ECS_EI_PAGE_BITS);
+        uint32_t i = id & (ECS_EI_PAGE_SIZE - 1);
+        uint16_t generation = ECS_GENERATION(entity);
+
+        if (page->generation[i] != generation) {
+            /* Setting a row for a deleted entity brings it back to life, which
+             * happens when restoring snapshots. This is not allowed when the id
+             * has been recycled for another entity. */
+            ecs_assert(page->flags[i] & ECS_EI_FREE, ECS_INVALID_HANDLE, NULL);
+            page->generation[i] = generation;
+        }
+
+        /* If the entity was in the free list, it will be skipped when it is
+         * popped from the free list. */
+        page->flags[i] &= ~ECS_EI_FREE;
+
+        ecs_row_t *dst = &page->rows[i];
+        if (row_is_empty(dst)) {
+            ei->count ++;
+        }
+
+        *dst = *row;
+    } else {
+        ecs_map_set(ei->hi, entity, row);
+    }
+}
+
+void ecs_ei_remove(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    if (is_paged(ei, entity)) {
+        ecs_row_t *row = ecs_ei_get_mut(ei, entity);
+        if (row) {
+            *row = (ecs_row_t){0, 0};
+            ei->count --;
+        }
+    } else {
+        ecs_map_remove(ei->hi, entity);
+    }
+}
+
+bool ecs_ei_delete(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    if (!is_paged(ei, entity)) {
+        ecs_map_remove(ei->hi, entity);
+        return false;
+    }
+
+    ecs_entity_t id = ECS_ENTITY_ID(entity);
+    ecs_ei_page_t *page = get_or_create_page(ei, id >> ECS_EI_PAGE_BITS);
+    uint32_t i = id & (ECS_EI_PAGE_SIZE - 1);
+
+    /* Don't delete entities that have already been deleted */
+    if (page->generation[i] != ECS_GENERATION(entity) ||
+        page->flags[i] & ECS_EI_FREE)
+    {
+        return false;
+    }
+
+    if (!row_is_empty(&page->rows[i])) {
+        page->rows[i] = (ecs_row_t){0, 0};
+        ei->count --;
+    }
+
+    page->generation[i] ++;
+    page->flags[i] |= ECS_EI_FREE;
+
+    /* An id can be deleted, brought back to life and deleted again while it
+     * is still in the free list. Make sure it is only added once. */
+    if (!(page->flags[i] & ECS_EI_LISTED)) {
+        ecs_entity_t *elem = ecs_vector_add(&ei->free_list, &free_arr_params);
+        *elem = id;
+        page->flags[i] |= ECS_EI_LISTED;
+    }
+
+    return true;
+}
+
+ecs_entity_t ecs_ei_recycle(
+    ecs_ei_t *ei)
+{
+    ecs_entity_t id;
+
+    while (ecs_vector_pop(ei->free_list, &free_arr_params, &id)) {
+        ecs_ei_page_t *page = get_mut_page(ei, id >> ECS_EI_PAGE_BITS);
+        ecs_assert(page != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        uint32_t i = id & (ECS_EI_PAGE_SIZE - 1);
+        page->flags[i] &= ~ECS_EI_LISTED;
+
+        /* Skip ids of entities that were brought back to life */
+        if (page->flags[i] & ECS_EI_FREE) {
+            page->flags[i] &= ~ECS_EI_FREE;
+            return id | ((ecs_entity_t)page->generation[i] <<
+                ECS_GENERATION_SHIFT);
+        }
+    }
+
+    return 0;
+}
+
+bool ecs_ei_is_alive(
+    ecs_ei_t *ei,
+    ecs_entity_t entity)
+{
+    if (!is_paged(ei, entity)) {
+        return ecs_map_get_ptr(ei->hi, entity) != NULL;
+    }
+
+    ecs_entity_t id = ECS_ENTITY_ID(entity);
+    ecs_ei_page_t *page = get_page(ei, id >> ECS_EI_PAGE_BITS);
+    if (!page) {
+        return ECS_GENERATION(entity) == 0;
+    }
+
+    uint32_t i = id & (ECS_EI_PAGE_SIZE - 1);
+    return page->generation[i] == ECS_GENERATION(entity) &&
+        !(page->flags[i] & ECS_EI_FREE);
+}
+
+uint32_t ecs_ei_count(
+    ecs_ei_t *ei)
+{
+    return ei->count + ecs_map_count(ei->hi);
+}
+
+void ecs_ei_grow(
+    ecs_ei_t *ei,
+    ecs_entity_t first,
+    uint32_t count)
+{
+    if (!count) {
+        return;
+    }
+
+    if (ei->is_paged) {
+        ecs_entity_t last = first + count - 1;
+        if (last >= ECS_EI_MAX_PAGED_ENTITY) {
+            last = ECS_EI_MAX_PAGED_ENTITY - 1;
+        }
+
+        if (first <= last) {
+            uint32_t p, last_page = last >> ECS_EI_PAGE_BITS;
+            for (p = first >> ECS_EI_PAGE_BITS; p <= last_page; p ++) {
+                get_or_create_page(ei, p);
+            }
+        }
+    } else {
+        ecs_map_grow(ei->hi, ecs_map_count(ei->hi) + count);
+    }
+}
+
+void ecs_ei_memory(
+    ecs_ei_t *ei,
+    uint32_t *allocd,
+    uint32_t *used)
+{
+    ecs_ei_page_t **pages = ecs_vector_first(ei->pages);
+    uint32_t i, page_count = 0, count = ecs_vector_count(ei->pages);
+
+    for (i = 0; i < count; i ++) {
+        page_count += pages[i] != NULL;
+    }
+
+    if (allocd) {
+        *allocd += sizeof(ecs_ei_t);
+        *allocd += page_count * sizeof(ecs_ei_page_t);
+        ecs_vector_memory(ei->pages, &page_arr_params, allocd, NULL);
+        ecs_vector_memory(ei->free_list, &free_arr_params, allocd, NULL);
+    }
+
+    if (used) {
+        *used += sizeof(ecs_ei_t);
+        *used += ei->count * sizeof(ecs_row_t);
+        ecs_vector_memory(ei->pages, &page_arr_params, NULL, used);
+        ecs_vector_memory(ei->free_list, &free_arr_params, NULL, used);
+    }
+
+    ecs_map_memory(ei->hi, allocd, used);
+}
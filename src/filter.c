@@ -9,6 +9,7 @@ ecs_filter_iter_t ecs_filter_iter(
         .filter = filter ? *filter : (ecs_filter_t){0},
         .tables = world->main_stage.tables,
         .index = 0,
+        .bloom = ecs_filter_bloom(filter),
         .rows = {
             .world = world
         }
@@ -24,6 +25,7 @@ ecs_filter_iter_t ecs_snapshot_filter_iter(
         .filter = filter ? *filter : (ecs_filter_t){0},
         .tables = snapshot->tables,
         .index = 0,
+        .bloom = ecs_filter_bloom(filter),
         .rows = {
             .world = world
         }
@@ -44,14 +46,25 @@ bool ecs_filter_next(
             continue;
         }
 
-        if (!ecs_type_match_w_filter(iter->rows.world, table->type, &iter->filter)) {
+        if (!ecs_table_match_filter(
+            iter->rows.world, table, &iter->filter, iter->bloom)) 
+        {
             continue;
         }
 
+        /* Filters do not know which components are written, so copy all
+         * columns that are shared with a snapshot */
+        ecs_world_t *world = iter->rows.world;
+        if (table->flags & EcsTableIsShared && 
+            world->magic == ECS_WORLD_MAGIC) 
+        {
+            ecs_table_unshare(world, table);
+        }
+
         ecs_rows_t *rows = &iter->rows;
         rows->table = table;
         rows->table_columns = table->columns;
-        rows->count = ecs_table_count(table);
+        rows->count = ecs_vector_count(table->columns[0].data);
         rows->entities = ecs_vector_first(table->columns[0].data);
         iter->index = ++i;
         return true;
@@ -59,3 +72,61 @@ bool ecs_filter_next(
 
     return false;
 }
+
+void ecs_filter_run(
+    ecs_world_t *world,
+    const ecs_filter_t *filter,
+    ecs_system_action_t action,
+    void *param)
+{
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_FROM_WORKER, NULL);
+    ecs_assert(!world->is_merging, ECS_INVALID_WHILE_MERGING, NULL);
+    ecs_assert(action != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_filter_t f = filter ? *filter : (ecs_filter_t){0};
+    uint64_t bloom = ecs_filter_bloom(filter);
+    ecs_filter_job_t job = {
+        .action = action,
+        .param = param
+    };
+
+    ecs_chunked_t *tables = world->main_stage.tables;
+    int32_t i, count = ecs_chunked_count(tables);
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, i);
+
+        if (!table->columns || !ecs_vector_count(table->columns[0].data)) {
+            continue;
+        }
+
+        if (!ecs_table_match_filter(world, table, &f, bloom)) {
+            continue;
+        }
+
+        /* Workers cannot copy columns shared with a snapshot */
+        if (table->flags & EcsTableIsShared) {
+            ecs_table_unshare(world, table);
+        }
+
+        ecs_table_t **elem = ecs_vector_add(&job.tables, &ptr_params);
+        *elem = table;
+    }
+
+    /* Tables cannot change while the callback is running, so mutations are
+     * always staged. If the operation is not called while in progress, the
+     * stages are merged before returning. */
+    bool in_progress = world->in_progress;
+    world->in_progress = true;
+
+    ecs_run_filter_jobs(world, &job);
+
+    if (!in_progress) {
+        world->in_progress = false;
+        if (world->auto_merge) {
+            ecs_merge(world);
+        }
+    }
+
+    ecs_vector_free(job.tables);
+}
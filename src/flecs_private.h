@@ -5,6 +5,21 @@
 
 #include "types.h"
 
+/* -- Memory API -- */
+
+/* Allocate memory from the allocator of the world */
+void* ecs_world_alloc(
+    ecs_world_t *world,
+    size_t alignment,
+    size_t size);
+
+/* Free memory allocated with ecs_world_alloc */
+void ecs_world_free(
+    ecs_world_t *world,
+    void *ptr,
+    size_t alignment,
+    size_t size);
+
 /* -- Entity API -- */
 
 /* Merge entity with stage */
@@ -14,6 +29,18 @@ void ecs_merge_entity(
     ecs_entity_t entity,
     ecs_row_t staged_row);
 
+/* Merge entities with the same main type, staged type and removed components */
+void ecs_merge_entities(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_staged_entity_t *entities,
+    uint32_t count);
+
+/* Delete entity from main stage and add its id to the free list */
+void ecs_free_entity(
+    ecs_world_t *world,
+    ecs_entity_t entity);
+
 /* Get prefab from type, even if type was introduced while in progress */
 ecs_entity_t ecs_get_prefab_from_type(
     ecs_world_t *world,
@@ -40,6 +67,52 @@ void ecs_set_watch(
     ecs_stage_t *stage,
     ecs_entity_t entity);
 
+/* Register change to a watched entity, which rematches the systems for tables
+ * that have the entity as container or prefab */
+void ecs_watched_changed(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_entity_t entity);
+
+/* Add entity to name index after its name is set */
+void ecs_name_index_add(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_entity_t entity,
+    const char *name);
+
+/* Remove entity from name index when it loses its name. The type is the type
+ * of the entity that had the name. */
+void ecs_name_index_remove(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_entity_t entity,
+    ecs_type_t type,
+    const char *name);
+
+/* Remove named entities of main stage table from name index before the table
+ * is cleared */
+void ecs_name_index_remove_table(
+    ecs_world_t *world,
+    ecs_table_t *table);
+
+/* Rebuild name index before the next lookup, after names were written
+ * directly to tables */
+void ecs_name_index_invalidate(
+    ecs_world_t *world);
+
+/* Test if name index can be used for lookups in stage, rebuild if needed */
+bool ecs_name_index_ready(
+    ecs_world_t *world,
+    ecs_stage_t *stage);
+
+/* Find entity by parent and name in name index */
+ecs_entity_t ecs_name_index_lookup(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_entity_t parent,
+    const char *name);
+
 /* Does one of the entity containers has specified component */
 bool ecs_components_contains_component(
     ecs_world_t *world,
@@ -63,6 +136,12 @@ ecs_entity_t ecs_get_entity_for_component(
     ecs_type_t type_id,
     ecs_entity_t component);
 
+/* Copy column that stores component of entity if it is shared with snapshot */
+bool ecs_unshare_component(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_entity_t component);
+
 void ecs_clear_w_filter(
     ecs_world_t *world,
     const ecs_filter_t *filter);
@@ -96,6 +175,82 @@ ecs_vector_t** ecs_system_array(
     ecs_world_t *world,
     EcsSystemKind kind);
 
+/* -- Entity index API -- */
+
+/* Create new entity index. Paged indices are used by the main stage. */
+ecs_ei_t* ecs_ei_new(
+    bool paged);
+
+/* Free entity index */
+void ecs_ei_free(
+    ecs_ei_t *ei);
+
+/* Remove all rows from entity index */
+void ecs_ei_clear(
+    ecs_ei_t *ei);
+
+/* Copy entity index. Pages are shared until either index modifies them. */
+ecs_ei_t* ecs_ei_copy(
+    const ecs_ei_t *ei);
+
+/* Get pointer to row for entity, returns NULL if entity is not in index */
+ecs_row_t* ecs_ei_get(
+    ecs_ei_t *ei,
+    ecs_entity_t entity);
+
+/* Same as ecs_ei_get, but copies the page of the row if it is shared */
+ecs_row_t* ecs_ei_get_mut(
+    ecs_ei_t *ei,
+    ecs_entity_t entity);
+
+/* Test if entity is in index, and optionally obtain its row */
+bool ecs_ei_has(
+    ecs_ei_t *ei,
+    ecs_entity_t entity,
+    ecs_row_t *row_out);
+
+/* Set row for entity */
+void ecs_ei_set(
+    ecs_ei_t *ei,
+    ecs_entity_t entity,
+    const ecs_row_t *row);
+
+/* Remove entity from index */
+void ecs_ei_remove(
+    ecs_ei_t *ei,
+    ecs_entity_t entity);
+
+/* Delete entity from index and add its id to the free list. Returns false if
+ * the entity was already deleted. */
+bool ecs_ei_delete(
+    ecs_ei_t *ei,
+    ecs_entity_t entity);
+
+/* Pop id from the free list, returns 0 if there are no ids to recycle */
+ecs_entity_t ecs_ei_recycle(
+    ecs_ei_t *ei);
+
+/* Test whether the generation of the entity handle is current */
+bool ecs_ei_is_alive(
+    ecs_ei_t *ei,
+    ecs_entity_t entity);
+
+/* Return number of rows in index */
+uint32_t ecs_ei_count(
+    ecs_ei_t *ei);
+
+/* Preallocate storage for count entities, starting from first */
+void ecs_ei_grow(
+    ecs_ei_t *ei,
+    ecs_entity_t first,
+    uint32_t count);
+
+/* Compute memory used by entity index */
+void ecs_ei_memory(
+    ecs_ei_t *ei,
+    uint32_t *allocd,
+    uint32_t *used);
+
 /* -- Stage API -- */
 
 /* Initialize stage data structures */
@@ -113,6 +268,18 @@ void ecs_stage_merge(
     ecs_world_t *world,
     ecs_stage_t *stage);
 
+/* Allocate memory that is valid until the stage is merged */
+void* ecs_stage_alloc(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    size_t size);
+
+/* Get memory allocated and used by stage arena */
+void ecs_stage_arena_memory(
+    ecs_stage_t *stage,
+    uint32_t *allocd,
+    uint32_t *used);
+
 /* -- Type utility API -- */
 
 ecs_type_t ecs_type_find_intern(
@@ -137,6 +304,10 @@ ecs_entity_t ecs_type_contains(
     bool match_all,
     bool match_prefab);
 
+/* Compute bloom signature of type */
+uint64_t ecs_type_bloom(
+    ecs_type_t type);
+
 /* Test if type contains component */
 bool ecs_type_has_entity_intern(
     ecs_world_t *world,
@@ -175,8 +346,49 @@ ecs_entity_t ecs_find_entity_in_prefabs(
     ecs_entity_t component,
     ecs_entity_t previous);
 
+/* -- Component lifecycle -- */
+
+/* Construct component values. Values without constructor are zeroed. */
+void ecs_lifecycle_ctor(
+    ecs_lifecycle_t *lc,
+    void *ptr,
+    uint32_t size,
+    uint32_t count);
+
+/* Destruct component values */
+void ecs_lifecycle_dtor(
+    ecs_lifecycle_t *lc,
+    void *ptr,
+    uint32_t size,
+    uint32_t count);
+
+/* Copy component values to constructed values */
+void ecs_lifecycle_copy(
+    ecs_lifecycle_t *lc,
+    void *dst,
+    const void *src,
+    uint32_t size,
+    uint32_t count);
+
+/* Move component values to constructed values */
+void ecs_lifecycle_move(
+    ecs_lifecycle_t *lc,
+    void *dst,
+    void *src,
+    uint32_t size,
+    uint32_t count);
+
 /* -- Table API -- */
 
+/* Find table that an entity moves to after adding/removing types. Returns NULL
+ * if the entity has no components after adding/removing types. */
+ecs_table_t* ecs_table_traverse(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_table_t *table,
+    ecs_type_t to_add,
+    ecs_type_t to_remove);
+
 /* Initialize table */
 void ecs_table_init(
     ecs_world_t *world,
@@ -199,9 +411,16 @@ void ecs_table_register_system(
     ecs_table_t *table,
     ecs_entity_t system);    
 
+/* Unregister system that is no longer matched with table */
+void ecs_table_unregister_system(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_entity_t system);
+
 /* Insert row into table (or stage) */
 uint32_t ecs_table_insert(
     ecs_world_t *world,
+    ecs_stage_t *stage,
     ecs_table_t *table,
     ecs_table_column_t *columns,
     ecs_entity_t entity);
@@ -209,6 +428,7 @@ uint32_t ecs_table_insert(
 /* Insert multiple rows into table (or stage) */
 uint32_t ecs_table_grow(
     ecs_world_t *world,
+    ecs_stage_t *stage,
     ecs_table_t *table,
     ecs_table_column_t *columns,
     uint32_t count,
@@ -216,6 +436,8 @@ uint32_t ecs_table_grow(
 
 /* Dimension array to have n rows (doesn't add entities) */
 int16_t ecs_table_dim(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
     ecs_table_t *table,
     ecs_table_column_t *columns,
     uint32_t count);
@@ -251,6 +473,18 @@ bool ecs_table_has_components(
     ecs_table_t *table,
     ecs_vector_t *components);
 
+/* Compute bloom signature of the include type of a filter */
+uint64_t ecs_filter_bloom(
+    const ecs_filter_t *filter);
+
+/* Test if table matches filter, using the bloom signature of the filter to
+ * reject tables before comparing types */
+bool ecs_table_match_filter(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    const ecs_filter_t *filter,
+    uint64_t bloom);
+
 /* Deinitialize table. This invokes all matching on_remove systems */
 void ecs_table_deinit(
     ecs_world_t *world,
@@ -275,6 +509,45 @@ void ecs_table_replace_columns(
     ecs_world_t *world,
     ecs_table_t *table,
     ecs_table_column_t *columns);
+
+/* Increment change counters of all columns in table */
+void ecs_table_mark_changed(
+    ecs_table_t *table,
+    ecs_table_column_t *columns);
+
+/* Activate / deactivate table after rows were written to its columns */
+void ecs_table_update_active(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    uint32_t prev_count);
+
+/* Replace data in columns with data that is stored in a mapped file */
+void ecs_table_map_columns(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_table_column_t *columns,
+    void *arena,
+    size_t arena_size);
+
+/* Destruct component values stored in columns */
+void ecs_table_destruct_columns(
+    ecs_type_t type,
+    ecs_table_column_t *columns);
+
+/* Copy data of a column to a new vector, invoking copy callbacks of component */
+ecs_vector_t* ecs_table_copy_column(
+    ecs_table_column_t *column);
+
+/* Copy column data that is shared with a snapshot */
+bool ecs_table_unshare_column(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    uint32_t index);
+
+/* Copy data of all columns that is shared with a snapshot */
+void ecs_table_unshare(
+    ecs_world_t *world,
+    ecs_table_t *table);
     
 /* Merge data of one table into another table */
 void ecs_table_merge(
@@ -335,6 +608,12 @@ ecs_entity_t ecs_new_col_system(
     const char *sig,
     ecs_system_action_t action);
 
+/* Test if two column systems access the same components, with at least one of
+ * the systems writing them */
+bool ecs_col_system_conflicts(
+    EcsColSystem *system_1,
+    EcsColSystem *system_2);
+
 /* Notify column system of a new table, which initiates system-table matching */
 void ecs_col_system_notify_of_table(
     ecs_world_t *world,
@@ -379,6 +658,7 @@ int ecs_parse_signature_action(
     ecs_system_expr_elem_kind_t elem_kind,
     ecs_system_expr_oper_kind_t oper_kind,
     ecs_system_expr_inout_kind_t inout_kind,
+    bool if_changed,
     const char *component_id,
     const char *source_id,
     void *data);
@@ -388,11 +668,33 @@ void ecs_rematch_system(
     ecs_world_t *world,
     ecs_entity_t system);
 
+/* Rematch system with table that has a changed container or prefab */
+void ecs_rematch_system_w_table(
+    ecs_world_t *world,
+    ecs_entity_t system,
+    ecs_table_t *table);
+
+/* Restore depth order of system tables after rematching with tables */
+void ecs_order_system_tables(
+    ecs_world_t *world,
+    ecs_entity_t system);
+
 /* Re-resolve references of system after table realloc */
 void ecs_revalidate_system_refs(
     ecs_world_t *world,
     ecs_entity_t system);
 
+/* Copy columns the system writes to that are shared with a snapshot */
+void ecs_col_system_unshare(
+    ecs_world_t *world,
+    ecs_entity_t system);
+
+/* Mark columns the system writes to as changed, and skip tables in which the
+ * [changed] columns of the system did not change */
+void ecs_col_system_track_changes(
+    ecs_world_t *world,
+    ecs_entity_t system);
+
 void ecs_measure_frame_time(
     ecs_world_t *world,
     bool enable);
@@ -417,6 +719,11 @@ void ecs_prepare_jobs(
 void ecs_run_jobs(
     ecs_world_t *world);
 
+/* Run callback of filter job on worker threads */
+void ecs_run_filter_jobs(
+    ecs_world_t *world,
+    ecs_filter_job_t *filter_job);
+
 /* -- Os time api -- */
 
 void ecs_os_time_setup(void);
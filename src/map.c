@@ -1,262 +1,362 @@
-
 #include "flecs_private.h"
 
-#define FLECS_LOAD_FACTOR (3.0f / 4.0f)
-
-typedef struct ecs_map_node_t {
-    uint64_t key;           /* Key */
-    uint32_t next;          /* Next node index */
-    uint32_t prev;          /* Previous node index (enables O(1) removal) */
-} ecs_map_node_t;
+/* -- Map storage --
+ * The map is an open addressing hash table. Keys and values are stored in a
+ * single array of slots, and each slot has a control byte. The control byte of
+ * an occupied slot stores 7 bits of the key hash, so that a lookup can find
+ * candidate slots without loading the keys. Control bytes are tested in groups
+ * of 16, with SSE2 instructions when available.
+ *
+ * The number of groups is a prime from the group_counts table, and the first
+ * group to probe for a key is the key modulo the number of groups. If the key
+ * is not in that group, the next groups are probed linearly, wrapping around
+ * to the first group. A lookup ends at the first group that has an empty slot.
+ *
+ * Removed slots are marked as deleted unless their group has an empty slot,
+ * as a probe that reaches that group would end there anyway. Deleted slots are
+ * reused by inserts, and are cleaned up when the map is rehashed. */
+
+/* Number of control bytes tested at once */
+#define ECS_MAP_GROUP_SIZE (16)
+
+/* Control byte values of slots that are not occupied. Occupied slots store a
+ * value between 0 and 127, so both values have the top bit set. */
+#define ECS_MAP_EMPTY ((uint8_t)0x80)
+#define ECS_MAP_DELETED ((uint8_t)0xFE)
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ECS_MAP_SSE2
+#include <emmintrin.h>
+#endif
 
 struct ecs_map_t {
-    uint32_t *buckets;      /* Array of buckets */
-    ecs_vector_t *nodes;    /* Array with memory for map nodes */
-    ecs_vector_params_t node_params; /* Parameters for node vector */
-    size_t bucket_count;    /* number of buckets */
-    uint32_t count;         /* number of elements */
-    uint32_t min;           /* minimum number of elements */
+    uint8_t *ctrl;          /* Control bytes, followed by the slots */
+    uint32_t data_size;     /* Size of value */
+    uint32_t slot_size;     /* Size of key and value, aligned to 8 bytes */
+    uint32_t capacity;      /* Number of slots (0 or 16 * group_counts[i]) */
+    uint32_t count;         /* Number of elements */
+    uint32_t growth_left;   /* Empty slots that can be used before rehashing */
+    uint32_t min;           /* Minimum number of elements */
 };
 
+/* Mix bits of the key, so that keys that only differ in a few bits (entity ids,
+ * aligned pointers) are spread out over the control bytes */
 static
-size_t data_size(
-    ecs_map_t *map)
+uint64_t hash_key(
+    uint64_t key)
 {
-    return map->node_params.element_size - sizeof(ecs_map_node_t);
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    return key;
 }
 
-/** Get map node from index */
+/* Control byte for a hash, which stores the top 7 bits of the hash */
 static
-ecs_map_node_t *node_from_index(
-    ecs_map_t *map,
-    ecs_vector_t *nodes,
-    uint32_t index)
+uint8_t hash_ctrl(
+    uint64_t hash)
 {
-    return ecs_vector_get(nodes, &map->node_params, index - 1);
+    return (uint8_t)(hash >> 57);
 }
 
-/** Get a bucket for a given key */
+/* Number of elements that can be stored before the map is rehashed */
 static
-uint32_t* get_bucket(
-    ecs_map_t *map,
-    uint64_t key)
+uint32_t max_count(
+    uint32_t capacity)
 {
-    uint64_t index = key % map->bucket_count;
-    return &map->buckets[index];
+    return capacity - capacity / 8;
 }
 
-/** Callback that updates administration when node is moved in nodes array */
+/* Number of groups for each map size. The group of a key is the remainder of
+ * the key divided by the number of groups. Using the largest prime below each
+ * power of two spreads out keys that are multiples of a common stride, like
+ * pointers to elements of an array, while sequential keys such as entity ids
+ * stay in neighbouring groups. */
 static
-void move_node(
-    ecs_vector_t *array,
-    const ecs_vector_params_t *params,
-    void *to,
-    void *from,
-    void *ctx)
-{
-    ecs_map_t *map = ctx;
-    ecs_map_node_t *node_p = to;
-    uint32_t node = ecs_vector_get_index(array, &map->node_params, to) + 1;
-    uint32_t prev = node_p->prev;
-    uint32_t next = node_p->next;
-    (void)params;
-    (void)from;
-
-    if (prev) {
-        ecs_map_node_t *prev_p = node_from_index(map, array, prev);
-        prev_p->next = node;
-    } else {
-        uint32_t *bucket = get_bucket(map, node_p->key);
-        *bucket = node;
-    }
+const uint32_t group_counts[] = {
+    1, 3, 7, 13, 31, 61, 127, 251, 509, 1021, 2039, 4093, 8191, 16381, 32749,
+    65521, 131071, 262139, 524287, 1048573, 2097143, 4194301, 8388593,
+    16777213, 33554393, 67108859, 134217689, 268435399
+};
 
-    if (next) {
-        ecs_map_node_t *next_p = node_from_index(map, array, next);
-        next_p->prev = node;
+/* Smallest capacity that is larger than capacity */
+static
+uint32_t next_capacity(
+    uint32_t capacity)
+{
+    uint32_t i, count = sizeof(group_counts) / sizeof(uint32_t);
+    for (i = 0; i < count; i ++) {
+        uint32_t result = group_counts[i] * ECS_MAP_GROUP_SIZE;
+        if (result > capacity) {
+            return result;
+        }
     }
+
+    ecs_abort(ECS_OUT_OF_MEMORY, NULL);
+    return 0;
 }
 
-/** Allocate the buckets buffer */
+/* Smallest capacity that can store count elements */
 static
-void alloc_buffer(
-    ecs_map_t *map,
-    uint32_t bucket_count)
+uint32_t capacity_for(
+    uint32_t count)
 {
-    if (bucket_count) {
-        map->buckets = ecs_os_calloc(bucket_count * sizeof(uint32_t), 1);
-        ecs_assert(map->buckets != NULL, ECS_OUT_OF_MEMORY, 0);
-    } else {
-        map->buckets = NULL;
+    if (!count) {
+        return 0;
     }
 
-    map->bucket_count = bucket_count;
+    uint32_t capacity = next_capacity(0);
+    while (max_count(capacity) < count) {
+        capacity = next_capacity(capacity);
+    }
+
+    return capacity;
 }
 
-/** Allocate a map object */
 static
-ecs_map_t *alloc_map(
-    uint32_t bucket_count,
-    uint32_t data_size)
+uint32_t first_group(
+    uint64_t key,
+    uint32_t group_count)
 {
-    ecs_map_t *result = ecs_os_malloc(sizeof(ecs_map_t));
-    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+    return (uint32_t)(key % group_count);
+}
 
-    alloc_buffer(result, bucket_count);
-    result->count = 0;
-    result->min = bucket_count;
-    result->node_params = (ecs_vector_params_t){
-        .element_size = data_size + sizeof(ecs_map_node_t),
-        .move_action = move_node
-    };
+static
+uint32_t next_group(
+    uint32_t group,
+    uint32_t group_count)
+{
+    group ++;
+    return group == group_count ? 0 : group;
+}
 
-    result->nodes = ecs_vector_new(&result->node_params, ECS_MAP_INITIAL_NODE_COUNT);
-    
+static
+uint32_t lowest_bit(
+    uint32_t mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    uint32_t index = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        index ++;
+    }
+    return index;
+#endif
+}
+
+/* Bitmask of control bytes in group that are equal to value */
+static
+uint32_t group_match(
+    const uint8_t *group,
+    uint8_t value)
+{
+#ifdef ECS_MAP_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)value)));
+#else
+    uint32_t i, result = 0;
+    for (i = 0; i < ECS_MAP_GROUP_SIZE; i ++) {
+        result |= (uint32_t)(group[i] == value) << i;
+    }
     return result;
+#endif
 }
 
-/** Find next non-empty bucket */
+/* Bitmask of control bytes in group that are empty or deleted */
 static
-uint32_t next_bucket(
-    ecs_map_t *map,
-    uint32_t start_index)
-{
-    size_t i;
-    for (i = start_index; i < map->bucket_count; i ++) {
-        if (map->buckets[i]) {
-            break;
-        }
+uint32_t group_match_free(
+    const uint8_t *group)
+{
+#ifdef ECS_MAP_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(ctrl);
+#else
+    uint32_t i, result = 0;
+    for (i = 0; i < ECS_MAP_GROUP_SIZE; i ++) {
+        result |= (uint32_t)(group[i] >> 7) << i;
     }
+    return result;
+#endif
+}
 
-    return i;
+static
+uint64_t* get_slot(
+    ecs_map_t *map,
+    uint32_t index)
+{
+    return ECS_OFFSET(map->ctrl, map->capacity + index * map->slot_size);
 }
 
 static
-void *get_node_data(
-    ecs_map_node_t *node)
+void* get_slot_data(
+    uint64_t *slot)
 {
-    return ECS_OFFSET(node, sizeof(ecs_map_node_t));
+    return ECS_OFFSET(slot, sizeof(uint64_t));
 }
 
 static
-void set_node_data(
+void set_slot_data(
     ecs_map_t *map,
-    ecs_map_node_t *node,
+    uint64_t *slot,
     const void *data)
 {
-    void *node_data = get_node_data(node);
-    if (data != node_data) { 
+    void *slot_data = get_slot_data(slot);
+    if (data != slot_data) {
         if (data) {
-            memcpy(node_data, data, data_size(map));
+            memcpy(slot_data, data, map->data_size);
         } else {
-            memset(node_data, 0, data_size(map));
+            memset(slot_data, 0, map->data_size);
         }
     }
 }
 
-/** Add new node to bucket */
+/** Find slot index of key, or -1 if the key is not in the map. If free_out is
+ * provided, it is set to the slot where find_free_slot would insert the key,
+ * or -1 if the probed groups have no free slots. */
 static
-void* add_node(
+int32_t find_slot(
     ecs_map_t *map,
-    uint32_t *bucket,
     uint64_t key,
-    const void *data,
-    ecs_map_node_t *elem_p)
+    uint64_t hash,
+    int32_t *free_out)
 {
-    uint32_t elem;
+    uint32_t group_count = map->capacity / ECS_MAP_GROUP_SIZE;
+    uint32_t group = first_group(key, group_count);
+    uint8_t ctrl = hash_ctrl(hash);
+    uint32_t i;
 
-    if (!elem_p) {
-        elem_p = ecs_vector_add(&map->nodes, &map->node_params);
-        elem = ecs_vector_count(map->nodes);
-    } else {
-        elem = ecs_vector_get_index(
-            map->nodes,
-            &map->node_params,
-            elem_p) + 1;
+    if (free_out) {
+        *free_out = -1;
     }
 
-    elem_p->key = key;
-    elem_p->next = 0;
-    elem_p->prev = 0;
-    set_node_data(map, elem_p, data);
+    for (i = 0; i < group_count; i ++) {
+        uint32_t offset = group * ECS_MAP_GROUP_SIZE;
+        const uint8_t *group_ctrl = &map->ctrl[offset];
+        uint32_t match = group_match(group_ctrl, ctrl);
 
-    uint32_t first = *bucket;
-    if (first) {
-        ecs_map_node_t *first_p = node_from_index(map, map->nodes, first);
-        first_p->prev = elem;
-        elem_p->next = first;
-    }
+        while (match) {
+            uint32_t index = offset + lowest_bit(match);
+            if (*get_slot(map, index) == key) {
+                return index;
+            }
+            match &= match - 1;
+        }
 
-    *bucket = elem;
+        if (free_out && *free_out == -1) {
+            uint32_t free_match = group_match_free(group_ctrl);
+            if (free_match) {
+                *free_out = offset + lowest_bit(free_match);
+            }
+        }
 
-    map->count ++;
+        if (group_match(group_ctrl, ECS_MAP_EMPTY)) {
+            break;
+        }
+
+        group = next_group(group, group_count);
+    }
 
-    return elem_p;
+    return -1;
 }
 
-/** Get map node for a given key */
+/** Find slot for a new key. The map must have an empty slot. */
 static
-ecs_map_node_t *get_node(
+uint32_t find_free_slot(
     ecs_map_t *map,
-    uint32_t *bucket,
     uint64_t key)
 {
-    uint32_t node = *bucket;
-
-    while (node) {
-        ecs_map_node_t *node_p = node_from_index(map, map->nodes, node);
+    uint32_t group_count = map->capacity / ECS_MAP_GROUP_SIZE;
+    uint32_t group = first_group(key, group_count);
+    uint32_t i;
 
-        if (node_p->prev) {
-            assert(node_from_index(map, map->nodes, node_p->prev)->next == node);
-        }
-        if (node_p->next) {
-            assert(node_from_index(map, map->nodes, node_p->next)->prev == node);
+    for (i = 0; i < group_count; i ++) {
+        uint32_t offset = group * ECS_MAP_GROUP_SIZE;
+        uint32_t match = group_match_free(&map->ctrl[offset]);
+        if (match) {
+            return offset + lowest_bit(match);
         }
 
-        if (node_p->key == key) {
-            return node_p;
-        }
-        node = node_p->next;
+        group = next_group(group, group_count);
     }
 
-    return NULL;
+    ecs_abort(ECS_INTERNAL_ERROR, NULL);
+    return 0;
 }
 
-/** Resize number of buckets in a map */
+/** Allocate slots for a capacity, all slots are empty */
 static
-void resize_map(
+void alloc_slots(
     ecs_map_t *map,
-    uint32_t bucket_count)
+    uint32_t capacity)
 {
-    ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
+    if (capacity) {
+        map->ctrl = ecs_os_malloc((size_t)capacity * (1 + map->slot_size));
+        ecs_assert(map->ctrl != NULL, ECS_OUT_OF_MEMORY, NULL);
+        memset(map->ctrl, ECS_MAP_EMPTY, capacity);
+    } else {
+        map->ctrl = NULL;
+    }
 
-    uint32_t *old_buckets = map->buckets;
-    uint32_t old_bucket_count = map->bucket_count;
+    map->capacity = capacity;
+    map->growth_left = max_count(capacity);
+}
 
-    alloc_buffer(map, bucket_count);
-    map->count = 0;
+/** Move elements to slots with a new capacity, which drops deleted slots */
+static
+void rehash(
+    ecs_map_t *map,
+    uint32_t capacity)
+{
+    uint8_t *old_ctrl = map->ctrl;
+    uint32_t old_capacity = map->capacity;
+    uint32_t i;
+
+    ecs_assert(max_count(capacity) >= map->count, ECS_INTERNAL_ERROR, NULL);
+
+    alloc_slots(map, capacity);
+    map->growth_left -= map->count;
 
-    uint32_t bucket_index;
-    for (bucket_index = 0; bucket_index < old_bucket_count; bucket_index ++) {
-        uint32_t bucket = old_buckets[bucket_index];
-        if (bucket) {
-            uint32_t node = bucket;
-            uint32_t next;
-            uint64_t key;
-
-            ecs_map_node_t *node_p;
-            do {
-                node_p = node_from_index(map, map->nodes, node);
-                next = node_p->next;
-                key = node_p->key;
-                uint32_t *new_bucket = get_bucket(map, key);
-                add_node(map, new_bucket, key, get_node_data(node_p), node_p);
-            } while ((node = next));
+    for (i = 0; i < old_capacity; i ++) {
+        if (old_ctrl[i] & ECS_MAP_EMPTY) {
+            continue;
         }
+
+        uint64_t *old_slot = ECS_OFFSET(
+            old_ctrl, old_capacity + i * map->slot_size);
+        uint64_t hash = hash_key(*old_slot);
+        uint32_t index = find_free_slot(map, *old_slot);
+
+        map->ctrl[index] = hash_ctrl(hash);
+        memcpy(get_slot(map, index), old_slot, map->slot_size);
     }
 
-    ecs_os_free(old_buckets);
+    ecs_os_free(old_ctrl);
 }
 
+/** Make room for one element. If more than half of the slots that can be used
+ * are occupied the map grows, otherwise only deleted slots are cleaned up. */
+static
+void reserve_slot(
+    ecs_map_t *map)
+{
+    if (map->growth_left) {
+        return;
+    }
+
+    uint32_t capacity = map->capacity;
+    if (!capacity || map->count >= max_count(capacity) / 2) {
+        capacity = next_capacity(capacity);
+    }
+
+    rehash(map, capacity);
+}
 
 /* -- Public functions -- */
 
@@ -267,7 +367,19 @@ ecs_map_t* ecs_map_new(
     if (!data_size) {
         data_size = sizeof(uint64_t);
     }
-    return alloc_map((float)size / FLECS_LOAD_FACTOR, data_size);
+
+    ecs_map_t *result = ecs_os_malloc(sizeof(ecs_map_t));
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    result->data_size = data_size;
+    result->slot_size = sizeof(uint64_t) +
+        ((data_size - 1) / sizeof(uint64_t) + 1) * sizeof(uint64_t);
+    result->count = 0;
+    result->min = size;
+
+    alloc_slots(result, capacity_for(size));
+
+    return result;
 }
 
 void ecs_map_clear(
@@ -275,21 +387,21 @@ void ecs_map_clear(
 {
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
 
-    uint32_t target_size = (float)map->count / FLECS_LOAD_FACTOR;
-
-    if (target_size < map->min) {
-        target_size = map->min;
+    /* Keep enough slots for the elements that were in the map */
+    uint32_t count = map->count;
+    if (count < map->min) {
+        count = map->min;
     }
 
-    if (target_size < (float)map->bucket_count * 0.75) {
-        ecs_os_free(map->buckets);
-        alloc_buffer(map, target_size);
-    } else {
-        memset(map->buckets, 0, sizeof(int32_t) * map->bucket_count);
-    }
+    uint32_t capacity = capacity_for(count);
 
-    ecs_vector_reclaim(&map->nodes, &map->node_params);
-    ecs_vector_clear(map->nodes);
+    if (capacity < map->capacity) {
+        ecs_os_free(map->ctrl);
+        alloc_slots(map, capacity);
+    } else if (map->capacity) {
+        memset(map->ctrl, ECS_MAP_EMPTY, map->capacity);
+        map->growth_left = max_count(map->capacity);
+    }
 
     map->count = 0;
 }
@@ -297,8 +409,7 @@ void ecs_map_clear(
 void ecs_map_free(
     ecs_map_t *map)
 {
-    ecs_vector_free(map->nodes);
-    ecs_os_free(map->buckets);
+    ecs_os_free(map->ctrl);
     ecs_os_free(map);
 }
 
@@ -313,33 +424,39 @@ void* _ecs_map_set(
     (void)size;
     ecs_assert(ecs_map_data_size(map) == size, ECS_INVALID_PARAMETER, NULL);
 
-    uint32_t bucket_count = map->bucket_count;
-    if (!bucket_count) {
-        alloc_buffer(map, 2);
-        bucket_count = map->bucket_count;
-    }
+    uint64_t hash = hash_key(key);
+    int32_t index = -1;
+    uint64_t *slot;
 
-    if ((((float)map->count) / (float)bucket_count) > FLECS_LOAD_FACTOR) {
-        resize_map(map, bucket_count * 2);
+    if (map->count) {
+        int32_t existing = find_slot(map, key, hash, &index);
+        if (existing != -1) {
+            slot = get_slot(map, existing);
+            set_slot_data(map, slot, data);
+            return get_slot_data(slot);
+        }
     }
 
-    uint32_t *bucket = get_bucket(map, key);
-    ecs_map_node_t *node = NULL;
+    /* A deleted slot can be reused without rehashing */
+    if (index == -1 ||
+        (!map->growth_left && map->ctrl[index] != ECS_MAP_DELETED))
+    {
+        reserve_slot(map);
+        index = find_free_slot(map, key);
+    }
 
-    if (!*bucket) {
-        node = add_node(map, bucket, key, data, NULL);
-    } else {
-        node = get_node(map, bucket, key);
-        if (node) {
-            set_node_data(map, node, data);
-        } else {
-            node = add_node(map, bucket, key, data, NULL);
-        }
+    if (map->ctrl[index] == ECS_MAP_EMPTY) {
+        map->growth_left --;
     }
 
-    ecs_assert(node != NULL, ECS_INTERNAL_ERROR, NULL);
+    map->ctrl[index] = hash_ctrl(hash);
+    map->count ++;
+
+    slot = get_slot(map, index);
+    *slot = key;
+    set_slot_data(map, slot, data);
 
-    return get_node_data(node);
+    return get_slot_data(slot);
 }
 
 int ecs_map_remove(
@@ -350,37 +467,22 @@ int ecs_map_remove(
         return -1;
     }
 
-    uint32_t *bucket = get_bucket(map, key);
-
-    if (*bucket) {
-        ecs_map_node_t *node = get_node(map, bucket, key);
-        if (node) {
-            ecs_map_node_t *prev_node = node_from_index(map, map->nodes, node->prev);
-            ecs_map_node_t *next_node = node_from_index(map, map->nodes, node->next);
-
-            if (prev_node) {
-                assert(node_from_index(map, map->nodes, prev_node->next) == node);
-                prev_node->next = node->next;
-            } else {
-                *bucket = node->next;
-            }
-
-            if (next_node) {
-                assert(node_from_index(map, map->nodes, next_node->prev) == node);
-                next_node->prev = node->prev;
-            }
-
-            ecs_vector_params_t params = map->node_params;
-            params.move_ctx = map;
-
-            ecs_vector_remove(map->nodes, &params, node);
-            map->count --;
+    int32_t index = find_slot(map, key, hash_key(key), NULL);
+    if (index == -1) {
+        return -1;
+    }
 
-            return 0;
-        }
+    uint32_t offset = index & ~(ECS_MAP_GROUP_SIZE - 1);
+    if (group_match(&map->ctrl[offset], ECS_MAP_EMPTY)) {
+        map->ctrl[index] = ECS_MAP_EMPTY;
+        map->growth_left ++;
+    } else {
+        map->ctrl[index] = ECS_MAP_DELETED;
     }
 
-    return -1;
+    map->count --;
+
+    return 0;
 }
 
 void* ecs_map_get_ptr(
@@ -388,18 +490,15 @@ void* ecs_map_get_ptr(
     uint64_t key)
 {
     if (!map->count) {
-        return 0;
+        return NULL;
     }
 
-    uint32_t *bucket = get_bucket(map, key);
-    if (*bucket) {
-        ecs_map_node_t *elem = get_node(map, bucket, key);
-        if (elem) {
-            return get_node_data(elem);
-        }
+    int32_t index = find_slot(map, key, hash_key(key), NULL);
+    if (index == -1) {
+        return NULL;
     }
 
-    return 0;
+    return get_slot_data(get_slot(map, index));
 }
 
 bool _ecs_map_has(
@@ -413,25 +512,23 @@ bool _ecs_map_has(
     if (!map) {
         return false;
     }
-    
+
     if (!map->count) {
         return false;
     }
 
-    ecs_assert(!value_out || (ecs_map_data_size(map) == size), ECS_INVALID_PARAMETER, NULL); 
+    ecs_assert(!value_out || (ecs_map_data_size(map) == size), ECS_INVALID_PARAMETER, NULL);
 
-    uint32_t *bucket = get_bucket(map, key_hash);
-    if (*bucket) {
-        ecs_map_node_t *elem = get_node(map, bucket, key_hash);
-        if (elem) {
-            if (value_out) {
-                memcpy(value_out, get_node_data(elem), data_size(map));
-            }
-            return true;
-        }
+    int32_t index = find_slot(map, key_hash, hash_key(key_hash), NULL);
+    if (index == -1) {
+        return false;
     }
 
-    return false;
+    if (value_out) {
+        memcpy(value_out, get_slot_data(get_slot(map, index)), map->data_size);
+    }
+
+    return true;
 }
 
 uint32_t ecs_map_count(
@@ -443,23 +540,26 @@ uint32_t ecs_map_count(
 uint32_t ecs_map_bucket_count(
     ecs_map_t *map)
 {
-    return map->bucket_count;
+    return map->capacity;
 }
 
 uint32_t ecs_map_set_size(
     ecs_map_t *map,
     uint32_t size)
 {
-    uint32_t result = ecs_vector_set_size(&map->nodes, &map->node_params, size);
-    resize_map(map, size / FLECS_LOAD_FACTOR);
-    return result;
+    uint32_t capacity = capacity_for(size);
+    if (capacity > map->capacity) {
+        rehash(map, capacity);
+    }
+
+    return max_count(map->capacity);
 }
 
 uint32_t ecs_map_grow(
     ecs_map_t *map,
     uint32_t size)
 {
-    if (size > ecs_vector_size(map->nodes)) {
+    if (size > map->count + map->growth_left) {
         return ecs_map_set_size(map, size);
     }
 
@@ -476,13 +576,11 @@ void ecs_map_memory(
     }
 
     if (total) {
-        *total += map->bucket_count * sizeof(uint32_t) + sizeof(ecs_map_t);
-        ecs_vector_memory(map->nodes, &map->node_params, total, NULL);
+        *total += sizeof(ecs_map_t) + map->capacity * (1 + map->slot_size);
     }
 
     if (used) {
-        *used += map->count * sizeof(uint32_t);
-        ecs_vector_memory(map->nodes, &map->node_params, NULL, used);
+        *used += map->count * (1 + map->slot_size);
     }
 }
 
@@ -490,10 +588,10 @@ ecs_map_t* ecs_map_copy(
     const ecs_map_t *map)
 {
     ecs_map_t *dst = ecs_os_memdup(map, sizeof(ecs_map_t));
-    dst->buckets = ecs_os_memdup(
-        map->buckets, map->bucket_count * sizeof(uint32_t));
-    
-    dst->nodes = ecs_vector_copy(map->nodes, &map->node_params);
+    if (map->capacity) {
+        dst->ctrl = ecs_os_memdup(
+            map->ctrl, (size_t)map->capacity * (1 + map->slot_size));
+    }
 
     return dst;
 }
@@ -503,8 +601,7 @@ ecs_map_iter_t ecs_map_iter(
 {
     ecs_map_iter_t result = {
         .map = map,
-        .bucket_index = -1,
-        .node = 0
+        .index = -1
     };
 
     return result;
@@ -518,34 +615,17 @@ bool ecs_map_hasnext(
         return false;
     }
 
-    if (!map->buckets) {
-        return false;
-    }
-
-    uint32_t bucket_index = iter_data->bucket_index;
-    uint32_t node = iter_data->node;
-
-    if (node) {
-        ecs_map_node_t *node_p = node_from_index(map, map->nodes, node);
-        node = node_p->next;
-    }
-
-    if (!node) {
-        bucket_index = next_bucket(map, bucket_index + 1);
-        if (bucket_index < map->bucket_count) {
-            node = map->buckets[bucket_index];
-        } else {
-            node = 0;
+    uint32_t i, capacity = map->capacity;
+    for (i = iter_data->index + 1; i < capacity; i ++) {
+        if (!(map->ctrl[i] & ECS_MAP_EMPTY)) {
+            iter_data->index = i;
+            return true;
         }
     }
 
-    if (node) {
-        iter_data->node = node;
-        iter_data->bucket_index = bucket_index;
-        return true;
-    } else {
-        return false;
-    }
+    iter_data->index = capacity;
+
+    return false;
 }
 
 void* ecs_map_next_w_key_w_size(
@@ -556,12 +636,12 @@ void* ecs_map_next_w_key_w_size(
     (void)size;
 
     ecs_map_t *map = iter_data->map;
-    ecs_assert(!size || data_size(map) == size, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(!size || map->data_size == size, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(iter_data->index < map->capacity, ECS_INVALID_PARAMETER, NULL);
 
-    ecs_map_node_t *node_p = node_from_index(map, map->nodes, iter_data->node);
-    assert(node_p != NULL);
-    if (key_out) *key_out = node_p->key;
-    return get_node_data(node_p);
+    uint64_t *slot = get_slot(map, iter_data->index);
+    if (key_out) *key_out = *slot;
+    return get_slot_data(slot);
 }
 
 void* ecs_map_next_w_key(
@@ -587,5 +667,5 @@ void* ecs_map_next_w_size(
 uint32_t ecs_map_data_size(
     ecs_map_t *map)
 {
-    return data_size(map);
+    return map->data_size;
 }
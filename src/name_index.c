@@ -0,0 +1,397 @@
+#include "flecs_private.h"
+
+/* -- Name index --
+ * The name index maps (parent, name) pairs to entities. An entity is added to
+ * the index when its name is set, once with parent 0 and once for each of its
+ * containers. When an entity loses its name because it is deleted, renamed or
+ * because EcsId is removed, its entries are removed from the index, and empty
+ * buckets are freed. Entries can still become stale when an entity is adopted
+ * by another parent, so each entry is validated against the current name and
+ * type of the entity when it is looked up. Buckets with stale entries are
+ * compacted each time they grow to a power of two, which keeps the cost of
+ * adding entries amortized O(1).
+ *
+ * Entries with a parent other than 0 only speed up lookups. If a lookup with a
+ * parent does not find an entry, it falls back to the entries of the name with
+ * parent 0, which are always complete, and caches the result. */
+
+typedef struct ecs_name_entry_t {
+    ecs_entity_t entity;
+    ecs_entity_t parent;
+} ecs_name_entry_t;
+
+static
+const ecs_vector_params_t name_entry_arr_params = {
+    .element_size = sizeof(ecs_name_entry_t)
+};
+
+/* Minimum bucket size before stale entries are removed */
+#define ECS_NAME_INDEX_COMPACT (16)
+
+/* FNV-1a hash of the name, combined with the parent. ecs_hash is not used as
+ * it reads the key in words, which can read past the end of the string. */
+static
+uint64_t name_key(
+    ecs_entity_t parent,
+    const char *name)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    const char *ptr;
+
+    for (ptr = name; *ptr; ptr ++) {
+        hash ^= (uint8_t)*ptr;
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash ^ (parent * 0x9E3779B97F4A7C15ull);
+}
+
+/* Get current name and type of entity in main stage */
+static
+const char* entity_name(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_type_t *type_out)
+{
+    ecs_entity_info_t info = {.entity = entity};
+    EcsId *id = ecs_get_ptr_intern(
+        world, &world->main_stage, &info, EEcsId, false, false);
+
+    if (!id) {
+        return NULL;
+    }
+
+    *type_out = info.type;
+    return *id;
+}
+
+static
+bool entry_matches(
+    ecs_world_t *world,
+    ecs_name_entry_t *entry,
+    ecs_entity_t parent,
+    const char *name)
+{
+    if (entry->parent != parent) {
+        return false;
+    }
+
+    ecs_type_t type = NULL;
+    const char *entity_id = entity_name(world, entry->entity, &type);
+    if (!entity_id || strcmp(entity_id, name)) {
+        return false;
+    }
+
+    /* Same test as ecs_lookup_child_in_columns, which also matches entities
+     * that have the parent as component */
+    if (parent && ecs_type_index_of(type, parent) == -1) {
+        return false;
+    }
+
+    return true;
+}
+
+static
+int compare_entry(
+    const void *p1,
+    const void *p2)
+{
+    const ecs_name_entry_t *e1 = p1, *e2 = p2;
+    if (e1->entity != e2->entity) {
+        return (e1->entity > e2->entity) - (e1->entity < e2->entity);
+    }
+
+    return (e1->parent > e2->parent) - (e1->parent < e2->parent);
+}
+
+/* Remove entries for entities that no longer have the name and parent for
+ * which they were added, and remove duplicate entries */
+static
+void compact_bucket(
+    ecs_world_t *world,
+    uint64_t key,
+    ecs_vector_t **bucket)
+{
+    ecs_name_entry_t *array = ecs_vector_first(*bucket);
+    uint32_t i, count = ecs_vector_count(*bucket), valid = 0;
+
+    for (i = 0; i < count; i ++) {
+        ecs_name_entry_t *entry = &array[i];
+        ecs_type_t type = NULL;
+        const char *name = entity_name(world, entry->entity, &type);
+
+        if (!name || name_key(entry->parent, name) != key) {
+            continue;
+        }
+
+        if (entry->parent && ecs_type_index_of(type, entry->parent) == -1) {
+            continue;
+        }
+
+        array[valid ++] = *entry;
+    }
+
+    qsort(array, valid, sizeof(ecs_name_entry_t), compare_entry);
+
+    count = valid;
+    valid = 0;
+    for (i = 0; i < count; i ++) {
+        if (!valid || compare_entry(&array[valid - 1], &array[i])) {
+            array[valid ++] = array[i];
+        }
+    }
+
+    ecs_vector_set_count(bucket, &name_entry_arr_params, valid);
+}
+
+static
+void add_entry(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_entity_t parent,
+    const char *name)
+{
+    uint64_t key = name_key(parent, name);
+    ecs_vector_t *bucket = NULL;
+    ecs_map_has(world->name_index, key, &bucket);
+
+    uint32_t count = ecs_vector_count(bucket);
+    if (count) {
+        /* Don't add entity twice when the same name is set repeatedly */
+        ecs_name_entry_t *last = ecs_vector_last(bucket, &name_entry_arr_params);
+        if (last->entity == entity && last->parent == parent) {
+            return;
+        }
+
+        if (count >= ECS_NAME_INDEX_COMPACT && !(count & (count - 1))) {
+            compact_bucket(world, key, &bucket);
+        }
+    }
+
+    ecs_name_entry_t *elem = ecs_vector_add(&bucket, &name_entry_arr_params);
+    elem->entity = entity;
+    elem->parent = parent;
+    ecs_map_set(world->name_index, key, &bucket);
+}
+
+/* Remove entries of entity with parent from bucket of name. The bucket is
+ * freed when no entries are left. */
+static
+void remove_entry(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_entity_t parent,
+    const char *name)
+{
+    uint64_t key = name_key(parent, name);
+    ecs_vector_t *bucket = NULL;
+    if (!ecs_map_has(world->name_index, key, &bucket)) {
+        return;
+    }
+
+    ecs_name_entry_t *array = ecs_vector_first(bucket);
+    uint32_t i, count = ecs_vector_count(bucket), valid = 0;
+
+    for (i = 0; i < count; i ++) {
+        if (array[i].entity != entity || array[i].parent != parent) {
+            array[valid ++] = array[i];
+        }
+    }
+
+    if (valid == count) {
+        return;
+    }
+
+    if (valid) {
+        ecs_vector_set_count(&bucket, &name_entry_arr_params, valid);
+    } else {
+        ecs_vector_free(bucket);
+        ecs_map_remove(world->name_index, key);
+    }
+}
+
+static
+void index_name(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_type_t type,
+    const char *name)
+{
+    add_entry(world, entity, 0, name);
+
+    /* Containers are stored at the end of the type, after the components */
+    ecs_entity_t *array = ecs_vector_first(type);
+    int32_t i;
+
+    for (i = ecs_vector_count(type) - 1; i >= 0; i --) {
+        ecs_entity_t e = array[i];
+        if (e & ECS_CHILDOF) {
+            add_entry(world, entity, e & ECS_ENTITY_MASK, name);
+        } else if (!(e & ECS_INSTANCEOF)) {
+            break;
+        }
+    }
+}
+
+static
+void rebuild_index(
+    ecs_world_t *world)
+{
+    ecs_map_iter_t it = ecs_map_iter(world->name_index);
+    while (ecs_map_hasnext(&it)) {
+        ecs_vector_t *bucket = ecs_map_nextptr(&it);
+        ecs_vector_free(bucket);
+    }
+
+    ecs_map_clear(world->name_index);
+
+    ecs_chunked_t *tables = world->main_stage.tables;
+    uint32_t t, count = ecs_chunked_count(tables);
+
+    for (t = 0; t < count; t ++) {
+        ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, t);
+        int16_t column = ecs_type_index_of(table->type, EEcsId);
+        if (column == -1 || !table->columns) {
+            continue;
+        }
+
+        ecs_entity_t *entities = ecs_vector_first(table->columns[0].data);
+        EcsId *names = ecs_vector_first(table->columns[column + 1].data);
+        uint32_t i, row_count = ecs_vector_count(table->columns[0].data);
+
+        for (i = 0; i < row_count; i ++) {
+            if (names[i]) {
+                index_name(world, entities[i], table->type, names[i]);
+            }
+        }
+    }
+
+    world->should_index_names = false;
+}
+
+void ecs_name_index_add(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_entity_t entity,
+    const char *name)
+{
+    /* Names set in a stage are added when the stage is merged */
+    if (stage != &world->main_stage || !name || world->should_index_names) {
+        return;
+    }
+
+    ecs_row_t *row = ecs_ei_get(world->main_stage.entity_index, entity);
+    index_name(world, entity, row ? row->type : NULL, name);
+}
+
+void ecs_name_index_remove(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_entity_t entity,
+    ecs_type_t type,
+    const char *name)
+{
+    if (stage != &world->main_stage || !name || world->should_index_names) {
+        return;
+    }
+
+    remove_entry(world, entity, 0, name);
+
+    /* Entries with a parent are added for containers, and for any entity in
+     * the type that a lookup used as parent */
+    ecs_entity_t *array = ecs_vector_first(type);
+    uint32_t i, count = ecs_vector_count(type);
+
+    for (i = 0; i < count; i ++) {
+        remove_entry(world, entity, array[i] & ECS_ENTITY_MASK, name);
+    }
+}
+
+void ecs_name_index_remove_table(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    int16_t column = ecs_type_index_of(table->type, EEcsId);
+    if (column == -1 || !table->columns || world->should_index_names) {
+        return;
+    }
+
+    ecs_entity_t *entities = ecs_vector_first(table->columns[0].data);
+    EcsId *names = ecs_vector_first(table->columns[column + 1].data);
+    uint32_t i, count = ecs_vector_count(table->columns[0].data);
+
+    for (i = 0; i < count; i ++) {
+        ecs_name_index_remove(
+            world, &world->main_stage, entities[i], table->type, names[i]);
+    }
+}
+
+void ecs_name_index_invalidate(
+    ecs_world_t *world)
+{
+    world->should_index_names = true;
+}
+
+bool ecs_name_index_ready(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    if (world->should_index_names) {
+        /* The index can only be rebuilt when no other threads are reading */
+        if (stage != &world->main_stage) {
+            return false;
+        }
+
+        rebuild_index(world);
+    }
+
+    return true;
+}
+
+ecs_entity_t ecs_name_index_lookup(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_entity_t parent,
+    const char *name)
+{
+    ecs_vector_t *bucket = NULL;
+    ecs_name_entry_t *array;
+    uint32_t i, count;
+
+    if (ecs_map_has(world->name_index, name_key(parent, name), &bucket)) {
+        array = ecs_vector_first(bucket);
+        count = ecs_vector_count(bucket);
+
+        for (i = 0; i < count; i ++) {
+            if (entry_matches(world, &array[i], parent, name)) {
+                return array[i].entity;
+            }
+        }
+    }
+
+    if (!parent) {
+        return 0;
+    }
+
+    /* Entity was named before it was added to the parent, or the parent is a
+     * component. Find it in the entries without parent. */
+    if (!ecs_map_has(world->name_index, name_key(0, name), &bucket)) {
+        return 0;
+    }
+
+    array = ecs_vector_first(bucket);
+    count = ecs_vector_count(bucket);
+
+    for (i = 0; i < count; i ++) {
+        ecs_name_entry_t entry = {.entity = array[i].entity, .parent = parent};
+        if (array[i].parent == 0 && entry_matches(world, &entry, parent, name)) {
+            if (stage == &world->main_stage) {
+                add_entry(world, entry.entity, parent, name);
+            }
+
+            return entry.entity;
+        }
+    }
+
+    return 0;
+}
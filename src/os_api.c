@@ -232,25 +232,131 @@ void ecs_os_gettime(ecs_time_t *timeOut)
     timeOut->nanosec = now - timeOut->sec * 1000000000;
 }
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+static
+int32_t ecs_os_api_ainc(int32_t *value) {
+    return _InterlockedIncrement((volatile long*)value);
+}
+
+static
+int32_t ecs_os_api_adec(int32_t *value) {
+    return _InterlockedDecrement((volatile long*)value);
+}
+
+/* Interlocked operations are full barriers, so a no-op read-modify-write is
+ * used as a load with acquire semantics */
+static
+int32_t ecs_os_api_aload(int32_t *value) {
+    return _InterlockedOr((volatile long*)value, 0);
+}
+
+#if defined(_M_IX86)
+/* 32 bit MSVC has no _InterlockedExchangeAdd64, use a compare-exchange loop */
+static
+uint64_t ecs_os_api_aadd64(uint64_t *value, int64_t add) {
+    __int64 old_value, new_value;
+    do {
+        old_value = *(volatile __int64*)value;
+        new_value = old_value + add;
+    } while (_InterlockedCompareExchange64(
+        (volatile __int64*)value, new_value, old_value) != old_value);
+    return (uint64_t)new_value;
+}
+#else
+static
+uint64_t ecs_os_api_aadd64(uint64_t *value, int64_t add) {
+    return (uint64_t)_InterlockedExchangeAdd64((volatile __int64*)value, add) + 
+        (uint64_t)add;
+}
+#endif
+#else
+static
+int32_t ecs_os_api_ainc(int32_t *value) {
+    return __sync_add_and_fetch(value, 1);
+}
+
+static
+int32_t ecs_os_api_adec(int32_t *value) {
+    return __sync_sub_and_fetch(value, 1);
+}
+
+static
+uint64_t ecs_os_api_aadd64(uint64_t *value, int64_t add) {
+    return __sync_add_and_fetch(value, (uint64_t)add);
+}
+
+static
+int32_t ecs_os_api_aload(int32_t *value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static
+void* ecs_os_api_map_file(
+    const char *filename,
+    size_t *size_out)
+{
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        return NULL;
+    }
+
+    void *result = NULL;
+    struct stat st;
+
+    if (!fstat(fd, &st) && st.st_size) {
+        /* Map private, so that pages are copied when they are written to */
+        result = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, 
+            fd, 0);
+        if (result == MAP_FAILED) {
+            result = NULL;
+        } else {
+            *size_out = st.st_size;
+        }
+    }
+
+    /* The mapping remains valid after the file is closed */
+    close(fd);
+
+    return result;
+}
+
+static
+void ecs_os_api_unmap_file(
+    void *data,
+    size_t size)
+{
+    munmap(data, size);
+}
+#endif
+
 static
 void* ecs_os_api_malloc(size_t size) {
-    ecs_os_api_malloc_count ++;
+    ecs_os_aadd64(&ecs_os_api_malloc_count, 1);
     return malloc(size);
 }
 
 static
 void* ecs_os_api_calloc(size_t num, size_t size) {
-    ecs_os_api_calloc_count ++;
+    ecs_os_aadd64(&ecs_os_api_calloc_count, 1);
     return calloc(num, size);
 }
 
 static
 void* ecs_os_api_realloc(void *ptr, size_t size) {
     if (ptr) {
-        ecs_os_api_realloc_count ++;
+        ecs_os_aadd64(&ecs_os_api_realloc_count, 1);
     } else {
         /* If not actually reallocing, treat as malloc */
-        ecs_os_api_malloc_count ++; 
+        ecs_os_aadd64(&ecs_os_api_malloc_count, 1);
     }
     return realloc(ptr, size);
 }
@@ -258,11 +364,39 @@ void* ecs_os_api_realloc(void *ptr, size_t size) {
 static
 void ecs_os_api_free(void *ptr) {
     if (ptr) {
-        ecs_os_api_free_count ++;
+        ecs_os_aadd64(&ecs_os_api_free_count, 1);
     }
     free(ptr);
 }
 
+/* Aligned memory is allocated with the malloc function of the OS API, so that
+ * it is counted and passes through a custom malloc. The pointer returned by
+ * malloc is stored in front of the aligned memory. */
+static
+void* ecs_os_api_aligned_alloc(size_t alignment, size_t size) {
+    ecs_assert(alignment && !(alignment & (alignment - 1)), 
+        ECS_INVALID_PARAMETER, NULL);
+
+    void *ptr = ecs_os_api.malloc(size + alignment - 1 + sizeof(void*));
+    if (!ptr) {
+        return NULL;
+    }
+
+    uintptr_t result = ((uintptr_t)ptr + sizeof(void*) + alignment - 1) & 
+        ~(uintptr_t)(alignment - 1);
+    ((void**)result)[-1] = ptr;
+
+    return (void*)result;
+}
+
+static
+void ecs_os_api_free_sized(void *ptr, size_t size) {
+    (void)size;
+    if (ptr) {
+        ecs_os_api.free(((void**)ptr)[-1]);
+    }
+}
+
 static
 char* ecs_os_api_strdup(const char *str) {
     int len = strlen(str);
@@ -286,6 +420,8 @@ void ecs_os_set_api_defaults(void)
     ecs_os_api.realloc = ecs_os_api_realloc;
     ecs_os_api.calloc = ecs_os_api_calloc;
     ecs_os_api.strdup = ecs_os_api_strdup;
+    ecs_os_api.aligned_alloc = ecs_os_api_aligned_alloc;
+    ecs_os_api.free_sized = ecs_os_api_free_sized;
 
 #ifdef __BAKE__
     ecs_os_api.thread_new = bake_thread_new;
@@ -312,6 +448,11 @@ void ecs_os_set_api_defaults(void)
 /* __BAKE__ */
 #endif
 
+    ecs_os_api.ainc = ecs_os_api_ainc;
+    ecs_os_api.adec = ecs_os_api_adec;
+    ecs_os_api.aadd64 = ecs_os_api_aadd64;
+    ecs_os_api.aload = ecs_os_api_aload;
+
     ecs_os_api.sleep = ecs_os_time_sleep;
     ecs_os_api.get_time = ecs_os_gettime;
 
@@ -321,4 +462,9 @@ void ecs_os_set_api_defaults(void)
     ecs_os_api.log_warning = ecs_log_warning;
 
     ecs_os_api.abort = abort;
+
+#ifndef _WIN32
+    ecs_os_api.map_file = ecs_os_api_map_file;
+    ecs_os_api.unmap_file = ecs_os_api_unmap_file;
+#endif
 }
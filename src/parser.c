@@ -84,6 +84,7 @@ int has_tables(
     ecs_system_expr_elem_kind_t elem_kind,
     ecs_system_expr_oper_kind_t oper_kind,
     ecs_system_expr_inout_kind_t inout_kind,
+    bool if_changed,
     const char *component_id,
     const char *source_id,
     void *data)
@@ -94,6 +95,7 @@ int has_tables(
     (void)column;
     (void)oper_kind;
     (void)inout_kind;
+    (void)if_changed;
     (void)component_id;
     (void)source_id;
     
@@ -122,15 +124,23 @@ bool ecs_needs_tables(
     return needs_matching;
 }
 
-/** Count components in a signature */
+/** Count components in a signature. Commas in annotations do not separate
+ * columns. */
 uint32_t ecs_columns_count(
     const char *sig)
 {
     const char *ptr = sig;
     uint32_t count = 1;
-
-    while ((ptr = strchr(ptr + 1, ','))) {
-        count ++;
+    bool in_annotation = false;
+
+    for (; *ptr; ptr ++) {
+        if (*ptr == '[') {
+            in_annotation = true;
+        } else if (*ptr == ']') {
+            in_annotation = false;
+        } else if (*ptr == ',' && !in_annotation) {
+            count ++;
+        }
     }
 
     return count;
@@ -142,7 +152,8 @@ const char* parse_annotation(
     const char *sig,
     int column,
     const char *ptr, 
-    ecs_system_expr_inout_kind_t *inout_kind_out)
+    ecs_system_expr_inout_kind_t *inout_kind_out,
+    bool *if_changed_out)
 {
     char *bptr, buffer[ECS_ANNOTATION_LENGTH_MAX + 1];
     char ch;
@@ -151,8 +162,7 @@ const char* parse_annotation(
 
     for (bptr = buffer; (ch = ptr[0]); ptr ++) {        
         if (ch == ',' || ch == ']') {
-            /* Even though currently only one simultaneous annotation is 
-             * useful, more annotations may be added in the future. */
+            /* An inout annotation can be combined with 'changed' */
             bptr[0] = '\0';
 
             if (!strcmp(buffer, "in")) {
@@ -161,6 +171,8 @@ const char* parse_annotation(
                 *inout_kind_out = EcsOut;
             } else if (!strcmp(buffer, "inout")) {
                 *inout_kind_out = EcsInOut;
+            } else if (!strcmp(buffer, "changed")) {
+                *if_changed_out = true;
             } else {
                 ecs_parser_error(
                     system_id, sig, column, "unknown annotation '%s'", buffer);
@@ -169,7 +181,8 @@ const char* parse_annotation(
             if (ch == ']') {
                 break;
             } else {
-                ptr = skip_space(ptr + 1);
+                /* Skip spaces after separator, loop increments ptr */
+                ptr = skip_space(ptr + 1) - 1;
             }
 
             bptr = buffer;
@@ -210,6 +223,7 @@ int ecs_parse_component_expr(
     ecs_system_expr_elem_kind_t elem_kind = EcsFromSelf;
     ecs_system_expr_oper_kind_t oper_kind = EcsOperAnd;
     ecs_system_expr_inout_kind_t inout_kind = EcsInOut;
+    bool if_changed = false;
     const char *source;
 
     for (bptr = buffer, ch = sig[0], ptr = sig; ch; ptr++) {
@@ -227,7 +241,8 @@ int ecs_parse_component_expr(
                 ecs_parser_error(system_id, sig, ptr - sig, "[...] should appear at start of column");
             }
 
-            ptr = parse_annotation(system_id, sig, ptr - sig, ptr + 1, &inout_kind);
+            ptr = parse_annotation(
+                system_id, sig, ptr - sig, ptr + 1, &inout_kind, &if_changed);
             ecs_assert(ptr != NULL, ECS_INTERNAL_ERROR, NULL);
 
         } else if (ch == ',' || ch == '|' || ch == '\0') {
@@ -292,7 +307,8 @@ int ecs_parse_component_expr(
             }
 
             if (action(world, system_id, sig, ptr - sig, 
-                elem_kind, oper_kind, inout_kind, bptr, source_id, ctx)) 
+                elem_kind, oper_kind, inout_kind, if_changed, bptr, source_id, 
+                ctx)) 
             {
                 ecs_abort(ECS_INVALID_SIGNATURE, sig);
             }
@@ -316,6 +332,7 @@ int ecs_parse_component_expr(
             }
 
             inout_kind = EcsInOut;
+            if_changed = false;
 
             bptr = buffer;
         } else {
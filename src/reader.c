@@ -1,5 +1,44 @@
 #include "flecs_private.h"
 
+/* Serialized data is padded so that each block of data is a multiple of 4 */
+static
+size_t padding_of(
+    size_t size)
+{
+    return (sizeof(int32_t) - (size % sizeof(int32_t))) % sizeof(int32_t);
+}
+
+/** Set the next block of data that is copied to the output */
+static
+void ecs_reader_set_data(
+    ecs_reader_t *stream,
+    const void *data,
+    size_t size,
+    size_t padding)
+{
+    stream->data = data;
+    stream->data_size = size;
+    stream->data_padding = padding;
+    stream->data_read = 0;
+}
+
+/** Set a header that starts with a header kind, followed by a struct */
+static
+void ecs_reader_set_header(
+    ecs_reader_t *stream,
+    ecs_blob_header_kind_t kind,
+    const void *data,
+    size_t size)
+{
+    int32_t *header = (int32_t*)stream->header;
+    ecs_assert(sizeof(int32_t) + size <= sizeof(stream->header),
+        ECS_INTERNAL_ERROR, NULL);
+
+    header[0] = kind;
+    memcpy(&header[1], data, size);
+    ecs_reader_set_data(stream, header, sizeof(int32_t) + size, 0);
+}
+
 static
 void ecs_component_reader_fetch_component_data(
     ecs_reader_t *stream)
@@ -16,383 +55,654 @@ void ecs_component_reader_fetch_component_data(
     reader->count = ecs_vector_count(table->columns[0].data);
 }
 
+/** Get a name as it is serialized. Names that are not set are serialized (and
+ * deserialized) as empty strings. */
+static
+const char* ecs_reader_name(
+    const char *name)
+{
+    if (!name) {
+        return "";
+    } else {
+        return name;
+    }
+}
+
 static
-void ecs_component_reader_next(
+bool ecs_table_reader_next(
+    ecs_reader_t *stream);
+
+static
+bool ecs_delta_reader_next(
+    ecs_reader_t *stream);
+
+/** Start serializing tables. A delta first serializes the entities from the
+ * base snapshot that are no longer stored in a table. */
+static
+bool ecs_reader_start_tables(
+    ecs_reader_t *stream)
+{
+    if (stream->base) {
+        stream->state = EcsDeltaSegment;
+        return ecs_delta_reader_next(stream);
+    } else {
+        stream->state = EcsTableSegment;
+        return ecs_table_reader_next(stream);
+    }
+}
+
+/** Get number of padding bytes between a column header and the vector header
+ * that precedes the column data, so that the column data is aligned. Columns
+ * that span one or more pages are aligned to a page. */
+static
+int32_t column_padding(
+    ecs_reader_t *stream,
+    size_t size)
+{
+    size_t alignment = stream->alignment;
+    if (size * stream->table.row_count < ECS_BLOB_PAGE_SIZE) {
+        alignment = ECS_TABLE_ALIGNMENT;
+    }
+
+    size_t data_offset = stream->offset + sizeof(ecs_blob_column_t) +
+        ECS_VECTOR_HEADER_SIZE;
+
+    return (alignment - data_offset % alignment) % alignment;
+}
+
+static
+bool ecs_component_reader_next(
     ecs_reader_t *stream)
 {
     ecs_component_reader_t *reader = &stream->component;
 
+    if (!reader->state) {
+        reader->state = EcsComponentHeader;
+    }
+
     switch(reader->state) {
-    case EcsComponentHeader:  
-        reader->state = EcsComponentId;
-        if (!reader->id_column) {
-            /* Start from EcsOnDemand. Everything before that is the same for
-             * every world */
-            reader->index = EEcsOnDemand;
+    case EcsComponentHeader: {
+        if (reader->index == reader->count) {
+            return ecs_reader_start_tables(stream);
         }
-        break;
 
-    case EcsComponentId:
-        reader->state = EcsComponentSize;
-        break;
+        const char *name = ecs_reader_name(reader->name_column[reader->index]);
 
-    case EcsComponentSize:
-        reader->state = EcsComponentNameLength;
-        reader->name = reader->name_column[reader->index];
-        reader->len = strlen(reader->name) + 1;
-        break;
+        ecs_blob_component_t component = {
+            .id = reader->id_column[reader->index],
+            .size = reader->data_column[reader->index].size,
+            .name_len = strlen(name) + 1
+        };
+
+        ecs_reader_set_header(
+            stream, EcsComponentHeader, &component, sizeof(component));
 
-    case EcsComponentNameLength:
         reader->state = EcsComponentName;
-        reader->written = 0;
         break;
+    }
 
-    case EcsComponentName:
-        reader->state = EcsComponentHeader;    
+    case EcsComponentName: {
+        const char *name = ecs_reader_name(reader->name_column[reader->index]);
+        size_t len = strlen(name) + 1;
+
+        ecs_reader_set_data(stream, name, len, padding_of(len));
+
+        reader->state = EcsComponentHeader;
         reader->index ++;
-        if (reader->index == reader->count) {
-            stream->state = EcsTableSegment;
-        }
         break;
+    }
 
     default:
-        ecs_abort(ECS_INTERNAL_ERROR, NULL);        
+        ecs_abort(ECS_INTERNAL_ERROR, NULL);
     }
+
+    return true;
 }
 
+/** Returns whether an entity from the base snapshot is no longer stored in a
+ * table, and if so, whether the entity is deleted */
 static
-size_t ecs_component_reader(
-    char *buffer,
-    size_t size,
-    ecs_reader_t *stream)
+bool ecs_delta_entity_removed(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    bool *is_deleted)
 {
-    if (!size) {
-        return 0;
+    ecs_ei_t *entity_index = world->main_stage.entity_index;
+    ecs_row_t *row = ecs_ei_get(entity_index, entity);
+    if (row && row->type) {
+        return false;
     }
 
-    if (size < sizeof(int32_t)) {
-        return -1;
-    }
+    *is_deleted = !ecs_ei_is_alive(entity_index, entity);
+    return true;
+}
 
-    ecs_component_reader_t *reader = &stream->component;
-    size_t read = 0;
+/** Serialize runs of entities in base snapshot tables that are no longer
+ * stored in a table */
+static
+bool ecs_delta_reader_next(
+    ecs_reader_t *stream)
+{
+    ecs_table_reader_t *reader = &stream->table;
+    ecs_chunked_t *tables = stream->base->tables;
 
     if (!reader->state) {
-        reader->state = EcsComponentHeader;
+        reader->state = EcsDeltaDeleteHeader;
     }
 
     switch(reader->state) {
-    case EcsComponentHeader:  
-        *(ecs_blob_header_kind_t*)buffer = EcsComponentHeader;
-        read = sizeof(ecs_blob_header_kind_t);
-        ecs_component_reader_next(stream);
-        break;
+    case EcsDeltaDeleteHeader: {
+        uint32_t table_count = ecs_chunked_count(tables);
+
+        for (; reader->table_index < table_count; reader->table_index ++) {
+            ecs_table_t *table = ecs_chunked_get(
+                tables, ecs_table_t, reader->table_index);
+            if (!table->columns || table->flags & EcsTableHasBuiltins) {
+                continue;
+            }
 
-    case EcsComponentId:
-        *(int32_t*)buffer = (int32_t)reader->id_column[reader->index];
-        read = sizeof(int32_t);
-        ecs_component_reader_next(stream);
-        break;
+            ecs_entity_t *entities = ecs_vector_first(table->columns[0].data);
+            int32_t count = ecs_vector_count(table->columns[0].data);
 
-    case EcsComponentSize:
-        *(int32_t*)buffer = (int32_t)reader->data_column[reader->index].size;
-        read = sizeof(int32_t);
-        ecs_component_reader_next(stream);
-        break;
+            while (reader->row_index < count) {
+                int32_t first = reader->row_index ++;
+                bool is_deleted, next_deleted;
 
-    case EcsComponentNameLength:
-        *(int32_t*)buffer = (int32_t)reader->len;
-        read = sizeof(int32_t);
-        ecs_component_reader_next(stream);    
-        break;
+                if (!ecs_delta_entity_removed(
+                    stream->world, entities[first], &is_deleted))
+                {
+                    continue;
+                }
 
-    case EcsComponentName:
-        read = reader->len - reader->written;
-        if (read >= sizeof(int32_t)) {
-            *(int32_t*)buffer = *(int32_t*)ECS_OFFSET(reader->name, reader->written);
-            reader->written += sizeof(int32_t);
-        } else {
-            memcpy(buffer, ECS_OFFSET(reader->name, reader->written), read);
-            memset(ECS_OFFSET(buffer, read), 0, sizeof(int32_t) - read);
-            reader->written += read;
-        }
+                /* Serialize consecutive entities with one header */
+                while (reader->row_index < count && ecs_delta_entity_removed(
+                    stream->world, entities[reader->row_index], &next_deleted) &&
+                    next_deleted == is_deleted)
+                {
+                    reader->row_index ++;
+                }
 
-        /* Always align buffer to multiples of 4 bytes */
-        read = sizeof(int32_t);
+                ecs_blob_delete_t header = {
+                    .count = reader->row_index - first,
+                    .is_deleted = is_deleted
+                };
 
-        if (reader->written == reader->len) {
-            ecs_component_reader_next(stream);
+                ecs_reader_set_header(
+                    stream, EcsDeltaDeleteHeader, &header, sizeof(header));
+
+                reader->deleted = &entities[first];
+                reader->state = EcsDeltaDeleteEntity;
+                return true;
+            }
+
+            reader->row_index = 0;
         }
+
+        /* Continue with the tables of the world */
+        *reader = (ecs_table_reader_t){0};
+        stream->state = EcsTableSegment;
+        return ecs_table_reader_next(stream);
+    }
+
+    case EcsDeltaDeleteEntity: {
+        ecs_blob_delete_t *header = (ecs_blob_delete_t*)
+            &((int32_t*)stream->header)[1];
+
+        ecs_reader_set_data(stream, reader->deleted,
+            header->count * sizeof(ecs_entity_t), 0);
+
+        reader->state = EcsDeltaDeleteHeader;
         break;
+    }
 
     default:
         ecs_abort(ECS_INTERNAL_ERROR, NULL);
     }
 
-    ecs_assert(read % 4 == 0, ECS_INTERNAL_ERROR, NULL);
+    return true;
+}
+
+/** Returns whether the names in a table are the same as in the base table */
+static
+bool ecs_delta_names_equal(
+    ecs_table_reader_t *reader)
+{
+    ecs_entity_t *type_buffer = ecs_vector_first(reader->type);
+    int32_t i, c;
+
+    for (c = 1; c < reader->total_columns; c ++) {
+        if (type_buffer[c - 1] != EEcsId) {
+            continue;
+        }
+
+        EcsId *names = ecs_vector_first(reader->columns[c].data);
+        EcsId *base_names = ecs_vector_first(reader->base->columns[c].data);
+
+        for (i = 0; i < reader->row_count; i ++) {
+            if (strcmp(ecs_reader_name(names[i]), 
+                       ecs_reader_name(base_names[i]))) 
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/** Returns whether chunk of rows in a column is different from the base */
+static
+bool ecs_delta_chunk_changed(
+    ecs_table_reader_t *reader,
+    int32_t row,
+    int32_t count)
+{
+    int32_t size = reader->columns[reader->column_index].size;
+    void *data = ecs_vector_first(reader->columns[reader->column_index].data);
+    void *base = ecs_vector_first(
+        reader->base->columns[reader->column_index].data);
+
+    return memcmp(ECS_OFFSET(data, row * size), ECS_OFFSET(base, row * size),
+        count * size) != 0;
+}
+
+/** Find the next chunk of rows that is different from the base table, starting
+ * from the current column and row. Returns false if no other chunks changed. */
+static
+bool ecs_delta_find_chunk(
+    ecs_table_reader_t *reader)
+{
+    ecs_entity_t *type_buffer = ecs_vector_first(reader->type);
+
+    for (; reader->column_index < reader->total_columns;
+        reader->column_index ++, reader->row_index = 0)
+    {
+        int32_t c = reader->column_index;
+        int32_t size = reader->columns[c].size;
+
+        /* Names are compared when the table is selected */
+        if (!size || type_buffer[c - 1] == EEcsId) {
+            continue;
+        }
+
+        /* Columns shared with a snapshot have not changed */
+        if (reader->columns[c].data == reader->base->columns[c].data) {
+            continue;
+        }
+
+        int32_t chunk = ECS_BLOB_CHUNK_SIZE / size;
+        if (!chunk) {
+            chunk = 1;
+        }
+
+        for (; reader->row_index < reader->row_count; 
+            reader->row_index += chunk) 
+        {
+            int32_t count = reader->row_count - reader->row_index;
+            if (count > chunk) {
+                count = chunk;
+            }
+
+            if (ecs_delta_chunk_changed(reader, reader->row_index, count)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/** Get table from base snapshot that a table in the world can be compared
+ * with. Tables are stored in the same order in the snapshot and the world. */
+static
+ecs_table_t* ecs_delta_base_table(
+    ecs_reader_t *stream,
+    uint32_t index)
+{
+    ecs_chunked_t *tables = stream->base->tables;
+    if (index >= ecs_chunked_count(tables)) {
+        return NULL;
+    }
+
+    ecs_table_t *base = ecs_chunked_get(tables, ecs_table_t, index);
+    if (!base->columns) {
+        return NULL;
+    }
 
-    return read;
+    return base;
 }
 
+/** Select how a table is serialized in a delta. Tables that store the same
+ * entities as in the base snapshot are serialized as chunks of changed data,
+ * other tables are serialized completely. Returns false if the table did not
+ * change. */
 static
-void ecs_table_reader_next(
+bool ecs_delta_select_table(
+    ecs_reader_t *stream)
+{
+    ecs_table_reader_t *reader = &stream->table;
+    ecs_table_t *base = ecs_delta_base_table(stream, reader->table_index - 1);
+    uint32_t count = ecs_vector_count(reader->columns[0].data);
+
+    reader->base = NULL;
+
+    if (!base) {
+        return count != 0;
+    }
+
+    ecs_vector_t *base_entities = base->columns[0].data;
+    if (ecs_vector_count(base_entities) != count) {
+        return true;
+    }
+
+    if (!count) {
+        return false;
+    }
+
+    if (memcmp(ecs_vector_first(reader->columns[0].data), 
+        ecs_vector_first(base_entities), count * sizeof(ecs_entity_t))) 
+    {
+        return true;
+    }
+
+    reader->base = base;
+    reader->type = reader->table->type;
+    reader->total_columns = ecs_vector_count(reader->type) + 1;
+    reader->row_count = count;
+
+    if (!ecs_delta_names_equal(reader)) {
+        reader->base = NULL;
+        return true;
+    }
+
+    reader->column_index = 1;
+    reader->row_index = 0;
+
+    return ecs_delta_find_chunk(reader);
+}
+
+static
+bool ecs_table_reader_next(
     ecs_reader_t *stream)
 {
     ecs_table_reader_t *reader = &stream->table;
     ecs_chunked_t *tables = stream->tables;
 
+    if (!reader->state) {
+        reader->state = EcsTableHeader;
+    }
+
     switch(reader->state) {
     case EcsTableHeader: {
         bool table_found = false;
+        uint32_t table_count = ecs_chunked_count(tables);
 
-        reader->state = EcsTableTypeSize;
-
-        do {
-            ecs_table_t *table = ecs_chunked_get(tables, ecs_table_t, reader->table_index);
+        while (reader->table_index < table_count) {
+            ecs_table_t *table = ecs_chunked_get(
+                tables, ecs_table_t, reader->table_index);
             reader->table = table;
             reader->columns = table->columns;
             reader->table_index ++;
 
-            /* If a table is filtered out by the snapshot, does not have any
-             * entities or contains builtin data, skip it */
-            if (reader->columns &&
-                 ecs_vector_count(reader->columns[0].data) &&
-                 !(reader->table->flags & EcsTableHasBuiltins))
+            /* If a table is filtered out by the snapshot or contains builtin
+             * data, skip it */
+            if (!reader->columns || 
+                reader->table->flags & EcsTableHasBuiltins) 
             {
+                continue;
+            }
+
+            /* A delta only contains tables that changed. Tables that no 
+             * longer have entities are serialized so they are cleared. */
+            if (stream->base) {
+                if (ecs_delta_select_table(stream)) {
+                    table_found = true;
+                    break;
+                }
+
+            /* Skip tables without entities */
+            } else if (ecs_vector_count(reader->columns[0].data)) {
                 table_found = true;
                 break;
             }
-        } while (reader->table_index != ecs_chunked_count(tables));
+        }
 
         if (!table_found) {
             stream->state = EcsFooterSegment;
+            return false;
+        }
+
+        if (reader->base) {
+            ecs_blob_table_t table = {
+                .type_count = ecs_vector_count(reader->type),
+                .row_count = reader->row_count
+            };
+
+            ecs_reader_set_header(
+                stream, EcsTableDeltaHeader, &table, sizeof(table));
+
+            reader->state = EcsTableDeltaType;
             break;
-        } else {
-            reader->type = reader->table->type;
-            reader->total_columns = ecs_vector_count(reader->type) + 1;
-            reader->column_index = 0;
-            reader->row_count = ecs_vector_count(reader->columns[0].data);
         }
-        break;
-    }
 
-    case EcsTableTypeSize:
+        reader->type = reader->table->type;
+        reader->total_columns = ecs_vector_count(reader->type) + 1;
+        reader->column_index = 0;
+        reader->row_count = ecs_vector_count(reader->columns[0].data);
+
+        ecs_blob_table_t table = {
+            .type_count = ecs_vector_count(reader->type),
+            .row_count = reader->row_count
+        };
+
+        ecs_reader_set_header(stream, EcsTableHeader, &table, sizeof(table));
+
         reader->state = EcsTableType;
-        reader->type_written = 0;
         break;
+    }
 
     case EcsTableType:
-        reader->state = EcsTableSize;
-        break;
+    case EcsTableDeltaType:
+        /* Type ids are 64 bit, so type is always aligned to 4 bytes */
+        ecs_reader_set_data(stream, ecs_vector_first(reader->type),
+            ecs_vector_count(reader->type) * sizeof(ecs_entity_t), 0);
 
-    case EcsTableSize: {
-        reader->state = EcsTableColumnHeader;
+        if (reader->state == EcsTableType) {
+            reader->state = EcsTableColumnHeader;
+        } else {
+            reader->state = EcsTableChunkHeader;
+        }
         break;
-    }
 
-    case EcsTableColumnHeader:
-        reader->state = EcsTableColumnSize;
-        reader->column = &reader->columns[reader->column_index];
-        reader->column_size = reader->column->size;
-        break;
+    case EcsTableChunkHeader: {
+        if (!ecs_delta_find_chunk(reader)) {
+            reader->state = EcsTableHeader;
+            return ecs_table_reader_next(stream);
+        }
 
-    case EcsTableColumnSize:
-        reader->state = EcsTableColumnData;
-        reader->column_data = ecs_vector_first(reader->column->data);
-        reader->column_written = 0;
-        break;
+        int32_t size = reader->columns[reader->column_index].size;
+        int32_t chunk = ECS_BLOB_CHUNK_SIZE / size;
+        if (!chunk) {
+            chunk = 1;
+        }
 
-    case EcsTableColumnNameHeader:
-        reader->state = EcsTableColumnNameLength;
-        reader->column = &reader->columns[reader->column_index];
-        reader->column_data = ecs_vector_first(reader->column->data);
-        reader->row_index = 0;
-        break;
+        /* Serialize consecutive chunks that changed with one header */
+        int32_t row = reader->row_index, end = row + chunk;
+        while (end < reader->row_count) {
+            int32_t count = reader->row_count - end;
+            if (count > chunk) {
+                count = chunk;
+            }
 
-    case EcsTableColumnNameLength:
-        reader->state = EcsTableColumnName;
-        reader->row_index ++;
-        break;
+            if (!ecs_delta_chunk_changed(reader, end, count)) {
+                break;
+            }
 
-    case EcsTableColumnName:
-        if (reader->row_index < reader->row_count) {
-            reader->state = EcsTableColumnNameLength;
-            break;
-        } else {
-            /* Fallthrough on purpose */
+            end += count;
         }
 
-    case EcsTableColumnData:
-        reader->column_index ++;
-        if (reader->column_index == reader->total_columns) {
-            reader->state = EcsTableHeader;
-            if (reader->table_index == ecs_chunked_count(tables)) {
-                stream->state = EcsFooterSegment;
-            }            
-        } else {
-            ecs_entity_t *type_buffer = ecs_vector_first(reader->type);
-            if (reader->column_index >= 1) {
-                ecs_entity_t e = type_buffer[reader->column_index - 1];
-                
-                if (e != EEcsId) {
-                    reader->state = EcsTableColumnHeader;
-                } else {
-                    reader->state = EcsTableColumnNameHeader;
-                }
-            } else {
-                reader->state = EcsTableColumnHeader;
-            }            
+        if (end > reader->row_count) {
+            end = reader->row_count;
         }
-        break;
-
-    default:
-        ecs_abort(ECS_INTERNAL_ERROR, NULL);
-    }
 
-    return;
-}
+        ecs_blob_chunk_t header = {
+            .column = reader->column_index,
+            .row = row,
+            .count = end - row
+        };
 
-static
-size_t ecs_table_reader(
-    char *buffer,
-    size_t size,
-    ecs_reader_t *stream)
-{
-    if (!size) {
-        return 0;
-    }
+        ecs_reader_set_header(
+            stream, EcsTableChunkHeader, &header, sizeof(header));
 
-    if (size < sizeof(int32_t)) {
-        return -1;
+        reader->row_index = end;
+        reader->state = EcsTableChunkData;
+        break;
     }
 
-    ecs_table_reader_t *reader = &stream->table;
-    size_t read = 0;
+    case EcsTableChunkData: {
+        ecs_blob_chunk_t *header = (ecs_blob_chunk_t*)
+            &((int32_t*)stream->header)[1];
+        ecs_table_column_t *column = &reader->columns[header->column];
+        size_t size = column->size * header->count;
 
-    if (!reader->state) {
-        reader->state = EcsTableHeader;
-    }
+        ecs_reader_set_data(stream, ECS_OFFSET(ecs_vector_first(column->data),
+            column->size * header->row), size, padding_of(size));
 
-    switch(reader->state) {
-    case EcsTableHeader:  
-        *(ecs_blob_header_kind_t*)buffer = EcsTableHeader;
-        read = sizeof(ecs_blob_header_kind_t);
-        ecs_table_reader_next(stream);
+        reader->state = EcsTableChunkHeader;
         break;
+    }
 
-    case EcsTableTypeSize:  
-        *(int32_t*)buffer = ecs_vector_count(reader->type);
-        read = sizeof(int32_t);
-        ecs_table_reader_next(stream);
-        break;  
+    case EcsTableColumnHeader: {
+        if (reader->column_index == reader->total_columns) {
+            reader->state = EcsTableHeader;
+            return ecs_table_reader_next(stream);
+        }
 
-    case EcsTableType: {
-        ecs_entity_t *type_array = ecs_vector_first(reader->type);
-        *(int32_t*)buffer = *(int32_t*)ECS_OFFSET(type_array, reader->type_written);
-        reader->type_written += sizeof(int32_t);
-        read = sizeof(int32_t);
+        ecs_table_column_t *column = &reader->columns[reader->column_index];
+        ecs_entity_t *type_buffer = ecs_vector_first(reader->type);
+        ecs_blob_column_t *header = (ecs_blob_column_t*)stream->header;
+        header->padding = 0;
+
+        if (reader->column_index >= 1 &&
+            type_buffer[reader->column_index - 1] == EEcsId)
+        {
+            /* Names can't be copied directly, so they are serialized as a
+             * sequence of strings with the total size in the header */
+            EcsId *names = ecs_vector_first(column->data);
+            int32_t i;
+
+            reader->names_size = 0;
+            for (i = 0; i < reader->row_count; i ++) {
+                reader->names_size += strlen(ecs_reader_name(names[i])) + 1;
+            }
 
-        if (reader->type_written == ecs_vector_count(reader->type) * sizeof(ecs_entity_t)) {
-            ecs_table_reader_next(stream);
+            header->kind = EcsTableColumnNameHeader;
+            header->size = reader->names_size;
+            reader->row_index = 0;
+            reader->state = EcsTableColumnName;
+        } else if (stream->alignment && column->size) {
+            header->kind = EcsTableColumnVectorHeader;
+            header->size = column->size;
+            header->padding = column_padding(stream, column->size);
+            reader->state = EcsTableColumnVector;
+        } else {
+            header->kind = EcsTableColumnHeader;
+            header->size = column->size;
+            reader->state = EcsTableColumnData;
         }
-        break;                
-    }
 
-    case EcsTableSize:
-        *(int32_t*)buffer = ecs_vector_count(reader->table->columns[0].data);
-        read = sizeof(int32_t);
-        ecs_table_reader_next(stream);
+        ecs_reader_set_data(stream, header, sizeof(ecs_blob_column_t),
+            header->padding);
         break;
+    }
 
-    case EcsTableColumnHeader:
-        *(ecs_blob_header_kind_t*)buffer = EcsTableColumnHeader;
-        read = sizeof(ecs_blob_header_kind_t);
-        ecs_table_reader_next(stream);
-        break; 
+    case EcsTableColumnVector: {
+        /* Vector header is written in front of the column data, so the data
+         * can be used as a vector when the output is mapped */
+        ecs_vector_params_t params = {.element_size = reader->columns[
+            reader->column_index].size};
+        ecs_vector_t *vector = ecs_vector_new_in_place(
+            &params, reader->row_count, stream->header);
+        ecs_vector_set_count(&vector, &params, reader->row_count);
 
-    case EcsTableColumnSize:
-        *(int32_t*)buffer = reader->column_size;
-        read = sizeof(ecs_blob_header_kind_t);
-        ecs_table_reader_next(stream);
+        ecs_reader_set_data(stream, vector, ECS_VECTOR_HEADER_SIZE, 0);
 
-        if (!reader->column_size) {
-            ecs_table_reader_next(stream);
-        }
-        break; 
+        reader->state = EcsTableColumnData;
+        break;
+    }
 
     case EcsTableColumnData: {
-        int32_t column_bytes = reader->column_size * reader->row_count;
-        read = column_bytes - reader->column_written;
-        if (read > size) {
-            read = size;
-        }
+        ecs_table_column_t *column = &reader->columns[reader->column_index];
+        size_t size = column->size * reader->row_count;
 
-        memcpy(buffer, ECS_OFFSET(reader->column_data, reader->column_written), read);
-        reader->column_written += read;
-        ecs_assert(reader->column_written <= column_bytes, ECS_INTERNAL_ERROR, NULL);
+        ecs_reader_set_data(stream,
+            ecs_vector_first(column->data), size, padding_of(size));
 
-        int32_t align = (((read - 1) / sizeof(int32_t)) + 1) * sizeof(int32_t);
-        if (align != read) {
-            /* Initialize padding bytes to 0 to keep valgrind happy */
-            memset(ECS_OFFSET(buffer, read), 0, align - read);
+        reader->column_index ++;
+        reader->state = EcsTableColumnHeader;
+        break;
+    }
 
-            /* Set read to align so that data is always aligned to 4 bytes */
-            read = align;
+    case EcsTableColumnName: {
+        ecs_table_column_t *column = &reader->columns[reader->column_index];
+        EcsId *names = ecs_vector_first(column->data);
+        const char *name = ecs_reader_name(names[reader->row_index]);
+        size_t padding = 0;
 
-            /* Buffer sizes are expected to be aligned to 4 bytes and the rest
-             * of the serialized data is aligned to 4 bytes. Should never happen
-             * that adding padding bytes exceeds the size. */
-            ecs_assert(read <= size, ECS_INTERNAL_ERROR, NULL);
+        reader->row_index ++;
+        if (reader->row_index == reader->row_count) {
+            padding = padding_of(reader->names_size);
+            reader->column_index ++;
+            reader->state = EcsTableColumnHeader;
         }
 
-        if (reader->column_written == column_bytes) {
-            ecs_table_reader_next(stream);
-        }
+        ecs_reader_set_data(stream, name, strlen(name) + 1, padding);
         break;
     }
 
-    case EcsTableColumnNameHeader:
-        *(ecs_blob_header_kind_t*)buffer = EcsTableColumnNameHeader;
-        read = sizeof(ecs_blob_header_kind_t);
-        ecs_table_reader_next(stream);
-        break;
+    default:
+        ecs_abort(ECS_INTERNAL_ERROR, NULL);
+    }
 
-    case EcsTableColumnNameLength:
-        reader->name = ((EcsId*)reader->column_data)[reader->row_index];
-        reader->name_len = strlen(reader->name) + 1;
-        reader->name_written = 0;
-        *(int32_t*)buffer = reader->name_len;
-        read = sizeof(int32_t);
-        ecs_table_reader_next(stream);    
-        break;
+    return true;
+}
 
-    case EcsTableColumnName:   
-        read = reader->name_len - reader->name_written;
-        if (read >= sizeof(int32_t)) {
-            *(int32_t*)buffer = *(int32_t*)ECS_OFFSET(reader->name, reader->name_written);
-            reader->name_written += sizeof(int32_t);
+/** Advance to next block of data. Returns false when there is no more data. */
+static
+bool ecs_reader_next(
+    ecs_reader_t *stream)
+{
+    switch(stream->state) {
+    case EcsStreamHeader:
+        *(int32_t*)stream->header = ECS_BLOB_VERSION;
+        ecs_reader_set_data(stream, stream->header, sizeof(int32_t), 0);
+
+        /* If the world does not contain components besides the built-in ones,
+         * go straight to serializing tables */
+        if (stream->component.count == EEcsOnDemand) {
+            stream->state = stream->base ? EcsDeltaSegment : EcsTableSegment;
         } else {
-            memcpy(buffer, ECS_OFFSET(reader->name, reader->name_written), read);
-            memset(ECS_OFFSET(buffer, read), 0, sizeof(int32_t) - read);
-            reader->name_written += read;
+            stream->state = EcsComponentSegment;
         }
+        return true;
 
-        /* Always align buffer to multiples of 4 bytes */
-        read = sizeof(int32_t);
+    case EcsComponentSegment:
+        return ecs_component_reader_next(stream);
 
-        if (reader->name_written == reader->name_len) {
-            ecs_table_reader_next(stream);
-        }
+    case EcsDeltaSegment:
+        return ecs_delta_reader_next(stream);
 
-        break;
+    case EcsTableSegment:
+        return ecs_table_reader_next(stream);
+
+    case EcsFooterSegment:
+        return false;
 
     default:
         ecs_abort(ECS_INTERNAL_ERROR, NULL);
     }
 
-    ecs_assert(read % 4 == 0, ECS_INTERNAL_ERROR, NULL);
-
-    return read;
+    return false;
 }
 
 size_t ecs_reader_read(
@@ -400,7 +710,7 @@ size_t ecs_reader_read(
     size_t size,
     ecs_reader_t *reader)
 {
-    size_t read, total_read = 0, remaining = size;
+    size_t total_read = 0;
 
     if (!size) {
         return 0;
@@ -409,44 +719,45 @@ size_t ecs_reader_read(
     ecs_assert(size >= sizeof(int32_t), ECS_INVALID_PARAMETER, NULL);
     ecs_assert(size % 4 == 0, ECS_INVALID_PARAMETER, NULL);
 
-    if (reader->state == EcsComponentSegment) {
-        while ((read = ecs_component_reader(ECS_OFFSET(buffer, total_read), remaining, reader))) {
-            if (read == -1) {
+    while (total_read < size) {
+        size_t data_total = reader->data_size + reader->data_padding;
+        if (reader->data_read == data_total) {
+            if (!ecs_reader_next(reader)) {
                 break;
             }
+            continue;
+        }
 
-            remaining -= read;
-            total_read += read;
+        size_t read, remaining = size - total_read;
+        char *dst = ECS_OFFSET(buffer, total_read);
 
-            if (reader->state != EcsComponentSegment) {
-                break;
+        /* Copy as much of the current block of data as fits in the buffer */
+        if (reader->data_read < reader->data_size) {
+            read = reader->data_size - reader->data_read;
+            if (read > remaining) {
+                read = remaining;
             }
 
-            ecs_assert(remaining % 4 == 0, ECS_INTERNAL_ERROR, NULL);
-        }
+            memcpy(dst, ECS_OFFSET(reader->data, reader->data_read), read);
+        } else {
+            read = data_total - reader->data_read;
+            if (read > remaining) {
+                read = remaining;
+            }
 
-        if (read == -1) {
-            return total_read;
+            /* Initialize padding bytes to 0 to keep valgrind happy */
+            memset(dst, 0, read);
         }
 
-        if (!read && remaining) {
-            reader->state = EcsTableSegment;
-        }
+        reader->data_read += read;
+        reader->offset += read;
+        total_read += read;
     }
 
-    if (reader->state == EcsTableSegment) {
-        while ((read = ecs_table_reader(ECS_OFFSET(buffer, total_read), remaining, reader))) {
-            remaining -= read;
-            total_read += read;
+    /* All serialized data is padded, so the buffer is either full or contains
+     * the last bytes of the data, which is a multiple of 4 */
+    ecs_assert(total_read % 4 == 0, ECS_INTERNAL_ERROR, NULL);
 
-            if (reader->state != EcsTableSegment) {
-                break;
-            }
-
-            ecs_assert(remaining % 4 == 0, ECS_INTERNAL_ERROR, NULL);        
-        }
-    }  
-    
     return total_read;
 }
 
@@ -455,18 +766,12 @@ ecs_reader_t ecs_reader_init(
 {
     ecs_reader_t result = {
         .world = world,
-        .state = EcsComponentSegment,
+        .state = EcsStreamHeader,
         .tables = world->main_stage.tables
     };
 
     ecs_component_reader_fetch_component_data(&result);
 
-    /* If the world does not contain components besides the built-in ones, go
-     * straight to serializing tables */
-    if (result.component.count == EEcsOnDemand) {
-        result.state = EcsTableSegment;
-    }
-
     return result;
 }
 
@@ -476,16 +781,61 @@ ecs_reader_t ecs_snapshot_reader_init(
 {
     ecs_reader_t result = {
         .world = world,
-        .state = EcsComponentSegment,
+        .state = EcsStreamHeader,
         .tables = snapshot->tables
     };
 
     ecs_component_reader_fetch_component_data(&result);
 
-    /* If the world does not contain components besides the built-in ones, go
-     * straight to serializing tables */
-    if (result.component.count == EEcsOnDemand) {
-        result.state = EcsTableSegment;
+    return result;
+}
+
+ecs_reader_t ecs_delta_reader_init(
+    ecs_world_t *world,
+    const ecs_snapshot_t *base)
+{
+    ecs_assert(base != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_reader_t result = {
+        .world = world,
+        .state = EcsStreamHeader,
+        .tables = world->main_stage.tables,
+        .base = base
+    };
+
+    ecs_component_reader_fetch_component_data(&result);
+
+    return result;
+}
+
+int ecs_save_file(
+    ecs_world_t *world,
+    const char *filename)
+{
+    FILE *file = fopen(filename, "wb");
+    if (!file) {
+        return -1;
+    }
+
+    ecs_reader_t reader = ecs_reader_init(world);
+    reader.alignment = ECS_BLOB_PAGE_SIZE;
+
+    size_t size = ECS_BLOB_PAGE_SIZE * 16, read;
+    char *buffer = ecs_os_malloc(size);
+    ecs_assert(buffer != NULL, ECS_OUT_OF_MEMORY, NULL);
+    int result = 0;
+
+    while ((read = ecs_reader_read(buffer, size, &reader))) {
+        if (fwrite(buffer, 1, read, file) != read) {
+            result = -1;
+            break;
+        }
+    }
+
+    ecs_os_free(buffer);
+
+    if (fclose(file)) {
+        result = -1;
     }
 
     return result;
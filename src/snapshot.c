@@ -6,6 +6,12 @@ void dup_table(
 {
     uint32_t c, column_count = ecs_vector_count(table->type);
 
+    /* The copied columns are regular vectors, even if the table stores its
+     * columns in a block or in a mapped file */
+    table->arena = NULL;
+    table->arena_size = 0;
+    table->flags &= ~(EcsTableIsMapped | EcsTableIsShared);
+
     /* First create a copy of columns structure */
     table->columns = ecs_os_memdup(
         table->columns, sizeof(ecs_table_column_t) * (column_count + 1));
@@ -13,38 +19,83 @@ void dup_table(
     /* Now copy each column separately */
     for (c = 0; c < column_count + 1; c ++) {
         ecs_table_column_t *column = &table->columns[c];
-        ecs_vector_params_t column_params = {.element_size = column->size};
-        column->data = ecs_vector_copy(column->data, &column_params);
+        column->data = ecs_table_copy_column(column);
+        column->refs = NULL;
+    }
+}
+
+/* Share columns of a table with the copied table. The columns are copied when
+ * the world writes to them, so that a snapshot only pays for the data that
+ * changes after it is taken. */
+static
+void share_table(
+    ecs_table_t *src,
+    ecs_table_t *table,
+    bool is_world)
+{
+    uint32_t c, column_count = ecs_vector_count(table->type);
+
+    table->flags &= ~EcsTableIsShared;
+    table->columns = ecs_os_memdup(
+        src->columns, sizeof(ecs_table_column_t) * (column_count + 1));
+
+    for (c = 0; c < column_count + 1; c ++) {
+        ecs_table_column_t *column = &src->columns[c];
+        if (!column->data) {
+            continue;
+        }
+
+        if (!column->refs) {
+            column->refs = ecs_os_malloc(sizeof(int32_t));
+            ecs_assert(column->refs != NULL, ECS_OUT_OF_MEMORY, NULL);
+            *column->refs = 1;
+        }
+
+        (*column->refs) ++;
+        table->columns[c].refs = column->refs;
+    }
+
+    /* Only tables in the world need to test if their data is shared */
+    if (is_world) {
+        src->flags |= EcsTableIsShared;
     }
 }
 
 static
 ecs_snapshot_t* snapshot_create(
     ecs_world_t *world,
-    const ecs_map_t *entity_index,
+    const ecs_ei_t *entity_index,
     const ecs_chunked_t *tables,
-    const ecs_filter_t *filter)
+    const ecs_filter_t *filter,
+    bool shared)
 {
     ecs_snapshot_t *result = ecs_os_malloc(sizeof(ecs_snapshot_t));
     ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
 
     /* Copy tables from world */
     result->tables = ecs_chunked_copy(tables);
+    result->shared = shared;
+    bool is_world = tables == world->main_stage.tables;
     
     if (filter || !entity_index) {
         result->filter = filter ? *filter : (ecs_filter_t){0};
         result->entity_index = NULL;
     } else {
         result->filter = (ecs_filter_t){0};
-        result->entity_index = ecs_map_copy(entity_index);
+        result->entity_index = ecs_ei_copy(entity_index);
     }
 
     /* We need to dup the table data, because right now the copied tables are
      * still pointing to columns in the main stage. */
     uint32_t i, count = ecs_chunked_count(result->tables);
+    uint64_t bloom = ecs_filter_bloom(filter);
     for (i = 0; i < count; i ++) {
         ecs_table_t *table = ecs_chunked_get(result->tables, ecs_table_t, i);
 
+        /* Tables in a snapshot are not matched with systems, so freeing the
+         * snapshot does not deactivate the tables in the world */
+        table->frame_systems = NULL;
+
         /* Skip tables with builtin components to avoid dropping critical data
          * like systems or components when restoring the snapshot */
         if (table->flags & EcsTableHasBuiltins) {
@@ -56,8 +107,16 @@ ecs_snapshot_t* snapshot_create(
             continue;
         }
 
-        if (!filter || ecs_type_match_w_filter(world, table->type, filter)) {
-            dup_table(table);
+        if (ecs_table_match_filter(world, table, filter, bloom)) {
+            ecs_table_t *src = ecs_chunked_get(tables, ecs_table_t, i);
+
+            /* Columns in a block or mapped file cannot be shared, as they are
+             * not allocated individually */
+            if (shared && !src->arena && !(src->flags & EcsTableIsMapped)) {
+                share_table(src, table, is_world);
+            } else {
+                dup_table(table);
+            }
         } else {
             /* If the table does not match the filter, instead of copying just
              * set the columns to NULL. This way the restore will ignore the
@@ -80,10 +139,32 @@ ecs_snapshot_t* ecs_snapshot_take(
             world,
             world->main_stage.entity_index,
             world->main_stage.tables,
-            filter);
+            filter,
+            false);
+
+    result->last_handle = world->last_handle;
+
+    return result;
+}
+
+/** Create a snapshot that shares columns with the world */
+ecs_snapshot_t* ecs_snapshot_take_shared(
+    ecs_world_t *world,
+    const ecs_filter_t *filter)
+{
+    ecs_snapshot_t *result = snapshot_create(
+            world,
+            world->main_stage.entity_index,
+            world->main_stage.tables,
+            filter,
+            true);
 
     result->last_handle = world->last_handle;
 
+    /* Systems copy shared data before they write to it. References are 
+     * resolved again, so that systems copy shared data they reference. */
+    world->should_resolve = true;
+
     return result;
 }
 
@@ -97,7 +178,8 @@ ecs_snapshot_t* ecs_snapshot_copy(
             world,
             snapshot->entity_index,
             snapshot->tables,
-            filter);
+            filter,
+            snapshot->shared);
 
     if (!filter) {
         result->filter = snapshot->filter;
@@ -124,7 +206,7 @@ void ecs_snapshot_restore(
     } else {
         /* If no filter was used, the entity index will be an exact copy of what
          * it was before taking the snapshot */
-        ecs_map_free(world->main_stage.entity_index);
+        ecs_ei_free(world->main_stage.entity_index);
         world->main_stage.entity_index = snapshot->entity_index;
     }   
 
@@ -151,14 +233,14 @@ void ecs_snapshot_restore(
             ecs_vector_t *entities = dst->columns[0].data;
             ecs_entity_t *array = ecs_vector_first(entities);
             uint32_t j, row_count = ecs_vector_count(entities);
-            ecs_map_t *entity_index = world->main_stage.entity_index;
+            ecs_ei_t *entity_index = world->main_stage.entity_index;
             
             for (j = 0; j < row_count; j ++) {
                 ecs_row_t row = {
                     .type = dst->type,
                     .index = j + 1
                 };
-                ecs_map_set(entity_index, array[j], &row);
+                ecs_ei_set(entity_index, array[j], &row);
             } 
         }
     }
@@ -174,6 +256,7 @@ void ecs_snapshot_restore(
 
     world->should_match = true;
     world->should_resolve = true;
+    ecs_name_index_invalidate(world);
 
     if (!filter_used) {
         world->last_handle = snapshot->last_handle;
@@ -188,7 +271,7 @@ void ecs_snapshot_free(
     ecs_snapshot_t *snapshot)
 {
     if (snapshot->entity_index) {
-        ecs_map_free(snapshot->entity_index);
+        ecs_ei_free(snapshot->entity_index);
     }
 
     uint32_t i, count = ecs_chunked_count(snapshot->tables);
@@ -205,3 +288,94 @@ void ecs_snapshot_free(
     ecs_chunked_free(snapshot->tables);
     ecs_os_free(snapshot);
 }
+
+/** Create a snapshot ring */
+ecs_snapshot_ring_t* ecs_snapshot_ring_new(
+    uint32_t size)
+{
+    ecs_assert(size != 0, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_snapshot_ring_t *result = ecs_os_calloc(1, sizeof(ecs_snapshot_ring_t));
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    result->snapshots = ecs_os_calloc(size, sizeof(ecs_snapshot_t*));
+    ecs_assert(result->snapshots != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    result->size = size;
+
+    return result;
+}
+
+/** Take a shared snapshot and add it to the ring */
+void ecs_snapshot_ring_push(
+    ecs_world_t *world,
+    ecs_snapshot_ring_t *ring)
+{
+    ecs_assert(ring != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    /* If the ring is full, the oldest snapshot is replaced */
+    if (ring->count == ring->size) {
+        ecs_snapshot_free(world, ring->snapshots[ring->first]);
+        ring->first = (ring->first + 1) % ring->size;
+        ring->count --;
+    }
+
+    uint32_t index = (ring->first + ring->count) % ring->size;
+    ring->snapshots[index] = ecs_snapshot_take_shared(world, NULL);
+    ring->count ++;
+}
+
+/** Return number of snapshots in ring */
+uint32_t ecs_snapshot_ring_count(
+    ecs_snapshot_ring_t *ring)
+{
+    ecs_assert(ring != NULL, ECS_INVALID_PARAMETER, NULL);
+    return ring->count;
+}
+
+/** Restore snapshot in ring, and free snapshots that are newer */
+bool ecs_snapshot_ring_rollback(
+    ecs_world_t *world,
+    ecs_snapshot_ring_t *ring,
+    uint32_t age)
+{
+    ecs_assert(ring != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    if (age >= ring->count) {
+        return false;
+    }
+
+    /* Free snapshots that were taken after the restored snapshot */
+    while (age) {
+        uint32_t last = (ring->first + ring->count - 1) % ring->size;
+        ecs_snapshot_free(world, ring->snapshots[last]);
+        ring->snapshots[last] = NULL;
+        ring->count --;
+        age --;
+    }
+
+    /* Restoring a snapshot consumes it, so restore a copy. The copy shares its
+     * data with the snapshot in the ring. */
+    uint32_t last = (ring->first + ring->count - 1) % ring->size;
+    ecs_snapshot_t *snapshot = ecs_snapshot_copy(
+        world, ring->snapshots[last], NULL);
+    ecs_snapshot_restore(world, snapshot);
+
+    return true;
+}
+
+/** Free snapshot ring and its snapshots */
+void ecs_snapshot_ring_free(
+    ecs_world_t *world,
+    ecs_snapshot_ring_t *ring)
+{
+    ecs_assert(ring != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    uint32_t i;
+    for (i = 0; i < ring->count; i ++) {
+        ecs_snapshot_free(world, ring->snapshots[(ring->first + i) % ring->size]);
+    }
+
+    ecs_os_free(ring->snapshots);
+    ecs_os_free(ring);
+}
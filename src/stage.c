@@ -1,5 +1,90 @@
 #include "flecs_private.h"
 
+static
+const ecs_vector_params_t staged_entity_params = {
+    .element_size = sizeof(ecs_staged_entity_t)
+};
+
+static
+const ecs_vector_params_t entity_arr_params = {
+    .element_size = sizeof(ecs_entity_t)
+};
+
+/* -- Stage arena --
+ * Staged columns are only needed until the stage is merged, after which they
+ * are all released at once. Instead of allocating each array separately, they
+ * are allocated from blocks owned by the stage. When a frame does not fit in
+ * the current block a new block is added, and on reset the blocks are replaced
+ * with a single block that is large enough for the whole frame. After a few
+ * frames the stage no longer allocates memory for staged data. */
+
+/* Minimum size of a block */
+#define ECS_STAGE_BLOCK_SIZE (64 * 1024)
+
+/* Alignment of allocations served from a block */
+#define ECS_STAGE_ALIGNMENT (16)
+
+struct ecs_stage_block_t {
+    ecs_stage_block_t *prev;       /* Previous block */
+    size_t size;                   /* Size of block, excluding header */
+};
+
+#define ECS_STAGE_BLOCK_HEADER\
+    (((sizeof(ecs_stage_block_t) - 1) / ECS_STAGE_ALIGNMENT + 1) *\
+        ECS_STAGE_ALIGNMENT)
+
+static
+void arena_add_block(
+    ecs_world_t *world,
+    ecs_stage_arena_t *arena,
+    size_t size)
+{
+    ecs_stage_block_t *block = ecs_world_alloc(
+        world, ECS_STAGE_ALIGNMENT, ECS_STAGE_BLOCK_HEADER + size);
+
+    block->prev = arena->block;
+    block->size = size;
+    arena->block = block;
+    arena->used = 0;
+    arena->block_count ++;
+}
+
+static
+void arena_free_blocks(
+    ecs_world_t *world,
+    ecs_stage_arena_t *arena)
+{
+    ecs_stage_block_t *block = arena->block;
+    while (block) {
+        ecs_stage_block_t *prev = block->prev;
+        ecs_world_free(world, block, ECS_STAGE_ALIGNMENT, 
+            ECS_STAGE_BLOCK_HEADER + block->size);
+        block = prev;
+    }
+
+    arena->block = NULL;
+    arena->used = 0;
+}
+
+/* Release all allocations. If the last frame needed more than one block, the
+ * blocks are replaced with one block that can store all of its data. */
+static
+void arena_reset(
+    ecs_world_t *world,
+    ecs_stage_arena_t *arena)
+{
+    ecs_stage_block_t *block = arena->block;
+
+    if (block && block->prev) {
+        size_t size = arena->allocd;
+        arena_free_blocks(world, arena);
+        arena_add_block(world, arena, size);
+    }
+
+    arena->used = 0;
+    arena->allocd = 0;
+}
+
 static
 void merge_families(
     ecs_world_t *world,
@@ -32,47 +117,180 @@ void notify_new_tables(
 
 static
 void clean_data_stage(
+    ecs_world_t *world,
     ecs_stage_t *stage)
 {
-    ecs_map_iter_t it = ecs_map_iter(stage->data_stage);
-    while (ecs_map_hasnext(&it)) {
-        uint64_t keyval;
-        ecs_table_column_t *columns = 
-            *(ecs_table_column_t**)ecs_map_next_w_key(&it, &keyval);
-        
-        ecs_type_t type = (ecs_type_t)(uintptr_t)keyval;
-        uint32_t i, count = ecs_vector_count(type);
-        
-        for(i = 0; i < count + 1; i ++) {
-            ecs_vector_free(columns[i].data);
+    /* Staged values are not deleted while in progress. Destruct them before
+     * the arena releases their storage. */
+    if (ecs_map_count(world->component_lifecycle)) {
+        ecs_map_iter_t it = ecs_map_iter(stage->data_stage);
+        while (ecs_map_hasnext(&it)) {
+            uint64_t key;
+            ecs_table_column_t *columns = ecs_map_nextptr_w_key(&it, &key);
+            ecs_table_destruct_columns((ecs_type_t)(uintptr_t)key, columns);
         }
-
-        ecs_os_free(columns);
     }
 
-    ecs_map_clear(stage->entity_index);
+    /* Staged columns are allocated from the arena */
+    arena_reset(world, &stage->arena);
+
+    ecs_ei_clear(stage->entity_index);
+    ecs_vector_clear(stage->delete_merge);
     ecs_map_clear(stage->remove_merge);
     ecs_map_clear(stage->data_stage);
 }
 
+static
+int compare_staged_entity(
+    const void *p1,
+    const void *p2)
+{
+    const ecs_staged_entity_t *e1 = p1;
+    const ecs_staged_entity_t *e2 = p2;
+
+    uintptr_t k1 = (uintptr_t)e1->main_row.type;
+    uintptr_t k2 = (uintptr_t)e2->main_row.type;
+    if (k1 == k2) {
+        k1 = (uintptr_t)e1->staged_row.type;
+        k2 = (uintptr_t)e2->staged_row.type;
+        if (k1 == k2) {
+            k1 = (uintptr_t)e1->to_remove;
+            k2 = (uintptr_t)e2->to_remove;
+            if (k1 == k2) {
+                return (e1->entity > e2->entity) - (e1->entity < e2->entity);
+            }
+        }
+    }
+
+    return (k1 > k2) - (k1 < k2);
+}
+
+/* Radix sort entity ids. Bytes that are the same for all ids are skipped, so
+ * ids that fit in 32 bits only take up to 4 passes. */
+static
+void sort_entities(
+    ecs_entity_t *ids,
+    ecs_entity_t *tmp,
+    uint32_t count)
+{
+    ecs_entity_t *src = ids, *dst = tmp;
+    uint32_t i, byte;
+
+    for (byte = 0; byte < sizeof(ecs_entity_t); byte ++) {
+        uint32_t offsets[256] = {0};
+        uint32_t shift = byte * 8, offset = 0;
+
+        for (i = 0; i < count; i ++) {
+            offsets[(src[i] >> shift) & 0xFF] ++;
+        }
+
+        if (offsets[(src[0] >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        for (i = 0; i < 256; i ++) {
+            uint32_t n = offsets[i];
+            offsets[i] = offset;
+            offset += n;
+        }
+
+        for (i = 0; i < count; i ++) {
+            dst[offsets[(src[i] >> shift) & 0xFF] ++] = src[i];
+        }
+
+        ecs_entity_t *t = src;
+        src = dst;
+        dst = t;
+    }
+
+    if (src != ids) {
+        memcpy(ids, src, count * sizeof(ecs_entity_t));
+    }
+}
+
+static
+bool same_merge_group(
+    ecs_staged_entity_t *e1,
+    ecs_staged_entity_t *e2)
+{
+    return e1->main_row.type == e2->main_row.type &&
+           e1->staged_row.type == e2->staged_row.type &&
+           e1->to_remove == e2->to_remove;
+}
+
 static
 void merge_commits(
     ecs_world_t *world,
     ecs_stage_t *stage)
 {  
-    if (!ecs_map_count(stage->entity_index)) {
+    if (!ecs_ei_count(stage->entity_index)) {
         return;
     }
 
-    ecs_map_iter_t it = ecs_map_iter(stage->entity_index);
+    /* Stages do not store rows in pages, so all rows are in the hashmap */
+    ecs_assert(!stage->entity_index->is_paged, ECS_INTERNAL_ERROR, NULL);
+    ecs_map_t *staged_rows = stage->entity_index->hi;
+    ecs_ei_t *main_index = world->main_stage.entity_index;
+    uint32_t i, count = ecs_map_count(staged_rows);
+
+    /* The map does not return entities in order. Sort the ids first, so that
+     * entities are merged in the order of their ids, and the tables they are
+     * moved to keep entities in that order. The second half of the array is
+     * used as temporary storage for the sort. */
+    ecs_vector_set_count(&stage->merge_ids, &entity_arr_params, count * 2);
+    ecs_entity_t *ids = ecs_vector_first(stage->merge_ids);
+
+    ecs_map_iter_t it = ecs_map_iter(staged_rows);
+    for (i = 0; ecs_map_hasnext(&it); i ++) {
+        ecs_map_next_w_key(&it, &ids[i]);
+    }
+
+    sort_entities(ids, &ids[count], count);
+
+    ecs_vector_clear(stage->merge_buffer);
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t entity = ids[i];
+        ecs_row_t *row = ecs_map_get_ptr(staged_rows, entity);
+        ecs_staged_entity_t *elem = ecs_vector_add(
+            &stage->merge_buffer, &staged_entity_params);
+
+        elem->entity = entity;
+        elem->staged_row = *row;
+        elem->to_remove = NULL;
+        ecs_map_has(stage->remove_merge, entity, &elem->to_remove);
+
+        if (!ecs_ei_has(main_index, entity, &elem->main_row) || 
+            !elem->main_row.index) 
+        {
+            elem->main_row = (ecs_row_t){0, 0};
+        }
+    }
+
+    /* Group entities that move between the same tables, so that each group
+     * can be moved with a single table lookup and bulk copies per column */
+    ecs_staged_entity_t *entities = ecs_vector_first(stage->merge_buffer);
+    qsort(entities, count, sizeof(ecs_staged_entity_t), compare_staged_entity);
+
+    uint32_t start = 0;
+    for (i = 1; i <= count; i ++) {
+        if (i == count || !same_merge_group(&entities[start], &entities[i])) {
+            ecs_merge_entities(world, stage, &entities[start], i - start);
+            start = i;
+        }
+    }
 
-    while (ecs_map_hasnext(&it)) {
-        ecs_entity_t entity;
-        ecs_row_t *row = ecs_map_next_w_key(&it, &entity);
-        ecs_merge_entity(world, stage, entity, *row);
+    /* Free ids of deleted entities, unless components were added to the
+     * entity after it was deleted */
+    ecs_entity_t *deleted = ecs_vector_first(stage->delete_merge);
+    count = ecs_vector_count(stage->delete_merge);
+    for (i = 0; i < count; i ++) {
+        if (!ecs_ei_get(world->main_stage.entity_index, deleted[i])) {
+            ecs_free_entity(world, deleted[i]);
+        }
     }
     
-    clean_data_stage(stage);
+    clean_data_stage(world, stage);
 }
 
 static
@@ -108,7 +326,7 @@ void ecs_stage_init(
 
     memset(stage, 0, sizeof(ecs_stage_t));
 
-    stage->entity_index = ecs_map_new(0, sizeof(ecs_row_t));
+    stage->entity_index = ecs_ei_new(is_main_stage);
 
     if (is_main_stage) {
         stage->last_link = &world->main_stage.type_root.link;
@@ -148,15 +366,19 @@ void ecs_stage_deinit(
     }
 
     if (!is_main_stage) {
-        clean_data_stage(stage);
+        clean_data_stage(world, stage);
         ecs_map_free(stage->data_stage);
         ecs_map_free(stage->remove_merge);
+        ecs_vector_free(stage->delete_merge);
+        ecs_vector_free(stage->merge_buffer);
+        ecs_vector_free(stage->merge_ids);
+        arena_free_blocks(world, &stage->arena);
     }
 
     clean_tables(world, stage);
     ecs_chunked_free(stage->tables);
     ecs_map_free(stage->table_index);
-    ecs_map_free(stage->entity_index);
+    ecs_ei_free(stage->entity_index);
 }
 
 void ecs_stage_merge(
@@ -187,3 +409,50 @@ void ecs_stage_merge(
         notify_new_tables(world, old_table_count, new_table_count);
     }
 }
+
+void* ecs_stage_alloc(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    size_t size)
+{
+    ecs_stage_arena_t *arena = &stage->arena;
+    ecs_stage_block_t *block = arena->block;
+
+    ecs_assert(size != 0, ECS_INVALID_PARAMETER, NULL);
+    size = ((size - 1) / ECS_STAGE_ALIGNMENT + 1) * ECS_STAGE_ALIGNMENT;
+
+    if (!block || arena->used + size > block->size) {
+        size_t block_size = ECS_STAGE_BLOCK_SIZE;
+        if (block && block_size < block->size * 2) {
+            block_size = block->size * 2;
+        }
+        if (block_size < size) {
+            block_size = size;
+        }
+
+        arena_add_block(world, arena, block_size);
+        block = arena->block;
+    }
+
+    void *result = ECS_OFFSET(block, ECS_STAGE_BLOCK_HEADER + arena->used);
+    arena->used += size;
+    arena->allocd += size;
+    arena->alloc_count ++;
+
+    return result;
+}
+
+void ecs_stage_arena_memory(
+    ecs_stage_t *stage,
+    uint32_t *allocd,
+    uint32_t *used)
+{
+    ecs_stage_block_t *block = stage->arena.block;
+
+    while (block) {
+        *allocd += ECS_STAGE_BLOCK_HEADER + block->size;
+        block = block->prev;
+    }
+
+    *used += stage->arena.allocd;
+}
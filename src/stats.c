@@ -112,7 +112,7 @@ void StatsCollectWorldStats(ecs_rows_t *rows) {
 
     ecs_world_t *world = rows->world;
 
-    stats->entities_count = ecs_map_count(world->main_stage.entity_index);
+    stats->entities_count = ecs_ei_count(world->main_stage.entity_index);
     stats->components_count = ecs_count(world, EcsComponent);
     stats->col_systems_count = ecs_count(world, EcsColSystem);
     stats->row_systems_count = ecs_count(world, EcsRowSystem);
@@ -135,6 +135,24 @@ void StatsCollectAllocStats(ecs_rows_t *rows) {
     stats->calloc_count_total = ecs_os_api_calloc_count;
     stats->realloc_count_total = ecs_os_api_realloc_count;
     stats->free_count_total = ecs_os_api_free_count;
+
+    ecs_world_t *world = rows->world;
+    stats->world_alloc_count_total = world->alloc_count;
+    stats->world_free_count_total = world->free_count;
+    stats->world_allocd_bytes = world->allocd_bytes;
+
+    /* Staged data is allocated from the arenas of the temporary stage and the
+     * worker stages */
+    stats->stage_alloc_count_total = world->temp_stage.arena.alloc_count;
+    stats->stage_block_count_total = world->temp_stage.arena.block_count;
+
+    uint32_t i, count = ecs_vector_count(world->worker_stages);
+    ecs_stage_t *stages = ecs_vector_first(world->worker_stages);
+
+    for (i = 0; i < count; i ++) {
+        stats->stage_alloc_count_total += stages[i].arena.alloc_count;
+        stats->stage_block_count_total += stages[i].arena.block_count;
+    }
 }
 
 static
@@ -187,7 +205,7 @@ void compute_stage_memory(
     ecs_stage_t *stage, 
     EcsMemoryStats *stats)
 {
-    ecs_map_memory(stage->entity_index, 
+    ecs_ei_memory(stage->entity_index, 
         &stats->entities_memory.allocd_bytes, 
         &stats->entities_memory.used_bytes);
 
@@ -202,6 +220,9 @@ void compute_stage_memory(
 
     ecs_map_memory(stage->remove_merge,
         &stats->stages_memory.allocd_bytes, &stats->stages_memory.used_bytes);
+
+    ecs_stage_arena_memory(stage,
+        &stats->stages_memory.allocd_bytes, &stats->stages_memory.used_bytes);
 }
 
 static
@@ -262,6 +283,16 @@ void compute_world_memory(
     ecs_map_memory(world->type_sys_set_index, 
         &stats->systems_memory.allocd_bytes, &stats->systems_memory.used_bytes);
 
+    /* Add indices to find tables and systems for matching to system memory */
+    ecs_map_memory(world->component_tables, 
+        &stats->systems_memory.allocd_bytes, &stats->systems_memory.used_bytes);
+    ecs_vector_memory(world->prefab_tables, &table_index_arr_params, 
+        &stats->systems_memory.allocd_bytes, &stats->systems_memory.used_bytes);
+    ecs_map_memory(world->component_systems, 
+        &stats->systems_memory.allocd_bytes, &stats->systems_memory.used_bytes);
+    ecs_vector_memory(world->unkeyed_systems, &handle_arr_params, 
+        &stats->systems_memory.allocd_bytes, &stats->systems_memory.used_bytes);
+
     /* Add table array to table memory */
     ecs_chunked_memory(world->main_stage.tables,
         &stats->tables_memory.allocd_bytes, &stats->tables_memory.used_bytes);
@@ -273,6 +304,10 @@ void compute_world_memory(
         &stats->world_memory.allocd_bytes, &stats->world_memory.used_bytes);
     ecs_map_memory(world->type_handles, 
         &stats->world_memory.allocd_bytes, &stats->world_memory.used_bytes);   
+    ecs_map_memory(world->name_index, 
+        &stats->world_memory.allocd_bytes, &stats->world_memory.used_bytes);
+    ecs_map_memory(world->component_lifecycle, 
+        &stats->world_memory.allocd_bytes, &stats->world_memory.used_bytes);
 
     stats->stages_memory = (ecs_memory_stat_t){0};
     
@@ -304,7 +339,7 @@ void StatsCollectMemoryStats(ecs_rows_t *rows) {
 
     /* Compute entity memory (entity index) */
     stats->entities_memory = (ecs_memory_stat_t){0};
-    ecs_map_memory(world->main_stage.entity_index, 
+    ecs_ei_memory(world->main_stage.entity_index, 
         &stats->entities_memory.allocd_bytes, 
         &stats->entities_memory.used_bytes);
     
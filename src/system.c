@@ -102,6 +102,9 @@ ecs_entity_t new_row_system(
 
     *id_data = id;
 
+    ecs_world_t *real_world = world;
+    ecs_name_index_add(world, ecs_get_stage(&real_world), result, id);
+
     EcsRowSystem *system_data = ecs_get_ptr(world, result, EcsRowSystem);
     memset(system_data, 0, sizeof(EcsRowSystem));
     system_data->base.action = action;
@@ -426,6 +429,7 @@ int ecs_parse_signature_action(
     ecs_system_expr_elem_kind_t elem_kind,
     ecs_system_expr_oper_kind_t oper_kind,
     ecs_system_expr_inout_kind_t inout_kind,
+    bool if_changed,
     const char *component_id,
     const char *source_id,
     void *data)
@@ -453,8 +457,13 @@ int ecs_parse_signature_action(
         elem->kind = elem_kind;
         elem->oper_kind = oper_kind;
         elem->inout_kind = inout_kind;
+        elem->if_changed = if_changed;
         elem->is.component = component;
 
+        if (if_changed) {
+            system_data->if_changed = true;
+        }
+
         if (elem_kind == EcsFromEntity) {
             elem->source = ecs_lookup(world, source_id);
             if (!elem->source) {
@@ -571,6 +580,15 @@ ecs_type_t ecs_notify_row_system(
             /* If a regular column, find corresponding column in table */
             columns[i] = ecs_type_index_of(type, buffer[i].is.component) + 1;
 
+            /* Copy the column if the system writes to data that is shared
+             * with a snapshot */
+            if (columns[i] && table && table->flags & EcsTableIsShared &&
+                table_columns == table->columns && 
+                buffer[i].inout_kind != EcsIn)
+            {
+                ecs_table_unshare_column(real_world, table, columns[i]);
+            }
+
             if (!columns[i] && table) {
                 /* If column is not found, it could come from a prefab. Look for
                  * components of components */
@@ -626,6 +644,7 @@ ecs_type_t ecs_notify_row_system(
         .offset = offset,
         .count = limit,
         .param = system_data->base.ctx,
+        .system_ctx = system_data->base.ctx,
         .system_data = &system_data->base
     };
 
@@ -1090,7 +1109,9 @@ void* ecs_table_column(
     uint32_t column)
 {
     ecs_table_t *table = rows->table;
-    return ecs_vector_first(table->columns[column + 1].data);
+    ecs_table_column_t *table_column = &table->columns[column + 1];
+    void *buffer = ecs_vector_first(table_column->data);
+    return ECS_OFFSET(buffer, table_column->size * rows->offset);
 }
 
 static
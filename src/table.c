@@ -23,18 +23,15 @@ void activate_table(
     }
 }
 
+/** Initialize zero-initialized columns for a type */
 static
-ecs_table_column_t* new_columns(
+void init_columns(
     ecs_world_t *world,
     ecs_stage_t *stage,
     ecs_table_t *table,
-    ecs_type_t type)
+    ecs_type_t type,
+    ecs_table_column_t *result)
 {
-    ecs_table_column_t *result = ecs_os_calloc(
-        sizeof(ecs_table_column_t), ecs_vector_count(type) + 1);
-
-    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
-
     ecs_entity_t *buf = ecs_vector_first(type);
     uint32_t i, count = ecs_vector_count(type);
 
@@ -51,6 +48,8 @@ ecs_table_column_t* new_columns(
             if (component->size) {
                 /* Regular column data */
                 result[i + 1].size = component->size;
+                ecs_map_has(world->component_lifecycle, buf[i], 
+                    &result[i + 1].lifecycle);
             }
         }
 
@@ -58,16 +57,675 @@ ecs_table_column_t* new_columns(
             table->flags |= EcsTableHasBuiltins;
         }        
 
+        if (table && buf[i] == EEcsId) {
+            table->flags |= EcsTableHasId;
+        }
+
         if (table && buf[i] == EEcsPrefab) {
             table->flags |= EcsTableIsPrefab;
         }
+
+        if (table && buf[i] & ECS_INSTANCEOF) {
+            table->flags |= EcsTableHasPrefab;
+        }
     }
+}
+
+static
+ecs_table_column_t* new_columns(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_table_t *table,
+    ecs_type_t type)
+{
+    ecs_table_column_t *result = ecs_os_calloc(
+        sizeof(ecs_table_column_t), ecs_vector_count(type) + 1);
+
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    init_columns(world, stage, table, type, result);
     
     return result;
 }
 
+/** Allocate columns for staged data from the stage arena. The columns are
+ * released when the stage is merged. */
+static
+ecs_table_column_t* new_staged_columns(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_table_t *table,
+    ecs_type_t type)
+{
+    size_t size = sizeof(ecs_table_column_t) * (ecs_vector_count(type) + 1);
+    ecs_table_column_t *result = ecs_stage_alloc(world, stage, size);
+    memset(result, 0, size);
+
+    init_columns(world, stage, table, type, result);
+
+    return result;
+}
+
+/* -- Component lifecycle --
+ * Values of components with lifecycle callbacks are constructed when rows are
+ * added, and destructed when rows are removed. Values that change location are
+ * moved with the move callback. This includes values that move when a column
+ * grows, so columns of components with a move callback are grown here instead
+ * of being reallocated by the vector. */
+
+/** Move values to uninitialized memory, and destruct the source values */
+static
+void relocate_values(
+    ecs_lifecycle_t *lc,
+    void *dst,
+    void *src,
+    uint32_t size,
+    uint32_t count)
+{
+    if (lc && lc->callbacks.move) {
+        ecs_lifecycle_ctor(lc, dst, size, count);
+        ecs_lifecycle_move(lc, dst, src, size, count);
+        ecs_lifecycle_dtor(lc, src, size, count);
+    } else {
+        memcpy(dst, src, size * count);
+    }
+}
+
+/** Swap two values, using tmp as temporary storage */
+static
+void swap_values(
+    ecs_lifecycle_t *lc,
+    void *el_1,
+    void *el_2,
+    void *tmp,
+    uint32_t size)
+{
+    if (lc && lc->callbacks.move) {
+        relocate_values(lc, tmp, el_1, size, 1);
+        ecs_lifecycle_ctor(lc, el_1, size, 1);
+        ecs_lifecycle_move(lc, el_1, el_2, size, 1);
+        ecs_lifecycle_move(lc, el_2, tmp, size, 1);
+        ecs_lifecycle_dtor(lc, tmp, size, 1);
+    } else {
+        memcpy(tmp, el_1, size);
+        memcpy(el_1, el_2, size);
+        memcpy(el_2, tmp, size);
+    }
+}
+
+/** Move the values of a column to a new vector that can store size values */
+static
+ecs_vector_t* relocate_column(
+    ecs_table_column_t *column,
+    uint32_t size)
+{
+    ecs_vector_params_t params = {.element_size = column->size};
+    uint32_t count = ecs_vector_count(column->data);
+
+    ecs_vector_t *vector = ecs_vector_new(&params, size);
+    if (count) {
+        ecs_vector_set_count(&vector, &params, count);
+        relocate_values(column->lifecycle, ecs_vector_first(vector), 
+            ecs_vector_first(column->data), column->size, count);
+    }
+
+    return vector;
+}
+
+/** Make sure that count values can be added to a column without reallocating
+ * the vector, if the values of the column must be moved with a callback. */
+static
+void column_reserve(
+    ecs_table_column_t *column,
+    uint32_t count)
+{
+    ecs_lifecycle_t *lc = column->lifecycle;
+    if (!lc || !lc->callbacks.move) {
+        return;
+    }
+
+    uint32_t size = ecs_vector_size(column->data);
+    uint32_t new_count = ecs_vector_count(column->data) + count;
+
+    if (new_count <= size) {
+        return;
+    }
+
+    if (!size) {
+        size = count;
+    } else {
+        while (size < new_count) {
+            size *= 2;
+        }
+    }
+
+    ecs_vector_t *vector = relocate_column(column, size);
+    ecs_vector_free(column->data);
+    column->data = vector;
+}
+
+/* -- Arena storage --
+ * Tables in worlds that enabled ecs_set_table_arena store all columns in a
+ * single block. Each column keeps its vector header, which is placed in the
+ * block so that the column data starts at an ECS_TABLE_ALIGNMENT boundary. The
+ * vectors in the block cannot be reallocated, so before rows are added to the
+ * table the block is resized with arena_reserve, which moves all columns to a
+ * new block with a single allocation.
+ *
+ * Tables loaded with ecs_load_file store columns in a mapped file, with the
+ * vector header stored in front of the column data in the file. These vectors
+ * are not owned by the table, and are copied to regular vectors before they
+ * are grown or moved. The block of a mapped table stores the columns that are
+ * not stored in the file. */
+
+/** Returns whether the column vectors of a table are allocated individually */
+static
+bool owns_vectors(
+    ecs_table_t *table)
+{
+    return !table->arena && !(table->flags & EcsTableIsMapped);
+}
+
+/** Release data of a column. Data that is shared with other tables is only
+ * destructed and freed when the last table releases it. */
+static
+void release_column(
+    ecs_table_column_t *column,
+    bool free_vector)
+{
+    ecs_lifecycle_t *lc = column->lifecycle;
+
+    if (column->refs) {
+        if (!-- (*column->refs)) {
+            if (lc) {
+                ecs_lifecycle_dtor(lc, ecs_vector_first(column->data), 
+                    column->size, ecs_vector_count(column->data));
+            }
+            ecs_vector_free(column->data);
+            ecs_os_free(column->refs);
+        }
+        column->refs = NULL;
+    } else {
+        if (lc) {
+            ecs_lifecycle_dtor(lc, ecs_vector_first(column->data), 
+                column->size, ecs_vector_count(column->data));
+        }
+        if (free_vector) {
+            ecs_vector_free(column->data);
+        }
+    }
+
+    column->data = NULL;
+}
+
+/** Continue the change counters of replaced columns, so that a counter never
+ * returns to a value that a system has already seen. Replaced columns keep the
+ * lifecycle callbacks of the table. */
+static
+void carry_column_state(
+    ecs_table_t *table,
+    ecs_table_column_t *old_columns,
+    ecs_table_column_t *new_columns)
+{
+    uint32_t i, column_count = ecs_vector_count(table->type);
+    for (i = 0; i < column_count + 1; i ++) {
+        new_columns[i].change_count = old_columns[i].change_count + 1;
+        new_columns[i].lifecycle = old_columns[i].lifecycle;
+    }
+}
+
+/** Copy shared columns before the main stage writes to a table */
+static
+void unshare_main(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_table_column_t *columns)
+{
+    if (columns == table->columns && table->flags & EcsTableIsShared) {
+        ecs_table_unshare(world, table);
+    }
+}
+
+static
+size_t arena_column_offset(
+    size_t offset)
+{
+    size_t data_offset = offset + ECS_VECTOR_HEADER_SIZE;
+    data_offset = ((data_offset - 1) / ECS_TABLE_ALIGNMENT + 1) * 
+        ECS_TABLE_ALIGNMENT;
+    return data_offset - ECS_VECTOR_HEADER_SIZE;
+}
+
+/** Move columns to a new block that can store size rows. If the table did not
+ * have a block yet, the columns are regular vectors which are freed. Values
+ * are moved out of the old columns, so the old storage is freed without
+ * destructing its values. */
+static
+void arena_resize(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    uint32_t size)
+{
+    ecs_table_column_t *columns = table->columns;
+    uint32_t i, column_count = ecs_vector_count(table->type) + 1;
+    size_t offset = 0;
+
+    ecs_assert(size != 0, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(!(table->flags & EcsTableIsMapped), ECS_INTERNAL_ERROR, NULL);
+
+    /* Values of columns that are shared with a snapshot must not be moved out
+     * of the snapshot, so copy them first */
+    if (table->flags & EcsTableIsShared) {
+        ecs_assert(!table->arena, ECS_INTERNAL_ERROR, NULL);
+        ecs_table_unshare(world, table);
+    }
+
+    bool free_vectors = !table->arena;
+
+    for (i = 0; i < column_count; i ++) {
+        if (columns[i].size) {
+            offset = arena_column_offset(offset) + 
+                ECS_VECTOR_HEADER_SIZE + size * columns[i].size;
+        }
+    }
+
+    void *arena = ecs_world_alloc(world, ECS_TABLE_ALIGNMENT, offset);
+    uintptr_t start = (uintptr_t)arena;
+    size_t arena_size = offset;
+
+    offset = 0;
+    for (i = 0; i < column_count; i ++) {
+        uint32_t column_size = columns[i].size;
+        if (!column_size) {
+            continue;
+        }
+
+        ecs_vector_params_t params = {.element_size = column_size};
+        ecs_vector_t *old_vector = columns[i].data;
+        uint32_t count = ecs_vector_count(old_vector);
+
+        offset = arena_column_offset(offset);
+        ecs_vector_t *vector = ecs_vector_new_in_place(
+            &params, size, ECS_OFFSET(start, offset));
+
+        if (count) {
+            ecs_assert(count <= size, ECS_INTERNAL_ERROR, NULL);
+            relocate_values(columns[i].lifecycle, ecs_vector_first(vector), 
+                ecs_vector_first(old_vector), column_size, count);
+            ecs_vector_set_count(&vector, &params, count);
+        }
+
+        if (free_vectors) {
+            ecs_vector_free(old_vector);
+        }
+
+        columns[i].data = vector;
+        offset += ECS_VECTOR_HEADER_SIZE + size * column_size;
+    }
+
+    ecs_world_free(world, table->arena, ECS_TABLE_ALIGNMENT, table->arena_size);
+    table->arena = arena;
+    table->arena_size = arena_size;
+
+    /* Component data moved, so cached references must be resolved again */
+    world->should_resolve = true;
+}
+
+/** Replace columns in the block with regular vectors, so that they can be moved
+ * to other tables. */
+static
+void arena_detach(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    if (owns_vectors(table)) {
+        return;
+    }
+
+    ecs_table_column_t *columns = table->columns;
+    uint32_t i, column_count = ecs_vector_count(table->type) + 1;
+
+    for (i = 0; i < column_count; i ++) {
+        if (columns[i].lifecycle && columns[i].lifecycle->callbacks.move) {
+            columns[i].data = relocate_column(
+                &columns[i], ecs_vector_count(columns[i].data));
+        } else if (columns[i].size) {
+            ecs_vector_params_t params = {.element_size = columns[i].size};
+            columns[i].data = ecs_vector_copy(columns[i].data, &params);
+        }
+    }
+
+    ecs_world_free(world, table->arena, ECS_TABLE_ALIGNMENT, table->arena_size);
+    table->arena = NULL;
+    table->arena_size = 0;
+    table->flags &= ~EcsTableIsMapped;
+}
+
+/** Copy columns of a mapped table to regular vectors, so they can be grown */
+static
+void mapped_detach(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    if (table->flags & EcsTableIsMapped) {
+        arena_detach(world, table);
+
+        /* Component data moved, so cached references must be resolved again */
+        world->should_resolve = true;
+    }
+}
+
+/** Make sure that count rows can be added to the columns of an arena table
+ * without reallocating the column vectors. */
+static
+void arena_reserve(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_table_column_t *columns,
+    uint32_t count)
+{
+    if (columns != table->columns) {
+        return;
+    }
+
+    unshare_main(world, table, columns);
+
+    if (count) {
+        mapped_detach(world, table);
+    }
+
+    if (!(table->flags & EcsTableIsArena)) {
+        return;
+    }
+
+    uint32_t size = ecs_vector_size(columns[0].data);
+    uint32_t new_count = ecs_vector_count(columns[0].data) + count;
+
+    if (new_count > size) {
+        if (!size) {
+            size = count;
+        } else {
+            while (size < new_count) {
+                size *= 2;
+            }
+        }
+    } else if (table->arena || !new_count) {
+        return;
+    }
+
+    arena_resize(world, table, size);
+}
+
+/* -- Staged columns --
+ * Column vectors of staged data are allocated from the arena of the stage, so
+ * they cannot be reallocated. When rows are added to a full column, the column
+ * vectors are copied to a larger allocation. The old allocation is released
+ * together with the rest of the arena when the stage is merged. */
+
+/** Move staged column vectors to allocations that can store size rows */
+static
+void staged_resize(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_table_t *table,
+    ecs_table_column_t *columns,
+    uint32_t size)
+{
+    uint32_t i, column_count = ecs_vector_count(table->type) + 1;
+
+    for (i = 0; i < column_count; i ++) {
+        uint32_t column_size = columns[i].size;
+        if (!column_size) {
+            continue;
+        }
+
+        ecs_vector_params_t params = {.element_size = column_size};
+        ecs_vector_t *old_vector = columns[i].data;
+        uint32_t count = ecs_vector_count(old_vector);
+
+        ecs_vector_t *vector = ecs_vector_new_in_place(&params, size, 
+            ecs_stage_alloc(world, stage, 
+                ECS_VECTOR_HEADER_SIZE + size * column_size));
+
+        if (count) {
+            relocate_values(columns[i].lifecycle, ecs_vector_first(vector), 
+                ecs_vector_first(old_vector), column_size, count);
+            ecs_vector_set_count(&vector, &params, count);
+        }
+
+        columns[i].data = vector;
+    }
+}
+
+/** Make sure that count rows can be added to staged columns without
+ * reallocating the column vectors. */
+static
+void staged_reserve(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_table_t *table,
+    ecs_table_column_t *columns,
+    uint32_t count)
+{
+    if (columns == table->columns) {
+        return;
+    }
+
+    ecs_assert(stage != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    uint32_t size = ecs_vector_size(columns[0].data);
+    uint32_t new_count = ecs_vector_count(columns[0].data) + count;
+
+    if (new_count <= size) {
+        return;
+    }
+
+    if (!size) {
+        size = count;
+    } else {
+        while (size < new_count) {
+            size *= 2;
+        }
+    }
+
+    staged_resize(world, stage, table, columns, size);
+}
+
+/** Get edge for component. If create is false and the edge does not exist yet,
+ * NULL is returned. */
+static
+ecs_edge_t* get_edge(
+    ecs_table_t *table,
+    ecs_entity_t component,
+    bool create)
+{
+    if (component < ECS_HI_COMPONENT_ID) {
+        if (!table->lo_edges) {
+            if (!create) {
+                return NULL;
+            }
+
+            table->lo_edges = ecs_os_calloc(
+                sizeof(ecs_edge_t), ECS_HI_COMPONENT_ID);
+            ecs_assert(table->lo_edges != NULL, ECS_OUT_OF_MEMORY, NULL);
+        }
+
+        return &table->lo_edges[component];
+    } else {
+        if (!table->hi_edges) {
+            if (!create) {
+                return NULL;
+            }
+
+            table->hi_edges = ecs_map_new(0, sizeof(ecs_edge_t));
+        }
+
+        ecs_edge_t *edge = ecs_map_get_ptr(table->hi_edges, component);
+        if (!edge && create) {
+            ecs_map_set(table->hi_edges, component, &((ecs_edge_t){0}));
+            edge = ecs_map_get_ptr(table->hi_edges, component);
+        }
+
+        return edge;
+    }
+}
+
 /* -- Private functions -- */
 
+void ecs_lifecycle_ctor(
+    ecs_lifecycle_t *lc,
+    void *ptr,
+    uint32_t size,
+    uint32_t count)
+{
+    if (!lc || !count) {
+        return;
+    }
+
+    if (lc->callbacks.ctor) {
+        lc->callbacks.ctor(lc->world, lc->component, ptr, size, count, 
+            lc->callbacks.ctx);
+    } else {
+        memset(ptr, 0, size * count);
+    }
+}
+
+void ecs_lifecycle_dtor(
+    ecs_lifecycle_t *lc,
+    void *ptr,
+    uint32_t size,
+    uint32_t count)
+{
+    if (lc && lc->callbacks.dtor && count) {
+        lc->callbacks.dtor(lc->world, lc->component, ptr, size, count, 
+            lc->callbacks.ctx);
+    }
+}
+
+void ecs_lifecycle_copy(
+    ecs_lifecycle_t *lc,
+    void *dst,
+    const void *src,
+    uint32_t size,
+    uint32_t count)
+{
+    if (lc && lc->callbacks.copy) {
+        lc->callbacks.copy(lc->world, lc->component, dst, src, size, count, 
+            lc->callbacks.ctx);
+    } else {
+        memcpy(dst, src, size * count);
+    }
+}
+
+void ecs_lifecycle_move(
+    ecs_lifecycle_t *lc,
+    void *dst,
+    void *src,
+    uint32_t size,
+    uint32_t count)
+{
+    if (!lc) {
+        memcpy(dst, src, size * count);
+    } else if (lc->callbacks.move) {
+        lc->callbacks.move(lc->world, lc->component, dst, src, size, count, 
+            lc->callbacks.ctx);
+    } else {
+        /* Without a move callback the values are copied with memcpy, which
+         * transfers ownership of resources to dst. Reinitialize src so that it
+         * can be destructed. */
+        ecs_lifecycle_dtor(lc, dst, size, count);
+        memcpy(dst, src, size * count);
+        ecs_lifecycle_ctor(lc, src, size, count);
+    }
+}
+
+void ecs_table_destruct_columns(
+    ecs_type_t type,
+    ecs_table_column_t *columns)
+{
+    uint32_t i, column_count = ecs_vector_count(type);
+    for (i = 1; i < column_count + 1; i ++) {
+        ecs_table_column_t *column = &columns[i];
+        if (column->lifecycle) {
+            ecs_lifecycle_dtor(column->lifecycle, 
+                ecs_vector_first(column->data), column->size, 
+                ecs_vector_count(column->data));
+        }
+    }
+}
+
+ecs_vector_t* ecs_table_copy_column(
+    ecs_table_column_t *column)
+{
+    ecs_vector_params_t params = {.element_size = column->size};
+    ecs_vector_t *result = ecs_vector_copy(column->data, &params);
+    ecs_lifecycle_t *lc = column->lifecycle;
+
+    if (lc && lc->callbacks.copy) {
+        uint32_t count = ecs_vector_count(result);
+        void *dst = ecs_vector_first(result);
+        ecs_lifecycle_ctor(lc, dst, column->size, count);
+        ecs_lifecycle_copy(
+            lc, dst, ecs_vector_first(column->data), column->size, count);
+    }
+
+    return result;
+}
+
+ecs_table_t* ecs_table_traverse(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_table_t *table,
+    ecs_type_t to_add,
+    ecs_type_t to_remove)
+{
+    ecs_type_t type = to_add ? to_add : to_remove;
+
+    /* Edges are only stored for adding or removing a single component */
+    if ((to_add && to_remove) || ecs_vector_count(type) != 1) {
+        type = ecs_type_merge_intern(
+            world, stage, table->type, to_add, to_remove);
+        return type ? ecs_world_get_table(world, stage, type) : NULL;
+    }
+
+    /* Edges are only created for tables in the main stage, when not in 
+     * progress. This guarantees that edges are never written to while worker
+     * threads are reading them, and that edges only point to tables that are
+     * stored in the main stage, which are never moved or freed before the
+     * world is deleted. */
+    bool can_create = !world->in_progress && stage == &world->main_stage;
+
+    ecs_entity_t component = *(ecs_entity_t*)ecs_vector_first(type);
+    ecs_edge_t *edge = get_edge(table, component, can_create);
+
+    if (edge) {
+        ecs_table_t *result = to_add ? edge->add : edge->remove;
+        if (result) {
+            return result;
+        }
+    }
+
+    /* Removing the last component results in a NULL type, which can't be 
+     * stored in an edge. This is not a problem, as ecs_type_merge_intern
+     * returns immediately in this case. */
+    type = ecs_type_merge_intern(world, stage, table->type, to_add, to_remove);
+    if (!type) {
+        return NULL;
+    }
+
+    ecs_table_t *result = ecs_world_get_table(world, stage, type);
+
+    if (edge && can_create) {
+        if (to_add) {
+            edge->add = result;
+        } else {
+            edge->remove = result;
+        }
+    }
+
+    return result;
+}
+
 ecs_table_column_t* ecs_table_get_columns(
     ecs_world_t *world,
     ecs_stage_t *stage,
@@ -80,8 +738,7 @@ ecs_table_column_t* ecs_table_get_columns(
         ecs_table_column_t *columns;
 
         if (!ecs_map_has(stage->data_stage, (uintptr_t)type, &columns)) {
-            ecs_type_t type = table->type;
-            columns = new_columns(world, stage, table, type);
+            columns = new_staged_columns(world, stage, table, type);
             ecs_map_set(stage->data_stage, (uintptr_t)type, &columns);
         }
 
@@ -95,8 +752,17 @@ void ecs_table_init(
     ecs_table_t *table)
 {
     table->frame_systems = NULL;
+    table->lo_edges = NULL;
+    table->hi_edges = NULL;
+    table->arena = NULL;
+    table->arena_size = 0;
     table->flags = 0;
+    table->bloom = ecs_type_bloom(table->type);
     table->columns = new_columns(world, stage, table, table->type);
+
+    if (world->table_arena && stage == &world->main_stage) {
+        table->flags |= EcsTableIsArena;
+    }
 }
 
 void ecs_table_deinit(
@@ -113,14 +779,21 @@ void ecs_table_deinit(
 
 /* Utility function to free column data */
 void clear_columns(
+    ecs_world_t *world,
     ecs_table_t *table)
 {
     uint32_t i, column_count = ecs_vector_count(table->type);
     
+    bool free_vectors = owns_vectors(table);
+    
     for (i = 0; i < column_count + 1; i ++) {
-        ecs_vector_free(table->columns[i].data);
-        table->columns[i].data = NULL;
+        release_column(&table->columns[i], free_vectors);
     }
+
+    ecs_world_free(world, table->arena, ECS_TABLE_ALIGNMENT, table->arena_size);
+    table->arena = NULL;
+    table->arena_size = 0;
+    table->flags &= ~(EcsTableIsMapped | EcsTableIsShared);
 }
 
 /* Clear columns. Deactivate table in systems if necessary, but do not invoke
@@ -132,7 +805,8 @@ void ecs_table_clear(
 {
     uint32_t count = ecs_vector_count(table->columns[0].data);
     
-    clear_columns(table);
+    clear_columns(world, table);
+    ecs_table_mark_changed(table, table->columns);
 
     if (count) {
         activate_table(world, table, 0, false);
@@ -149,12 +823,25 @@ void ecs_table_replace_columns(
 
     if (table->columns) {
         prev_count = ecs_vector_count(table->columns[0].data);
-        clear_columns(table);
+        clear_columns(world, table);
     }
 
     if (columns) {
+        if (table->columns) {
+            carry_column_state(table, table->columns, columns);
+        }
+
         ecs_os_free(table->columns);
         table->columns = columns;
+
+        /* Columns of shared snapshots may still be shared with other
+         * snapshots */
+        uint32_t i, column_count = ecs_vector_count(table->type);
+        for (i = 0; i < column_count + 1; i ++) {
+            if (columns[i].refs) {
+                table->flags |= EcsTableIsShared;
+            }
+        }
     }
 
     uint32_t count = 0;
@@ -162,6 +849,27 @@ void ecs_table_replace_columns(
         count = ecs_vector_count(table->columns[0].data);
     }
 
+    /* New columns are regular vectors, move them to a block */
+    if (count && table->flags & EcsTableIsArena) {
+        arena_resize(world, table, count);
+    }
+
+    if (!prev_count && count) {
+        activate_table(world, table, 0, true);
+    } else if (prev_count && !count) {
+        activate_table(world, table, 0, false);
+    }
+}
+
+/* Activate / deactivate table with systems after rows were written directly
+ * to its columns, which changed the number of rows from prev_count. */
+void ecs_table_update_active(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    uint32_t prev_count)
+{
+    uint32_t count = ecs_vector_count(table->columns[0].data);
+
     if (!prev_count && count) {
         activate_table(world, table, 0, true);
     } else if (prev_count && !count) {
@@ -169,6 +877,81 @@ void ecs_table_replace_columns(
     }
 }
 
+/* Replace columns with columns that are stored in a mapped file. Columns that
+ * are not stored in the file are stored in the arena, which is owned by the
+ * table. Activate / deactivate table with systems if necessary. */
+void ecs_table_map_columns(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_table_column_t *columns,
+    void *arena,
+    size_t arena_size)
+{
+    uint32_t prev_count = ecs_vector_count(table->columns[0].data);
+
+    clear_columns(world, table);
+    carry_column_state(table, table->columns, columns);
+    ecs_os_free(table->columns);
+
+    table->columns = columns;
+    table->arena = arena;
+    table->arena_size = arena_size;
+    table->flags |= EcsTableIsMapped;
+
+    uint32_t count = ecs_vector_count(columns[0].data);
+
+    if (!prev_count && count) {
+        activate_table(world, table, 0, true);
+    } else if (prev_count && !count) {
+        activate_table(world, table, 0, false);
+    }
+
+    /* Component data moved, so cached references must be resolved again */
+    world->should_resolve = true;
+}
+
+/* Copy a column that shares data with a snapshot, so that the table can write
+ * to it without changing the snapshot. Returns whether the column was shared. */
+bool ecs_table_unshare_column(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    uint32_t index)
+{
+    ecs_table_column_t *column = &table->columns[index];
+    int32_t *refs = column->refs;
+    if (!refs) {
+        return false;
+    }
+
+    if (*refs > 1) {
+        column->data = ecs_table_copy_column(column);
+        (*refs) --;
+
+        /* Component data moved, so cached references must be resolved again */
+        world->should_resolve = true;
+    } else {
+        /* The snapshots that shared the column have been freed */
+        ecs_os_free(refs);
+    }
+
+    column->refs = NULL;
+
+    return true;
+}
+
+/* Copy all columns that share data with a snapshot */
+void ecs_table_unshare(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    uint32_t i, column_count = ecs_vector_count(table->type);
+    for (i = 0; i < column_count + 1; i ++) {
+        ecs_table_unshare_column(world, table, i);
+    }
+
+    table->flags &= ~EcsTableIsShared;
+}
+
 /* Delete all entities in table, invoke OnRemove handlers. This function is used
  * when an application invokes delete_w_filter. Use ecs_table_clear, as the
  * table may have to be deactivated with systems. */
@@ -187,9 +970,24 @@ void ecs_table_free(
     ecs_table_t *table)
 {
     (void)world;
-    clear_columns(table);
+    clear_columns(world, table);
     ecs_os_free(table->columns);
     ecs_vector_free(table->frame_systems);
+    ecs_os_free(table->lo_edges);
+
+    if (table->hi_edges) {
+        ecs_map_free(table->hi_edges);
+    }
+}
+
+void ecs_table_mark_changed(
+    ecs_table_t *table,
+    ecs_table_column_t *columns)
+{
+    uint32_t i, column_count = ecs_vector_count(table->type);
+    for (i = 0; i < column_count + 1; i ++) {
+        columns[i].change_count ++;
+    }
 }
 
 void ecs_table_register_system(
@@ -206,14 +1004,37 @@ void ecs_table_register_system(
     }
 }
 
+void ecs_table_unregister_system(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_entity_t system)
+{
+    (void)world;
+
+    ecs_entity_t *buffer = ecs_vector_first(table->frame_systems);
+    uint32_t i, count = ecs_vector_count(table->frame_systems);
+
+    for (i = 0; i < count; i ++) {
+        if (buffer[i] == system) {
+            ecs_vector_remove_index(
+                table->frame_systems, &handle_arr_params, i);
+            break;
+        }
+    }
+}
+
 uint32_t ecs_table_insert(
     ecs_world_t *world,
+    ecs_stage_t *stage,
     ecs_table_t *table,
     ecs_table_column_t *columns,
     ecs_entity_t entity)
 {
     uint32_t column_count = ecs_vector_count(table->type);
 
+    arena_reserve(world, table, columns, 1);
+    staged_reserve(world, stage, table, columns, 1);
+
     /* Fist add entity to column with entity ids */
     ecs_entity_t *e = ecs_vector_add(&columns[0].data, &handle_arr_params);
     ecs_assert(e != NULL, ECS_INTERNAL_ERROR, NULL);
@@ -230,7 +1051,9 @@ uint32_t ecs_table_insert(
             ecs_vector_params_t params = {.element_size = size};
             void *old_vector = columns[i].data;
 
-            ecs_vector_add(&columns[i].data, &params);
+            column_reserve(&columns[i], 1);
+            void *ptr = ecs_vector_add(&columns[i].data, &params);
+            ecs_lifecycle_ctor(columns[i].lifecycle, ptr, size, 1);
             
             if (old_vector != columns[i].data) {
                 reallocd = true;
@@ -240,6 +1063,8 @@ uint32_t ecs_table_insert(
 
     uint32_t index = ecs_vector_count(columns[0].data) - 1;
 
+    ecs_table_mark_changed(table, columns);
+
     if (!world->in_progress && !index) {
         activate_table(world, table, 0, true);
     }
@@ -266,6 +1091,8 @@ void ecs_table_delete(
         columns = table->columns;
     }
 
+    unshare_main(world, table, columns);
+
     ecs_vector_t *entity_column = columns[0].data;
     uint32_t index, count = ecs_vector_count(entity_column);
 
@@ -286,6 +1113,24 @@ void ecs_table_delete(
     uint32_t column_last = ecs_vector_count(table->type) + 1;
     uint32_t i;
 
+    /* Destruct values of the deleted row. If the row is not the last row, the
+     * values of the last row are moved into the deleted row. */
+    for (i = 1; i < column_last; i ++) {
+        ecs_lifecycle_t *lc = columns[i].lifecycle;
+        if (lc) {
+            uint32_t size = columns[i].size;
+            void *data = ecs_vector_first(columns[i].data);
+            void *last = ECS_OFFSET(data, size * count);
+
+            if (index != count) {
+                ecs_lifecycle_move(
+                    lc, ECS_OFFSET(data, size * index), last, size, 1);
+            }
+
+            ecs_lifecycle_dtor(lc, last, size, 1);
+        }
+    }
+
     if (index != count) {
         /* Move last entity in array to index */
         ecs_entity_t *entities = ecs_vector_first(entity_column);
@@ -293,7 +1138,9 @@ void ecs_table_delete(
         entities[index] = to_move;
 
         for (i = 1; i < column_last; i ++) {
-            if (columns[i].size) {
+            if (columns[i].lifecycle) {
+                ecs_vector_remove_last(columns[i].data);
+            } else if (columns[i].size) {
                 ecs_vector_params_t params = {.element_size = columns[i].size};
                 ecs_vector_remove_index(columns[i].data, &params, index);
             }
@@ -303,7 +1150,7 @@ void ecs_table_delete(
         ecs_row_t row;
         row.type = table->type;
         row.index = index + 1;
-        ecs_map_set(stage->entity_index, to_move, &row);
+        ecs_ei_set(stage->entity_index, to_move, &row);
 
         /* Decrease size of entity column */
         ecs_vector_remove_last(entity_column);
@@ -318,6 +1165,8 @@ void ecs_table_delete(
             }
         }
     }
+
+    ecs_table_mark_changed(table, columns);
     
     if (!world->in_progress && !count) {
         activate_table(world, table, 0, false);
@@ -326,6 +1175,7 @@ void ecs_table_delete(
 
 uint32_t ecs_table_grow(
     ecs_world_t *world,
+    ecs_stage_t *stage,
     ecs_table_t *table,
     ecs_table_column_t *columns,
     uint32_t count,
@@ -333,6 +1183,9 @@ uint32_t ecs_table_grow(
 {
     uint32_t column_count = ecs_vector_count(table->type);
 
+    arena_reserve(world, table, columns, count);
+    staged_reserve(world, stage, table, columns, count);
+
     /* Fist add entity to column with entity ids */
     ecs_entity_t *e = ecs_vector_addn(&columns[0].data, &handle_arr_params, count);
     ecs_assert(e != NULL, ECS_INTERNAL_ERROR, NULL);
@@ -352,13 +1205,17 @@ uint32_t ecs_table_grow(
         }
         void *old_vector = columns[i].data;
 
-        ecs_vector_addn(&columns[i].data, &params, count);
+        column_reserve(&columns[i], count);
+        void *ptr = ecs_vector_addn(&columns[i].data, &params, count);
+        ecs_lifecycle_ctor(columns[i].lifecycle, ptr, params.element_size, count);
 
         if (old_vector != columns[i].data) {
             reallocd = true;
         }
     }
 
+    ecs_table_mark_changed(table, columns);
+
     uint32_t row_count = ecs_vector_count(columns[0].data);
     if (!world->in_progress && row_count == count) {
         activate_table(world, table, 0, true);
@@ -373,6 +1230,8 @@ uint32_t ecs_table_grow(
 }
 
 int16_t ecs_table_dim(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
     ecs_table_t *table,
     ecs_table_column_t *columns,
     uint32_t count)
@@ -381,6 +1240,26 @@ int16_t ecs_table_dim(
         columns = table->columns;
     }
 
+    if (columns == table->columns) {
+        unshare_main(world, table, columns);
+        mapped_detach(world, table);
+    } else {
+        if (count > ecs_vector_size(columns[0].data)) {
+            staged_resize(world, stage, table, columns, count);
+        }
+        return 0;
+    }
+
+    if (table->flags & EcsTableIsArena && columns == table->columns) {
+        uint32_t size = ecs_vector_size(columns[0].data);
+        if (count > size) {
+            arena_resize(world, table, count);
+        } else if (!table->arena && size) {
+            arena_resize(world, table, size);
+        }
+        return 0;
+    }
+
     uint32_t column_count = ecs_vector_count(table->type);
 
     uint32_t size = ecs_vector_set_size(
@@ -394,6 +1273,10 @@ int16_t ecs_table_dim(
 
         if (column_size) {
             ecs_vector_params_t params = {.element_size = column_size};
+            uint32_t column_count = ecs_vector_count(columns[i].data);
+            if (count > column_count) {
+                column_reserve(&columns[i], count - column_count);
+            }
             uint32_t size = ecs_vector_set_size(&columns[i].data, &params, count);
             ecs_assert(size != 0, ECS_INTERNAL_ERROR, NULL);
             (void)size;
@@ -437,13 +1320,15 @@ void ecs_table_swap(
     
     /* Get pointers to records in entity index */
     if (!row_ptr_1) {
-        row_ptr_1 = ecs_map_get_ptr(stage->entity_index, e1);
+        row_ptr_1 = ecs_ei_get_mut(stage->entity_index, e1);
     }
 
     if (!row_ptr_2) {
-        row_ptr_2 = ecs_map_get_ptr(stage->entity_index, e2);
+        row_ptr_2 = ecs_ei_get_mut(stage->entity_index, e2);
     }
 
+    ecs_table_mark_changed(table, columns);
+
     /* Swap entities */
     entities[row_1] = e2;
     entities[row_2] = e1;
@@ -463,9 +1348,7 @@ void ecs_table_swap(
             void *el_1 = ECS_OFFSET(data, size * row_1);
             void *el_2 = ECS_OFFSET(data, size * row_2);
 
-            memcpy(tmp, el_1, size);
-            memcpy(el_1, el_2, size);
-            memcpy(el_2, tmp, size);
+            swap_values(columns[i + 1].lifecycle, el_1, el_2, tmp, size);
         }
     }
 }
@@ -480,18 +1363,20 @@ void ecs_table_move_back_and_swap(
     ecs_entity_t *entities = ecs_vector_first(columns[0].data);
     uint32_t i;
 
+    ecs_table_mark_changed(table, columns);
+
     /* First move back and swap entities */
     ecs_entity_t e = entities[row - 1];
     for (i = 0; i < count; i ++) {
         ecs_entity_t cur = entities[row + i];
         entities[row + i - 1] = cur;
 
-        ecs_row_t *row_ptr = ecs_map_get_ptr(stage->entity_index, cur);
+        ecs_row_t *row_ptr = ecs_ei_get_mut(stage->entity_index, cur);
         row_ptr->index = row + i;
     }
 
     entities[row + count - 1] = e;
-    ecs_row_t *row_ptr = ecs_map_get_ptr(stage->entity_index, e);
+    ecs_row_t *row_ptr = ecs_ei_get_mut(stage->entity_index, e);
     row_ptr->index = row + count;
 
     /* Move back and swap columns */
@@ -502,26 +1387,97 @@ void ecs_table_move_back_and_swap(
         uint32_t size = columns[i + 1].size;
 
         if (size) {
+            /* Values without a move callback are relocated with memcpy */
+            ecs_lifecycle_t *lc = columns[i + 1].lifecycle;
+            if (lc && !lc->callbacks.move) {
+                lc = NULL;
+            }
+
             /* Backup first element */
             void *tmp = _ecs_os_alloca(size, 1);
             void *el = ECS_OFFSET(data, size * (row - 1));
-            memcpy(tmp, el, size);
+            relocate_values(lc, tmp, el, size, 1);
+
+            /* Move component values. The destination of the first move was
+             * relocated, so construct it before moving values into it. */
+            ecs_lifecycle_ctor(lc, el, size, 1);
 
-            /* Move component values */
             uint32_t j;
             for (j = 0; j < count; j ++) {
                 void *dst = ECS_OFFSET(data, size * (row + j - 1));
                 void *src = ECS_OFFSET(data, size * (row + j));
-                memcpy(dst, src, size);
+                ecs_lifecycle_move(lc, dst, src, size, 1);
             }
 
             /* Move first element to last element */
             void *dst = ECS_OFFSET(data, size * (row + count - 1));
-            memcpy(dst, tmp, size);
+            ecs_lifecycle_move(lc, dst, tmp, size, 1);
+            ecs_lifecycle_dtor(lc, tmp, size, 1);
         }
     }
 }
 
+/** Move the values of a column that occurs in both tables of a merge. If the
+ * new table is empty the vector of the old column is moved to the new column,
+ * otherwise the values are appended to the new column. */
+static
+void merge_column(
+    ecs_table_column_t *new_column,
+    ecs_table_column_t *old_column,
+    uint32_t new_count,
+    uint32_t old_count)
+{
+    uint32_t size = new_column->size;
+    if (!size) {
+        return;
+    }
+
+    if (!new_count) {
+        ecs_vector_free(new_column->data);
+        new_column->data = old_column->data;
+    } else {
+        ecs_vector_params_t params = {.element_size = size};
+        column_reserve(new_column, old_count);
+
+        void *dst = ecs_vector_addn(&new_column->data, &params, old_count);
+        relocate_values(new_column->lifecycle, dst, 
+            ecs_vector_first(old_column->data), size, old_count);
+
+        ecs_vector_free(old_column->data);
+    }
+
+    old_column->data = NULL;
+}
+
+/** Add values for merged rows to a column that only occurs in the new table */
+static
+void grow_column(
+    ecs_table_column_t *column,
+    uint32_t count)
+{
+    uint32_t size = column->size;
+    if (!size) {
+        return;
+    }
+
+    ecs_vector_params_t params = {.element_size = size};
+    column_reserve(column, count);
+
+    void *ptr = ecs_vector_addn(&column->data, &params, count);
+    ecs_lifecycle_ctor(column->lifecycle, ptr, size, count);
+}
+
+/** Free a column that only occurs in the old table */
+static
+void drop_column(
+    ecs_table_column_t *column)
+{
+    ecs_lifecycle_dtor(column->lifecycle, ecs_vector_first(column->data), 
+        column->size, ecs_vector_count(column->data));
+    ecs_vector_free(column->data);
+    column->data = NULL;
+}
+
 void ecs_table_merge(
     ecs_world_t *world,
     ecs_table_t *new_table,
@@ -538,18 +1494,46 @@ void ecs_table_merge(
     ecs_table_column_t *old_columns = old_table->columns;
     ecs_assert(old_columns != NULL, ECS_INTERNAL_ERROR, NULL);
 
-    uint32_t old_count = old_columns->data ? ecs_vector_count(old_columns->data) : 0;
+    uint32_t old_count = ecs_vector_count(old_columns[0].data);
     uint32_t new_count = 0;
     if (new_columns) {
-        new_count = new_columns->data ? ecs_vector_count(new_columns->data) : 0;
+        new_count = ecs_vector_count(new_columns[0].data);
     }
 
-    /* First, update entity index so old entities point to new type */
+    if (!old_count) {
+        return;
+    }
+
+    /* Entities lose their name when EcsId is not in the new type */
+    if (old_table->flags & EcsTableHasId) {
+        if (!new_type || ecs_type_index_of(new_type, EEcsId) == -1) {
+            ecs_name_index_remove_table(world, old_table);
+        }
+    }
+
+    /* First, update entity index so old entities point to new type. Rows of
+     * watched entities have a negative index, which must be preserved. */
+    ecs_ei_t *entity_index = world->main_stage.entity_index;
     ecs_entity_t *old_entities = ecs_vector_first(old_columns[0].data);
     uint32_t i;
     for(i = 0; i < old_count; i ++) {
-        ecs_row_t row = {.type = new_type, .index = i + new_count};
-        ecs_map_set(world->main_stage.entity_index, old_entities[i], &row);
+        ecs_row_t *row = ecs_ei_get_mut(entity_index, old_entities[i]);
+        ecs_assert(row != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        bool is_watched = row->index < 0;
+        
+        if (new_table) {
+            row->type = new_type;
+            row->index = i + new_count + 1;
+            if (is_watched) {
+                row->index *= -1;
+            }
+        } else if (is_watched) {
+            row->type = NULL;
+            row->index = -1;
+        } else {
+            ecs_ei_remove(entity_index, old_entities[i]);
+        }
     }
 
     if (!new_table) {
@@ -557,79 +1541,95 @@ void ecs_table_merge(
         return;
     }
 
-    uint16_t i_new, new_component_count = ecs_vector_count(new_type);
-    uint16_t i_old = 0, old_component_count = ecs_vector_count(old_type);
+    /* Columns are moved between tables as vectors, which is not possible for
+     * columns that are stored in a block or shared with a snapshot */
+    unshare_main(world, new_table, new_columns);
+    unshare_main(world, old_table, old_columns);
+    arena_detach(world, new_table);
+    arena_detach(world, old_table);
+
+    ecs_table_mark_changed(new_table, new_columns);
+    ecs_table_mark_changed(old_table, old_columns);
+
+    /* Walk the sorted types of both tables, where index 0 is the column with
+     * entity ids which occurs in both tables */
+    uint32_t i_new = 0, new_component_count = ecs_vector_count(new_type);
+    uint32_t i_old = 0, old_component_count = ecs_vector_count(old_type);
     ecs_entity_t *new_components = ecs_vector_first(new_type);
     ecs_entity_t *old_components = ecs_vector_first(old_type);
 
-    if (!old_count) {
-        return;
-    }
+    while (i_new <= new_component_count && i_old <= old_component_count) {
+        ecs_entity_t new_component = i_new ? new_components[i_new - 1] : 0;
+        ecs_entity_t old_component = i_old ? old_components[i_old - 1] : 0;
 
-    for (i_new = 0; i_new <= new_component_count; ) {
-        if (i_old == old_component_count) {
-            break;
+        if (new_component == old_component) {
+            merge_column(
+                &new_columns[i_new], &old_columns[i_old], new_count, old_count);
+            i_new ++;
+            i_old ++;
+        } else if (new_component < old_component) {
+            grow_column(&new_columns[i_new], old_count);
+            i_new ++;
+        } else {
+            drop_column(&old_columns[i_old]);
+            i_old ++;
         }
+    }
 
-        ecs_entity_t new_component = 0;
-        ecs_entity_t old_component = 0;
-        uint32_t size = 0;
+    for (; i_new <= new_component_count; i_new ++) {
+        grow_column(&new_columns[i_new], old_count);
+    }
 
-        if (i_new) {
-            new_component = new_components[i_new - 1];
-            old_component = old_components[i_old - 1];
-            size = new_columns[i_new].size;
-        } else {
-            size = sizeof(ecs_entity_t);
-        }
+    for (; i_old <= old_component_count; i_old ++) {
+        drop_column(&old_columns[i_old]);
+    }
 
-        if ((new_component & ECS_ENTITY_FLAGS_MASK) || 
-            (old_component & ECS_ENTITY_FLAGS_MASK)) 
-        {
-            break;
-        }
+    if (new_table->flags & EcsTableIsArena) {
+        arena_resize(world, new_table, new_count + old_count);
+    }
 
-        if (new_component == old_component) {
-            /* If the new table is empty, move column to new table */
-            if (!new_count) {
-                ecs_assert(new_columns != NULL, ECS_INTERNAL_ERROR, NULL);
-                if (new_columns[i_new].data) {
-                    ecs_vector_free(new_columns[i_new].data);
-                }
-                new_columns[i_new].data = old_columns[i_old].data;
-                old_columns[i_old].data = NULL;
-            
-            /* If the new table is not empty, copy the contents from the
-             * smallest into the largest vector. */
-            } else {
-                ecs_vector_t *dst = new_columns[i_new].data;
-                ecs_vector_t *src = old_columns[i_old].data;
-
-                ecs_vector_params_t params = {.element_size = size};
-                ecs_vector_set_count(&dst, &params, new_count + old_count);
-                
-                void *dst_ptr = ecs_vector_first(dst);
-                void *src_ptr = ecs_vector_first(src);
-
-                dst_ptr = ECS_OFFSET(dst_ptr, size * old_count);
-                memcpy(dst_ptr, src_ptr, size * old_count);
-
-                ecs_vector_free(src);
-                old_columns[i_old].data = NULL;
-                new_columns[i_new].data = dst;
+    /* The old table is now empty, and the new table may have been empty */
+    activate_table(world, old_table, 0, false);
+    if (!new_count) {
+        activate_table(world, new_table, 0, true);
+    }
+
+    /* Component data moved, so cached references must be resolved again */
+    world->should_resolve = true;
+}
+
+uint64_t ecs_filter_bloom(
+    const ecs_filter_t *filter)
+{
+    if (!filter || !filter->include || filter->include_kind == EcsMatchExact) {
+        return 0;
+    }
+
+    return ecs_type_bloom(filter->include);
+}
+
+bool ecs_table_match_filter(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    const ecs_filter_t *filter,
+    uint64_t bloom)
+{
+    if (!filter) {
+        return true;
+    }
+
+    /* Components inherited from prefabs are not in the table signature, so
+     * the signature can only reject tables without prefabs. */
+    if (bloom && !(table->flags & EcsTableHasPrefab)) {
+        uint64_t match = table->bloom & bloom;
+        if (filter->include_kind == EcsMatchAny) {
+            if (!match) {
+                return false;
             }
-            
-            i_new ++;
-            i_old ++;
-        } else if (new_component < old_component) {
-            /* This should not happen. A table should never be merged to
-             * another table of which the type is not a subset. */
-            ecs_abort(ECS_INTERNAL_ERROR, NULL);
-        } else if (new_component > old_component) {
-            /* Old column does not occur in new table, remove */
-            ecs_vector_free(old_columns[i_old].data);
-            old_columns[i_old].data = NULL;
-            i_old ++;
+        } else if (match != bloom) {
+            return false;
         }
     }
+
+    return ecs_type_match_w_filter(world, table->type, filter);
 }
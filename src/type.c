@@ -32,6 +32,7 @@ int parse_type_action(
     ecs_system_expr_elem_kind_t elem_kind,
     ecs_system_expr_oper_kind_t oper_kind,
     ecs_system_expr_inout_kind_t inout_kind,
+    bool if_changed,
     const char *entity_id,
     const char *source_id,
     void *data)
@@ -39,6 +40,7 @@ int parse_type_action(
     ecs_vector_t **array = data;
     (void)source_id;
     (void)inout_kind;
+    (void)if_changed;
 
     if (strcmp(entity_id, "0")) {
         ecs_entity_t entity = 0;
@@ -811,6 +813,20 @@ ecs_entity_t ecs_type_contains(
     }
 }
 
+uint64_t ecs_type_bloom(
+    ecs_type_t type)
+{
+    ecs_entity_t *array = ecs_vector_first(type);
+    uint32_t i, count = ecs_vector_count(type);
+    uint64_t result = 0;
+
+    for (i = 0; i < count; i ++) {
+        result |= ECS_BLOOM_BIT(array[i]);
+    }
+
+    return result;
+}
+
 bool ecs_type_has_entity_intern(
     ecs_world_t *world,
     ecs_type_t type,
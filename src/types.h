@@ -35,10 +35,12 @@
 #define ECS_WORLD_INITIAL_REMOVE_SYSTEM_COUNT (0)
 #define ECS_WORLD_INITIAL_SET_SYSTEM_COUNT (0)
 #define ECS_WORLD_INITIAL_PREFAB_COUNT (0)
-#define ECS_MAP_INITIAL_NODE_COUNT (4)
 #define ECS_TABLE_INITIAL_ROW_COUNT (0)
 #define ECS_SYSTEM_INITIAL_TABLE_COUNT (0)
-#define ECS_MAX_JOBS_PER_WORKER (16)
+
+/* When no job size is set, the rows of a system are divided in this number of
+ * jobs per thread, so that threads that finish early can steal jobs. */
+#define ECS_JOBS_PER_THREAD (4)
 
 /* This is _not_ the max number of entities that can be of a given type. This 
  * constant defines the maximum number of components, prefabs and parents can be
@@ -47,6 +49,17 @@
  * using alloca for temporary buffers). */
 #define ECS_MAX_ENTITIES_IN_TYPE (256)
 
+/* Maximum length of an element in a path passed to ecs_lookup_path */
+#define ECS_MAX_PATH_ELEMENT (256)
+
+/* Entity ids below ECS_EI_MAX_PAGED_ENTITY are stored in pages of the main
+ * stage entity index, which are indexed directly by entity id. Larger ids are
+ * stored in a hashmap, which prevents the page array from exploding for large
+ * (or reserved) ids like EcsSingleton. */
+#define ECS_EI_PAGE_BITS (12)
+#define ECS_EI_PAGE_SIZE (1 << ECS_EI_PAGE_BITS)
+#define ECS_EI_MAX_PAGED_ENTITY ((ecs_entity_t)1 << 28)
+
 #define ECS_WORLD_MAGIC (0x65637377)
 #define ECS_THREAD_MAGIC (0x65637374)
 
@@ -121,6 +134,7 @@ typedef int (*ecs_parse_action_t)(
     ecs_system_expr_elem_kind_t elem_kind,
     ecs_system_expr_oper_kind_t oper_kind,
     ecs_system_expr_inout_kind_t inout_kind,
+    bool if_changed,
     const char *component,
     const char *source,
     void *ctx);
@@ -135,18 +149,56 @@ typedef struct ecs_system_column_t {
         ecs_entity_t component;      /* Used for AND operator */
     } is;
     ecs_entity_t source;             /* Source entity (used with FromEntity) */
+    bool if_changed;                 /* Only run on tables where column changed */
 } ecs_system_column_t;
 
+/** Lifecycle callbacks of a component. Table columns point to the callbacks of
+ * their component, so they are allocated once and never move. */
+typedef struct ecs_lifecycle_t {
+    EcsComponentLifecycle callbacks; /* Callbacks registered by application */
+    ecs_world_t *world;              /* World passed to callbacks */
+    ecs_entity_t component;          /* Component passed to callbacks */
+} ecs_lifecycle_t;
+
 /** A table column describes a single column in a table (archetype) */
 struct ecs_table_column_t {
     ecs_vector_t *data;              /* Column data */
     uint16_t size;                   /* Column size (saves component lookups) */
+    uint32_t change_count;           /* Incremented when column data changes */
+    int32_t *refs;                   /* Number of tables sharing data (optional) */
+    ecs_lifecycle_t *lifecycle;      /* Component lifecycle (optional) */
 };
 
+/* Edges to tables for components with an id lower than this constant are
+ * stored in an array, edges for other components are stored in a map */
+#define ECS_HI_COMPONENT_ID (256)
+
+/** An edge stores the table an entity moves to when a single component is
+ * added to or removed from the table. Edges are created on the first add or
+ * remove, so that subsequent transitions do not have to merge types or look up
+ * the table of the resulting type. */
+typedef struct ecs_edge_t {
+    ecs_table_t *add;                /* Table after adding component */
+    ecs_table_t *remove;             /* Table after removing component */
+} ecs_edge_t;
+
 #define EcsTableIsStaged  (1)
 #define EcsTableIsPrefab (2)
 #define EcsTableHasPrefab (4)
 #define EcsTableHasBuiltins (8)
+#define EcsTableIsArena (16)
+#define EcsTableIsMapped (32)
+#define EcsTableIsShared (64)
+#define EcsTableHasId (128)
+
+/* Bloom signatures store one bit per component, selected by a hash of the
+ * component id. A table that does not have all bits of a signature set cannot
+ * have all of its components, which rejects most tables with a single test. */
+#define ECS_BLOOM_BIT(component)\
+    ((uint64_t)1 << ((((component) & ECS_ENTITY_MASK) * 0x9E3779B97F4A7C15ull) >> 58))
+
+/* Alignment of column data in tables that store columns in a single block */
+#define ECS_TABLE_ALIGNMENT (64)
 
 /** A table is the Flecs equivalent of an archetype. Tables store all entities
  * with a specific set of components. Tables are automatically created when an
@@ -156,9 +208,20 @@ struct ecs_table_t {
     ecs_table_column_t *columns;      /* Columns storing components of array */
     ecs_vector_t *frame_systems;      /* Frame systems matched with table */
     ecs_type_t type;                  /* Identifies table type in type_index */
+    ecs_edge_t *lo_edges;             /* Edges for low component ids */
+    ecs_map_t *hi_edges;              /* Edges for high component ids */
+    void *arena;                      /* Block with column data (optional) */
+    size_t arena_size;                /* Size of block */
+    uint64_t bloom;                   /* Bloom signature of table type */
     uint32_t flags;                   /* Flags for testing table properties */
 };
 
+/** A file with table data that is mapped into memory by ecs_load_file */
+typedef struct ecs_mapped_file_t {
+    void *data;
+    size_t size;
+} ecs_mapped_file_t;
+
 /** Cached reference to a component in an entity */
 struct ecs_reference_t {
     ecs_entity_t entity;
@@ -173,6 +236,8 @@ typedef struct ecs_matched_table_t {
     ecs_entity_t *components;       /* Actual components of system columns */
     ecs_vector_t *references;       /* Reference columns and cached pointers */
     int32_t depth;                  /* Depth of table (when using CASCADE) */
+    int64_t monitor;                /* Change count of [changed] columns at last run */
+    bool skip;                      /* Columns did not change (set before jobs) */
 } ecs_matched_table_t;
 
 /** Keep track of how many [in] columns are active for [out] columns of OnDemand
@@ -211,6 +276,7 @@ typedef struct EcsSystem {
     double time_spent;             /* Time spent on running system */
     bool enabled;                  /* Is system enabled or not */
     bool has_refs;                 /* Does the system have reference columns */
+    bool if_changed;               /* Does the system have [changed] columns */
     bool needs_tables;             /* Does the system need table matching */
     bool match_prefab;             /* Should this system match prefabs */
     bool match_disabled;           /* Should this system match disabled entities */
@@ -253,6 +319,12 @@ typedef struct EcsSystem {
  * time the system is evaluated but not ran, the delta_time is added to the 
  * time_passed member, until it exceeds 'period'. In that case, the system is
  * ran, and 'time_passed' is decreased by 'period'. 
+ * 
+ * The 'match_key' member contains the component of an AND column that is 
+ * stored in the fewest tables. Only tables that have this component (or that
+ * can inherit it, if 'match_inherited' is true) can match the system, which
+ * limits the number of tables that need to be evaluated when the system is 
+ * created, when it is rematched, and when new tables are created.
  */
 typedef struct EcsColSystem {
     EcsSystem base;
@@ -260,12 +332,20 @@ typedef struct EcsColSystem {
     ecs_vector_t *jobs;                   /* Jobs for this system */
     ecs_vector_t *tables;                 /* Vector with matched tables */
     ecs_vector_t *inactive_tables;        /* Inactive tables */
+    ecs_map_t *table_index;               /* Index to find matched table */
     ecs_on_demand_out_t *on_demand;       /* Keep track of [out] column refs */
     ecs_system_status_action_t status_action; /* Status action */
     void *status_ctx;                     /* User data for status action */
     ecs_vector_params_t column_params;    /* Parameters for table_columns */
     ecs_vector_params_t component_params; /* Parameters for components */
     ecs_vector_params_t ref_params;       /* Parameters for refs */
+    ecs_type_t reads;                     /* Components read by system */
+    ecs_type_t writes;                    /* Components written by system */
+    uint32_t batch;                       /* Batch in which system runs in phase */
+    ecs_entity_t match_key;               /* Component a matched table must have */
+    bool match_inherited;                 /* Can match_key be inherited from prefab */
+    uint64_t self_bloom;                  /* Bloom signature of SELF columns */
+    uint64_t owned_bloom;                 /* Bloom signature of OWNED columns */
     float period;                         /* Minimum period inbetween system invocations */
     float time_passed;                    /* Time passed since last invocation */
 } EcsColSystem;
@@ -287,6 +367,34 @@ typedef struct ecs_row_t {
     int32_t index;                /* Index of the entity in its table */
 } ecs_row_t;
 
+/* Entity is deleted, and its id can be recycled */
+#define ECS_EI_FREE (1)
+
+/* Entity id is stored in the free list */
+#define ECS_EI_LISTED (2)
+
+/** A page in the entity index. Besides the rows, a page stores the current
+ * generation of each entity id, which is used to reject handles to deleted
+ * entities after their id has been recycled. */
+typedef struct ecs_ei_page_t {
+    ecs_row_t rows[ECS_EI_PAGE_SIZE];         /* Table & row for entity */
+    uint16_t generation[ECS_EI_PAGE_SIZE];    /* Current generation of id */
+    uint8_t flags[ECS_EI_PAGE_SIZE];          /* ECS_EI_FREE, ECS_EI_LISTED */
+    uint32_t shared;                          /* Number of other indices using page */
+} ecs_ei_page_t;
+
+/** The entity index stores an ecs_row_t for every entity with components. The
+ * main stage stores rows in pages that are indexed by entity id, as this is
+ * much faster than a hashmap lookup. Stages only store deltas, and store rows
+ * in a hashmap so they can be iterated efficiently when merging. */
+typedef struct ecs_ei_t {
+    ecs_vector_t *pages;          /* Array with pages (ecs_ei_page_t*) */
+    ecs_vector_t *free_list;      /* Ids of deleted entities */
+    ecs_map_t *hi;                /* Rows not stored in pages */
+    uint32_t count;               /* Number of rows stored in pages */
+    bool is_paged;                /* Store rows in pages */
+} ecs_ei_t;
+
 #define ECS_TYPE_DB_MAX_CHILD_NODES (256)
 #define ECS_TYPE_DB_BUCKET_COUNT (256)
 
@@ -314,6 +422,19 @@ typedef struct ecs_type_node_t {
     ecs_type_link_t link;     
 } ecs_type_node_t;
 
+/** Block of memory from which a stage arena serves allocations */
+typedef struct ecs_stage_block_t ecs_stage_block_t;
+
+/** Bump allocator for data that a stage only needs until it is merged. Memory
+ * is not freed per allocation, the arena is reset as a whole after a merge. */
+typedef struct ecs_stage_arena_t {
+    ecs_stage_block_t *block;      /* Current block, links to older blocks */
+    size_t used;                   /* Bytes used in current block */
+    size_t allocd;                 /* Bytes allocated since last reset */
+    uint64_t alloc_count;          /* Allocations served by the arena */
+    uint64_t block_count;          /* Blocks allocated by the arena */
+} ecs_stage_arena_t;
+
 /** A stage is a data structure in which delta's are stored until it is safe to
  * merge those delta's with the main world stage. A stage allows flecs systems
  * to arbitrarily add/remove/set components and create/delete entities while
@@ -323,7 +444,7 @@ typedef struct ecs_stage_t {
     /* If this is not main stage, 
      * changes to the entity index 
      * are buffered here */
-    ecs_map_t *entity_index;       /* Entity lookup table for (table, row) */
+    ecs_ei_t *entity_index;        /* Entity lookup table for (table, row) */
 
     /* If this is not a thread
      * stage, these are the same
@@ -338,6 +459,10 @@ typedef struct ecs_stage_t {
      * not on the main stage */
     ecs_map_t *data_stage;         /* Arrays with staged component values */
     ecs_map_t *remove_merge;       /* All removed components before merge */
+    ecs_vector_t *delete_merge;    /* All deleted entities before merge */
+    ecs_vector_t *merge_buffer;    /* Staged entities, grouped during merge */
+    ecs_vector_t *merge_ids;       /* Staged entity ids, sorted during merge */
+    ecs_stage_arena_t arena;       /* Storage for staged columns */
 
     /* Keep track of changes so
      * code knows when entity
@@ -365,12 +490,30 @@ typedef struct ecs_entity_info_t {
     uint32_t commit_count;
 } ecs_entity_info_t;
 
+/** An entity that is merged from a stage. Entities that have the same main
+ * type, staged type and removed components are merged together. */
+typedef struct ecs_staged_entity_t {
+    ecs_entity_t entity;
+    ecs_row_t main_row;
+    ecs_row_t staged_row;
+    ecs_type_t to_remove;
+} ecs_staged_entity_t;
+
+/** Tables matched by a filter that is run on worker threads */
+typedef struct ecs_filter_job_t {
+    ecs_vector_t *tables;         /* Matched tables */
+    ecs_system_action_t action;   /* Callback to invoke for matched rows */
+    void *param;                  /* Param passed to callback */
+} ecs_filter_job_t;
+
 /** A type describing a unit of work to be executed by a worker thread. */ 
 typedef struct ecs_job_t {
     ecs_entity_t system;          /* System handle */
     EcsColSystem *system_data;    /* System to run */
+    ecs_filter_job_t *filter;     /* Filter to run (if system is not set) */
     uint32_t offset;              /* Start index in row chunk */
     uint32_t limit;               /* Total number of rows to process */
+    bool main_thread;             /* Job may not be stolen from main thread */
 } ecs_job_t;
 
 /** A type desribing a worker thread. When a system is invoked by a worker
@@ -382,9 +525,11 @@ typedef struct ecs_job_t {
  * without requiring different API calls when working in multi threaded mode. */
 typedef struct ecs_thread_t {
     uint32_t magic;                           /* Magic number to verify thread pointer */
-    uint32_t job_count;                       /* Number of jobs scheduled for thread */
     ecs_world_t *world;                       /* Reference to world */
-    ecs_job_t *jobs[ECS_MAX_JOBS_PER_WORKER]; /* Array with jobs */
+    ecs_vector_t *jobs;                       /* Deque with jobs for thread */
+    uint32_t job_head;                        /* First job not yet taken */
+    uint32_t job_tail;                        /* Last job not yet taken + 1 */
+    ecs_os_mutex_t job_mutex;                 /* Protects head & tail from thieves */
     ecs_stage_t *stage;                       /* Stage for thread */
     ecs_os_thread_t thread;                   /* Thread handle */
     uint16_t index;                           /* Index of thread */
@@ -392,10 +537,19 @@ typedef struct ecs_thread_t {
 
 /* World snapshot */
 struct ecs_snapshot_t {
-    ecs_map_t *entity_index;
+    ecs_ei_t *entity_index;
     ecs_chunked_t *tables;
     ecs_entity_t last_handle;
     ecs_filter_t filter;
+    bool shared;                  /* Columns are shared with other tables */
+};
+
+/** Ring of snapshots used to roll back a world to an earlier frame */
+struct ecs_snapshot_ring_t {
+    ecs_snapshot_t **snapshots;   /* Snapshots, ordered from oldest to newest */
+    uint32_t size;                /* Maximum number of snapshots */
+    uint32_t first;               /* Index of oldest snapshot */
+    uint32_t count;               /* Number of snapshots in ring */
 };
 
 /** The world stores and manages all ECS data. An application can have more than
@@ -436,6 +590,11 @@ struct ecs_world_t {
     ecs_vector_t *fini_tasks;         /* Tasks to execute on ecs_fini */
 
 
+    /* -- Mapped files -- */
+
+    ecs_vector_t *mapped_files;       /* Files that contain table columns */
+
+
     /* -- Lookup Indices -- */
 
     ecs_map_t *type_sys_add_index;    /* Index to find add row systems for type */
@@ -445,6 +604,22 @@ struct ecs_world_t {
     ecs_map_t *prefab_parent_index;   /* Index to find flag for prefab parent */
     ecs_map_t *type_handles;          /* Handles to named types */
 
+    ecs_map_t *component_tables;      /* Index to find tables for component */
+    ecs_vector_t *prefab_tables;      /* Tables with INSTANCEOF components */
+    ecs_map_t *component_systems;     /* Index to find systems for match key */
+    ecs_vector_t *unkeyed_systems;    /* Column systems without match key */
+    ecs_map_t *watched_changes;       /* Watched entities changed since match */
+    ecs_map_t *name_index;            /* Index to find entities by (parent, name) */
+    ecs_map_t *component_lifecycle;   /* Index to find lifecycle of component */
+
+
+    /* -- Memory -- */
+
+    ecs_os_allocator_t allocator;     /* Allocator for block storage of world */
+    uint64_t alloc_count;             /* Allocations by allocator (atomic) */
+    uint64_t free_count;              /* Frees by allocator (atomic) */
+    uint64_t allocd_bytes;            /* Memory in use from allocator (atomic) */
+
 
     /* -- Staging -- */
 
@@ -459,9 +634,12 @@ struct ecs_world_t {
     ecs_os_cond_t thread_cond;       /* Signal that worker threads can start */
     ecs_os_mutex_t thread_mutex;     /* Mutex for thread condition */
     ecs_os_cond_t job_cond;          /* Signal that worker thread job is done */
-    ecs_os_mutex_t job_mutex;        /* Mutex for protecting job counter */
-    uint32_t jobs_finished;          /* Number of jobs finished */
-    uint32_t threads_running;        /* Number of threads running */
+    ecs_os_mutex_t job_mutex;        /* Mutex for job condition */
+    int32_t job_epoch;               /* Incremented when threads can start */
+    int32_t jobs_finished;           /* Number of threads done (atomic) */
+    int32_t threads_running;         /* Number of threads running (atomic) */
+    uint32_t spin_count;             /* Iterations to spin before waiting */
+    uint32_t job_size;               /* Rows per job (0 is automatic) */
 
     ecs_entity_t last_handle;        /* Last issued handle */
     ecs_entity_t min_handle;         /* First allowed handle */
@@ -504,15 +682,18 @@ struct ecs_world_t {
     /* -- World state -- */
 
     bool valid_schedule;          /* Is job schedule still valid */
+    bool valid_system_batches;    /* Are batches of multithreaded systems valid */
     bool quit_workers;            /* Signals worker threads to quit */
     bool in_progress;             /* Is world being progressed */
     bool is_merging;              /* Is world currently being merged */
     bool auto_merge;              /* Are stages auto-merged by ecs_progress */
+    bool table_arena;             /* Store columns of new tables in one block */
     bool measure_frame_time;      /* Time spent on each frame */
     bool measure_system_time;     /* Time spent by each system */
     bool should_quit;             /* Did a system signal that app should quit */
-    bool should_match;            /* Should tablea be rematched */
+    bool should_match;            /* Should all tables be rematched */
     bool should_resolve;          /* If a table reallocd, resolve system refs */
+    bool should_index_names;      /* Should name index be rebuilt before lookup */
 }; 
 
 
@@ -520,6 +701,7 @@ struct ecs_world_t {
 extern const ecs_vector_params_t handle_arr_params;
 extern const ecs_vector_params_t stage_arr_params;
 extern const ecs_vector_params_t table_arr_params;
+extern const ecs_vector_params_t table_index_arr_params;
 extern const ecs_vector_params_t thread_arr_params;
 extern const ecs_vector_params_t job_arr_params;
 extern const ecs_vector_params_t builder_params;
@@ -528,5 +710,6 @@ extern const ecs_vector_params_t matched_table_params;
 extern const ecs_vector_params_t matched_column_params;
 extern const ecs_vector_params_t reference_params;
 extern const ecs_vector_params_t ptr_params;
+extern const ecs_vector_params_t mapped_file_arr_params;
 
 #endif
@@ -35,6 +35,22 @@ ecs_vector_t* ecs_vector_new(
     return result;
 }
 
+ecs_vector_t* ecs_vector_new_in_place(
+    const ecs_vector_params_t *params,
+    uint32_t size,
+    void *memory)
+{
+    ecs_assert(params->element_size != 0, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(memory != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(sizeof(ecs_vector_t) == ECS_VECTOR_HEADER_SIZE, 
+        ECS_INTERNAL_ERROR, NULL);
+
+    ecs_vector_t *result = memory;
+    result->count = 0;
+    result->size = size;
+    return result;
+}
+
 void ecs_vector_free(
     ecs_vector_t *array)
 {
@@ -8,50 +8,226 @@ const ecs_vector_params_t job_arr_params = {
     .element_size = sizeof(ecs_job_t)
 };
 
-/** Worker thread code. Processes a job for one system */
+/** Take the next job from the front of the job deque of a thread */
 static
-void* ecs_worker(void *arg) {
-    ecs_thread_t *thread = arg;
+bool pop_job(
+    ecs_thread_t *thread,
+    ecs_job_t *job_out)
+{
+    bool result = false;
+
+    ecs_os_mutex_lock(thread->job_mutex);
+    if (thread->job_head != thread->job_tail) {
+        *job_out = *(ecs_job_t*)ecs_vector_get(
+            thread->jobs, &job_arr_params, thread->job_head);
+        thread->job_head ++;
+        result = true;
+    }
+    ecs_os_mutex_unlock(thread->job_mutex);
+
+    return result;
+}
+
+/** Take a job from the back of the job deque of another thread. Jobs are
+ * assigned to threads in contiguous blocks of rows, so stealing from the back
+ * keeps the owner and the thief from working on adjacent rows. */
+static
+bool steal_job(
+    ecs_thread_t *victim,
+    ecs_job_t *job_out)
+{
+    bool result = false;
+
+    ecs_os_mutex_lock(victim->job_mutex);
+    if (victim->job_head != victim->job_tail) {
+        ecs_job_t *job = ecs_vector_get(
+            victim->jobs, &job_arr_params, victim->job_tail - 1);
+        if (!job->main_thread) {
+            *job_out = *job;
+            victim->job_tail --;
+            result = true;
+        }
+    }
+    ecs_os_mutex_unlock(victim->job_mutex);
+
+    return result;
+}
+
+/** Invoke the callback of a filter job for the rows in the job. The rows of a
+ * job can span multiple tables, in which case the callback is invoked once for
+ * every table. */
+static
+void run_filter_job(
+    ecs_world_t *world,
+    ecs_world_t *real_world,
+    ecs_job_t *job)
+{
+    ecs_filter_job_t *filter_job = job->filter;
+    ecs_table_t **tables = ecs_vector_first(filter_job->tables);
+    uint32_t i, count = ecs_vector_count(filter_job->tables);
+    uint32_t offset = job->offset;
+    uint32_t limit = job->limit;
+
+    ecs_rows_t rows = {
+        .world = world,
+        .param = filter_job->param,
+        .delta_time = real_world->delta_time,
+        .world_time = real_world->world_time_total,
+        .frame_offset = offset
+    };
+
+    for (i = 0; i < count && limit; i ++) {
+        ecs_table_t *table = tables[i];
+        uint32_t table_count = ecs_table_count(table);
+
+        if (offset >= table_count) {
+            offset -= table_count;
+            continue;
+        }
+
+        uint32_t first = offset;
+        uint32_t row_count = table_count - first;
+        if (row_count > limit) {
+            row_count = limit;
+        }
+
+        ecs_entity_t *entities = ecs_vector_first(table->columns[0].data);
+
+        rows.table = table;
+        rows.table_columns = table->columns;
+        rows.table_offset = i;
+        rows.entities = &entities[first];
+        rows.offset = first;
+        rows.count = row_count;
+
+        filter_job->action(&rows);
+
+        rows.frame_offset += row_count;
+        limit -= row_count;
+        offset = 0;
+    }
+}
+
+/** Run a single job on a thread */
+static
+void run_job(
+    ecs_thread_t *thread,
+    ecs_job_t *job)
+{
     ecs_world_t *world = thread->world;
+
+    if (job->filter) {
+        run_filter_job((ecs_world_t*)thread, world, job);
+    } else {
+        ecs_run_w_filter(
+            (ecs_world_t*)thread, /* magic */
+            job->system, 
+            world->delta_time, 
+            job->offset, 
+            job->limit, 
+            0, 
+            NULL);
+    }
+}
+
+/** Run the jobs of a thread, then steal jobs from other threads until no jobs
+ * are left. No jobs are added while threads are running, so once a thread 
+ * fails to steal from all other threads it is done. */
+static
+void run_jobs(
+    ecs_thread_t *thread)
+{
+    ecs_world_t *world = thread->world;
+    ecs_thread_t *threads = ecs_vector_first(world->worker_threads);
+    uint32_t i, thread_count = ecs_vector_count(world->worker_threads);
+    ecs_job_t job;
+    bool stolen;
+
+    while (pop_job(thread, &job)) {
+        run_job(thread, &job);
+    }
+
+    do {
+        stolen = false;
+
+        for (i = 1; i < thread_count; i ++) {
+            ecs_thread_t *victim = &threads[(thread->index + i) % thread_count];
+
+            while (steal_job(victim, &job)) {
+                run_job(thread, &job);
+
+                stolen = true;
+            }
+        }
+    } while (stolen);
+}
+
+/** Wait until the job epoch is different from the last epoch seen by a thread.
+ * The thread first spins for at most spin_count iterations, which avoids the
+ * latency of being woken up when the next phase starts soon. If the epoch does
+ * not change while spinning, the thread blocks on the thread condition. The
+ * epoch is loaded with acquire semantics, so that the thread sees the jobs
+ * that were prepared before the phase started. */
+static
+int32_t wait_for_epoch(
+    ecs_world_t *world,
+    int32_t last_epoch,
+    uint32_t spin_count)
+{
     uint32_t i;
+    int32_t epoch;
 
-    ecs_os_mutex_lock(world->thread_mutex);
-    world->threads_running ++;
+    for (i = 0; i < spin_count; i ++) {
+        epoch = ecs_os_aload(&world->job_epoch);
+        if (epoch != last_epoch) {
+            return epoch;
+        }
+    }
 
-    while (!world->quit_workers) {
+    ecs_os_mutex_lock(world->thread_mutex);
+    while ((epoch = ecs_os_aload(&world->job_epoch)) == last_epoch) {
         ecs_os_cond_wait(world->thread_cond, world->thread_mutex);
+    }
+    ecs_os_mutex_unlock(world->thread_mutex);
+
+    return epoch;
+}
+
+/** Worker thread code. Runs jobs until all jobs for the phase are done */
+static
+void* ecs_worker(void *arg) {
+    ecs_thread_t *thread = arg;
+    ecs_world_t *world = thread->world;
+
+    /* The epoch must be read before signalling that the thread is running, as
+     * the first phase does not start before all threads are running */
+    int32_t epoch = ecs_os_aload(&world->job_epoch);
+    uint32_t spin_count = world->spin_count;
+    ecs_os_ainc(&world->threads_running);
+
+    while (true) {
+        epoch = wait_for_epoch(world, epoch, spin_count);
         if (world->quit_workers) {
             break;
         }
 
-        ecs_job_t **jobs = thread->jobs;
-        uint32_t job_count = thread->job_count;
-        ecs_os_mutex_unlock(world->thread_mutex);
-
-        for (i = 0; i < job_count; i ++) {
-            ecs_run_w_filter(
-                (ecs_world_t*)thread, /* magic */
-                jobs[i]->system, 
-                world->delta_time, 
-                jobs[i]->offset, 
-                jobs[i]->limit, 
-                0, 
-                NULL);
-        }
+        /* The spin count is only written by the main thread between phases,
+         * so it is read while the phase is running */
+        spin_count = world->spin_count;
 
-        ecs_os_mutex_lock(world->thread_mutex);
-        thread->job_count = 0;
+        run_jobs(thread);
 
-        ecs_os_mutex_lock(world->job_mutex);
-        world->jobs_finished ++;
-        if (world->jobs_finished == world->threads_running) {
+        /* Signal main thread if this is the last thread to finish. The main
+         * thread tests the counter while holding the job mutex, so the signal
+         * cannot get lost. */
+        int32_t worker_count = ecs_vector_count(world->worker_threads) - 1;
+        if (ecs_os_ainc(&world->jobs_finished) == worker_count) {
+            ecs_os_mutex_lock(world->job_mutex);
             ecs_os_cond_signal(world->job_cond);
+            ecs_os_mutex_unlock(world->job_mutex);
         }
-        ecs_os_mutex_unlock(world->job_mutex);
     }
 
-    ecs_os_mutex_unlock(world->thread_mutex);
-
     return NULL;
 }
 
@@ -60,49 +236,68 @@ static
 void wait_for_threads(
     ecs_world_t *world)
 {
-    uint32_t thread_count = ecs_vector_count(world->worker_threads) - 1;
-    bool wait = true;
-
-    do {
-        ecs_os_mutex_lock(world->thread_mutex);
-        if (world->threads_running == thread_count) {
-            wait = false;
-        }
-        ecs_os_mutex_unlock(world->thread_mutex);
-    } while (wait);
+    int32_t thread_count = ecs_vector_count(world->worker_threads) - 1;
+    while (ecs_os_aload(&world->threads_running) != thread_count) { }
 }
 
-/** Wait until threads have finished processing their jobs */
+/** Wait until threads have finished processing their jobs. Like workers, the
+ * main thread spins before it blocks on the job condition. */
 static
 void wait_for_jobs(
     ecs_world_t *world)
 {
-    uint32_t thread_count = ecs_vector_count(world->worker_threads) - 1;
+    int32_t thread_count = ecs_vector_count(world->worker_threads) - 1;
+    uint32_t i, spin_count = world->spin_count;
+
+    for (i = 0; i < spin_count; i ++) {
+        if (ecs_os_aload(&world->jobs_finished) == thread_count) {
+            return;
+        }
+    }
 
     ecs_os_mutex_lock(world->job_mutex);
-    if (world->jobs_finished != thread_count) {
-        do {
-            ecs_os_cond_wait(world->job_cond, world->job_mutex);
-        } while (world->jobs_finished != thread_count);
+    while (ecs_os_aload(&world->jobs_finished) != thread_count) {
+        ecs_os_cond_wait(world->job_cond, world->job_mutex);
     }
     ecs_os_mutex_unlock(world->job_mutex);
 }
 
-/** Stop worker threads */
+/** Start next phase, and wake up threads that are blocked. */
 static
-void ecs_stop_threads(
+void signal_threads(
     ecs_world_t *world)
 {
+    ecs_os_ainc(&world->job_epoch);
+
+    /* Threads that are blocked test the epoch while holding the thread mutex,
+     * so the broadcast cannot get lost. */
     ecs_os_mutex_lock(world->thread_mutex);
-    world->quit_workers = true;
     ecs_os_cond_broadcast(world->thread_cond);
     ecs_os_mutex_unlock(world->thread_mutex);
+}
+
+/** Stop worker threads */
+static
+void ecs_stop_threads(
+    ecs_world_t *world)
+{
+    /* Make sure threads have read the epoch before signalling them */
+    wait_for_threads(world);
+
+    world->quit_workers = true;
+    signal_threads(world);
 
     ecs_thread_t *buffer = ecs_vector_first(world->worker_threads);
     uint32_t i, count = ecs_vector_count(world->worker_threads);
     for (i = 1; i < count; i ++) {
         ecs_os_thread_join(buffer[i].thread);
+    }
+
+    /* The first stage is used by the main thread, which has no thread */
+    for (i = 0; i < count; i ++) {
         ecs_stage_deinit(world, buffer[i].stage);
+        ecs_vector_free(buffer[i].jobs);
+        ecs_os_mutex_free(buffer[i].job_mutex);
     }
 
     ecs_vector_free(world->worker_threads);
@@ -131,7 +326,10 @@ void start_threads(
         thread->magic = ECS_THREAD_MAGIC;
         thread->world = world;
         thread->thread = 0;
-        thread->job_count = 0;
+        thread->jobs = NULL;
+        thread->job_head = 0;
+        thread->job_tail = 0;
+        thread->job_mutex = ecs_os_mutex_new();
         thread->index = i;
 
         thread->stage = ecs_vector_add(&world->worker_stages, &stage_arr_params);
@@ -148,16 +346,16 @@ void start_threads(
 static
 void create_jobs(
     EcsColSystem *system_data,
-    uint32_t thread_count)
+    uint32_t job_count)
 {
     if (system_data->jobs) {
         ecs_vector_free(system_data->jobs);
     }
 
-    system_data->jobs = ecs_vector_new(&job_arr_params, thread_count);
+    system_data->jobs = ecs_vector_new(&job_arr_params, job_count);
 
     uint32_t i;
-    for (i = 0; i < thread_count; i ++) {
+    for (i = 0; i < job_count; i ++) {
         ecs_vector_add(&system_data->jobs, &job_arr_params);
     }
 }
@@ -165,7 +363,7 @@ void create_jobs(
 
 /* -- Private functions -- */
 
-/** Create a job per available thread for system */
+/** Divide the rows of a system in jobs of (at most) job_size rows */
 void ecs_schedule_jobs(
     ecs_world_t *world,
     ecs_entity_t system)
@@ -190,63 +388,72 @@ void ecs_schedule_jobs(
         ecs_assert(!is_task || !i, ECS_INTERNAL_ERROR, NULL);
     }
 
+    uint32_t job_size = world->job_size;
+    uint32_t job_count;
+
     if (is_task) {
-        thread_count = 1; /* Tasks are always scheduled to the main thread */
-    } else if (total_rows < thread_count) {
-        thread_count = total_rows;
-    }
+        job_count = 1; /* Tasks are always scheduled to the main thread */
+    } else {
+        if (!job_size) {
+            uint32_t max_jobs = thread_count * ECS_JOBS_PER_THREAD;
+            job_size = (total_rows + max_jobs - 1) / max_jobs;
+            if (!job_size) {
+                job_size = 1;
+            }
+        }
 
-    if (ecs_vector_count(system_data->jobs) != thread_count) {
-        create_jobs(system_data, thread_count);
+        job_count = (total_rows + job_size - 1) / job_size;
     }
 
-    float rows_per_thread = (float)total_rows / (float)thread_count;
-    float residual = 0;
-    int32_t rows_per_thread_i = rows_per_thread;
+    if (ecs_vector_count(system_data->jobs) != job_count) {
+        create_jobs(system_data, job_count);
+    }
 
-    uint32_t start_index = 0;
+    ecs_job_t *jobs = ecs_vector_first(system_data->jobs);
+    uint32_t offset = 0;
 
-    ecs_job_t *job = NULL;
+    for (i = 0; i < job_count; i ++) {
+        uint32_t limit = 0;
 
-    for (i = 0; i < thread_count; i ++) {
-        job = ecs_vector_get(system_data->jobs, &job_arr_params, i);
-        int32_t rows_per_job = rows_per_thread_i;
-        residual += rows_per_thread - rows_per_job;
-        if (residual > 1) {
-            rows_per_job ++;
-            residual --;
+        if (!is_task) {
+            limit = total_rows - offset;
+            if (limit > job_size) {
+                limit = job_size;
+            }
         }
 
-        job->system = system;
-        job->system_data = system_data;
-        job->offset = start_index;
-        job->limit = rows_per_job;
-
-        start_index += rows_per_job;
-    }
+        jobs[i].system = system;
+        jobs[i].system_data = system_data;
+        jobs[i].filter = NULL;
+        jobs[i].offset = offset;
+        jobs[i].limit = limit;
+        jobs[i].main_thread = is_task;
 
-    if (i && residual >= 0.9) {
-        job->limit ++;
+        offset += limit;
     }
 }
 
-/** Assign jobs to worker threads, signal workers */
+/** Assign jobs to worker threads. Each thread gets a contiguous block of jobs,
+ * which are appended to the job deque of the thread. */
 void ecs_prepare_jobs(
     ecs_world_t *world,
     ecs_entity_t system)
 {
     EcsColSystem *system_data = ecs_get_ptr(world, system, EcsColSystem);
-    ecs_vector_t *threads = world->worker_threads;
-    ecs_vector_t *jobs = system_data->jobs;
-    uint32_t i;
+    ecs_thread_t *threads = ecs_vector_first(world->worker_threads);
+    uint32_t thread_count = ecs_vector_count(world->worker_threads);
+    ecs_job_t *jobs = ecs_vector_first(system_data->jobs);
+    uint32_t i, job_count = ecs_vector_count(system_data->jobs);
 
-    uint32_t thread_count = ecs_vector_count(jobs);
+    for (i = 0; i < job_count; i++) {
+        ecs_thread_t *thr = &threads[0];
+        if (!jobs[i].main_thread) {
+            thr = &threads[(uint64_t)i * thread_count / job_count];
+        }
 
-    for (i = 0; i < thread_count; i++) {
-        ecs_thread_t *thr = ecs_vector_get(threads, &thread_arr_params, i);
-        uint32_t job_count = thr->job_count;
-        thr->jobs[job_count] = ecs_vector_get(jobs, &job_arr_params, i);
-        thr->job_count = job_count + 1;
+        ecs_job_t *job = ecs_vector_add(&thr->jobs, &job_arr_params);
+        *job = jobs[i];
+        thr->job_tail ++;
     }
 }
 
@@ -256,25 +463,86 @@ void ecs_run_jobs(
     /* Make sure threads are ready to accept jobs */
     wait_for_threads(world);
 
-    ecs_os_mutex_lock(world->thread_mutex);
+    /* No threads are running jobs at this point, so the counter can be reset
+     * before the next phase starts. Incrementing the epoch is a full barrier,
+     * which publishes the reset to the worker threads. */
     world->jobs_finished = 0;
-    ecs_os_cond_broadcast(world->thread_cond);
-    ecs_os_mutex_unlock(world->thread_mutex);
+    signal_threads(world);
 
-    /* Run job for thread 0 in main thread */
-    ecs_thread_t *thread = ecs_vector_first(world->worker_threads);
-    ecs_job_t **jobs = thread->jobs;
-    uint32_t i, job_count = thread->job_count;
+    /* Run jobs for thread 0 in main thread */
+    ecs_thread_t *threads = ecs_vector_first(world->worker_threads);
+    uint32_t i, thread_count = ecs_vector_count(world->worker_threads);
+    run_jobs(&threads[0]);
 
-    for (i = 0; i < job_count; i ++) {
-        ecs_run_w_filter(
-            (ecs_world_t*)thread, jobs[i]->system, world->delta_time, jobs[i]->offset, jobs[i]->limit, 0, NULL);
+    wait_for_jobs(world);
+
+    /* All jobs have been taken, reset deques for the next phase. The deques
+     * are reset under the same lock that pop_job and steal_job use. */
+    for (i = 0; i < thread_count; i ++) {
+        ecs_os_mutex_lock(threads[i].job_mutex);
+        ecs_vector_clear(threads[i].jobs);
+        threads[i].job_head = 0;
+        threads[i].job_tail = 0;
+        ecs_os_mutex_unlock(threads[i].job_mutex);
+    }
+}
+
+/** Divide the rows of the tables of a filter job in jobs of (at most) job_size
+ * rows, and run them on the worker threads. Without worker threads the rows
+ * are processed in a single job on the calling thread. */
+void ecs_run_filter_jobs(
+    ecs_world_t *world,
+    ecs_filter_job_t *filter_job)
+{
+    ecs_table_t **tables = ecs_vector_first(filter_job->tables);
+    uint32_t i, count = ecs_vector_count(filter_job->tables);
+    uint32_t total_rows = 0;
+
+    for (i = 0; i < count; i ++) {
+        total_rows += ecs_table_count(tables[i]);
+    }
+
+    if (!total_rows) {
+        return;
+    }
+
+    ecs_job_t job = {
+        .filter = filter_job,
+        .offset = 0,
+        .limit = total_rows
+    };
+
+    uint32_t thread_count = ecs_vector_count(world->worker_threads);
+    if (!thread_count) {
+        run_filter_job(world, world, &job);
+        return;
     }
-    thread->job_count = 0;
 
-    if (world->jobs_finished != ecs_vector_count(world->worker_threads) - 1) {
-        wait_for_jobs(world);
+    uint32_t job_size = world->job_size;
+    if (!job_size) {
+        uint32_t max_jobs = thread_count * ECS_JOBS_PER_THREAD;
+        job_size = (total_rows + max_jobs - 1) / max_jobs;
     }
+
+    uint32_t job_count = (total_rows + job_size - 1) / job_size;
+    ecs_thread_t *threads = ecs_vector_first(world->worker_threads);
+
+    for (i = 0; i < job_count; i ++) {
+        ecs_thread_t *thr = &threads[(uint64_t)i * thread_count / job_count];
+
+        job.limit = total_rows - job.offset;
+        if (job.limit > job_size) {
+            job.limit = job_size;
+        }
+
+        ecs_job_t *elem = ecs_vector_add(&thr->jobs, &job_arr_params);
+        *elem = job;
+        thr->job_tail ++;
+
+        job.offset += job.limit;
+    }
+
+    ecs_run_jobs(world);
 }
 
 
@@ -295,6 +563,8 @@ void ecs_set_threads(
     ecs_assert(!threads || ecs_os_api.cond_wait, ECS_MISSING_OS_API, "cond_wait");
     ecs_assert(!threads || ecs_os_api.cond_signal, ECS_MISSING_OS_API, "cond_signal");
     ecs_assert(!threads || ecs_os_api.cond_broadcast, ECS_MISSING_OS_API, "cond_broadcast");
+    ecs_assert(!threads || ecs_os_api.ainc, ECS_MISSING_OS_API, "ainc");
+    ecs_assert(!threads || ecs_os_api.aload, ECS_MISSING_OS_API, "aload");
 
     if (!world->arg_threads) {
         if (ecs_vector_count(world->worker_threads)) {
@@ -316,3 +586,20 @@ void ecs_set_threads(
         world->valid_schedule = false;
     }
 }
+
+void ecs_set_job_size(
+    ecs_world_t *world,
+    uint32_t rows)
+{
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_FROM_WORKER, NULL);
+    world->job_size = rows;
+    world->valid_schedule = false;
+}
+
+void ecs_set_thread_spin(
+    ecs_world_t *world,
+    uint32_t spin_count)
+{
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_FROM_WORKER, NULL);
+    world->spin_count = spin_count;
+}
@@ -6,6 +6,10 @@ const ecs_vector_params_t table_arr_params = {
     .element_size = sizeof(ecs_table_t)
 };
 
+const ecs_vector_params_t table_index_arr_params = {
+    .element_size = sizeof(uint32_t)
+};
+
 const ecs_vector_params_t handle_arr_params = {
     .element_size = sizeof(ecs_entity_t)
 };
@@ -22,6 +26,10 @@ const ecs_vector_params_t ptr_params = {
     .element_size = sizeof(void*)
 };
 
+const ecs_vector_params_t mapped_file_arr_params = {
+    .element_size = sizeof(ecs_mapped_file_t)
+};
+
 /* -- Global variables -- */
 
 ecs_type_t TEcsComponent;
@@ -112,6 +120,51 @@ void bootstrap_types(
     ecs_assert(ecs_vector_count(world->t_col_system) == 2, ECS_INTERNAL_ERROR, NULL);
 }
 
+/** Add table to the indices used to find candidate tables for systems. Tables
+ * in the main stage are never deleted, so the index stores the position of the
+ * table in the main stage table array, which keeps the lists sorted by the
+ * order in which tables were created. */
+static
+void index_table(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    ecs_chunked_t *tables = world->main_stage.tables;
+    uint32_t index = ecs_chunked_count(tables) - 1;
+    ecs_assert(ecs_chunked_get(tables, ecs_table_t, index) == table, 
+        ECS_INTERNAL_ERROR, NULL);
+
+    ecs_entity_t *array = ecs_vector_first(table->type);
+    uint32_t i, count = ecs_vector_count(table->type);
+    bool has_prefab = false;
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = array[i];
+        ecs_vector_t *v = NULL;
+        ecs_map_has(world->component_tables, e & ECS_ENTITY_MASK, &v);
+
+        /* A type can contain the same entity with different flags */
+        uint32_t *last = ecs_vector_last(v, &table_index_arr_params);
+        if (last && *last == index) {
+            continue;
+        }
+
+        uint32_t *elem = ecs_vector_add(&v, &table_index_arr_params);
+        *elem = index;
+        ecs_map_set(world->component_tables, e & ECS_ENTITY_MASK, &v);
+
+        if (e & ECS_INSTANCEOF) {
+            has_prefab = true;
+        }
+    }
+
+    if (has_prefab) {
+        uint32_t *elem = ecs_vector_add(
+            &world->prefab_tables, &table_index_arr_params);
+        *elem = index;
+    }
+}
+
 /** Initialize component table. This table is manually constructed to bootstrap
  * flecs. After this function has been called, the builtin components can be
  * created. */
@@ -125,9 +178,15 @@ ecs_table_t* bootstrap_component_table(
     ecs_table_t *result = ecs_chunked_add(stage->tables, ecs_table_t);
     result->type = world->t_component;
     result->frame_systems = NULL;
+    result->lo_edges = NULL;
+    result->hi_edges = NULL;
+    result->arena = NULL;
+    result->arena_size = 0;
     result->flags = 0;
     result->flags |= EcsTableHasBuiltins;
-    result->columns = ecs_os_malloc(sizeof(ecs_table_column_t) * 3);
+    result->flags |= EcsTableHasId;
+    result->bloom = ecs_type_bloom(world->t_component);
+    result->columns = ecs_os_calloc(sizeof(ecs_table_column_t), 3);
     ecs_assert(result->columns != NULL, ECS_OUT_OF_MEMORY, NULL);
 
     result->columns[0].data = ecs_vector_new(&handle_arr_params, 16);
@@ -136,8 +195,11 @@ ecs_table_t* bootstrap_component_table(
     result->columns[1].size = sizeof(EcsComponent);
     result->columns[2].data = ecs_vector_new(&handle_arr_params, 16);
     result->columns[2].size = sizeof(EcsId);
+    ecs_map_has(world->component_lifecycle, EEcsId, 
+        &result->columns[2].lifecycle);
 
     set_table(stage, world->t_component, result);
+    index_table(world, result);
 
     return result;
 }
@@ -154,11 +216,11 @@ void bootstrap_component(
     ecs_stage_t *stage = &world->main_stage;
 
     /* Insert row into table to store EcsComponent itself */
-    int32_t index = ecs_table_insert(world, table, table->columns, entity);
+    int32_t index = ecs_table_insert(world, stage, table, table->columns, entity);
 
     /* Create record in entity index */
     ecs_row_t row = {.type = world->t_component, .index = index};
-    ecs_map_set(stage->entity_index, entity, &row);
+    ecs_ei_set(stage->entity_index, entity, &row);
 
     /* Set size and id */
     EcsComponent *component_data = ecs_vector_first(table->columns[1].data);
@@ -166,36 +228,81 @@ void bootstrap_component(
     
     component_data[index - 1].size = size;
     id_data[index - 1] = id;
+
+    ecs_name_index_add(world, stage, entity, id);
+}
+
+/** Add systems from a list of systems to a vector */
+static
+void add_systems(
+    ecs_vector_t **dst,
+    ecs_vector_t *systems)
+{
+    uint32_t count = ecs_vector_count(systems);
+    if (count) {
+        ecs_entity_t *elem = ecs_vector_addn(dst, &handle_arr_params, count);
+        memcpy(elem, ecs_vector_first(systems), sizeof(ecs_entity_t) * count);
+    }
 }
 
+/** Collect the column systems that can match a table. A system can only match
+ * a table that has its match key. If the table has no prefabs, it cannot 
+ * inherit the key, and only systems for the components in the table type have
+ * to be tested. Prefabs are always stored at the end of a type. */
 static
-void notify_create_table(
+void collect_table_systems(
     ecs_world_t *world,
-    ecs_vector_t *systems,
-    ecs_table_t *table)
+    ecs_table_t *table,
+    ecs_vector_t **systems_out)
 {
-    ecs_entity_t *buffer = ecs_vector_first(systems);
-    uint32_t i, count = ecs_vector_count(systems);
+    ecs_entity_t *array = ecs_vector_first(table->type);
+    uint32_t i, j, count = ecs_vector_count(table->type);
 
-    for (i = 0; i < count; i ++) {
-        ecs_col_system_notify_of_table(world, buffer[i], table);
+    if (count && array[count - 1] & ECS_INSTANCEOF) {
+        ecs_map_iter_t it = ecs_map_iter(world->component_systems);
+        while (ecs_map_hasnext(&it)) {
+            add_systems(systems_out, ecs_map_nextptr(&it));
+        }
+    } else {
+        for (i = 0; i < count; i ++) {
+            ecs_entity_t key = array[i] & ECS_ENTITY_MASK;
+
+            /* Don't add systems twice if entity is in type with other flags */
+            for (j = 0; j < i; j ++) {
+                if ((array[j] & ECS_ENTITY_MASK) == key) {
+                    break;
+                }
+            }
+
+            if (j != i) {
+                continue;
+            }
+
+            ecs_vector_t *systems = NULL;
+            if (ecs_map_has(world->component_systems, key, &systems)) {
+                add_systems(systems_out, systems);
+            }
+        }
     }
+
+    add_systems(systems_out, world->unkeyed_systems);
 }
 
 void ecs_notify_systems_of_table(
     ecs_world_t *world,
     ecs_table_t *table)
 {
-    notify_create_table(world, world->pre_update_systems, table);
-    notify_create_table(world, world->post_update_systems, table);
-    notify_create_table(world, world->on_load_systems, table);
-    notify_create_table(world, world->post_load_systems, table);
-    notify_create_table(world, world->pre_store_systems, table);
-    notify_create_table(world, world->on_store_systems, table);
-    notify_create_table(world, world->on_validate_systems, table);
-    notify_create_table(world, world->on_update_systems, table);
-    notify_create_table(world, world->manual_systems, table);
-    notify_create_table(world, world->inactive_systems, table);
+    ecs_vector_t *systems = NULL;
+    collect_table_systems(world, table, &systems);
+
+    ecs_entity_t *buffer = ecs_vector_first(systems);
+    uint32_t i, count = ecs_vector_count(systems);
+
+    for (i = 0; i < count; i ++) {
+        ecs_col_system_notify_of_table(world, buffer[i], table);
+    }
+
+    ecs_vector_free(systems);
 }
 
 /** Create a new table and register it with the world and systems. A table in
@@ -220,6 +327,10 @@ ecs_table_t* create_table(
 
     set_table(stage, type, result);
 
+    if (stage == &world->main_stage) {
+        index_table(world, result);
+    }
+
     if (stage == &world->main_stage && !world->is_merging) {
         ecs_notify_systems_of_table(world, result);
     }
@@ -243,8 +354,63 @@ void no_time(
 }
 #endif
 
+/** Default allocator for block storage of a world, which uses the OS API */
+static
+void* default_alloc(
+    void *ctx,
+    size_t alignment,
+    size_t size)
+{
+    (void)ctx;
+    return ecs_os_aligned_alloc(alignment, size);
+}
+
+static
+void default_free(
+    void *ctx,
+    void *ptr,
+    size_t alignment,
+    size_t size)
+{
+    (void)ctx;
+    (void)alignment;
+    ecs_os_free_sized(ptr, size);
+}
+
 /* -- Private functions -- */
 
+void* ecs_world_alloc(
+    ecs_world_t *world,
+    size_t alignment,
+    size_t size)
+{
+    void *result = world->allocator.alloc(
+        world->allocator.ctx, alignment, size);
+    ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    /* Worker threads allocate blocks for their stages */
+    ecs_os_aadd64(&world->alloc_count, 1);
+    ecs_os_aadd64(&world->allocd_bytes, size);
+
+    return result;
+}
+
+void ecs_world_free(
+    ecs_world_t *world,
+    void *ptr,
+    size_t alignment,
+    size_t size)
+{
+    if (!ptr) {
+        return;
+    }
+
+    world->allocator.free(world->allocator.ctx, ptr, alignment, size);
+
+    ecs_os_aadd64(&world->free_count, 1);
+    ecs_os_aadd64(&world->allocd_bytes, -(int64_t)size);
+}
+
 /** Find or create table from type */
 ecs_table_t* ecs_world_get_table(
     ecs_world_t *world,
@@ -363,6 +529,9 @@ void ecs_world_activate_system(
 
     qsort(to_sort, sort_count, sizeof(ecs_entity_t), compare_handle);    
 
+    /* Systems in a phase changed, so they need to be batched again */
+    world->valid_system_batches = false;
+
     /* Signal that system has been either activated or deactivated */
     ecs_system_activate(world, system, active);
 
@@ -448,6 +617,7 @@ void col_systems_deinit(
 
         ecs_vector_free(ptr->inactive_tables);
         ecs_vector_free(ptr->tables);
+        ecs_map_free(ptr->table_index);
     }
 }
 
@@ -634,6 +804,7 @@ ecs_world_t *ecs_init(void) {
     ecs_assert(ecs_os_api.malloc != NULL, ECS_MISSING_OS_API, "malloc");
     ecs_assert(ecs_os_api.realloc != NULL, ECS_MISSING_OS_API, "realloc");
     ecs_assert(ecs_os_api.calloc != NULL, ECS_MISSING_OS_API, "calloc");
+    ecs_assert(ecs_os_api.aadd64 != NULL, ECS_MISSING_OS_API, "aadd64");
 
     bool time_ok = true;
 
@@ -681,29 +852,53 @@ ecs_world_t *ecs_init(void) {
     world->remove_systems = ecs_vector_new(&handle_arr_params, 0);
     world->set_systems = ecs_vector_new(&handle_arr_params, 0);
     world->fini_tasks = ecs_vector_new(&handle_arr_params, 0);
+    world->mapped_files = NULL;
 
     world->type_sys_add_index = ecs_map_new(0, sizeof(ecs_vector_t*));
     world->type_sys_remove_index = ecs_map_new(0, sizeof(ecs_vector_t*));
     world->type_sys_set_index = ecs_map_new(0, sizeof(ecs_vector_t*));
     world->type_handles = ecs_map_new(0, sizeof(ecs_entity_t));
     world->prefab_parent_index = ecs_map_new(0, sizeof(ecs_entity_t));
+    world->component_tables = ecs_map_new(0, sizeof(ecs_vector_t*));
+    world->prefab_tables = NULL;
+    world->component_systems = ecs_map_new(0, sizeof(ecs_vector_t*));
+    world->unkeyed_systems = NULL;
+    world->watched_changes = ecs_map_new(0, sizeof(ecs_entity_t));
+    world->name_index = ecs_map_new(0, sizeof(ecs_vector_t*));
+    world->component_lifecycle = ecs_map_new(0, sizeof(ecs_lifecycle_t*));
+
+    /* Names are read from EcsId columns when entities are removed from the
+     * name index, so values added without a name must be zero-initialized */
+    ecs_lifecycle_t *id_lifecycle = ecs_os_malloc(sizeof(ecs_lifecycle_t));
+    *id_lifecycle = (ecs_lifecycle_t){.world = world, .component = EEcsId};
+    ecs_map_set(world->component_lifecycle, EEcsId, &id_lifecycle);
     world->on_activate_components = ecs_map_new(0, sizeof(ecs_on_demand_in_t));
     world->on_enable_components = ecs_map_new(0, sizeof(ecs_on_demand_in_t));
 
     world->worker_stages = NULL;
     world->worker_threads = NULL;
+    world->job_epoch = 0;
     world->jobs_finished = 0;
     world->threads_running = 0;
+    world->spin_count = 0;
+    world->job_size = 0;
     world->valid_schedule = false;
+    world->valid_system_batches = false;
     world->quit_workers = false;
     world->in_progress = false;
     world->is_merging = false;
     world->auto_merge = true;
+    world->table_arena = false;
+    world->alloc_count = 0;
+    world->free_count = 0;
+    world->allocd_bytes = 0;
+    ecs_set_allocator(world, NULL);
     world->measure_frame_time = false;
     world->measure_system_time = false;
     world->last_handle = 0;
     world->should_quit = false;
     world->should_match = false;
+    world->should_index_names = false;
 
     world->frame_start_time = (ecs_time_t){0, 0};
     if (time_ok) {
@@ -851,6 +1046,19 @@ void on_demand_in_map_deinit(
     ecs_map_free(map);
 }
 
+static
+void lifecycle_index_deinit(
+    ecs_map_t *map)
+{
+    ecs_map_iter_t it = ecs_map_iter(map);
+
+    while (ecs_map_hasnext(&it)) {
+        ecs_os_free(ecs_map_nextptr(&it));
+    }
+
+    ecs_map_free(map);
+}
+
 int ecs_fini(
     ecs_world_t *world)
 {
@@ -903,10 +1111,26 @@ int ecs_fini(
     row_index_deinit(world->type_sys_set_index);
     ecs_map_free(world->type_handles);
     ecs_map_free(world->prefab_parent_index);
+    row_index_deinit(world->component_tables);
+    ecs_vector_free(world->prefab_tables);
+    row_index_deinit(world->component_systems);
+    ecs_vector_free(world->unkeyed_systems);
+    ecs_map_free(world->watched_changes);
+    row_index_deinit(world->name_index);
 
     ecs_stage_deinit(world, &world->main_stage);
     ecs_stage_deinit(world, &world->temp_stage);
 
+    /* Unmap files after the tables that use them have been freed */
+    ecs_mapped_file_t *files = ecs_vector_first(world->mapped_files);
+    for (i = 0; i < ecs_vector_count(world->mapped_files); i ++) {
+        ecs_os_unmap_file(files[i].data, files[i].size);
+    }
+    ecs_vector_free(world->mapped_files);
+
+    /* Free lifecycle callbacks after the tables that refer to them */
+    lifecycle_index_deinit(world->component_lifecycle);
+
     on_demand_in_map_deinit(world->on_activate_components);
     on_demand_in_map_deinit(world->on_enable_components);
 
@@ -927,7 +1151,8 @@ int ecs_fini(
     ecs_vector_free(world->remove_systems);
     ecs_vector_free(world->set_systems);
 
-
+    /* All memory from the world allocator belongs to tables and stages */
+    ecs_assert(!world->allocd_bytes, ECS_INTERNAL_ERROR, NULL);
 
     world->magic = 0;
 
@@ -945,7 +1170,7 @@ void ecs_dim(
     uint32_t entity_count)
 {
     assert(world->magic == ECS_WORLD_MAGIC);
-    ecs_map_set_size(world->main_stage.entity_index, entity_count);
+    ecs_ei_grow(world->main_stage.entity_index, 0, entity_count);
 }
 
 void _ecs_dim_type(
@@ -957,7 +1182,8 @@ void _ecs_dim_type(
     if (type) {
         ecs_table_t *table = ecs_world_get_table(world, &world->main_stage, type);
         if (table) {
-            ecs_table_dim(table, NULL, entity_count);
+            ecs_table_dim(
+                world, &world->main_stage, table, NULL, entity_count);
         }
     }
 }
@@ -1019,7 +1245,11 @@ ecs_entity_t ecs_lookup_child(
         }
     }
 
-    if (!result) {
+    if (!result && ecs_name_index_ready(world, stage)) {
+        result = ecs_name_index_lookup(world, stage, parent, id);
+    } else if (!result) {
+        /* Name index is being rebuilt, which cannot happen while in progress,
+         * so search the tables in the main stage */
         ecs_chunked_t *tables = world->main_stage.tables;
         uint32_t t, count = ecs_chunked_count(tables);
 
@@ -1047,6 +1277,37 @@ ecs_entity_t ecs_lookup(
     return ecs_lookup_child(world, 0, id);
 }
 
+ecs_entity_t ecs_lookup_path(
+    ecs_world_t *world,
+    ecs_entity_t parent,
+    const char *path)
+{
+    char buff[ECS_MAX_PATH_ELEMENT];
+    const char *ptr = path;
+    ecs_entity_t result = parent;
+
+    do {
+        const char *end = strchr(ptr, '.');
+        size_t len = end ? (size_t)(end - ptr) : strlen(ptr);
+
+        if (!len || len >= ECS_MAX_PATH_ELEMENT) {
+            return 0;
+        }
+
+        memcpy(buff, ptr, len);
+        buff[len] = '\0';
+
+        result = ecs_lookup_child(world, result, buff);
+        if (!result) {
+            return 0;
+        }
+
+        ptr = end ? end + 1 : NULL;
+    } while (ptr);
+
+    return result;
+}
+
 static
 void rematch_system_array(
     ecs_world_t *world,
@@ -1084,6 +1345,193 @@ void rematch_systems(
     rematch_system_array(world, world->inactive_systems);   
 }
 
+static
+int compare_table_index(
+    const void *p1,
+    const void *p2)
+{
+    uint32_t i1 = *(uint32_t*)p1;
+    uint32_t i2 = *(uint32_t*)p2;
+    return (i1 > i2) - (i1 < i2);
+}
+
+/** Does type have entity as container or prefab */
+static
+bool has_parent(
+    ecs_type_t type,
+    ecs_entity_t entity)
+{
+    ecs_entity_t *array = ecs_vector_first(type);
+    int32_t i, count = ecs_vector_count(type);
+
+    /* Containers and prefabs are always stored at the end of a type */
+    for (i = count - 1; i >= 0; i --) {
+        ecs_entity_t e = array[i];
+        if (!(e & ECS_ENTITY_FLAGS_MASK)) {
+            break;
+        }
+
+        if ((e & ECS_ENTITY_MASK) == entity) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** Add tables that have the entity as container or prefab */
+static
+void collect_child_tables(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_vector_t **tables_out)
+{
+    ecs_vector_t *tables = NULL;
+    ecs_map_has(world->component_tables, entity, &tables);
+
+    uint32_t *buffer = ecs_vector_first(tables);
+    uint32_t i, count = ecs_vector_count(tables);
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(
+            world->main_stage.tables, ecs_table_t, buffer[i]);
+
+        if (has_parent(table->type, entity)) {
+            uint32_t *elem = ecs_vector_add(tables_out, &table_index_arr_params);
+            *elem = buffer[i];
+        }
+    }
+}
+
+/** Collect tables affected by changes to watched entities. Entities in these
+ * tables can be containers or prefabs of other tables, which are collected as
+ * well. Returns table indices in the order in which tables were created. */
+static
+ecs_vector_t* collect_watched_tables(
+    ecs_world_t *world,
+    ecs_map_t *changed)
+{
+    ecs_vector_t *entities = NULL;
+    ecs_vector_t *tables = NULL;
+    ecs_map_t *visited = ecs_map_copy(changed);
+
+    ecs_map_iter_t it = ecs_map_iter(changed);
+    while (ecs_map_hasnext(&it)) {
+        ecs_entity_t *elem = ecs_vector_add(&entities, &handle_arr_params);
+        *elem = *(ecs_entity_t*)ecs_map_next(&it);
+    }
+
+    uint32_t i, t, r;
+    for (i = 0; i < ecs_vector_count(entities); i ++) {
+        ecs_entity_t *buffer = ecs_vector_first(entities);
+        uint32_t first = ecs_vector_count(tables);
+
+        collect_child_tables(world, buffer[i], &tables);
+
+        for (t = first; t < ecs_vector_count(tables); t ++) {
+            uint32_t *indices = ecs_vector_first(tables);
+            ecs_table_t *table = ecs_chunked_get(
+                world->main_stage.tables, ecs_table_t, indices[t]);
+            ecs_entity_t *rows = ecs_vector_first(table->columns[0].data);
+            uint32_t row_count = ecs_vector_count(table->columns[0].data);
+
+            for (r = 0; r < row_count; r ++) {
+                ecs_entity_t e = rows[r];
+                ecs_row_t *row = ecs_ei_get(world->main_stage.entity_index, e);
+
+                if (row && row->index < 0 && !ecs_map_has(visited, e, &e)) {
+                    ecs_map_set(visited, e, &e);
+                    ecs_entity_t *elem = ecs_vector_add(
+                        &entities, &handle_arr_params);
+                    *elem = e;
+                }
+            }
+        }
+    }
+
+    ecs_vector_free(entities);
+    ecs_map_free(visited);
+
+    /* Sort tables, and remove tables that were collected more than once */
+    uint32_t *indices = ecs_vector_first(tables);
+    uint32_t count = ecs_vector_count(tables), unique = 0;
+    qsort(indices, count, sizeof(uint32_t), compare_table_index);
+
+    for (t = 0; t < count; t ++) {
+        if (!unique || indices[unique - 1] != indices[t]) {
+            indices[unique ++] = indices[t];
+        }
+    }
+
+    ecs_vector_set_count(&tables, &table_index_arr_params, unique);
+
+    return tables;
+}
+
+/** Rematch systems with the tables that have a changed watched entity as
+ * container or prefab, instead of rematching all systems with all tables */
+static
+void rematch_watched(
+    ecs_world_t *world)
+{
+    ecs_vector_t *tables = collect_watched_tables(
+        world, world->watched_changes);
+    ecs_map_clear(world->watched_changes);
+
+    uint32_t *indices = ecs_vector_first(tables);
+    uint32_t i, s, count = ecs_vector_count(tables);
+
+    ecs_map_t *rematched = ecs_map_new(0, sizeof(ecs_entity_t));
+    ecs_vector_t *systems = NULL;
+
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_chunked_get(
+            world->main_stage.tables, ecs_table_t, indices[i]);
+
+        ecs_vector_clear(systems);
+        collect_table_systems(world, table, &systems);
+
+        ecs_entity_t *buffer = ecs_vector_first(systems);
+        uint32_t system_count = ecs_vector_count(systems);
+
+        for (s = 0; s < system_count; s ++) {
+            ecs_rematch_system_w_table(world, buffer[s], table);
+            ecs_map_set(rematched, buffer[s], &buffer[s]);
+        }
+    }
+
+    ecs_map_iter_t it = ecs_map_iter(rematched);
+    while (ecs_map_hasnext(&it)) {
+        ecs_order_system_tables(world, *(ecs_entity_t*)ecs_map_next(&it));
+    }
+
+    /* Enable/disable systems if constraints are (not) met. Systems move
+     * between arrays when they are enabled, so collect them first. */
+    ecs_vector_clear(systems);
+    add_systems(&systems, world->on_load_systems);
+    add_systems(&systems, world->post_load_systems);
+    add_systems(&systems, world->pre_update_systems);
+    add_systems(&systems, world->on_update_systems);
+    add_systems(&systems, world->on_validate_systems);
+    add_systems(&systems, world->post_update_systems);
+    add_systems(&systems, world->pre_store_systems);
+    add_systems(&systems, world->on_store_systems);
+    add_systems(&systems, world->inactive_systems);
+
+    ecs_entity_t *buffer = ecs_vector_first(systems);
+    count = ecs_vector_count(systems);
+
+    for (s = 0; s < count; s ++) {
+        EcsColSystem *system_data = ecs_get_ptr(world, buffer[s], EcsColSystem);
+        ecs_enable(world, buffer[s], ecs_check_column_constraints(
+            world, (EcsSystem*)system_data));
+    }
+
+    ecs_vector_free(systems);
+    ecs_map_free(rematched);
+    ecs_vector_free(tables);
+}
+
 static
 void revalidate_system_array(
     ecs_world_t *world,
@@ -1145,6 +1593,38 @@ void run_single_thread_stage(
     }
 }
 
+/** Assign each system in a phase to a batch. A system runs in the batch after
+ * the last earlier system it conflicts with, so systems that access different
+ * components run concurrently while conflicting systems keep their order. */
+static
+void compute_system_batches(
+    ecs_world_t *world,
+    ecs_vector_t *systems)
+{
+    uint32_t i, system_count = ecs_vector_count(systems);
+    ecs_entity_t *buffer = ecs_vector_first(systems);
+
+    for (i = 0; i < system_count; i ++) {
+        EcsColSystem *system_data = ecs_get_ptr(
+            world, buffer[i], EcsColSystem);
+        ecs_assert(system_data != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        uint32_t j, batch = 0;
+        for (j = 0; j < i; j ++) {
+            EcsColSystem *prev_data = ecs_get_ptr(
+                world, buffer[j], EcsColSystem);
+
+            if (prev_data->batch >= batch &&
+                ecs_col_system_conflicts(system_data, prev_data))
+            {
+                batch = prev_data->batch + 1;
+            }
+        }
+
+        system_data->batch = batch;
+    }
+}
+
 static
 void run_multi_thread_stage(
     ecs_world_t *world,
@@ -1155,22 +1635,53 @@ void run_multi_thread_stage(
     if (system_count) {
         bool valid_schedule = world->valid_schedule;
         ecs_entity_t *buffer = ecs_vector_first(systems);
+        uint32_t batch;
+        bool has_jobs;
 
         world->in_progress = true;
 
-        for (i = 0; i < system_count; i ++) {
-            if (!valid_schedule) {
-                ecs_schedule_jobs(world, buffer[i]);
-            }
-            ecs_prepare_jobs(world, buffer[i]);
+        if (!world->valid_system_batches) {
+            compute_system_batches(world, world->pre_update_systems);
+            compute_system_batches(world, world->on_update_systems);
+            compute_system_batches(world, world->on_validate_systems);
+            compute_system_batches(world, world->post_update_systems);
+            world->valid_system_batches = true;
         }
 
-        ecs_time_t start;
-        ecs_time_measure(&start);
+        /* Batches are numbered without gaps, so stop at first empty batch */
+        for (batch = 0, has_jobs = true; has_jobs; batch ++) {
+            has_jobs = false;
 
-        ecs_run_jobs(world);
+            for (i = 0; i < system_count; i ++) {
+                EcsColSystem *system_data = ecs_get_ptr(
+                    world, buffer[i], EcsColSystem);
 
-        world->system_time_total += ecs_time_measure(&start);
+                if (system_data->batch != batch) {
+                    continue;
+                }
+
+                if (!valid_schedule) {
+                    ecs_schedule_jobs(world, buffer[i]);
+                }
+
+                /* Workers cannot copy columns shared with a snapshot */
+                ecs_col_system_unshare(world, buffer[i]);
+
+                /* Workers cannot mark columns as changed */
+                ecs_col_system_track_changes(world, buffer[i]);
+                ecs_prepare_jobs(world, buffer[i]);
+                has_jobs = true;
+            }
+
+            if (has_jobs) {
+                ecs_time_t start;
+                ecs_time_measure(&start);
+
+                ecs_run_jobs(world);
+
+                world->system_time_total += ecs_time_measure(&start);
+            }
+        }
 
         if (world->auto_merge) {
             world->in_progress = false;
@@ -1259,12 +1770,17 @@ bool ecs_progress(
     if (world->should_match) {
         rematch_systems(world);
         world->should_match = false;
+        ecs_map_clear(world->watched_changes);
+    } else if (ecs_map_count(world->watched_changes)) {
+        rematch_watched(world);
     }
 
-    if (world->should_resolve) {
-        revalidate_system_refs(world);
+    /* Resolving references can copy columns that are shared with a snapshot,
+     * which moves component data, so resolve until no data moved */
+    while (world->should_resolve) {
         world->should_resolve = false;
-    }    
+        revalidate_system_refs(world);
+    }
 
     /* -- System execution starts here -- */
 
@@ -1350,6 +1866,35 @@ void ecs_set_automerge(
     world->auto_merge = auto_merge;
 }
 
+void ecs_set_table_arena(
+    ecs_world_t *world,
+    bool enable)
+{
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_FROM_WORKER, NULL);
+    world->table_arena = enable;
+}
+
+void ecs_set_allocator(
+    ecs_world_t *world,
+    const ecs_os_allocator_t *allocator)
+{
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_FROM_WORKER, NULL);
+
+    /* Memory must be freed by the allocator that allocated it */
+    ecs_assert(!world->allocd_bytes, ECS_INVALID_PARAMETER, NULL);
+
+    if (allocator) {
+        ecs_assert(allocator->alloc != NULL, ECS_INVALID_PARAMETER, NULL);
+        ecs_assert(allocator->free != NULL, ECS_INVALID_PARAMETER, NULL);
+        world->allocator = *allocator;
+    } else {
+        world->allocator = (ecs_os_allocator_t){
+            .alloc = default_alloc,
+            .free = default_free
+        };
+    }
+}
+
 void ecs_measure_frame_time(
     ecs_world_t *world,
     bool enable)
@@ -1,5 +1,13 @@
 #include "flecs_private.h"
 
+/* Serialized data is padded so that each block of data is a multiple of 4 */
+static
+size_t padding_of(
+    size_t size)
+{
+    return (sizeof(int32_t) - (size % sizeof(int32_t))) % sizeof(int32_t);
+}
+
 static
 void ecs_name_writer_alloc(
     ecs_name_writer_t *writer,
@@ -11,26 +19,6 @@ void ecs_name_writer_alloc(
         writer->name = ecs_os_malloc(writer->len);
         writer->max_len = writer->len;
     }
-    writer->written = 0;
-}
-
-static
-bool ecs_name_writer_write(
-    ecs_name_writer_t *writer,
-    const char *buffer)
-{
-    int32_t written = writer->len - writer->written;
-    char *name_ptr = ECS_OFFSET(writer->name, writer->written);
-
-    if (written >= sizeof(int32_t)) {
-        *(int32_t*)name_ptr = *(int32_t*)buffer;
-        writer->written += sizeof(int32_t);
-        return writer->written != writer->len;
-    } else {
-        memcpy(name_ptr, buffer, written);
-        writer->written += written;
-        return false;
-    }
 }
 
 static
@@ -42,6 +30,29 @@ void ecs_name_writer_reset(
     writer->len = 0;
 }
 
+/** Set the destination for the next block of data copied from the input */
+static
+void ecs_writer_set_data(
+    ecs_writer_t *stream,
+    void *data,
+    size_t size,
+    size_t padding)
+{
+    stream->data = data;
+    stream->data_size = size;
+    stream->data_padding = padding;
+    stream->data_written = 0;
+}
+
+/** Expect the header kind of the next component or table */
+static
+void ecs_writer_expect_header(
+    ecs_writer_t *stream)
+{
+    stream->state = EcsStreamHeader;
+    ecs_writer_set_data(stream, stream->header, sizeof(int32_t), 0);
+}
+
 static
 int ecs_component_writer_register_component(
     ecs_writer_t *stream)
@@ -65,8 +76,13 @@ int ecs_component_writer_register_component(
         ecs_set(world, id, EcsComponent, {writer->size});
         ecs_set(world, id, EcsId, {name});
 
+        /* Don't issue the component id to new entities */
+        if (ECS_ENTITY_ID(id) > world->last_handle) {
+            world->last_handle = ECS_ENTITY_ID(id);
+        }
+
         /* Don't overwrite component name */
-        ecs_name_writer_reset(&writer->name);        
+        ecs_name_writer_reset(&writer->name);
     } else {
         if (world_id != id) {
             stream->error = ECS_DESERIALIZE_COMPONENT_ID_CONFLICT;
@@ -80,7 +96,7 @@ int ecs_component_writer_register_component(
                 /* Component exists, do nothing */
             }
         }
-    } 
+    }
 
     return 0;
 error:
@@ -88,84 +104,49 @@ error:
 }
 
 static
-void ecs_component_writer_next(
-    ecs_writer_t *stream)
-{
-    ecs_component_writer_t *writer = &stream->component;
-
-    switch(writer->state) {
-    case EcsComponentId:
-        writer->state = EcsComponentSize;
-        break;
-    case EcsComponentSize:
-        writer->state = EcsComponentNameLength;
-        break;
-    case EcsComponentNameLength:
-        writer->state = EcsComponentName;
-        break;
-    case EcsComponentName:
-        stream->state = EcsStreamHeader;
-        writer->state = 0;
-        break;
-    default:
-        ecs_abort(ECS_INTERNAL_ERROR, NULL);
-        break;
-    }    
-}
-
-static
-size_t ecs_component_writer(
-    const char *buffer,
-    size_t size,
+int ecs_component_writer_next(
     ecs_writer_t *stream)
 {
     ecs_component_writer_t *writer = &stream->component;
-    size_t written = 0;
 
-    ecs_assert(size != 0, ECS_INTERNAL_ERROR, NULL);
-    ecs_assert(size >= sizeof(uint32_t), ECS_INVALID_PARAMETER, NULL);
+    switch(stream->state) {
+    case EcsComponentHeader: {
+        ecs_blob_component_t *component = (ecs_blob_component_t*)stream->header;
+        if (component->name_len <= 0 || component->size < 0) {
+            stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+            goto error;
+        }
 
-    if (!writer->state) {
-        writer->state = EcsComponentId;
-    }
+        writer->id = component->id;
+        writer->size = component->size;
+        ecs_name_writer_alloc(&writer->name, component->name_len);
 
-    switch(writer->state) {
-    case EcsComponentId:
-        writer->id = *(int32_t*)buffer;
-        written = sizeof(int32_t);
-        ecs_component_writer_next(stream);
-        break;
+        ecs_writer_set_data(stream, writer->name.name, writer->name.len,
+            padding_of(writer->name.len));
 
-    case EcsComponentSize:
-        writer->size = *(int32_t*)buffer;
-        written = sizeof(int32_t);
-        ecs_component_writer_next(stream);  
-        break;
-
-    case EcsComponentNameLength:
-        ecs_name_writer_alloc(&writer->name, *(int32_t*)buffer);
-        written = sizeof(int32_t);
-        ecs_component_writer_next(stream);
+        stream->state = EcsComponentName;
         break;
+    }
 
-    case EcsComponentName: {
-        written = sizeof(int32_t);
-        if (!ecs_name_writer_write(&writer->name, buffer)) {
-            if (ecs_component_writer_register_component(stream)) {
-                goto error;
-            }
+    case EcsComponentName:
+        if (writer->name.name[writer->name.len - 1]) {
+            stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+            goto error;
+        }
 
-            ecs_component_writer_next(stream);            
+        if (ecs_component_writer_register_component(stream)) {
+            goto error;
         }
+
+        ecs_writer_expect_header(stream);
         break;
-    }
 
     default:
         ecs_abort(ECS_INTERNAL_ERROR, NULL);
         break;
     }
 
-    return written;
+    return 0;
 error:
     return -1;
 }
@@ -181,13 +162,14 @@ void ecs_table_writer_register_table(
     ecs_assert(type != NULL, ECS_INTERNAL_ERROR, NULL);
 
     writer->table = ecs_world_get_table(world, &world->main_stage, type);
+    writer->prev_count = ecs_vector_count(writer->table->columns[0].data);
 
     /* Remove any existing entities from entity index */
     ecs_vector_t *entity_vector = writer->table->columns[0].data;
     ecs_entity_t *entities = ecs_vector_first(entity_vector);
     int32_t i, count = ecs_vector_count(entity_vector);
     for (i = 0; i < count; i ++) {
-        ecs_map_remove(world->main_stage.entity_index, entities[i]);
+        ecs_ei_remove(world->main_stage.entity_index, entities[i]);
     }
 
     ecs_assert(writer->table != NULL, ECS_INTERNAL_ERROR, NULL);
@@ -200,6 +182,19 @@ void ecs_table_writer_finalize_table(
     ecs_world_t *world = stream->world;
     ecs_table_writer_t *writer = &stream->table;
 
+    /* Columns of a mapped table are stored in the input, and are only added to
+     * the table when all columns have been deserialized */
+    if (stream->map) {
+        ecs_table_map_columns(world, writer->table, writer->columns,
+            writer->arena, writer->arena_size);
+        writer->columns = NULL;
+        writer->arena = NULL;
+        writer->arena_size = 0;
+    } else {
+        ecs_table_mark_changed(writer->table, writer->table->columns);
+        ecs_table_update_active(world, writer->table, writer->prev_count);
+    }
+
     /* Register entities in table in entity index */
     ecs_vector_t *entity_vector = writer->table->columns[0].data;
     ecs_entity_t *entities = ecs_vector_first(entity_vector);
@@ -207,12 +202,12 @@ void ecs_table_writer_finalize_table(
 
     for (i = 0; i < count; i ++) {
         ecs_row_t row;
-        if (ecs_map_has(world->main_stage.entity_index, entities[i], &row)) {
+        if (ecs_ei_has(world->main_stage.entity_index, entities[i], &row)) {
             if (row.type != writer->table->type) {
                 ecs_table_t *table = ecs_world_get_table(world, &world->main_stage, row.type);
                 ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
 
-                ecs_table_delete(world, &world->main_stage, 
+                ecs_table_delete(world, &world->main_stage,
                     table, table->columns, row.index);
             }
         }
@@ -222,12 +217,12 @@ void ecs_table_writer_finalize_table(
             .type = writer->table->type
         };
 
-        ecs_map_set(world->main_stage.entity_index, entities[i], &row);
+        ecs_ei_set(world->main_stage.entity_index, entities[i], &row);
 
-        if (entities[i] >= world->last_handle) {
-            world->last_handle = entities[i] + 1;
+        if (ECS_ENTITY_ID(entities[i]) >= world->last_handle) {
+            world->last_handle = ECS_ENTITY_ID(entities[i]) + 1;
         }
-    }   
+    }
 }
 
 static
@@ -237,202 +232,499 @@ void ecs_table_writer_prepare_column(
 {
     ecs_table_writer_t *writer = &stream->table;
 
-    writer->column = &writer->table->columns[writer->column_index];
-    writer->column_size = size;
+    writer->column = &writer->columns[writer->column_index];
 
     if (size) {
-        ecs_vector_params_t params = {.element_size = writer->column_size};
+        ecs_vector_params_t params = {.element_size = size};
+
+        /* Vectors of a mapped table are not freed individually, so a column
+         * that is not stored in the input is stored in a block that is owned
+         * by the table. Only the name column is not stored in the input. */
+        if (stream->map) {
+            ecs_assert(writer->arena == NULL, ECS_INTERNAL_ERROR, NULL);
+            writer->arena_size = ECS_VECTOR_HEADER_SIZE + 
+                writer->row_count * size;
+            writer->arena = ecs_world_alloc(
+                stream->world, ECS_TABLE_ALIGNMENT, writer->arena_size);
+            writer->column->data = ecs_vector_new_in_place(
+                &params, writer->row_count, writer->arena);
+        }
+
         ecs_vector_set_count(&writer->column->data, &params, writer->row_count);
     }
+}
 
-    writer->column_data = ecs_vector_first(writer->column->data);
-    writer->column_written = 0;
+/** Use a column that is stored in the input as table column. The column is
+ * preceded by a vector header that must match the table. */
+static
+int ecs_table_writer_map_column(
+    ecs_writer_t *stream,
+    ecs_blob_column_t *column)
+{
+    ecs_table_writer_t *writer = &stream->table;
+    size_t size = column->size * writer->row_count;
+
+    if (stream->input_size <
+        column->padding + ECS_VECTOR_HEADER_SIZE + size + padding_of(size))
+    {
+        goto error;
+    }
+
+    ecs_vector_t *vector = (ecs_vector_t*)
+        ECS_OFFSET(stream->input, column->padding);
+
+    if ((uintptr_t)vector % sizeof(int64_t) ||
+        ecs_vector_count(vector) != writer->row_count ||
+        ecs_vector_size(vector) != writer->row_count)
+    {
+        goto error;
+    }
+
+    writer->column = &writer->columns[writer->column_index];
+    writer->column->data = vector;
+
+    return 0;
+error:
+    stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+    return -1;
 }
 
+/** Store names from a name column, which are serialized as a sequence of
+ * strings, in the column */
 static
-void ecs_table_writer_next(
+int ecs_table_writer_set_names(
     ecs_writer_t *stream)
 {
     ecs_table_writer_t *writer = &stream->table;
+    EcsId *names = ecs_vector_first(writer->column->data);
+    char *ptr = writer->names.name, *end = ptr + writer->names.len;
+    uint32_t i;
+    int result = 0;
+
+    for (i = 0; i < writer->row_count; i ++) {
+        char *name_end = memchr(ptr, 0, end - ptr);
+        if (!name_end) {
+            stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+            result = -1;
+            break;
+        }
 
-    switch(writer->state) {
-    case EcsTableTypeSize:
-        writer->state = EcsTableType;
-        break;
+        names[i] = ecs_os_strdup(ptr);
+        ptr = name_end + 1;
+    }
 
-    case EcsTableType:
-        writer->state = EcsTableSize;
-        break;
+    /* Names are written directly to the column, so the name index has to be
+     * rebuilt before it can be used */
+    ecs_name_index_invalidate(stream->world);
 
-    case EcsTableSize:
-        writer->state = EcsTableColumn;
-        break;
+    /* Names are copied, so buffer is no longer needed */
+    ecs_os_free(writer->names.name);
+    ecs_name_writer_reset(&writer->names);
 
-    case EcsTableColumnHeader:
-        writer->state = EcsTableColumnSize;
-        break;
+    return result;
+}
 
-    case EcsTableColumnSize:
-        writer->state = EcsTableColumnData;
-        break;
+/** Expect the header of the next column, or the next table */
+static
+void ecs_table_writer_next_column(
+    ecs_writer_t *stream)
+{
+    ecs_table_writer_t *writer = &stream->table;
 
-    case EcsTableColumnNameHeader:
-        writer->state = EcsTableColumnNameLength;
-        break;
+    writer->column_index ++;
+    if (writer->column_index > writer->type_count) {
+        ecs_table_writer_finalize_table(stream);
+        ecs_writer_expect_header(stream);
+    } else {
+        ecs_writer_set_data(
+            stream, stream->header, sizeof(ecs_blob_column_t), 0);
+        stream->state = EcsTableColumnHeader;
+    }
+}
+
+/** Find the table of a delta, which must have the same number of rows as the
+ * table in the serialized world */
+static
+int ecs_table_writer_register_delta(
+    ecs_writer_t *stream)
+{
+    ecs_world_t *world = stream->world;
+    ecs_table_writer_t *writer = &stream->table;
+    ecs_type_t type = ecs_type_find(world, writer->type_array, writer->type_count);
+
+    ecs_assert(type != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    writer->table = ecs_world_get_table(world, &world->main_stage, type);
+    ecs_assert(writer->table != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (ecs_vector_count(writer->table->columns[0].data) != writer->row_count) {
+        stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+        return -1;
+    }
+
+    writer->is_delta = true;
+
+    return 0;
+}
+
+/** Test whether a chunk fits in the column of a delta table. Entity ids and
+ * names are never serialized as chunks. */
+static
+int ecs_table_writer_check_chunk(
+    ecs_writer_t *stream,
+    ecs_blob_chunk_t *chunk)
+{
+    ecs_table_writer_t *writer = &stream->table;
+
+    if (!writer->is_delta || chunk->column <= 0 ||
+        chunk->column > (int32_t)writer->type_count ||
+        chunk->row < 0 || chunk->count <= 0 ||
+        chunk->count > (int32_t)writer->row_count - chunk->row)
+    {
+        goto error;
+    }
 
-    case EcsTableColumnNameLength:
-        writer->state = EcsTableColumnName;
+    ecs_entity_t *type_buffer = ecs_vector_first(writer->table->type);
+    if (!writer->table->columns[chunk->column].size ||
+        type_buffer[chunk->column - 1] == EEcsId)
+    {
+        goto error;
+    }
+
+    return 0;
+error:
+    stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+    return -1;
+}
+
+/** Remove entities that are no longer stored in a table from their tables */
+static
+int ecs_delta_writer_next(
+    ecs_writer_t *stream)
+{
+    ecs_world_t *world = stream->world;
+    ecs_table_writer_t *writer = &stream->table;
+    ecs_ei_t *entity_index = world->main_stage.entity_index;
+
+    switch(stream->state) {
+    case EcsDeltaDeleteHeader: {
+        ecs_blob_delete_t *header = (ecs_blob_delete_t*)stream->header;
+        if (header->count <= 0) {
+            stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+            goto error;
+        }
+
+        writer->delete_count = header->count;
+        writer->is_deleted = header->is_deleted != 0;
+
+        ecs_writer_set_data(
+            stream, stream->header, sizeof(ecs_entity_t), 0);
+        stream->state = EcsDeltaDeleteEntity;
         break;
+    }
 
-    case EcsTableColumnName:
-        writer->row_index ++;
-        if (writer->row_index < writer->row_count) {
-            writer->state = EcsTableColumnNameLength;
-            break;
+    case EcsDeltaDeleteEntity: {
+        ecs_entity_t entity = *(ecs_entity_t*)stream->header;
+        ecs_row_t *row = ecs_ei_get(entity_index, entity);
+
+        if (row && row->type) {
+            ecs_table_t *table = ecs_world_get_table(
+                world, &world->main_stage, row->type);
+            ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+
+            ecs_table_delete(world, &world->main_stage,
+                table, table->columns, row->index);
+        }
+
+        if (writer->is_deleted) {
+            ecs_ei_delete(entity_index, entity);
         } else {
-            /* Fallthrough on purpose */
+            ecs_ei_remove(entity_index, entity);
         }
 
-    case EcsTableColumnData:
-        writer->column_index ++;
-        if (writer->column_index > writer->type_count) {
-            ecs_table_writer_finalize_table(stream);
-            stream->state = EcsStreamHeader;
-            writer->column_written = 0;
-            writer->state = 0;
-            writer->column_index = 0;
-            writer->row_index = 0;
+        writer->delete_count --;
+        if (writer->delete_count) {
+            ecs_writer_set_data(
+                stream, stream->header, sizeof(ecs_entity_t), 0);
         } else {
-            writer->state = EcsTableColumn;
+            ecs_writer_expect_header(stream);
         }
         break;
+    }
 
     default:
         ecs_abort(ECS_INTERNAL_ERROR, NULL);
         break;
     }
+
+    return 0;
+error:
+    return -1;
 }
 
 static
-size_t ecs_table_writer(
-    const char *buffer,
-    size_t size,
+int ecs_table_writer_next(
     ecs_writer_t *stream)
 {
     ecs_table_writer_t *writer = &stream->table;
-    size_t written = 0;
 
-    ecs_assert(size != 0, ECS_INTERNAL_ERROR, NULL);
-    ecs_assert(size >= sizeof(uint32_t), ECS_INVALID_PARAMETER, NULL);
+    switch(stream->state) {
+    case EcsTableHeader:
+    case EcsTableDeltaHeader: {
+        ecs_blob_table_t *table = (ecs_blob_table_t*)stream->header;
+        if (table->type_count <= 0 ||
+            table->type_count >= ECS_MAX_ENTITIES_IN_TYPE ||
+            table->row_count < 0)
+        {
+            stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+            goto error;
+        }
 
-    if (!writer->state) {
-        writer->state = EcsTableTypeSize;
-    }
+        writer->type_count = table->type_count;
+        writer->row_count = table->row_count;
 
-    switch(writer->state) {
-    case EcsTableTypeSize:
-        writer->type_count = *(int32_t*)buffer;
         if (writer->type_count > writer->type_max_count) {
             ecs_os_free(writer->type_array);
             writer->type_array = ecs_os_malloc(writer->type_count * sizeof(ecs_entity_t));
             writer->type_max_count = writer->type_count;
         }
-        writer->type_written = 0;
-        written = sizeof(int32_t);
-        ecs_table_writer_next(stream);
-        break;
 
-    case EcsTableType:
-        *(int32_t*)ECS_OFFSET(writer->type_array, writer->type_written) = *(int32_t*)buffer;
-        written = sizeof(int32_t);
-        writer->type_written += written;
+        ecs_writer_set_data(stream, writer->type_array,
+            writer->type_count * sizeof(ecs_entity_t), 0);
 
-        if (writer->type_written == writer->type_count * sizeof(ecs_entity_t)) {
-            ecs_table_writer_register_table(stream);
-            ecs_table_writer_next(stream);
+        if (stream->state == EcsTableHeader) {
+            stream->state = EcsTableType;
+        } else {
+            stream->state = EcsTableDeltaType;
         }
         break;
+    }
+
+    case EcsTableDeltaType:
+        if (ecs_table_writer_register_delta(stream)) {
+            goto error;
+        }
 
-    case EcsTableSize:
-        writer->row_count = *(int32_t*)buffer;
-        written += sizeof(int32_t);
-        ecs_table_writer_next(stream);
+        ecs_writer_expect_header(stream);
         break;
 
-    case EcsTableColumn:
-        writer->state = *(int32_t*)buffer;
-        if (writer->state != EcsTableColumnHeader &&
-            writer->state != EcsTableColumnNameHeader)
-        {
-            stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+    case EcsTableChunkHeader: {
+        ecs_blob_chunk_t *chunk = (ecs_blob_chunk_t*)stream->header;
+        if (ecs_table_writer_check_chunk(stream, chunk)) {
             goto error;
         }
-        written += sizeof(int32_t);
+
+        /* Copy column data that is shared with a snapshot before changing it */
+        ecs_table_unshare_column(stream->world, writer->table, chunk->column);
+
+        ecs_table_column_t *column = &writer->table->columns[chunk->column];
+        size_t size = column->size * chunk->count;
+        column->change_count ++;
+
+        ecs_writer_set_data(stream, ECS_OFFSET(ecs_vector_first(column->data),
+            column->size * chunk->row), size, padding_of(size));
+
+        stream->state = EcsTableChunkData;
+        break;
+    }
+
+    case EcsTableChunkData:
+        ecs_writer_expect_header(stream);
         break;
 
-    case EcsTableColumnHeader:
-    case EcsTableColumnSize:
-        ecs_table_writer_prepare_column(stream, *(int32_t*)buffer);
-        ecs_table_writer_next(stream);
+    case EcsTableType:
+        ecs_table_writer_register_table(stream);
+
+        if (stream->map) {
+            /* Columns of a mapped table replace the table columns when the
+             * table is finalized */
+            uint32_t i, count = ecs_vector_count(writer->table->type) + 1;
+            writer->columns = ecs_os_calloc(sizeof(ecs_table_column_t), count);
+            ecs_assert(writer->columns != NULL, ECS_OUT_OF_MEMORY, NULL);
 
-        written += sizeof(int32_t);
-        ecs_table_writer_next(stream);
+            for (i = 0; i < count; i ++) {
+                writer->columns[i].size = writer->table->columns[i].size;
+            }
+
+        /* Reserve space for all columns, so that setting the column count
+         * does not need to grow the table */
+        } else {
+            writer->columns = writer->table->columns;
+            if (writer->row_count) {
+                ecs_table_dim(stream->world, &stream->world->main_stage, 
+                    writer->table, NULL, writer->row_count);
 
-        /* If column has no size, there will be no column data, so skip to the
-         * next state. */
-        if (!writer->column_size) {
-            ecs_table_writer_next(stream);
+            /* Columns are cleared, which must not change a snapshot */
+            } else {
+                ecs_table_unshare(stream->world, writer->table);
+            }
         }
 
+        writer->column_index = 0;
+        ecs_writer_set_data(
+            stream, stream->header, sizeof(ecs_blob_column_t), 0);
+        stream->state = EcsTableColumnHeader;
         break;
 
-    case EcsTableColumnData: {
-        written = writer->row_count * writer->column_size - writer->column_written;
-        if (written > size) {
-            written = size;
+    case EcsTableColumnHeader: {
+        ecs_blob_column_t *column = (ecs_blob_column_t*)stream->header;
+        ecs_table_column_t *table_column =
+            &writer->columns[writer->column_index];
+
+        if (column->padding < 0 || column->padding % sizeof(int32_t)) {
+            stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+            goto error;
         }
 
-        memcpy(ECS_OFFSET(writer->column_data, writer->column_written), buffer, written);
-        writer->column_written += written;
-        written = (((written - 1) / sizeof(int32_t)) + 1) * sizeof(int32_t);
+        if (column->kind == EcsTableColumnHeader) {
+            /* Column data is copied directly into the table. A mapped table
+             * can only contain data that is stored in the input. */
+            if (column->size != table_column->size || column->padding ||
+                (stream->map && column->size))
+            {
+                stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+                goto error;
+            }
+
+            size_t size = column->size * writer->row_count;
+            ecs_table_writer_prepare_column(stream, column->size);
+            ecs_writer_set_data(stream, ecs_vector_first(writer->column->data),
+                size, padding_of(size));
 
-        if (writer->column_written == writer->row_count * writer->column_size) {
-            ecs_table_writer_next(stream);
+            stream->state = EcsTableColumnData;
+        } else if (column->kind == EcsTableColumnVectorHeader) {
+            if (!column->size || column->size != table_column->size) {
+                stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+                goto error;
+            }
+
+            size_t size = column->size * writer->row_count;
+
+            if (stream->map) {
+                if (ecs_table_writer_map_column(stream, column)) {
+                    goto error;
+                }
+
+                /* Column is not copied, skip to the next column */
+                ecs_writer_set_data(stream, stream->header, 0,
+                    column->padding + ECS_VECTOR_HEADER_SIZE + size +
+                    padding_of(size));
+
+                stream->state = EcsTableColumnData;
+            } else {
+                /* Skip alignment and vector header, copy column data */
+                ecs_writer_set_data(stream, stream->header, 0,
+                    column->padding + ECS_VECTOR_HEADER_SIZE);
+
+                stream->state = EcsTableColumnVector;
+            }
+        } else if (column->kind == EcsTableColumnNameHeader) {
+            if (table_column->size != sizeof(EcsId) || column->size < 0 ||
+                column->padding)
+            {
+                stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+                goto error;
+            }
+
+            ecs_table_writer_prepare_column(stream, sizeof(EcsId));
+            ecs_name_writer_alloc(&writer->names, column->size);
+            ecs_writer_set_data(stream, writer->names.name, column->size,
+                padding_of(column->size));
+
+            stream->state = EcsTableColumnName;
+        } else {
+            stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+            goto error;
         }
         break;
     }
 
-    case EcsTableColumnNameHeader:
-        ecs_table_writer_prepare_column(stream, sizeof(EcsId));
-        ecs_table_writer_next(stream);
+    case EcsTableColumnVector: {
+        int32_t size = writer->columns[writer->column_index].size;
+        size_t data_size = size * writer->row_count;
 
-    case EcsTableColumnNameLength:
-        ecs_name_writer_alloc(&writer->name, *(int32_t*)buffer);
-        written = sizeof(int32_t);
-        ecs_table_writer_next(stream);
-        break;
+        ecs_table_writer_prepare_column(stream, size);
+        ecs_writer_set_data(stream, ecs_vector_first(writer->column->data),
+            data_size, padding_of(data_size));
 
-    case EcsTableColumnName: {
-        written = sizeof(int32_t);
-        if (!ecs_name_writer_write(&writer->name, buffer)) {
-            ((EcsId*)writer->column_data)[writer->row_index] = writer->name.name;
+        stream->state = EcsTableColumnData;
+        break;
+    }
 
-            /* Don't overwrite entity name */
-            ecs_name_writer_reset(&writer->name);   
+    case EcsTableColumnData:
+        ecs_table_writer_next_column(stream);
+        break;
 
-            ecs_table_writer_next(stream);
+    case EcsTableColumnName:
+        if (ecs_table_writer_set_names(stream)) {
+            goto error;
         }
+
+        ecs_table_writer_next_column(stream);
         break;
-    }
 
     default:
         ecs_abort(ECS_INTERNAL_ERROR, NULL);
         break;
     }
 
-    ecs_assert(written <= size, ECS_INTERNAL_ERROR, NULL);
+    return 0;
+error:
+    return -1;
+}
+
+/** Process a block of data that has been completely copied from the input */
+static
+int ecs_writer_next(
+    ecs_writer_t *stream)
+{
+    if (stream->state == EcsStreamHeader) {
+        int32_t kind = *(int32_t*)stream->header;
+
+        /* The first header identifies the format of the data */
+        if (!stream->version) {
+            if (kind != ECS_BLOB_VERSION) {
+                stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+                goto error;
+            }
+
+            stream->version = kind;
+            ecs_writer_expect_header(stream);
+        } else if (kind == EcsComponentHeader) {
+            ecs_writer_set_data(
+                stream, stream->header, sizeof(ecs_blob_component_t), 0);
+            stream->state = EcsComponentHeader;
+        } else if (kind == EcsTableHeader || kind == EcsTableDeltaHeader) {
+            ecs_writer_set_data(
+                stream, stream->header, sizeof(ecs_blob_table_t), 0);
+            stream->state = kind;
+            stream->table.is_delta = false;
+        } else if (kind == EcsTableChunkHeader) {
+            ecs_writer_set_data(
+                stream, stream->header, sizeof(ecs_blob_chunk_t), 0);
+            stream->state = EcsTableChunkHeader;
+        } else if (kind == EcsDeltaDeleteHeader) {
+            ecs_writer_set_data(
+                stream, stream->header, sizeof(ecs_blob_delete_t), 0);
+            stream->state = EcsDeltaDeleteHeader;
+        } else {
+            stream->error = ECS_DESERIALIZE_FORMAT_ERROR;
+            goto error;
+        }
+
+        return 0;
+    } else if (stream->state == EcsComponentHeader ||
+               stream->state == EcsComponentName)
+    {
+        return ecs_component_writer_next(stream);
+    } else if (stream->state == EcsDeltaDeleteHeader ||
+               stream->state == EcsDeltaDeleteEntity)
+    {
+        return ecs_delta_writer_next(stream);
+    } else {
+        return ecs_table_writer_next(stream);
+    }
 
-    return written;
 error:
     return -1;
 }
@@ -442,7 +734,7 @@ int ecs_writer_write(
     size_t size,
     ecs_writer_t *writer)
 {
-    size_t written = 0, total_written = 0, remaining = size;
+    size_t total_written = 0;
 
     if (!size) {
         return 0;
@@ -451,36 +743,49 @@ int ecs_writer_write(
     ecs_assert(size >= sizeof(uint32_t), ECS_INVALID_PARAMETER, NULL);
     ecs_assert(size % 4 == 0, ECS_INVALID_PARAMETER, NULL);
 
-    while (total_written < size) {
-        if (writer->state == EcsStreamHeader) {
-            writer->state = *(ecs_blob_header_kind_t*)ECS_OFFSET(buffer, total_written);
+    if (!writer->data) {
+        ecs_writer_expect_header(writer);
+    }
+
+    while (true) {
+        /* Process blocks that are complete before consuming more input, as a
+         * block may be empty (a column without data) */
+        writer->input = ECS_OFFSET(buffer, total_written);
+        writer->input_size = size - total_written;
 
-            if (writer->state != EcsComponentHeader &&
-                writer->state != EcsTableHeader)
-            {
-                writer->error = ECS_DESERIALIZE_FORMAT_ERROR;
+        while (writer->data_written == writer->data_size + writer->data_padding) {
+            if (ecs_writer_next(writer)) {
                 goto error;
             }
-
-            written = sizeof(ecs_blob_header_kind_t);
-        } else
-        if (writer->state == EcsComponentHeader) {
-            written = ecs_component_writer(ECS_OFFSET(buffer, total_written), remaining, writer);        
-        } else
-        if (writer->state == EcsTableHeader) {
-            written = ecs_table_writer(ECS_OFFSET(buffer, total_written), remaining, writer);
         }
 
-        if (!written) {
+        if (total_written == size) {
             break;
         }
 
-        if (written == -1) {
-            goto error;
+        size_t written, remaining = size - total_written;
+        const char *src = ECS_OFFSET(buffer, total_written);
+
+        /* Copy as much of the current block as is available in the input. The
+         * data is copied directly to its destination, like a table column. */
+        if (writer->data_written < writer->data_size) {
+            written = writer->data_size - writer->data_written;
+            if (written > remaining) {
+                written = remaining;
+            }
+
+            memcpy(ECS_OFFSET(writer->data, writer->data_written), src, written);
+        } else {
+            /* Skip padding bytes */
+            written = writer->data_size + writer->data_padding -
+                writer->data_written;
+            if (written > remaining) {
+                written = remaining;
+            }
         }
 
-        remaining -= written;
-        total_written += written;    
+        writer->data_written += written;
+        total_written += written;
     }
 
     ecs_assert(total_written <= size, ECS_INTERNAL_ERROR, NULL);
@@ -498,3 +803,41 @@ ecs_writer_t ecs_writer_init(
         .state = EcsStreamHeader,
     };
 }
+
+int ecs_load_file(
+    ecs_world_t *world,
+    const char *filename)
+{
+    ecs_assert(ecs_os_api.map_file != NULL, ECS_MISSING_OS_API, "map_file");
+    ecs_assert(ecs_os_api.unmap_file != NULL, ECS_MISSING_OS_API, "unmap_file");
+
+    size_t size = 0;
+    void *data = ecs_os_map_file(filename, &size);
+    if (!data) {
+        return -1;
+    }
+
+    /* Tables may use the mapped data until the world is deleted */
+    ecs_mapped_file_t *file = ecs_vector_add(
+        &world->mapped_files, &mapped_file_arr_params);
+    file->data = data;
+    file->size = size;
+
+    ecs_writer_t writer = ecs_writer_init(world);
+    writer.map = true;
+
+    int result = ecs_writer_write(data, size, &writer);
+    if (result) {
+        /* Free columns of a table that was not completely deserialized */
+        ecs_os_free(writer.table.columns);
+        ecs_world_free(world, writer.table.arena, ECS_TABLE_ALIGNMENT, 
+            writer.table.arena_size);
+        ecs_os_err("failed to load '%s': %s", filename,
+            ecs_strerror(writer.error));
+    }
+
+    ecs_os_free(writer.table.type_array);
+    ecs_os_free(writer.component.name.name);
+
+    return result;
+}
@@ -596,3 +596,96 @@ void Add_remove_entity() {
     
     ecs_fini(world);
 }
+
+void Add_add_remove_tag_again() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_entity_t e_2 = ecs_new(world, Position);
+
+    ecs_add(world, e_1, Tag);
+    ecs_remove(world, e_1, Tag);
+
+    /* Second transition from same table uses cached edge */
+    ecs_add(world, e_2, Tag);
+    test_assert(ecs_has(world, e_2, Tag));
+    test_assert(ecs_has(world, e_2, Position));
+    test_assert(ecs_get_type(world, e_2) != ecs_get_type(world, e_1));
+
+    ecs_add(world, e_1, Tag);
+    test_assert(ecs_get_type(world, e_2) == ecs_get_type(world, e_1));
+
+    ecs_remove(world, e_2, Tag);
+    test_assert(!ecs_has(world, e_2, Tag));
+    test_assert(ecs_has(world, e_2, Position));
+    test_assert(ecs_get_type(world, e_2) == ecs_type(Position));
+    
+    ecs_fini(world);
+}
+
+void Add_add_remove_hi_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    /* Create entity with an id that is not stored in the edge array */
+    ecs_entity_t tag = ecs_new(world, 0);
+    ecs_set_entity_range(world, 5000, 0);
+    ecs_entity_t f = ecs_new(world, 0);
+    test_assert(f >= 5000);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_entity_t e_2 = ecs_new(world, Position);
+
+    ecs_add_entity(world, e_1, f);
+    ecs_add_entity(world, e_2, f);
+    ecs_add_entity(world, e_2, tag);
+    test_assert(ecs_has_entity(world, e_1, f));
+    test_assert(ecs_has_entity(world, e_2, f));
+    test_assert(ecs_has_entity(world, e_2, tag));
+
+    ecs_remove_entity(world, e_1, f);
+    ecs_remove_entity(world, e_2, tag);
+    test_assert(!ecs_has_entity(world, e_1, f));
+    test_assert(!ecs_has_entity(world, e_2, tag));
+    test_assert(ecs_has_entity(world, e_2, f));
+    
+    ecs_fini(world);
+}
+
+static
+void AddTag(ecs_rows_t *rows) {
+    ecs_type_t TTag = ecs_column_type(rows, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        _ecs_add(rows->world, rows->entities[i], TTag);
+    }
+}
+
+void Add_add_again_in_progress() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ECS_SYSTEM(world, AddTag, EcsOnUpdate, Position, .Tag);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_add(world, e_1, Tag);
+    ecs_remove(world, e_1, Tag);
+
+    ecs_entity_t e_2 = ecs_new(world, Position);
+
+    ecs_progress(world, 0);
+
+    test_assert(ecs_has(world, e_1, Tag));
+    test_assert(ecs_has(world, e_2, Tag));
+    test_assert(ecs_has(world, e_1, Position));
+    test_assert(ecs_has(world, e_2, Position));
+    
+    ecs_fini(world);
+}
@@ -496,3 +496,165 @@ void Add_remove_w_filter_add_2() {
 
     ecs_fini(world);
 }
+
+static
+void test_add_remove_values(
+    bool arena)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_TYPE(world, Type_1, Position, Velocity);
+    ECS_TYPE(world, Type_2, Position, Mass);
+
+    if (arena) {
+        ecs_set_table_arena(world, true);
+    }
+
+    ecs_entity_t e_1 = ecs_new_w_count(world, Type_1, 3);
+    ecs_entity_t e_2 = ecs_new_w_count(world, Type_2, 3);
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        ecs_set(world, e_1 + i, Position, {i, i * 2});
+        ecs_set(world, e_1 + i, Velocity, {i * 3, i * 4});
+        ecs_set(world, e_2 + i, Position, {i + 10, i + 20});
+        ecs_set(world, e_2 + i, Mass, {i + 30});
+    }
+
+    /* Moves Type_1 to Type_2, which is not empty */
+    ecs_add_remove_w_filter(world, Mass, Velocity, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    test_int( ecs_count(world, Type_1), 0);
+    test_int( ecs_count(world, Type_2), 6);
+
+    for (i = 0; i < 3; i ++) {
+        test_assert( ecs_get_type(world, e_1 + i) == ecs_type(Type_2));
+        test_assert( ecs_get_type(world, e_2 + i) == ecs_type(Type_2));
+
+        Position *p = ecs_get_ptr(world, e_1 + i, Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+
+        p = ecs_get_ptr(world, e_2 + i, Position);
+        test_assert(p != NULL);
+        test_int(p->x, i + 10);
+        test_int(p->y, i + 20);
+
+        Mass *m = ecs_get_ptr(world, e_2 + i, Mass);
+        test_assert(m != NULL);
+        test_int(*m, i + 30);
+
+        /* Values of added component can be set after the move */
+        ecs_set(world, e_1 + i, Mass, {i + 40});
+    }
+
+    /* Moves Type_2 to Type_1, which is empty */
+    ecs_add_remove_w_filter(world, Velocity, Mass, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    test_int( ecs_count(world, Type_1), 6);
+    test_int( ecs_count(world, Type_2), 0);
+
+    for (i = 0; i < 3; i ++) {
+        test_assert( ecs_get_type(world, e_1 + i) == ecs_type(Type_1));
+        test_assert( ecs_get_type(world, e_2 + i) == ecs_type(Type_1));
+
+        Position *p = ecs_get_ptr(world, e_1 + i, Position);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+
+        p = ecs_get_ptr(world, e_2 + i, Position);
+        test_int(p->x, i + 10);
+        test_int(p->y, i + 20);
+
+        ecs_set(world, e_2 + i, Velocity, {i, i});
+        test_assert( ecs_get_ptr(world, e_1 + i, Velocity) != NULL);
+    }
+
+    ecs_fini(world);
+}
+
+void Add_remove_w_filter_add_remove_values() {
+    test_add_remove_values(false);
+}
+
+void Add_remove_w_filter_add_remove_values_w_arena() {
+    test_add_remove_values(true);
+}
+
+void Add_remove_w_filter_add_remove_same_table() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_TYPE(world, Type_1, Position, Mass);
+    ECS_TYPE(world, Type_2, Position, Velocity);
+
+    ecs_entity_t e_1 = ecs_new_w_count(world, Type_1, 3);
+    ecs_entity_t e_2 = ecs_new_w_count(world, Type_2, 3);
+
+    /* Type_1 already has Mass, but still has Velocity removed */
+    ecs_add_remove_w_filter(world, Mass, Velocity, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    test_int( ecs_count(world, Type_1), 6);
+    test_int( ecs_count(world, Type_2), 0);
+
+    test_assert( ecs_get_type(world, e_1) == ecs_type(Type_1));
+    test_assert( ecs_get_type(world, e_2) == ecs_type(Type_1));
+    test_assert( ecs_get_type(world, e_2 + 2) == ecs_type(Type_1));
+
+    ecs_fini(world);
+}
+
+static
+void Dummy(ecs_rows_t *rows) {
+    ProbeSystem(rows);
+}
+
+void Add_remove_w_filter_add_activates_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_SYSTEM(world, Dummy, EcsOnUpdate, Position, Mass);
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, 3);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 0);
+
+    ecs_add_remove_w_filter(world, Mass, 0, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 3);
+    test_int(ctx.e[0], e);
+    test_int(ctx.e[1], e + 1);
+    test_int(ctx.e[2], e + 2);
+
+    /* Table of entities is empty, system should no longer be invoked */
+    ecs_add_remove_w_filter(world, 0, Mass, NULL);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.count, 0);
+
+    ecs_fini(world);
+}
@@ -0,0 +1,891 @@
+#include <api.h>
+
+typedef struct xtor_ctx {
+    int32_t ctor;
+    int32_t ctor_invoked;
+    int32_t dtor;
+    int32_t copy;
+    int32_t move;
+} xtor_ctx;
+
+static
+void position_ctor(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx)
+{
+    test_int(size, sizeof(Position));
+
+    xtor_ctx *data = ctx;
+    data->ctor += count;
+    data->ctor_invoked ++;
+
+    Position *p = ptr;
+    uint32_t i;
+    for (i = 0; i < count; i ++) {
+        p[i].x = 10;
+        p[i].y = 20;
+    }
+}
+
+static
+void count_dtor(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx)
+{
+    xtor_ctx *data = ctx;
+    data->dtor += count;
+}
+
+static
+void count_copy(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *dst_ptr,
+    const void *src_ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx)
+{
+    xtor_ctx *data = ctx;
+    data->copy += count;
+    memcpy(dst_ptr, src_ptr, size * count);
+}
+
+static
+void count_move(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *dst_ptr,
+    void *src_ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx)
+{
+    xtor_ctx *data = ctx;
+    data->move += count;
+    memcpy(dst_ptr, src_ptr, size * count);
+}
+
+void ComponentLifecycle_ctor_on_add() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .ctor = position_ctor,
+            .dtor = count_dtor,
+            .ctx = &ctx
+        });
+
+    ecs_entity_t e = ecs_new(world, 0);
+    ecs_add(world, e, Position);
+    test_int(ctx.ctor, 1);
+    test_int(ctx.dtor, 0);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+
+    test_int(ctx.dtor, 1);
+}
+
+void ComponentLifecycle_ctor_on_new_w_count() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .ctor = position_ctor,
+            .ctx = &ctx
+        });
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, 10);
+    test_assert(e != 0);
+    test_int(ctx.ctor, 10);
+    test_int(ctx.ctor_invoked, 1);
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        Position *p = ecs_get_ptr(world, e + i, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 10);
+        test_int(p->y, 20);
+    }
+
+    ecs_fini(world);
+}
+
+void ComponentLifecycle_zero_init_wo_ctor() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .dtor = count_dtor,
+            .ctx = &ctx
+        });
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, 10);
+    test_assert(e != 0);
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        Position *p = ecs_get_ptr(world, e + i, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 0);
+        test_int(p->y, 0);
+    }
+
+    ecs_fini(world);
+
+    test_int(ctx.dtor, 10);
+}
+
+void ComponentLifecycle_dtor_on_remove() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Velocity),
+        &(EcsComponentLifecycle){
+            .dtor = count_dtor,
+            .ctx = &ctx
+        });
+
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_add(world, e, Velocity);
+    ctx = (xtor_ctx){0};
+
+    ecs_remove(world, e, Velocity);
+    test_int(ctx.dtor, 1);
+    test_assert(ecs_has(world, e, Position));
+    test_assert(!ecs_has(world, e, Velocity));
+
+    ecs_fini(world);
+
+    test_int(ctx.dtor, 1);
+}
+
+void ComponentLifecycle_dtor_on_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .dtor = count_dtor,
+            .ctx = &ctx
+        });
+
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_delete(world, e);
+    test_int(ctx.dtor, 1);
+
+    ecs_fini(world);
+
+    test_int(ctx.dtor, 1);
+}
+
+void ComponentLifecycle_dtor_on_delete_w_filter() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .dtor = count_dtor,
+            .ctx = &ctx
+        });
+
+    ecs_new_w_count(world, Position, 10);
+
+    ecs_delete_w_filter(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    });
+
+    test_int(ctx.dtor, 10);
+    test_int(ecs_count(world, Position), 0);
+
+    ecs_fini(world);
+
+    test_int(ctx.dtor, 10);
+}
+
+void ComponentLifecycle_dtor_on_fini() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .ctor = position_ctor,
+            .dtor = count_dtor,
+            .ctx = &ctx
+        });
+
+    ecs_new_w_count(world, Position, 3);
+    test_int(ctx.ctor, 3);
+    test_int(ctx.dtor, 0);
+
+    ecs_fini(world);
+
+    test_int(ctx.dtor, 3);
+}
+
+void ComponentLifecycle_move_on_add() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .ctor = position_ctor,
+            .dtor = count_dtor,
+            .move = count_move,
+            .ctx = &ctx
+        });
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {1, 2});
+    test_int(ctx.ctor, 1);
+
+    ecs_add(world, e, Velocity);
+    test_int(ctx.ctor, 2);
+    test_int(ctx.move, 1);
+    test_int(ctx.dtor, 1);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    ecs_fini(world);
+
+    test_int(ctx.dtor, 2);
+}
+
+void ComponentLifecycle_move_on_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .ctor = position_ctor,
+            .dtor = count_dtor,
+            .move = count_move,
+            .ctx = &ctx
+        });
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, 3);
+    ecs_set(world, e, Position, {1, 2});
+    ecs_set(world, e + 1, Position, {3, 4});
+    ecs_set(world, e + 2, Position, {5, 6});
+
+    ctx = (xtor_ctx){0};
+
+    ecs_delete(world, e);
+    test_int(ctx.move, 1);
+    test_int(ctx.dtor, 1);
+
+    Position *p = ecs_get_ptr(world, e + 1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+
+    p = ecs_get_ptr(world, e + 2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 5);
+    test_int(p->y, 6);
+
+    ecs_fini(world);
+
+    test_int(ctx.dtor, 3);
+}
+
+void ComponentLifecycle_move_on_grow() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .ctor = position_ctor,
+            .dtor = count_dtor,
+            .move = count_move,
+            .ctx = &ctx
+        });
+
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_set(world, e, Position, {1, 2});
+
+    /* Values that move to a larger allocation are moved with the callback */
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_new(world, Position);
+    }
+
+    test_assert(ctx.move != 0);
+    test_int(ctx.ctor - ctx.dtor, 101);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    ecs_fini(world);
+
+    test_int(ctx.ctor, ctx.dtor);
+}
+
+void ComponentLifecycle_copy_on_set() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .copy = count_copy,
+            .ctx = &ctx
+        });
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {1, 2});
+    test_int(ctx.copy, 1);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    ecs_fini(world);
+}
+
+void ComponentLifecycle_copy_on_clone() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .copy = count_copy,
+            .ctx = &ctx
+        });
+
+    ecs_entity_t e_1 = ecs_set(world, 0, Position, {1, 2});
+    ctx = (xtor_ctx){0};
+
+    ecs_entity_t e_2 = ecs_clone(world, e_1, true);
+    test_int(ctx.copy, 1);
+
+    Position *p = ecs_get_ptr(world, e_2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    ecs_fini(world);
+}
+
+void ComponentLifecycle_copy_on_override() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .copy = count_copy,
+            .ctx = &ctx
+        });
+
+    ECS_PREFAB(world, Prefab, Position);
+    ecs_set(world, Prefab, Position, {1, 2});
+
+    ecs_entity_t e = _ecs_new_instance(world, Prefab, 0);
+    ctx = (xtor_ctx){0};
+
+    ecs_add(world, e, Position);
+    test_int(ctx.copy, 1);
+    test_assert(ecs_has_owned(world, e, Position));
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    ecs_fini(world);
+}
+
+static
+void Add_velocity(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_add(rows->world, rows->entities[i], Velocity);
+    }
+}
+
+static
+void velocity_ctor(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx)
+{
+    xtor_ctx *data = ctx;
+    data->ctor += count;
+
+    Velocity *v = ptr;
+    uint32_t i;
+    for (i = 0; i < count; i ++) {
+        v[i].x = 30;
+        v[i].y = 40;
+    }
+}
+
+void ComponentLifecycle_staged_add() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Velocity),
+        &(EcsComponentLifecycle){
+            .ctor = velocity_ctor,
+            .dtor = count_dtor,
+            .copy = count_copy,
+            .move = count_move,
+            .ctx = &ctx
+        });
+
+    ECS_SYSTEM(world, Add_velocity, EcsOnUpdate, Position, .Velocity);
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, 10);
+
+    ecs_progress(world, 1);
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        test_assert(ecs_has(world, e + i, Velocity));
+        Velocity *v = ecs_get_ptr(world, e + i, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, 30);
+        test_int(v->y, 40);
+    }
+
+    /* Staged values are destructed after they are merged */
+    test_int(ctx.ctor - ctx.dtor, 10);
+
+    ecs_fini(world);
+
+    test_int(ctx.ctor, ctx.dtor);
+}
+
+static
+void Set_velocity(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_set(rows->world, rows->entities[i], Velocity, {i, i * 2});
+    }
+}
+
+void ComponentLifecycle_staged_set() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Velocity),
+        &(EcsComponentLifecycle){
+            .ctor = velocity_ctor,
+            .dtor = count_dtor,
+            .copy = count_copy,
+            .move = count_move,
+            .ctx = &ctx
+        });
+
+    ECS_SYSTEM(world, Set_velocity, EcsOnUpdate, Position, .Velocity);
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, 10);
+
+    ecs_progress(world, 1);
+
+    test_int(ctx.copy, 10);
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        Velocity *v = ecs_get_ptr(world, e + i, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, i);
+        test_int(v->y, i * 2);
+    }
+
+    ecs_fini(world);
+
+    test_int(ctx.ctor, ctx.dtor);
+}
+
+/* Component that owns heap memory. Values that are not moved or destructed
+ * with the callbacks leak or are freed twice. */
+typedef struct String {
+    char *value;
+} String;
+
+static int32_t string_alive;
+
+static
+void string_dtor(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx)
+{
+    String *s = ptr;
+    uint32_t i;
+    for (i = 0; i < count; i ++) {
+        if (s[i].value) {
+            ecs_os_free(s[i].value);
+            string_alive --;
+        }
+    }
+}
+
+static
+void string_copy(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *dst_ptr,
+    const void *src_ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx)
+{
+    String *dst = dst_ptr;
+    const String *src = src_ptr;
+    uint32_t i;
+    for (i = 0; i < count; i ++) {
+        if (dst[i].value) {
+            ecs_os_free(dst[i].value);
+            string_alive --;
+        }
+        if (src[i].value) {
+            dst[i].value = ecs_os_strdup(src[i].value);
+            string_alive ++;
+        } else {
+            dst[i].value = NULL;
+        }
+    }
+}
+
+static
+void string_move(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *dst_ptr,
+    void *src_ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx)
+{
+    String *dst = dst_ptr;
+    String *src = src_ptr;
+    uint32_t i;
+    for (i = 0; i < count; i ++) {
+        char *tmp = dst[i].value;
+        dst[i].value = src[i].value;
+        src[i].value = tmp;
+    }
+}
+
+static
+void Set_string(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, String, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_set(rows->world, rows->entities[i], String, {"staged"});
+    }
+}
+
+static
+void owned_resource(
+    bool arena)
+{
+    ecs_world_t *world = ecs_init();
+    ecs_set_table_arena(world, arena);
+    string_alive = 0;
+
+    ECS_COMPONENT(world, String);
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_set_component_lifecycle(world, ecs_entity(String),
+        &(EcsComponentLifecycle){
+            .dtor = string_dtor,
+            .copy = string_copy,
+            .move = string_move
+        });
+
+    ecs_entity_t e = ecs_new_w_count(world, String, 100);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_set(world, e + i, String, {"hello"});
+    }
+
+    /* Move values to other tables, and delete from the middle of tables */
+    for (i = 0; i < 100; i += 2) {
+        ecs_add(world, e + i, Position);
+    }
+
+    for (i = 0; i < 100; i += 3) {
+        ecs_delete(world, e + i);
+    }
+
+    ecs_entity_t clone = ecs_clone(world, e + 1, true);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    ecs_set(world, e + 1, String, {"world"});
+    test_str(ecs_get(world, e + 1, String).value, "world");
+
+    ecs_snapshot_restore(world, s);
+    test_str(ecs_get(world, e + 1, String).value, "hello");
+
+    ECS_SYSTEM(world, Set_string, EcsOnUpdate, Velocity, .String);
+    ecs_add(world, e + 1, Velocity);
+    ecs_add(world, clone, Velocity);
+
+    ecs_progress(world, 1);
+
+    test_str(ecs_get(world, e + 1, String).value, "staged");
+    test_str(ecs_get(world, clone, String).value, "staged");
+
+    for (i = 0; i < 100; i ++) {
+        if (i % 3 && i != 1) {
+            test_str(ecs_get(world, e + i, String).value, "hello");
+        }
+    }
+
+    ecs_fini(world);
+
+    test_int(string_alive, 0);
+}
+
+void ComponentLifecycle_owned_resource() {
+    owned_resource(false);
+}
+
+void ComponentLifecycle_owned_resource_w_arena() {
+    owned_resource(true);
+}
+
+void ComponentLifecycle_dtor_on_remove_w_filter() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    xtor_ctx ctx = {0};
+    ecs_set_component_lifecycle(world, ecs_entity(Position),
+        &(EcsComponentLifecycle){
+            .dtor = count_dtor,
+            .ctx = &ctx
+        });
+
+    ECS_TYPE(world, Type, Position, Velocity);
+    ecs_new_w_count(world, Type, 10);
+
+    ecs_add_remove_w_filter(world, 0, Position, NULL);
+
+    test_int(ctx.dtor, 10);
+    test_int(ecs_count(world, Position), 0);
+    test_int(ecs_count(world, Velocity), 10);
+
+    ecs_fini(world);
+
+    test_int(ctx.dtor, 10);
+}
+
+static
+void owned_resource_w_filter(
+    bool arena)
+{
+    ecs_world_t *world = ecs_init();
+    ecs_set_table_arena(world, arena);
+    string_alive = 0;
+
+    ECS_COMPONENT(world, String);
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_set_component_lifecycle(world, ecs_entity(String),
+        &(EcsComponentLifecycle){
+            .dtor = string_dtor,
+            .copy = string_copy,
+            .move = string_move
+        });
+
+    ecs_entity_t e = ecs_new_w_count(world, String, 100);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_set(world, e + i, String, {"hello"});
+    }
+
+    /* Destination table is not empty, values are appended */
+    for (i = 0; i < 10; i ++) {
+        ecs_add(world, e + i, Position);
+    }
+
+    ecs_add_remove_w_filter(world, Position, 0, &(ecs_filter_t){
+        .include = ecs_type(String)
+    });
+    test_int(ecs_count(world, Position), 100);
+
+    /* Destination table is empty, columns are moved */
+    ecs_add_remove_w_filter(world, Velocity, Position, &(ecs_filter_t){
+        .include = ecs_type(String)
+    });
+    test_int(ecs_count(world, Position), 0);
+    test_int(ecs_count(world, Velocity), 100);
+
+    for (i = 0; i < 100; i ++) {
+        test_str(ecs_get(world, e + i, String).value, "hello");
+    }
+
+    test_int(string_alive, 100);
+
+    ecs_add_remove_w_filter(world, 0, String, NULL);
+    test_int(string_alive, 0);
+
+    ecs_fini(world);
+
+    test_int(string_alive, 0);
+}
+
+void ComponentLifecycle_owned_resource_w_filter() {
+    owned_resource_w_filter(false);
+}
+
+void ComponentLifecycle_owned_resource_w_filter_w_arena() {
+    owned_resource_w_filter(true);
+}
+
+/* Component with a ctor and dtor, but without a move callback. Values are
+ * moved with memcpy, so each value must be destructed exactly once. */
+typedef struct Handle {
+    int32_t *value;
+} Handle;
+
+static int32_t handle_alive;
+
+static
+void handle_ctor(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx)
+{
+    Handle *h = ptr;
+    uint32_t i;
+    for (i = 0; i < count; i ++) {
+        h[i].value = ecs_os_malloc(sizeof(int32_t));
+        handle_alive ++;
+    }
+}
+
+static
+void handle_dtor(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    void *ptr,
+    size_t size,
+    uint32_t count,
+    void *ctx)
+{
+    Handle *h = ptr;
+    uint32_t i;
+    for (i = 0; i < count; i ++) {
+        test_assert(h[i].value != NULL);
+        ecs_os_free(h[i].value);
+        h[i].value = NULL;
+        handle_alive --;
+    }
+}
+
+void ComponentLifecycle_dtor_on_arena_grow() {
+    ecs_world_t *world = ecs_init();
+    ecs_set_table_arena(world, true);
+    handle_alive = 0;
+
+    ECS_COMPONENT(world, Handle);
+    ECS_COMPONENT(world, Position);
+
+    ecs_set_component_lifecycle(world, ecs_entity(Handle),
+        &(EcsComponentLifecycle){
+            .ctor = handle_ctor,
+            .dtor = handle_dtor
+        });
+
+    /* Each new entity grows the block of the table */
+    ecs_new(world, Handle);
+    ecs_new(world, Handle);
+    ecs_new(world, Handle);
+    test_int(handle_alive, 3);
+
+    ecs_entity_t e = ecs_new_w_count(world, Handle, 100);
+    test_int(handle_alive, 103);
+
+    int i;
+    for (i = 0; i < 100; i += 2) {
+        ecs_add(world, e + i, Position);
+    }
+
+    for (i = 0; i < 100; i += 3) {
+        ecs_delete(world, e + i);
+    }
+
+    test_int(handle_alive, 103 - 34);
+
+    ecs_fini(world);
+
+    test_int(handle_alive, 0);
+}
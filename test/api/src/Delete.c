@@ -193,3 +193,145 @@ void Delete_delete_w_on_remove() {
     
     ecs_fini(world);
 }
+
+void Delete_recycle_id() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    test_assert(e_1 != 0);
+
+    ecs_delete(world, e_1);
+
+    ecs_entity_t e_2 = ecs_new(world, Position);
+    test_assert(e_2 != 0);
+    test_assert(e_2 != e_1);
+    test_int(ECS_ENTITY_ID(e_2), ECS_ENTITY_ID(e_1));
+    test_int(ECS_GENERATION(e_2), ECS_GENERATION(e_1) + 1);
+    
+    ecs_fini(world);
+}
+
+void Delete_is_alive() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_entity_t e_2 = ecs_new(world, 0);
+
+    test_assert(ecs_is_alive(world, e_1));
+    test_assert(ecs_is_alive(world, e_2));
+    test_assert(!ecs_is_alive(world, e_2 + 1));
+    
+    ecs_fini(world);
+}
+
+void Delete_is_alive_after_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_entity_t e_2 = ecs_new(world, 0);
+
+    ecs_delete(world, e_1);
+    ecs_delete(world, e_2);
+
+    test_assert(!ecs_is_alive(world, e_1));
+    test_assert(!ecs_is_alive(world, e_2));
+    
+    ecs_fini(world);
+}
+
+void Delete_is_alive_after_recycle() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_delete(world, e_1);
+
+    ecs_entity_t e_2 = ecs_new(world, 0);
+    test_int(ECS_ENTITY_ID(e_2), ECS_ENTITY_ID(e_1));
+
+    test_assert(!ecs_is_alive(world, e_1));
+    test_assert(ecs_is_alive(world, e_2));
+    
+    ecs_fini(world);
+}
+
+void Delete_get_after_recycle() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_delete(world, e_1);
+
+    ecs_entity_t e_2 = ecs_set(world, 0, Position, {30, 40});
+    test_int(ECS_ENTITY_ID(e_2), ECS_ENTITY_ID(e_1));
+
+    test_assert(!ecs_has(world, e_1, Position));
+    test_assert(ecs_get_ptr(world, e_1, Position) == NULL);
+
+    Position *p = ecs_get_ptr(world, e_2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+    
+    ecs_fini(world);
+}
+
+void Delete_delete_stale_handle() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_delete(world, e_1);
+
+    ecs_entity_t e_2 = ecs_new(world, Position);
+    test_int(ECS_ENTITY_ID(e_2), ECS_ENTITY_ID(e_1));
+
+    /* Deleting the stale handle should not delete the new entity */
+    ecs_delete(world, e_1);
+    test_assert(ecs_is_alive(world, e_2));
+    test_assert(ecs_has(world, e_2, Position));
+
+    /* Id should not have been added to the free list twice */
+    ecs_entity_t e_3 = ecs_new(world, 0);
+    test_assert(ECS_ENTITY_ID(e_3) != ECS_ENTITY_ID(e_2));
+    
+    ecs_fini(world);
+}
+
+static
+void DeleteAll(ecs_rows_t *rows) {
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_delete(rows->world, rows->entities[i]);
+    }
+}
+
+void Delete_recycle_in_progress() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, DeleteAll, EcsOnUpdate, Position);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    test_assert(ecs_is_alive(world, e_1));
+
+    ecs_progress(world, 0);
+
+    test_assert(!ecs_is_alive(world, e_1));
+
+    ecs_entity_t e_2 = ecs_new(world, 0);
+    test_int(ECS_ENTITY_ID(e_2), ECS_ENTITY_ID(e_1));
+    test_assert(ecs_is_alive(world, e_2));
+    
+    ecs_fini(world);
+}
@@ -387,3 +387,292 @@ void FilterIter_iter_snapshot_filtered_table() {
     
     ecs_fini(world);
 }
+
+void FilterIter_iter_w_inherited_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_PREFAB(world, Prefab, Velocity);
+
+    ecs_entity_t e = ecs_new_instance(world, Prefab, Position);
+    test_assert(e != 0);
+
+    ecs_new(world, Position);
+
+    ECS_TYPE(world, Movable, Position, Velocity);
+
+    ecs_filter_iter_t it = ecs_filter_iter(world, &(ecs_filter_t){
+        .include = ecs_type(Movable)
+    });
+
+    int table_count = 0;
+    int entity_count = 0;
+
+    while (ecs_filter_next(&it)) {
+        table_count ++;
+        entity_count += it.rows.count;
+        test_assert(it.rows.entities[0] == e);
+    }
+
+    test_int(table_count, 1);
+    test_int(entity_count, 1);
+
+    test_int(ecs_count_w_filter(world, &(ecs_filter_t){
+        .include = ecs_type(Movable)
+    }), 1);
+
+    ecs_fini(world);
+}
+
+void FilterIter_iter_match_any() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_TYPE(world, Movable, Position, Velocity);
+
+    ecs_new(world, Position);
+    ecs_new(world, Velocity);
+    ecs_new(world, Mass);
+
+    ecs_filter_iter_t it = ecs_filter_iter(world, &(ecs_filter_t){
+        .include = ecs_type(Movable),
+        .include_kind = EcsMatchAny
+    });
+
+    int table_count = 0;
+    int entity_count = 0;
+
+    while (ecs_filter_next(&it)) {
+        table_count ++;
+        entity_count += it.rows.count;
+
+        ecs_type_t table_type = ecs_table_type(&it.rows);
+        test_assert(!ecs_type_has_entity(world, table_type, ecs_entity(Mass)));
+    }
+
+    test_int(table_count, 2);
+    test_int(entity_count, 2);
+
+    ecs_fini(world);
+}
+
+void FilterIter_iter_w_many_components() {
+    ecs_world_t *world = ecs_init();
+
+    /* Create more tags than there are bits in a table signature, so that
+     * tables share signature bits with tags they don't have */
+    ecs_entity_t tags[128];
+    ecs_type_t type = NULL;
+
+    int i;
+    for (i = 0; i < 128; i ++) {
+        tags[i] = _ecs_new(world, NULL);
+        test_assert(tags[i] != 0);
+
+        if (i < 64) {
+            type = ecs_type_add(world, type, tags[i]);
+        }
+    }
+
+    ecs_entity_t e = _ecs_new(world, type);
+    test_assert(e != 0);
+
+    for (i = 0; i < 128; i ++) {
+        ecs_filter_t filter = {
+            .include = ecs_type_add(world, NULL, tags[i])
+        };
+
+        test_int(ecs_count_w_filter(world, &filter), i < 64);
+
+        ecs_filter_iter_t it = ecs_filter_iter(world, &filter);
+        int entity_count = 0;
+        while (ecs_filter_next(&it)) {
+            entity_count += it.rows.count;
+        }
+
+        test_int(entity_count, i < 64);
+    }
+
+    ecs_fini(world);
+}
+
+static
+void IncPosition(ecs_rows_t *rows) {
+    Position *p = ecs_table_column(rows, 0);
+    test_assert(p != NULL);
+
+    int32_t *count = rows->param;
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        test_int(p[i].y, rows->entities[i]);
+        p[i].x ++;
+    }
+
+    ecs_os_ainc(count);
+}
+
+static
+void SetVelocity(ecs_rows_t *rows) {
+    ECS_ENTITY_VAR(Velocity) = *(ecs_entity_t*)rows->param;
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_entity_t e = rows->entities[i];
+        ecs_set(rows->world, e, Velocity, {e, e * 2});
+    }
+}
+
+static
+void run_inc_position(
+    uint32_t threads,
+    uint32_t job_size)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_TYPE(world, Movable, Position, Velocity);
+
+    int i, ENTITIES = 100;
+
+    ecs_entity_t e1 = ecs_new_w_count(world, Position, ENTITIES);
+    ecs_entity_t e2 = ecs_new_w_count(world, Movable, ENTITIES);
+    ecs_new_w_count(world, Velocity, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_set(world, e1 + i, Position, {0, e1 + i});
+        ecs_set(world, e2 + i, Position, {0, e2 + i});
+    }
+
+    ecs_set_threads(world, threads);
+    ecs_set_job_size(world, job_size);
+
+    int32_t count = 0;
+    ecs_filter_run(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    }, IncPosition, &count);
+
+    test_assert(count >= 2);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        Position *p = ecs_get_ptr(world, e1 + i, Position);
+        test_int(p->x, 1);
+        p = ecs_get_ptr(world, e2 + i, Position);
+        test_int(p->x, 1);
+    }
+
+    ecs_fini(world);
+}
+
+void FilterIter_run() {
+    run_inc_position(0, 0);
+}
+
+void FilterIter_run_w_threads() {
+    run_inc_position(4, 0);
+}
+
+void FilterIter_run_w_threads_w_job_size() {
+    run_inc_position(4, 7);
+}
+
+void FilterIter_run_no_match() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_new_w_count(world, Velocity, 10);
+
+    ecs_set_threads(world, 2);
+
+    int32_t count = 0;
+    ecs_filter_run(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    }, IncPosition, &count);
+
+    test_int(count, 0);
+
+    ecs_fini(world);
+}
+
+static
+void run_set_velocity(
+    uint32_t threads)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    int i, ENTITIES = 100;
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, ENTITIES);
+
+    ecs_set_threads(world, threads);
+
+    ecs_filter_run(world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    }, SetVelocity, &ecs_entity(Velocity));
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_assert( ecs_has(world, e + i, Position));
+        Velocity *v = ecs_get_ptr(world, e + i, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, e + i);
+        test_int(v->y, (e + i) * 2);
+    }
+
+    ecs_fini(world);
+}
+
+void FilterIter_run_set() {
+    run_set_velocity(0);
+}
+
+void FilterIter_run_w_threads_set() {
+    run_set_velocity(4);
+}
+
+static
+void RunFilter(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, Position, 1);
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    ecs_filter_run(rows->world, &(ecs_filter_t){
+        .include = ecs_type(Position)
+    }, SetVelocity, &ecs_entity(Velocity));
+}
+
+void FilterIter_run_w_threads_from_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, RunFilter, EcsOnStore, .Position, .Velocity);
+
+    int i, ENTITIES = 100;
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, ENTITIES);
+
+    ecs_set_threads(world, 4);
+
+    ecs_progress(world, 1);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        Velocity *v = ecs_get_ptr(world, e + i, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, e + i);
+        test_int(v->y, (e + i) * 2);
+    }
+
+    ecs_fini(world);
+}
@@ -179,3 +179,243 @@ void Lookup_get_id_from_empty() {
 
     ecs_fini(world);
 }
+
+void Lookup_lookup_after_rename() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsId, {"Foo"});
+    test_assert(ecs_lookup(world, "Foo") == e);
+
+    ecs_set(world, e, EcsId, {"Bar"});
+    test_assert(ecs_lookup(world, "Foo") == 0);
+    test_assert(ecs_lookup(world, "Bar") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsId, {"Foo"});
+    test_assert(ecs_lookup(world, "Foo") == e);
+
+    ecs_delete(world, e);
+    test_assert(ecs_lookup(world, "Foo") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_remove_id() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsId, {"Foo"});
+    test_assert(ecs_lookup(world, "Foo") == e);
+
+    ecs_remove(world, e, EcsId);
+    test_assert(ecs_lookup(world, "Foo") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_child_after_orphan() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent, 0);
+
+    ecs_entity_t e = _ecs_new_child(world, Parent, NULL);
+    ecs_set(world, e, EcsId, {"Child"});
+    test_assert(ecs_lookup_child(world, Parent, "Child") == e);
+
+    ecs_orphan(world, e, Parent);
+    test_assert(ecs_lookup_child(world, Parent, "Child") == 0);
+    test_assert(ecs_lookup(world, "Child") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_child_many_parents() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t parents[100], children[100];
+
+    /* Name half of the children before adding them to their parent, and
+     * rename children so that the index has to remove stale entries */
+    int i;
+    for (i = 0; i < 100; i ++) {
+        parents[i] = ecs_new(world, 0);
+
+        if (i % 2) {
+            children[i] = _ecs_new_child(world, parents[i], NULL);
+            ecs_set(world, children[i], EcsId, {"Foo"});
+        } else {
+            children[i] = ecs_set(world, 0, EcsId, {"Foo"});
+            ecs_adopt(world, children[i], parents[i]);
+        }
+
+        ecs_set(world, children[i], EcsId, {"Child"});
+    }
+
+    test_assert(ecs_lookup(world, "Foo") == 0);
+
+    for (i = 0; i < 100; i ++) {
+        test_assert(ecs_lookup_child(world, parents[i], "Child") == children[i]);
+        test_assert(ecs_lookup_child(world, parents[i], "Foo") == 0);
+    }
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_snapshot_restore() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsId, {"Foo"});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    ecs_set(world, e, EcsId, {"Bar"});
+    test_assert(ecs_lookup(world, "Foo") == 0);
+    test_assert(ecs_lookup(world, "Bar") == e);
+
+    ecs_snapshot_restore(world, s);
+    test_assert(ecs_lookup(world, "Foo") == e);
+    test_assert(ecs_lookup(world, "Bar") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_clone() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsId, {"Foo"});
+    ecs_entity_t clone = ecs_clone(world, e, true);
+    test_assert(clone != 0);
+
+    ecs_delete(world, e);
+    test_assert(ecs_lookup(world, "Foo") == clone);
+
+    ecs_fini(world);
+}
+
+static
+void NewChildSystem(ecs_rows_t *rows) {
+    ecs_entity_t parent = ecs_set(rows->world, 0, EcsId, {"Parent"});
+    test_assert(parent != 0);
+
+    ecs_entity_t e = _ecs_new_child(rows->world, parent, NULL);
+    test_assert(e != 0);
+
+    ecs_set(rows->world, e, EcsId, {"Child"});
+}
+
+void Lookup_lookup_after_merge() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_SYSTEM(world, NewChildSystem, EcsOnUpdate, 0);
+
+    ecs_progress(world, 1);
+
+    ecs_entity_t parent = ecs_lookup(world, "Parent");
+    test_assert(parent != 0);
+
+    ecs_entity_t e = ecs_lookup_child(world, parent, "Child");
+    test_assert(e != 0);
+    test_assert(ecs_contains(world, parent, e));
+    test_assert(ecs_lookup(world, "Child") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_path() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent, 0);
+
+    ecs_entity_t child = _ecs_new_child(world, Parent, NULL);
+    ecs_set(world, child, EcsId, {"Child"});
+
+    ecs_entity_t grandchild = _ecs_new_child(world, child, NULL);
+    ecs_set(world, grandchild, EcsId, {"GrandChild"});
+
+    test_assert(ecs_lookup_path(world, 0, "Parent") == Parent);
+    test_assert(ecs_lookup_path(world, 0, "Parent.Child") == child);
+    test_assert(ecs_lookup_path(world, 0, "Parent.Child.GrandChild") == grandchild);
+    test_assert(ecs_lookup_path(world, Parent, "Child.GrandChild") == grandchild);
+    test_assert(ecs_lookup_path(world, child, "GrandChild") == grandchild);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_path_not_found() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent, 0);
+
+    ecs_entity_t child = _ecs_new_child(world, Parent, NULL);
+    ecs_set(world, child, EcsId, {"Child"});
+
+    test_assert(ecs_lookup_path(world, 0, "Parent.Foo") == 0);
+    test_assert(ecs_lookup_path(world, 0, "Foo.Child") == 0);
+    test_assert(ecs_lookup_path(world, 0, "Parent..Child") == 0);
+    test_assert(ecs_lookup_path(world, 0, "Parent.Child.") == 0);
+    test_assert(ecs_lookup_path(world, child, "Parent") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_name_index_bounded() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsStats, 0);
+
+    ECS_COMPONENT(world, Position);
+
+    /* Make sure that stats are collected by requiring EcsMemoryStats */
+    ecs_new_system(world, "CollectMemoryStats", EcsManual, "[in] EcsMemoryStats", NULL);
+    ecs_progress(world, 1);
+
+    static char names[5][100][16];
+    static char renamed[5][100][16];
+    uint32_t used = 0;
+    int i, r;
+
+    for (r = 0; r < 5; r ++) {
+        for (i = 0; i < 100; i ++) {
+            sprintf(names[r][i], "E_%d_%d", r, i);
+            sprintf(renamed[r][i], "R_%d_%d", r, i);
+
+            ecs_entity_t e = ecs_set(world, 0, EcsId, {names[r][i]});
+            ecs_add(world, e, Position);
+
+            if (i % 4 == 0) {
+                ecs_delete(world, e);
+            } else if (i % 4 == 1) {
+                ecs_remove(world, e, EcsId);
+                ecs_delete(world, e);
+            } else if (i % 4 == 2) {
+                ecs_set(world, e, EcsId, {renamed[r][i]});
+                ecs_delete(world, e);
+            }
+        }
+
+        /* Delete remaining entities by table */
+        ecs_delete_w_filter(world, &(ecs_type_filter_t){
+            .include = ecs_type(Position)
+        });
+
+        for (i = 0; i < 100; i ++) {
+            test_assert(ecs_lookup(world, names[r][i]) == 0);
+            test_assert(ecs_lookup(world, renamed[r][i]) == 0);
+        }
+
+        ecs_progress(world, 1);
+
+        EcsMemoryStats stats = ecs_get(world, EcsWorld, EcsMemoryStats);
+        if (!r) {
+            used = stats.world_memory.used_bytes;
+        } else {
+            test_int(stats.world_memory.used_bytes, used);
+        }
+    }
+
+    ecs_fini(world);
+}
@@ -1049,3 +1049,421 @@ void MultiThread_reactive_system() {
 
     ecs_fini(world);
 }
+
+void MultiThread_2_thread_job_size_1() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+
+    int i, ENTITIES = 100, THREADS = 2;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+    }
+
+    ecs_set_threads(world, THREADS);
+    ecs_set_job_size(world, 1);
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 1);
+    }
+
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 2);
+    }
+
+    ecs_fini(world);
+}
+
+void MultiThread_4_thread_job_size_7() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+
+    int i, ENTITIES = 100, THREADS = 4;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    /* Spread entities over two tables, so that jobs cross table boundaries */
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+        if (i % 3) {
+            ecs_add(world, handles[i], Velocity);
+        }
+    }
+
+    ecs_set_threads(world, THREADS);
+    ecs_set_job_size(world, 7);
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 1);
+    }
+
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 2);
+    }
+
+    ecs_fini(world);
+}
+
+void MultiThread_2_thread_job_size_larger_than_rows() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+
+    int i, ENTITIES = 10, THREADS = 2;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+    }
+
+    ecs_set_threads(world, THREADS);
+    ecs_set_job_size(world, 1000);
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 1);
+    }
+
+    ecs_fini(world);
+}
+
+static
+void SlowProgress(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        /* Make the first entities much more expensive than the rest, so that
+         * threads finishing early steal jobs */
+        if (rows->frame_offset + i < 10) {
+            ecs_sleepf(0.001);
+        }
+        p[i].x ++;
+    }
+}
+
+void MultiThread_4_thread_skewed_workload() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, SlowProgress, EcsOnUpdate, Position);
+
+    int i, ENTITIES = 200, THREADS = 4;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+    }
+
+    ecs_set_threads(world, THREADS);
+    ecs_set_job_size(world, 2);
+
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 2);
+    }
+
+    ecs_fini(world);
+}
+
+static
+void TaskThreadIndex(ecs_rows_t *rows) {
+    int32_t *thread_index = rows->param;
+    *thread_index = ecs_get_thread_index(rows->world);
+}
+
+void MultiThread_task_on_main_thread() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+    ECS_SYSTEM(world, TaskThreadIndex, EcsOnUpdate, 0);
+
+    ecs_new_w_count(world, Position, 100);
+
+    int32_t thread_index = -1;
+    ecs_set_system_context(world, TaskThreadIndex, &thread_index);
+
+    ecs_set_threads(world, 4);
+    ecs_set_job_size(world, 1);
+
+    ecs_progress(world, 0);
+
+    test_int(thread_index, 0);
+
+    ecs_fini(world);
+}
+
+void MultiThread_2_thread_spin() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+
+    int i, ENTITIES = 100, THREADS = 2;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+    }
+
+    ecs_set_thread_spin(world, 100000);
+    ecs_set_threads(world, THREADS);
+
+    for (i = 0; i < 10; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 10);
+    }
+
+    ecs_fini(world);
+}
+
+void MultiThread_4_thread_spin_multiple_phases() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ecs_new_system(world, "PreUpdate", EcsPreUpdate, "Position", Progress);
+    ecs_new_system(world, "OnUpdate", EcsOnUpdate, "Position", Progress);
+    ecs_new_system(world, "OnValidate", EcsOnValidate, "Position", Progress);
+    ecs_new_system(world, "PostUpdate", EcsPostUpdate, "Position", Progress);
+
+    int i, ENTITIES = 100, THREADS = 4;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+    }
+
+    ecs_set_thread_spin(world, 100000);
+    ecs_set_threads(world, THREADS);
+
+    for (i = 0; i < 10; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 40);
+    }
+
+    ecs_fini(world);
+}
+
+void MultiThread_change_thread_count_w_spin() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+
+    int i, ENTITIES = 100;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+    }
+
+    ecs_set_thread_spin(world, 1000);
+    ecs_set_threads(world, 2);
+    ecs_progress(world, 0);
+
+    ecs_set_threads(world, 4);
+    ecs_progress(world, 0);
+
+    ecs_set_thread_spin(world, 0);
+    ecs_progress(world, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 3);
+    }
+
+    ecs_fini(world);
+}
+
+static
+void CopyPosition(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN(rows, Velocity, v, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        v[i].x = p[i].x;
+    }
+}
+
+static
+void ProgressVelocity(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Velocity, v, 1);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        v[i].y ++;
+    }
+}
+
+static
+void ReadPosition(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    int *count = rows->param;
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        if (p[i].x == 0) {
+            ecs_os_ainc(count);
+        }
+    }
+}
+
+void MultiThread_4_thread_write_then_read() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+    ECS_SYSTEM(world, CopyPosition, EcsOnUpdate, [in] Position, Velocity);
+
+    int i, ENTITIES = 1000;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+        ecs_set(world, handles[i], Velocity, {0});
+    }
+
+    ecs_set_threads(world, 4);
+    ecs_set_job_size(world, 7);
+
+    for (i = 0; i < 3; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    /* Copy must see all increments of the same frame */
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 3);
+        test_int(ecs_get(world, handles[i], Velocity).x, 3);
+    }
+
+    ecs_fini(world);
+}
+
+void MultiThread_4_thread_read_then_write() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, CopyPosition, EcsOnUpdate, [in] Position, Velocity);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+
+    int i, ENTITIES = 1000;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+        ecs_set(world, handles[i], Velocity, {0});
+    }
+
+    ecs_set_threads(world, 4);
+    ecs_set_job_size(world, 7);
+
+    for (i = 0; i < 3; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    /* Copy runs before the increment, so it must lag one frame behind */
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 3);
+        test_int(ecs_get(world, handles[i], Velocity).x, 2);
+    }
+
+    ecs_fini(world);
+}
+
+void MultiThread_4_thread_disjoint_writes() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, Progress, EcsOnUpdate, Position);
+    ECS_SYSTEM(world, ProgressVelocity, EcsOnUpdate, Velocity);
+
+    int i, ENTITIES = 1000;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+        ecs_set(world, handles[i], Velocity, {0});
+    }
+
+    ecs_set_threads(world, 4);
+    ecs_set_job_size(world, 7);
+
+    for (i = 0; i < 3; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 3);
+        test_int(ecs_get(world, handles[i], Velocity).y, 3);
+    }
+
+    ecs_fini(world);
+}
+
+void MultiThread_4_thread_shared_reads() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ecs_entity_t read_1 = ecs_new_system(
+        world, "ReadPosition1", EcsOnUpdate, "[in] Position", ReadPosition);
+    ecs_entity_t read_2 = ecs_new_system(
+        world, "ReadPosition2", EcsOnUpdate, "[in] Position", ReadPosition);
+
+    int i, ENTITIES = 1000;
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_set(world, 0, Position, {0});
+    }
+
+    int32_t count = 0;
+    ecs_set_system_context(world, read_1, &count);
+    ecs_set_system_context(world, read_2, &count);
+
+    ecs_set_threads(world, 4);
+    ecs_set_job_size(world, 7);
+    ecs_progress(world, 0);
+
+    test_int(count, ENTITIES * 2);
+
+    ecs_fini(world);
+}
+
+void MultiThread_4_thread_write_read_write() {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ecs_new_system(world, "Progress1", EcsOnUpdate, "Position", Progress);
+    ECS_SYSTEM(world, CopyPosition, EcsOnUpdate, [in] Position, Velocity);
+    ecs_new_system(world, "Progress2", EcsOnUpdate, "Position", Progress);
+
+    int i, ENTITIES = 1000;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {0});
+        ecs_set(world, handles[i], Velocity, {0});
+    }
+
+    ecs_set_threads(world, 4);
+    ecs_set_job_size(world, 7);
+    ecs_progress(world, 0);
+
+    /* Copy runs between the two increments */
+    for (i = 0; i < ENTITIES; i ++) {
+        test_int(ecs_get(world, handles[i], Position).x, 2);
+        test_int(ecs_get(world, handles[i], Velocity).x, 1);
+    }
+
+    ecs_fini(world);
+}
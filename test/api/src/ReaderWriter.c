@@ -1347,3 +1347,818 @@ void ReaderWriter_invalid_header() {
 
     ecs_fini(world);
 }
+
+static
+void large_id_test(int buffer_size) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    /* Ids that don't fit in 32 bits must be serialized without truncation */
+    ecs_entity_t e1 = (ecs_entity_t)1 << 40;
+    ecs_entity_t e2 = e1 + 1;
+    ecs_set(world, e1, Position, {1, 2});
+    ecs_set(world, e2, Position, {3, 4});
+
+    ecs_vector_t *v = serialize_to_vector(world, buffer_size);
+
+    ecs_fini(world);
+
+    world = deserialize_from_vector(v, buffer_size);
+
+    test_int( ecs_count(world, Position), 2);
+    test_assert( ecs_has(world, e1, Position));
+    test_assert( ecs_has(world, e2, Position));
+    test_assert( !ecs_has(world, (ecs_entity_t)(uint32_t)e1, Position));
+
+    Position *
+    p = ecs_get_ptr(world, e1, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    p = ecs_get_ptr(world, e2, Position);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+
+    ecs_fini(world);
+    ecs_vector_free(v);
+}
+
+void ReaderWriter_large_id() {
+    large_id_test(4);
+    large_id_test(12);
+    large_id_test(1024);
+}
+
+static
+void large_table_test(int buffer_size) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    int i, ENTITIES = 10000;
+    ecs_entity_t first = 0;
+
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i * 2});
+        ecs_set(world, e, Velocity, {i * 3, i * 4});
+        if (!i) {
+            first = e;
+        }
+    }
+
+    ecs_vector_t *v = serialize_to_vector(world, buffer_size);
+
+    ecs_fini(world);
+
+    world = deserialize_from_vector(v, buffer_size);
+
+    test_int( ecs_count(world, Position), ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        Position *p = ecs_get_ptr(world, first + i, Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+
+        Velocity *vel = ecs_get_ptr(world, first + i, Velocity);
+        test_assert(vel != NULL);
+        test_int(vel->x, i * 3);
+        test_int(vel->y, i * 4);
+    }
+
+    ecs_fini(world);
+    ecs_vector_free(v);
+}
+
+void ReaderWriter_large_table() {
+    large_table_test(4);
+    large_table_test(36);
+    large_table_test(1024 * 1024);
+}
+
+void ReaderWriter_invalid_version() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ecs_set(world, 0, Position, {1, 2});
+
+    ecs_vector_t *v = serialize_to_vector(world, 64);
+
+    ecs_fini(world);
+
+    /* Data starts with format version */
+    int32_t *version = ecs_vector_first(v);
+    test_int(*version, ECS_BLOB_VERSION);
+    (*version) ++;
+
+    world = ecs_init();
+    ecs_world_t *result = deserialize_from_vector_to_existing_expect(
+        v, 64, world, ECS_DESERIALIZE_FORMAT_ERROR);
+    test_assert(result == NULL);
+
+    ecs_fini(world);
+    ecs_vector_free(v);
+}
+
+void ReaderWriter_invalid_component_size() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ecs_set(world, 0, Position, {1, 2});
+
+    ecs_vector_t *v = serialize_to_vector(world, 64);
+
+    ecs_fini(world);
+
+    /* Find the serialized component, which is followed by its name. The
+     * header is not necessarily aligned in the buffer, so it is copied. */
+    char *data = ecs_vector_first(v);
+    uint32_t i, count = ecs_vector_count(v);
+    char *component = NULL;
+    ecs_blob_component_t hdr;
+
+    for (i = sizeof(ecs_blob_component_t); i < count; i ++) {
+        if (!strcmp(&data[i], "Position")) {
+            char *c = &data[i - sizeof(ecs_blob_component_t)];
+            memcpy(&hdr, c, sizeof(ecs_blob_component_t));
+            if (hdr.size == sizeof(Position) && hdr.name_len == 9) {
+                component = c;
+                break;
+            }
+        }
+    }
+
+    test_assert(component != NULL);
+    hdr.size = -1;
+    memcpy(component, &hdr, sizeof(ecs_blob_component_t));
+
+    world = ecs_init();
+    ecs_world_t *result = deserialize_from_vector_to_existing_expect(
+        v, 64, world, ECS_DESERIALIZE_FORMAT_ERROR);
+    test_assert(result == NULL);
+
+    /* Component must not be created with an invalid size */
+    test_assert(ecs_lookup(world, "Position") == 0);
+
+    ecs_fini(world);
+    ecs_vector_free(v);
+}
+
+#define TEST_FILE "test_reader_writer.flecs"
+
+void ReaderWriter_save_load_file() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {3, 4});
+    ecs_set(world, e2, Velocity, {5, 6});
+    ecs_set(world, e2, EcsId, {"e2"});
+
+    test_int(ecs_save_file(world, TEST_FILE), 0);
+
+    ecs_fini(world);
+
+    world = ecs_init();
+    test_int(ecs_load_file(world, TEST_FILE), 0);
+
+    test_int( ecs_count(world, Position), 2);
+
+    Position *p = ecs_get_ptr(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    p = ecs_get_ptr(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+
+    Velocity *v = ecs_get_ptr(world, e2, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 5);
+    test_int(v->y, 6);
+
+    test_assert(ecs_lookup(world, "e2") == e2);
+
+    ecs_fini(world);
+
+    remove(TEST_FILE);
+}
+
+void ReaderWriter_load_file_modify() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {3, 4});
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {5, 6});
+
+    test_int(ecs_save_file(world, TEST_FILE), 0);
+
+    ecs_fini(world);
+
+    world = ecs_init();
+    test_int(ecs_load_file(world, TEST_FILE), 0);
+
+    /* Modify component in place */
+    ecs_set(world, e1, Position, {10, 20});
+
+    /* Delete entity from mapped table */
+    ecs_delete(world, e2);
+
+    /* Grow mapped table */
+    ecs_entity_t e4 = ecs_set(world, 0, Position, {7, 8});
+
+    /* Move entity out of mapped table */
+    ecs_set(world, e3, Velocity, {1, 1});
+
+    test_int( ecs_count(world, Position), 3);
+
+    Position *p = ecs_get_ptr(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    test_assert(ecs_get_type(world, e2) == NULL);
+
+    p = ecs_get_ptr(world, e3, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 5);
+    test_int(p->y, 6);
+
+    p = ecs_get_ptr(world, e4, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 7);
+    test_int(p->y, 8);
+
+    ecs_fini(world);
+
+    /* Changes are not written back to the file */
+    world = ecs_init();
+    test_int(ecs_load_file(world, TEST_FILE), 0);
+
+    test_int( ecs_count(world, Position), 3);
+
+    p = ecs_get_ptr(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    p = ecs_get_ptr(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+
+    test_assert(!ecs_has(world, e3, Velocity));
+
+    ecs_fini(world);
+
+    remove(TEST_FILE);
+}
+
+void ReaderWriter_load_file_large_table() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    int i, ENTITIES = 10000;
+    ecs_entity_t first = 0;
+
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i * 2});
+        ecs_set(world, e, Velocity, {i * 3, i * 4});
+        if (!i) {
+            first = e;
+        }
+    }
+
+    test_int(ecs_save_file(world, TEST_FILE), 0);
+
+    ecs_fini(world);
+
+    world = ecs_init();
+    test_int(ecs_load_file(world, TEST_FILE), 0);
+
+    test_int( ecs_count(world, Position), ENTITIES);
+
+    /* Columns that span multiple pages start at a page */
+    Position *p = ecs_get_ptr(world, first, Position);
+    test_assert(p != NULL);
+    test_int((uintptr_t)p % ECS_BLOB_PAGE_SIZE, 0);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        Position *p = ecs_get_ptr(world, first + i, Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+
+        Velocity *vel = ecs_get_ptr(world, first + i, Velocity);
+        test_assert(vel != NULL);
+        test_int(vel->x, i * 3);
+        test_int(vel->y, i * 4);
+    }
+
+    ecs_fini(world);
+
+    remove(TEST_FILE);
+}
+
+static
+void save_position_file(
+    ecs_entity_t *e1,
+    ecs_entity_t *e2)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    /* Don't use ids that are used by systems in the world that loads the file */
+    ecs_new_w_count(world, 0, 10);
+
+    *e1 = ecs_set(world, 0, Position, {1, 2});
+    *e2 = ecs_set(world, 0, Position, {3, 4});
+
+    test_int(ecs_save_file(world, TEST_FILE), 0);
+
+    ecs_fini(world);
+}
+
+void ReaderWriter_load_file_w_system() {
+    ecs_entity_t e1, e2;
+    save_position_file(&e1, &e2);
+
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, Dummy, EcsOnUpdate, Position);
+
+    /* Table is activated for system that was created before loading */
+    test_int(ecs_load_file(world, TEST_FILE), 0);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 0);
+
+    test_int(ctx.count, 2);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.system, Dummy);
+    test_int(ctx.column_count, 1);
+    test_int(ctx.e[0], e1);
+    test_int(ctx.e[1], e2);
+    test_int(ctx.c[0][0], ecs_entity(Position));
+
+    ecs_fini(world);
+
+    remove(TEST_FILE);
+}
+
+void ReaderWriter_load_file_w_writer() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    int i, ENTITIES = 10000;
+    ecs_entity_t first = 0;
+
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i * 2});
+        ecs_set(world, e, Velocity, {i * 3, i * 4});
+        if (!i) {
+            first = e;
+            ecs_set(world, e, EcsId, {"first"});
+        }
+    }
+
+    test_int(ecs_save_file(world, TEST_FILE), 0);
+
+    ecs_fini(world);
+
+    /* A saved file can also be deserialized with a regular writer */
+    FILE *file = fopen(TEST_FILE, "rb");
+    test_assert(file != NULL);
+
+    world = ecs_init();
+    ecs_writer_t writer = ecs_writer_init(world);
+    char buffer[36];
+    size_t read;
+
+    while ((read = fread(buffer, 1, sizeof(buffer), file))) {
+        test_int(ecs_writer_write(buffer, read, &writer), 0);
+    }
+
+    fclose(file);
+
+    test_int( ecs_count(world, Position), ENTITIES);
+    test_assert(ecs_lookup(world, "first") == first);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        Position *p = ecs_get_ptr(world, first + i, Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+
+        Velocity *vel = ecs_get_ptr(world, first + i, Velocity);
+        test_assert(vel != NULL);
+        test_int(vel->x, i * 3);
+        test_int(vel->y, i * 4);
+    }
+
+    ecs_fini(world);
+
+    remove(TEST_FILE);
+}
+
+void ReaderWriter_load_file_not_found() {
+    ecs_world_t *world = ecs_init();
+
+    test_assert(ecs_load_file(world, "not_a_file.flecs") != 0);
+
+    ecs_fini(world);
+}
+
+static
+ecs_vector_t* serialize_delta_to_vector(
+    ecs_world_t *world, 
+    int buffer_size,
+    ecs_snapshot_t *base) 
+{
+    ecs_reader_t reader = ecs_delta_reader_init(world, base);
+    return serialize_reader_to_vector(world, buffer_size, &reader);
+}
+
+static
+ecs_world_t* deserialize_snapshot(
+    ecs_world_t *world,
+    ecs_snapshot_t *snapshot)
+{
+    ecs_vector_t *v = serialize_snapshot_to_vector(world, 36, snapshot);
+    ecs_world_t *result = deserialize_from_vector(v, 36);
+    ecs_vector_free(v);
+    return result;
+}
+
+static
+void apply_delta(
+    ecs_world_t *world,
+    ecs_snapshot_t *base,
+    ecs_world_t *dst)
+{
+    ecs_vector_t *v = serialize_delta_to_vector(world, 36, base);
+    deserialize_from_vector_to_existing(v, 36, dst);
+    ecs_vector_free(v);
+}
+
+void ReaderWriter_delta_set() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {3, 4});
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {5, 6});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+    ecs_world_t *world2 = deserialize_snapshot(world, s);
+
+    ecs_set(world, e2, Position, {30, 40});
+
+    apply_delta(world, s, world2);
+
+    test_int( ecs_count(world2, Position), 3);
+
+    Position *
+    p = ecs_get_ptr(world2, e1, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    p = ecs_get_ptr(world2, e2, Position);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    p = ecs_get_ptr(world2, e3, Position);
+    test_int(p->x, 5);
+    test_int(p->y, 6);
+
+    ecs_snapshot_free(world, s);
+    ecs_fini(world);
+    ecs_fini(world2);
+}
+
+void ReaderWriter_delta_new() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {3, 4});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+    ecs_world_t *world2 = deserialize_snapshot(world, s);
+
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {5, 6});
+
+    apply_delta(world, s, world2);
+
+    test_int( ecs_count(world2, Position), 3);
+
+    Position *
+    p = ecs_get_ptr(world2, e1, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    p = ecs_get_ptr(world2, e2, Position);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+
+    p = ecs_get_ptr(world2, e3, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 5);
+    test_int(p->y, 6);
+
+    /* New entities in the destination must not reuse the id */
+    test_assert(ecs_new(world2, 0) > e3);
+
+    ecs_snapshot_free(world, s);
+    ecs_fini(world);
+    ecs_fini(world2);
+}
+
+void ReaderWriter_delta_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {3, 4});
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {5, 6});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+    ecs_world_t *world2 = deserialize_snapshot(world, s);
+
+    ecs_delete(world, e2);
+
+    apply_delta(world, s, world2);
+
+    test_int( ecs_count(world2, Position), 2);
+    test_assert( ecs_is_empty(world2, e2));
+
+    Position *
+    p = ecs_get_ptr(world2, e1, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    p = ecs_get_ptr(world2, e3, Position);
+    test_int(p->x, 5);
+    test_int(p->y, 6);
+
+    ecs_snapshot_free(world, s);
+    ecs_fini(world);
+    ecs_fini(world2);
+}
+
+void ReaderWriter_delta_remove_all() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {3, 4});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+    ecs_world_t *world2 = deserialize_snapshot(world, s);
+
+    ecs_remove(world, e1, Position);
+    ecs_remove(world, e2, Position);
+
+    apply_delta(world, s, world2);
+
+    test_int( ecs_count(world2, Position), 0);
+    test_assert( ecs_is_empty(world2, e1));
+    test_assert( ecs_is_empty(world2, e2));
+
+    /* Entity was not deleted, so it can get components again */
+    ecs_set(world2, e1, Position, {5, 6});
+    test_int( ecs_count(world2, Position), 1);
+
+    ecs_snapshot_free(world, s);
+    ecs_fini(world);
+    ecs_fini(world2);
+}
+
+void ReaderWriter_delta_move() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {3, 4});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+    ecs_world_t *world2 = deserialize_snapshot(world, s);
+
+    ECS_SYSTEM(world2, Dummy, EcsOnUpdate, Position, Velocity);
+
+    ecs_set(world, e1, Velocity, {10, 20});
+
+    apply_delta(world, s, world2);
+
+    test_int( ecs_count(world2, Position), 2);
+    test_int( ecs_count(world2, Velocity), 1);
+    test_assert( ecs_has(world2, e1, Velocity));
+    test_assert( !ecs_has(world2, e2, Velocity));
+
+    Position *
+    p = ecs_get_ptr(world2, e1, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    Velocity *v = ecs_get_ptr(world2, e1, Velocity);
+    test_int(v->x, 10);
+    test_int(v->y, 20);
+
+    p = ecs_get_ptr(world2, e2, Position);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+
+    /* Table that got entities from the delta is active */
+    SysTestData ctx = {0};
+    ecs_set_context(world2, &ctx);
+    ecs_progress(world2, 0);
+    test_int(ctx.count, 1);
+    test_int(ctx.e[0], e1);
+
+    ecs_snapshot_free(world, s);
+    ecs_fini(world);
+    ecs_fini(world2);
+}
+
+void ReaderWriter_delta_unchanged() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_set(world, 0, Position, {3, 4});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    /* Delta only contains the stream header and components */
+    ecs_vector_t *delta = serialize_delta_to_vector(world, 36, s);
+    ecs_vector_t *v = serialize_snapshot_to_vector(world, 36, s);
+    test_assert(ecs_vector_count(delta) < ecs_vector_count(v));
+
+    ecs_world_t *world2 = deserialize_from_vector(v, 36);
+    deserialize_from_vector_to_existing(delta, 36, world2);
+
+    test_int( ecs_count(world2, Position), 2);
+
+    Position *p = ecs_get_ptr(world2, e1, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    ecs_vector_free(delta);
+    ecs_vector_free(v);
+    ecs_snapshot_free(world, s);
+    ecs_fini(world);
+    ecs_fini(world2);
+}
+
+void ReaderWriter_delta_chunks() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_new_w_count(world, Position, 1000);
+    test_assert(e != 0);
+
+    int i;
+    for (i = 0; i < 1000; i ++) {
+        ecs_set(world, e + i, Position, {i, i * 2});
+    }
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+    ecs_world_t *world2 = deserialize_snapshot(world, s);
+    ecs_vector_t *v = serialize_snapshot_to_vector(world, 36, s);
+
+    ecs_set(world, e + 10, Position, {-1, -2});
+    ecs_set(world, e + 999, Position, {-3, -4});
+
+    /* Only the chunks with the changed rows are serialized */
+    ecs_vector_t *delta = serialize_delta_to_vector(world, 36, s);
+    test_assert(ecs_vector_count(delta) < 
+        ECS_BLOB_CHUNK_SIZE * 2 + ECS_BLOB_PAGE_SIZE / 2);
+    test_assert(ecs_vector_count(delta) < ecs_vector_count(v) / 4);
+
+    deserialize_from_vector_to_existing(delta, 36, world2);
+
+    test_int( ecs_count(world2, Position), 1000);
+
+    for (i = 0; i < 1000; i ++) {
+        Position *p = ecs_get_ptr(world2, e + i, Position);
+        test_assert(p != NULL);
+
+        if (i == 10) {
+            test_int(p->x, -1);
+            test_int(p->y, -2);
+        } else if (i == 999) {
+            test_int(p->x, -3);
+            test_int(p->y, -4);
+        } else {
+            test_int(p->x, i);
+            test_int(p->y, i * 2);
+        }
+    }
+
+    ecs_vector_free(delta);
+    ecs_vector_free(v);
+    ecs_snapshot_free(world, s);
+    ecs_fini(world);
+    ecs_fini(world2);
+}
+
+void ReaderWriter_delta_shared_snapshot() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Velocity, {3, 4});
+
+    ecs_snapshot_t *s = ecs_snapshot_take_shared(world, NULL);
+    ecs_world_t *world2 = deserialize_snapshot(world, s);
+
+    ecs_set(world, e1, Position, {10, 20});
+
+    apply_delta(world, s, world2);
+
+    Position *p = ecs_get_ptr(world2, e1, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    Velocity *v = ecs_get_ptr(world2, e2, Velocity);
+    test_int(v->x, 3);
+    test_int(v->y, 4);
+
+    ecs_snapshot_free(world, s);
+    ecs_fini(world);
+    ecs_fini(world2);
+}
+
+void ReaderWriter_delta_twice() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {3, 4});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+    ecs_world_t *world2 = deserialize_snapshot(world, s);
+
+    /* Delta is applied to a world that still shares data with a snapshot */
+    ecs_snapshot_t *s2 = ecs_snapshot_take_shared(world2, NULL);
+
+    ecs_set(world, e1, Position, {10, 20});
+    apply_delta(world, s, world2);
+    ecs_snapshot_free(world, s);
+
+    s = ecs_snapshot_take(world, NULL);
+    ecs_set(world, e2, Position, {30, 40});
+    apply_delta(world, s, world2);
+
+    Position *
+    p = ecs_get_ptr(world2, e1, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    p = ecs_get_ptr(world2, e2, Position);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    /* Snapshot of destination world did not change */
+    ecs_snapshot_restore(world2, s2);
+
+    p = ecs_get_ptr(world2, e1, Position);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    p = ecs_get_ptr(world2, e2, Position);
+    test_int(p->x, 3);
+    test_int(p->y, 4);
+
+    ecs_snapshot_free(world, s);
+    ecs_fini(world);
+    ecs_fini(world2);
+}
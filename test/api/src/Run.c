@@ -1238,3 +1238,38 @@ void Run_run_w_interrupt() {
  
     ecs_fini(world);
 }
+
+static void *system_ctx_param;
+static void *system_ctx_ctx;
+
+static
+void GetSystemCtx(ecs_rows_t *rows) {
+    system_ctx_param = rows->param;
+    system_ctx_ctx = rows->system_ctx;
+}
+
+void Run_run_w_param_w_system_ctx() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_ENTITY(world, e_1, Position);
+
+    ECS_SYSTEM(world, GetSystemCtx, EcsManual, Position);
+
+    int system_ctx = 0;
+    ecs_set_system_context(world, GetSystemCtx, &system_ctx);
+
+    /* Without param, param is set to the system context */
+    ecs_run(world, GetSystemCtx, 1.0, NULL);
+    test_ptr(system_ctx_param, &system_ctx);
+    test_ptr(system_ctx_ctx, &system_ctx);
+
+    /* The system context is passed separately from the param, so that the
+     * system can find its context when the application passes a param */
+    ecs_run(world, GetSystemCtx, 1.0, (void*)1);
+    test_ptr(system_ctx_param, (void*)1);
+    test_ptr(system_ctx_ctx, &system_ctx);
+
+    ecs_fini(world);
+}
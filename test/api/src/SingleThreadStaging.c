@@ -2529,9 +2529,9 @@ void SingleThreadStaging_match_table_created_in_progress() {
     test_int(ctx.column_count, 2);
     test_null(ctx.param);
 
-    test_int(ctx.e[0], e_3);
-    test_int(ctx.e[1], e_1);
-    test_int(ctx.e[2], e_2);
+    test_int(ctx.e[0], e_1);
+    test_int(ctx.e[1], e_2);
+    test_int(ctx.e[2], e_3);
     test_int(ctx.c[0][0], ecs_entity(Position));
     test_int(ctx.s[0][0], 0);
     test_int(ctx.c[0][1], ecs_entity(Velocity));
@@ -2967,3 +2967,223 @@ void SingleThreadStaging_get_parent_in_progress() {
 
     ecs_fini(world);
 }
+
+static
+void SetVelocityFromPosition(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_set(rows->world, rows->entities[i], Velocity, {p[i].x, p[i].y});
+    }
+}
+
+void SingleThreadStaging_merge_many_add() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, SetVelocityFromPosition, EcsOnUpdate, Position, !Velocity);
+
+    int i, ENTITIES = 1000;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {i, i * 2});
+    }
+
+    ecs_progress(world, 1);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        test_assert( ecs_has(world, handles[i], Velocity));
+        Position *p = ecs_get_ptr(world, handles[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+
+        Velocity *v = ecs_get_ptr(world, handles[i], Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, i);
+        test_int(v->y, i * 2);
+    }
+
+    ecs_fini(world);
+}
+
+static
+void SetPositionInProgress(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN_COMPONENT(rows, Position, 1);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_set(rows->world, rows->entities[i], Position, {p[i].y, p[i].x});
+    }
+}
+
+void SingleThreadStaging_merge_many_set_existing() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, SetPositionInProgress, EcsOnUpdate, Position);
+
+    int i, ENTITIES = 1000;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {i, i * 2});
+        ecs_set(world, handles[i], Velocity, {i * 3, i * 4});
+    }
+
+    ecs_progress(world, 1);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        Position *p = ecs_get_ptr(world, handles[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, i * 2);
+        test_int(p->y, i);
+
+        Velocity *v = ecs_get_ptr(world, handles[i], Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, i * 3);
+        test_int(v->y, i * 4);
+    }
+
+    ecs_fini(world);
+}
+
+static
+void RemoveVelocityFromOdd(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        if ((int)p[i].x % 2) {
+            ecs_remove(rows->world, rows->entities[i], Velocity);
+        }
+    }
+}
+
+static
+void CountRemove(ecs_rows_t *rows) {
+    int *count = ecs_get_context(rows->world);
+    *count += rows->count;
+}
+
+void SingleThreadStaging_merge_many_remove_w_on_remove() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, RemoveVelocityFromOdd, EcsOnUpdate, Position, Velocity);
+    ECS_SYSTEM(world, CountRemove, EcsOnRemove, Velocity);
+
+    int i, ENTITIES = 1000;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {i, i * 2});
+        ecs_set(world, handles[i], Velocity, {i * 3, i * 4});
+    }
+
+    int count = 0;
+    ecs_set_context(world, &count);
+
+    ecs_progress(world, 1);
+
+    test_int(count, ENTITIES / 2);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        Position *p = ecs_get_ptr(world, handles[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+
+        if (i % 2) {
+            test_assert( !ecs_has(world, handles[i], Velocity));
+        } else {
+            Velocity *v = ecs_get_ptr(world, handles[i], Velocity);
+            test_assert(v != NULL);
+            test_int(v->x, i * 3);
+            test_int(v->y, i * 4);
+        }
+    }
+
+    ecs_fini(world);
+}
+
+static
+void AddRemoveByIndex(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN_COMPONENT(rows, Position, 1);
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+    ECS_COLUMN_COMPONENT(rows, Mass, 3);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_entity_t e = rows->entities[i];
+        int kind = (int)p[i].x % 3;
+
+        if (kind == 0) {
+            ecs_set(rows->world, e, Velocity, {p[i].x, p[i].y});
+        } else if (kind == 1) {
+            ecs_set(rows->world, e, Mass, {p[i].x});
+        } else {
+            ecs_remove(rows->world, e, Position);
+        }
+    }
+}
+
+void SingleThreadStaging_merge_many_different_groups() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_SYSTEM(world, AddRemoveByIndex, EcsOnUpdate, Position, .Velocity, .Mass);
+
+    int i, ENTITIES = 999;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {i, i * 2});
+    }
+
+    ecs_progress(world, 1);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_entity_t e = handles[i];
+
+        if (i % 3 == 2) {
+            test_assert( !ecs_has(world, e, Position));
+            continue;
+        }
+
+        Position *p = ecs_get_ptr(world, e, Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+
+        if (i % 3 == 0) {
+            test_assert( !ecs_has(world, e, Mass));
+            Velocity *v = ecs_get_ptr(world, e, Velocity);
+            test_assert(v != NULL);
+            test_int(v->x, i);
+            test_int(v->y, i * 2);
+        } else {
+            test_assert( !ecs_has(world, e, Velocity));
+            Mass *m = ecs_get_ptr(world, e, Mass);
+            test_assert(m != NULL);
+            test_int(*m, i);
+        }
+    }
+
+    ecs_fini(world);
+}
@@ -574,3 +574,374 @@ void Snapshot_snapshot_copy_w_filter() {
 
     ecs_fini(world);
 }
+
+static
+void Snapshot_Move(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        p[i].x ++;
+        p[i].y ++;
+    }
+}
+
+static
+Position* snapshot_get_position(
+    ecs_world_t *world,
+    ecs_snapshot_t *s,
+    ecs_entity_t e,
+    ecs_type_t type)
+{
+    ecs_filter_t filter = {.include = type};
+    ecs_filter_iter_t it = ecs_snapshot_filter_iter(world, s, &filter);
+
+    while (ecs_filter_next(&it)) {
+        if (ecs_table_type(&it.rows) != type) {
+            continue;
+        }
+
+        Position *p = ecs_table_column(&it.rows, 0);
+
+        int i;
+        for (i = 0; i < it.rows.count; i ++) {
+            if (it.rows.entities[i] == e) {
+                return &p[i];
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void Snapshot_shared_snapshot() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    test_assert(e != 0);
+
+    ecs_snapshot_t *s = ecs_snapshot_take_shared(world, NULL);
+
+    ecs_set(world, e, Position, {30, 40});
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    /* Snapshot still has the value from before the set */
+    p = snapshot_get_position(world, s, e, ecs_type(Position));
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_snapshot_restore(world, s);
+
+    test_assert(ecs_has(world, e, Position));
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_shared_snapshot_after_new() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    test_assert(e != 0);
+
+    ecs_snapshot_t *s = ecs_snapshot_take_shared(world, NULL);
+
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    test_assert(e2 != 0);
+
+    ecs_snapshot_restore(world, s);
+
+    test_assert(ecs_has(world, e, Position));
+    test_assert(!ecs_has(world, e2, Position));
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+    test_assert(ecs_new(world, 0) == e2);
+
+    ecs_fini(world);
+}
+
+void Snapshot_shared_snapshot_after_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+
+    ecs_snapshot_t *s = ecs_snapshot_take_shared(world, NULL);
+
+    ecs_delete(world, e);
+    test_assert(!ecs_has(world, e, Position));
+
+    Position *p = ecs_get_ptr(world, e2, Position);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_snapshot_restore(world, s);
+
+    test_assert(ecs_has(world, e, Position));
+    test_assert(ecs_has(world, e2, Position));
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+    p = ecs_get_ptr(world, e2, Position);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+void Snapshot_shared_snapshot_after_add() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s = ecs_snapshot_take_shared(world, NULL);
+
+    ecs_add(world, e, Velocity);
+    test_assert(ecs_has(world, e, Velocity));
+
+    ecs_snapshot_restore(world, s);
+
+    test_assert(ecs_has(world, e, Position));
+    test_assert(!ecs_has(world, e, Velocity));
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_shared_snapshot_w_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, Snapshot_Move, EcsOnUpdate, Position);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s = ecs_snapshot_take_shared(world, NULL);
+
+    ecs_progress(world, 1);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 11);
+    test_int(p->y, 21);
+
+    p = snapshot_get_position(world, s, e, ecs_type(Position));
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_snapshot_restore(world, s);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_progress(world, 1);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 11);
+    test_int(p->y, 21);
+
+    ecs_fini(world);
+}
+
+void Snapshot_shared_snapshot_w_threads() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, Snapshot_Move, EcsOnUpdate, Position);
+
+    ecs_set_threads(world, 2);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_new_w_count(world, Position, 99);
+
+    ecs_snapshot_t *s = ecs_snapshot_take_shared(world, NULL);
+
+    ecs_progress(world, 1);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 11);
+    test_int(p->y, 21);
+
+    p = snapshot_get_position(world, s, e, ecs_type(Position));
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_snapshot_restore(world, s);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_shared_snapshot_free() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s = ecs_snapshot_take_shared(world, NULL);
+    ecs_snapshot_free(world, s);
+
+    ecs_set(world, e, Position, {30, 40});
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+void Snapshot_shared_snapshot_copy() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s = ecs_snapshot_take_shared(world, NULL);
+    ecs_snapshot_t *s_copy = ecs_snapshot_copy(world, s, NULL);
+    ecs_snapshot_free(world, s);
+
+    ecs_set(world, e, Position, {30, 40});
+
+    ecs_snapshot_restore(world, s_copy);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_shared_snapshot_w_arena() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_set_table_arena(world, true);
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s = ecs_snapshot_take_shared(world, NULL);
+
+    ecs_set(world, e, Position, {30, 40});
+    ecs_set(world, 0, Position, {50, 60});
+
+    ecs_snapshot_restore(world, s);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+    test_int(ecs_count(world, Position), 1);
+
+    ecs_fini(world);
+}
+
+void Snapshot_ring_rollback() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, Snapshot_Move, EcsOnUpdate, Position);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_ring_t *ring = ecs_snapshot_ring_new(4);
+    test_int(ecs_snapshot_ring_count(ring), 0);
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        ecs_snapshot_ring_push(world, ring);
+        ecs_progress(world, 1);
+    }
+
+    test_int(ecs_snapshot_ring_count(ring), 3);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 13);
+    test_int(p->y, 23);
+
+    /* Roll back to the state before the second frame */
+    test_assert(ecs_snapshot_ring_rollback(world, ring, 1));
+    test_int(ecs_snapshot_ring_count(ring), 2);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 11);
+    test_int(p->y, 21);
+
+    /* Resimulate, and roll back to the same snapshot again */
+    ecs_progress(world, 1);
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 12);
+    test_int(p->y, 22);
+
+    test_assert(ecs_snapshot_ring_rollback(world, ring, 0));
+    test_int(ecs_snapshot_ring_count(ring), 2);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 11);
+    test_int(p->y, 21);
+
+    ecs_snapshot_ring_free(world, ring);
+
+    ecs_fini(world);
+}
+
+void Snapshot_ring_overflow() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_SYSTEM(world, Snapshot_Move, EcsOnUpdate, Position);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_ring_t *ring = ecs_snapshot_ring_new(2);
+
+    int i;
+    for (i = 0; i < 5; i ++) {
+        ecs_snapshot_ring_push(world, ring);
+        ecs_progress(world, 1);
+    }
+
+    test_int(ecs_snapshot_ring_count(ring), 2);
+
+    /* Oldest snapshots are no longer in the ring */
+    test_assert(!ecs_snapshot_ring_rollback(world, ring, 2));
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 15);
+    test_int(p->y, 25);
+
+    test_assert(ecs_snapshot_ring_rollback(world, ring, 1));
+    test_int(ecs_snapshot_ring_count(ring), 1);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_int(p->x, 13);
+    test_int(p->y, 23);
+
+    ecs_snapshot_ring_free(world, ring);
+
+    ecs_fini(world);
+}
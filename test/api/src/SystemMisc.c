@@ -708,3 +708,340 @@ void SystemMisc_status_deactivate_after_delete() {
     test_assert(enable_status == EcsSystemDisabled);
     test_assert(active_status == EcsSystemStatusNone);
 }
+
+static
+void Iter(ecs_rows_t *rows) {
+    ProbeSystem(rows);
+}
+
+void SystemMisc_match_rare_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+    ECS_TAG(world, Tag_1);
+    ECS_TAG(world, Tag_2);
+    ECS_TAG(world, Tag_3);
+    ECS_TYPE(world, Type_1, Position, Tag_1);
+    ECS_TYPE(world, Type_2, Position, Tag_2);
+    ECS_TYPE(world, Type_3, Position, Tag_3);
+    ECS_TYPE(world, Type_4, Position, Velocity);
+    ECS_TYPE(world, Type_5, Position, Velocity, Mass);
+
+    ecs_new(world, Position);
+    ecs_new(world, Type_1);
+    ecs_new(world, Type_2);
+    ecs_new(world, Type_3);
+    ecs_new(world, Velocity);
+    ecs_entity_t e_1 = ecs_new(world, Type_4);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position, Velocity);
+
+    /* Table is created after the system */
+    ecs_entity_t e_2 = ecs_new(world, Type_5);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+
+    test_int(ctx.count, 2);
+    test_int(ctx.invoked, 2);
+    test_int(ctx.system, Iter);
+    test_int(ctx.column_count, 2);
+    test_int(ctx.e[0], e_1);
+    test_int(ctx.e[1], e_2);
+
+    ecs_fini(world);
+}
+
+void SystemMisc_match_inherited_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_PREFAB(world, Prefab, Velocity);
+    ECS_TYPE(world, Type_1, Position, INSTANCEOF | Prefab);
+    ECS_TYPE(world, Type_2, Position, Velocity, INSTANCEOF | Prefab);
+
+    ecs_entity_t e_1 = ecs_new(world, Type_1);
+    ecs_entity_t e_2 = ecs_new(world, Type_2);
+    ecs_new(world, Position);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position, Velocity);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+
+    /* Table of e_2 owns and inherits Velocity, and should be matched once */
+    test_int(ctx.count, 2);
+    test_int(ctx.invoked, 2);
+    test_int(ctx.e[0], e_1);
+    test_int(ctx.e[1], e_2);
+
+    ecs_fini(world);
+}
+
+void SystemMisc_match_inherited_component_after_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_PREFAB(world, Prefab, Velocity);
+    ECS_TYPE(world, Type, Position, INSTANCEOF | Prefab);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position, Velocity);
+
+    ecs_entity_t e = ecs_new(world, Type);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+
+    test_int(ctx.count, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.e[0], e);
+
+    ecs_fini(world);
+}
+
+void SystemMisc_match_owned_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_PREFAB(world, Prefab, Velocity);
+    ECS_TYPE(world, Type_1, Position, INSTANCEOF | Prefab);
+    ECS_TYPE(world, Type_2, Position, Velocity, INSTANCEOF | Prefab);
+
+    ecs_new(world, Type_1);
+    ecs_entity_t e_1 = ecs_new(world, Type_2);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position, OWNED.Velocity);
+
+    ecs_entity_t e_2 = ecs_new(world, Velocity);
+    ecs_add(world, e_2, Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+
+    test_int(ctx.count, 2);
+    test_int(ctx.invoked, 2);
+    test_int(ctx.e[0], e_1);
+    test_int(ctx.e[1], e_2);
+
+    ecs_fini(world);
+}
+
+void SystemMisc_match_or_column_after_system() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position | Velocity);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+    ecs_entity_t e_2 = ecs_new(world, Velocity);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+
+    test_int(ctx.count, 2);
+    test_int(ctx.invoked, 2);
+    test_int(ctx.e[0], e_1);
+    test_int(ctx.e[1], e_2);
+
+    ecs_fini(world);
+}
+
+void SystemMisc_match_child_of_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position);
+
+    /* Type contains Position both as component and as parent */
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_adopt(world, e, ecs_entity(Position));
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+
+    test_int(ctx.count, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.e[0], e);
+
+    ecs_fini(world);
+}
+
+void SystemMisc_rematch_after_add_to_prefab() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_PREFAB(world, Prefab, Position);
+    ECS_TYPE(world, Type, Position, INSTANCEOF | Prefab);
+
+    ecs_entity_t e = ecs_new(world, Type);
+    ecs_new(world, Position);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position, Velocity);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 0);
+
+    ecs_add(world, Prefab, Velocity);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.e[0], e);
+
+    ecs_fini(world);
+}
+
+void SystemMisc_rematch_after_add_to_container() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, CONTAINER.Mass, Position);
+
+    ecs_entity_t parent_1 = ecs_new(world, 0);
+    ecs_entity_t parent_2 = ecs_new(world, 0);
+    ecs_entity_t e_1 = ecs_new_child(world, parent_1, Position);
+    ecs_new_child(world, parent_2, Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 0);
+
+    /* Only the table with parent_1 as container should be matched */
+    ecs_set(world, parent_1, Mass, {2});
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.e[0], e_1);
+    test_int(ctx.s[0][0], parent_1);
+
+    ecs_fini(world);
+}
+
+void SystemMisc_rematch_after_add_to_container_prefab() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Mass);
+    ECS_PREFAB(world, Prefab, Position);
+    ECS_TYPE(world, Type, INSTANCEOF | Prefab);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, CONTAINER.Mass, Position);
+
+    ecs_entity_t parent = ecs_new(world, Type);
+    ecs_entity_t e = ecs_new_child(world, parent, Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 0);
+
+    /* Container inherits Mass from the prefab that is changed */
+    ecs_set(world, Prefab, Mass, {2});
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.e[0], e);
+
+    ecs_fini(world);
+}
+
+void SystemMisc_rematch_after_add_to_base_prefab() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_PREFAB(world, Base, Position);
+    ECS_PREFAB(world, Prefab, INSTANCEOF | Base);
+    ECS_TYPE(world, Type, Position, INSTANCEOF | Prefab);
+
+    ecs_entity_t e = ecs_new(world, Type);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, Position, Velocity);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 0);
+
+    ecs_add(world, Base, Velocity);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.e[0], e);
+
+    ecs_fini(world);
+}
+
+void SystemMisc_rematch_unmatch_match() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Mass);
+
+    ECS_TAG(world, Tag);
+    ECS_TYPE(world, Parent, Mass, Tag);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, CONTAINER.Mass, Position);
+
+    ecs_entity_t parent = ecs_new(world, Parent);
+    ecs_entity_t e_1 = ecs_new_child(world, parent, Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.count, 1);
+
+    /* Unmatch table, and add an entity to the unmatched table */
+    ecs_remove(world, parent, Mass);
+    ecs_progress(world, 1);
+
+    ecs_entity_t e_2 = ecs_new_child(world, parent, Position);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.count, 0);
+
+    /* Match table again, entities should only be iterated once */
+    ecs_add(world, parent, Mass);
+    ecs_progress(world, 1);
+    test_int(ctx.count, 2);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.e[0], e_1);
+    test_int(ctx.e[1], e_2);
+
+    ecs_fini(world);
+}
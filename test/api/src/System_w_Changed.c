@@ -0,0 +1,384 @@
+#include <api.h>
+
+static
+void Iter(ecs_rows_t *rows) {
+    ProbeSystem(rows);
+}
+
+static
+void Write(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        p[i].x ++;
+    }
+}
+
+static int read_count;
+
+static
+void Read(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    test_assert(p != NULL);
+    read_count += rows->count;
+}
+
+static
+void CountInvoked(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Velocity, v, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        v[i].x ++;
+    }
+}
+
+static ecs_entity_t set_entity;
+
+static
+void SetPosition(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, Position, 1);
+
+    if (set_entity) {
+        ecs_set(rows->world, set_entity, Position, {10, 20});
+        set_entity = 0;
+    }
+}
+
+void System_w_Changed_run_first_frame() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+    ECS_ENTITY(world, e_3, Position, Velocity);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, [in, changed] Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+
+    test_int(ctx.count, 3);
+    test_int(ctx.invoked, 2);
+    test_int(ctx.system, Iter);
+    test_int(ctx.column_count, 1);
+
+    ecs_fini(world);
+}
+
+void System_w_Changed_skip_unchanged() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+    ECS_ENTITY(world, e_3, Position, Velocity);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, [in, changed] Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 2);
+
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 2);
+    test_int(ctx.count, 3);
+
+    ecs_fini(world);
+}
+
+void System_w_Changed_run_after_set() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+    ECS_ENTITY(world, e_3, Position, Velocity);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, [in, changed] Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 2);
+
+    /* Only the table of the entity is changed */
+    ecs_set(world, e_3, Position, {10, 20});
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 1);
+    test_int(ctx.e[0], e_3);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 0);
+
+    ecs_fini(world);
+}
+
+void System_w_Changed_skip_after_set_other() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_ENTITY(world, e_1, Position, Velocity);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, [in, changed] Position, Velocity);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+
+    /* Velocity is not a [changed] column */
+    ecs_set(world, e_1, Velocity, {10, 20});
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 0);
+
+    ecs_fini(world);
+}
+
+void System_w_Changed_run_after_new() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e_1 = ecs_new(world, Position);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, [in, changed] Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+
+    ecs_entity_t e_2 = ecs_new(world, Position);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 2);
+    test_int(ctx.e[0], e_1);
+    test_int(ctx.e[1], e_2);
+
+    ecs_fini(world);
+}
+
+void System_w_Changed_run_after_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, [in, changed] Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+
+    ecs_delete(world, e_1);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 1);
+    test_int(ctx.e[0], e_2);
+
+    ecs_fini(world);
+}
+
+void System_w_Changed_run_after_system_write() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_ENTITY(world, e_1, Position);
+
+    ECS_SYSTEM(world, Write, EcsPreUpdate, Position);
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, [in, changed] Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 3);
+
+    ecs_fini(world);
+}
+
+void System_w_Changed_skip_after_system_read() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_ENTITY(world, e_1, Position);
+
+    ECS_SYSTEM(world, Read, EcsPreUpdate, [in] Position);
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, [in, changed] Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    read_count = 0;
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+    test_int(read_count, 3);
+
+    ecs_fini(world);
+}
+
+void System_w_Changed_skip_own_write() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_ENTITY(world, e_1, Position);
+
+    ECS_SYSTEM(world, Write, EcsOnUpdate, [changed] Position);
+
+    ecs_set(world, e_1, Position, {0, 0});
+
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+
+    Position *p = ecs_get_ptr(world, e_1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+
+    ecs_fini(world);
+}
+
+void System_w_Changed_run_after_staged_set() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_ENTITY(world, e_1, Position);
+    ECS_ENTITY(world, e_2, Position);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, [in, changed] Position);
+    ECS_SYSTEM(world, SetPosition, EcsPostUpdate, .Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    /* Set is merged at the end of the frame */
+    set_entity = e_1;
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 2);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 0);
+
+    Position *p = ecs_get_ptr(world, e_1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void System_w_Changed_run_after_restore() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_ENTITY(world, e_1, Position);
+
+    ECS_SYSTEM(world, Iter, EcsOnUpdate, [in, changed] Position);
+
+    SysTestData ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+
+    /* Restored data may be different from the data the system has seen */
+    ecs_snapshot_restore(world, s);
+
+    ctx = (SysTestData){0};
+    ecs_progress(world, 1);
+    test_int(ctx.invoked, 1);
+
+    ecs_fini(world);
+}
+
+void System_w_Changed_multithread() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+    ECS_TYPE(world, Type_1, Position, Velocity);
+    ECS_TYPE(world, Type_2, Position, Velocity, Mass);
+
+    ECS_SYSTEM(world, CountInvoked, EcsOnUpdate, [in, changed] Position, Velocity);
+
+    ecs_entity_t e = ecs_new_w_count(world, Type_1, 100);
+    ecs_entity_t e2 = ecs_new_w_count(world, Type_2, 100);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_set(world, e + i, Velocity, {0, 0});
+        ecs_set(world, e2 + i, Velocity, {0, 0});
+    }
+
+    ecs_set_threads(world, 4);
+
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+
+    /* Only the table with the changed entity runs */
+    ecs_set(world, e + 10, Position, {10, 20});
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+
+    for (i = 0; i < 100; i ++) {
+        Velocity *v = ecs_get_ptr(world, e + i, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, 2);
+
+        v = ecs_get_ptr(world, e2 + i, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, 1);
+    }
+
+    ecs_fini(world);
+}
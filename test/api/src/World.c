@@ -329,13 +329,13 @@ void World_dim_type() {
 
     ecs_new_w_count(world, Position, 500);
 
-    test_int(malloc_count, 2);
+    test_int(malloc_count, 0);
 
     malloc_count = 0;
 
     ecs_new_w_count(world, Position, 400);
 
-    test_int(malloc_count, 2);
+    test_int(malloc_count, 0);
 
     ecs_fini(world);
 }
@@ -1082,3 +1082,323 @@ void World_is_entity_enabled() {
 
     ecs_fini(world);
 }
+
+void World_table_arena_aligned() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_set_table_arena(world, true);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e, Velocity, {1, 2});
+
+    test_assert((uintptr_t)ecs_get_ptr(world, e, Position) % 64 == 0);
+    test_assert((uintptr_t)ecs_get_ptr(world, e, Velocity) % 64 == 0);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_entity_t e2 = ecs_set(world, 0, Position, {i, i * 2});
+        ecs_set(world, e2, Velocity, {i * 3, i * 4});
+
+        Position *p = ecs_get_ptr(world, e2, Position);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+    }
+
+    /* Adding entities moved the columns, check if data is still aligned and
+     * values are preserved */
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_assert((uintptr_t)p % 64 == 0);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    Velocity *v = ecs_get_ptr(world, e, Velocity);
+    test_assert((uintptr_t)v % 64 == 0);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_fini(world);
+}
+
+void World_table_arena_grow() {
+    ecs_os_set_api_defaults();
+    ecs_os_api_t os_api = ecs_os_api;
+    os_api.malloc = test_malloc;
+    os_api.calloc = test_calloc;
+    os_api.realloc = test_realloc;
+    ecs_os_set_api(&os_api);    
+
+    ecs_world_t *world = ecs_init();
+
+    ecs_set_table_arena(world, true);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TYPE(world, Type, Position, Velocity);
+
+    ecs_entity_t e = ecs_new(world, Type);
+
+    malloc_count = 0;
+
+    /* All columns are grown with a single allocation */
+    ecs_new_w_count(world, Type, 500);
+    test_int(malloc_count, 1);
+
+    test_assert((uintptr_t)ecs_get_ptr(world, e, Position) % 64 == 0);
+    test_assert((uintptr_t)ecs_get_ptr(world, e, Velocity) % 64 == 0);
+    test_int(ecs_count(world, Type), 501);
+
+    ecs_fini(world);
+}
+
+void World_table_arena_dim() {
+    ecs_os_set_api_defaults();
+    ecs_os_api_t os_api = ecs_os_api;
+    os_api.malloc = test_malloc;
+    os_api.calloc = test_calloc;
+    os_api.realloc = test_realloc;
+    ecs_os_set_api(&os_api);    
+
+    ecs_world_t *world = ecs_init();
+
+    ecs_set_table_arena(world, true);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_new(world, Position);
+
+    ecs_dim_type(world, Position, 1100);
+
+    malloc_count = 0;
+
+    ecs_new_w_count(world, Position, 500);
+    ecs_new_w_count(world, Position, 500);
+
+    test_int(malloc_count, 0);
+    test_int(ecs_count(world, Position), 1001);
+
+    ecs_fini(world);
+}
+
+void World_table_arena_remove() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_set_table_arena(world, true);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e_1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e_1, Velocity, {1, 2});
+    ecs_entity_t e_2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_set(world, e_2, Velocity, {3, 4});
+
+    ecs_remove(world, e_1, Velocity);
+    ecs_delete(world, e_2);
+
+    Position *p = ecs_get_ptr(world, e_1, Position);
+    test_assert((uintptr_t)p % 64 == 0);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+    test_assert(!ecs_has(world, e_1, Velocity));
+
+    ecs_fini(world);
+}
+
+void World_table_arena_snapshot() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_set_table_arena(world, true);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    p->x ++;
+    p->y ++;
+
+    ecs_snapshot_restore(world, s);
+
+    p = ecs_get_ptr(world, e, Position);
+    test_assert((uintptr_t)p % 64 == 0);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    p = ecs_get_ptr(world, e2, Position);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+static
+void SetVelocity(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    int i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_set(rows->world, rows->entities[i], Velocity, {p[i].x, p[i].y});
+    }
+}
+
+void World_stage_arena_alloc_stats() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsStats, 0);
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ECS_SYSTEM(world, SetVelocity, EcsOnUpdate, Position, .Velocity);
+
+    /* Make sure that stats are collected by requiring EcsAllocStats */
+    ecs_new_system(world, "CollectAllocStats", EcsManual, "[in] EcsAllocStats", NULL);
+
+    int i, ENTITIES = 10000;
+    ecs_entity_t *handles = ecs_os_alloca(ecs_entity_t, ENTITIES);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        handles[i] = ecs_set(world, 0, Position, {i, i * 2});
+    }
+
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+
+    EcsAllocStats stats = ecs_get(world, EcsWorld, EcsAllocStats);
+    test_assert(stats.stage_alloc_count_total != 0);
+    test_assert(stats.stage_block_count_total != 0);
+
+    uint64_t alloc_count = stats.stage_alloc_count_total;
+    uint64_t block_count = stats.stage_block_count_total;
+
+    ecs_progress(world, 1);
+    ecs_progress(world, 1);
+
+    /* Stage reuses the block of the previous frames */
+    stats = ecs_get(world, EcsWorld, EcsAllocStats);
+    test_assert(stats.stage_alloc_count_total > alloc_count);
+    test_assert(stats.stage_block_count_total == block_count);
+
+    for (i = 0; i < ENTITIES; i ++) {
+        Velocity *v = ecs_get_ptr(world, handles[i], Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, i);
+        test_int(v->y, i * 2);
+    }
+
+    ecs_fini(world);
+}
+
+typedef struct test_allocator_t {
+    int32_t alloc_count;
+    int32_t free_count;
+    size_t allocd_bytes;
+} test_allocator_t;
+
+static
+void* test_allocator_alloc(
+    void *ctx,
+    size_t alignment,
+    size_t size)
+{
+    test_allocator_t *allocator = ctx;
+    allocator->alloc_count ++;
+    allocator->allocd_bytes += size;
+    return ecs_os_aligned_alloc(alignment, size);
+}
+
+static
+void test_allocator_free(
+    void *ctx,
+    void *ptr,
+    size_t alignment,
+    size_t size)
+{
+    test_allocator_t *allocator = ctx;
+    allocator->free_count ++;
+    allocator->allocd_bytes -= size;
+    ecs_os_free_sized(ptr, size);
+}
+
+void World_os_aligned_alloc() {
+    ecs_os_set_api_defaults();
+
+    void *ptr = ecs_os_aligned_alloc(256, 100);
+    test_assert(ptr != NULL);
+    test_assert((uintptr_t)ptr % 256 == 0);
+    memset(ptr, 0, 100);
+    ecs_os_free_sized(ptr, 100);
+}
+
+void World_custom_allocator() {
+    ecs_world_t *world = ecs_init();
+
+    test_allocator_t ctx = {0};
+    ecs_set_allocator(world, &(ecs_os_allocator_t){
+        .alloc = test_allocator_alloc,
+        .free = test_allocator_free,
+        .ctx = &ctx
+    });
+
+    ecs_set_table_arena(world, true);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_new_w_count(world, Position, 100);
+
+    test_assert(ctx.alloc_count != 0);
+    test_assert(ctx.allocd_bytes != 0);
+
+    Position *p = ecs_get_ptr(world, e, Position);
+    test_assert((uintptr_t)p % 64 == 0);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+
+    test_int(ctx.alloc_count, ctx.free_count);
+    test_int(ctx.allocd_bytes, 0);
+}
+
+void World_alloc_stats_per_world() {
+    ecs_world_t *world_1 = ecs_init();
+    ecs_world_t *world_2 = ecs_init();
+
+    test_allocator_t ctx = {0};
+    ecs_set_allocator(world_2, &(ecs_os_allocator_t){
+        .alloc = test_allocator_alloc,
+        .free = test_allocator_free,
+        .ctx = &ctx
+    });
+
+    ECS_IMPORT(world_1, FlecsStats, 0);
+
+    ecs_new_system(world_1, "CollectAllocStats", EcsManual, "[in] EcsAllocStats", NULL);
+
+    ecs_set_table_arena(world_1, true);
+    ecs_set_table_arena(world_2, true);
+
+    ECS_COMPONENT(world_1, Position);
+    ecs_new_w_count(world_1, Position, 100);
+
+    ecs_progress(world_1, 1);
+    ecs_progress(world_1, 1);
+
+    EcsAllocStats stats = ecs_get(world_1, EcsWorld, EcsAllocStats);
+    test_assert(stats.world_alloc_count_total != 0);
+    test_assert(stats.world_allocd_bytes != 0);
+
+    /* Allocations of world_1 don't use the allocator of world_2 */
+    test_int(ctx.alloc_count, 0);
+
+    ecs_fini(world_1);
+    ecs_fini(world_2);
+}
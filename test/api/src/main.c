@@ -103,6 +103,9 @@ void Add_add_2_remove(void);
 void Add_on_add_after_new_type_in_progress(void);
 void Add_add_entity(void);
 void Add_remove_entity(void);
+void Add_add_remove_tag_again(void);
+void Add_add_remove_hi_component(void);
+void Add_add_again_in_progress(void);
 
 // Testsuite 'Remove'
 void Remove_zero(void);
@@ -134,6 +137,10 @@ void Add_remove_w_filter_remove_1_include_1(void);
 void Add_remove_w_filter_remove_1_include_2(void);
 void Add_remove_w_filter_add_1(void);
 void Add_remove_w_filter_add_2(void);
+void Add_remove_w_filter_add_remove_values(void);
+void Add_remove_w_filter_add_remove_values_w_arena(void);
+void Add_remove_w_filter_add_remove_same_table(void);
+void Add_remove_w_filter_add_activates_system(void);
 
 // Testsuite 'Has'
 void Has_zero(void);
@@ -195,6 +202,13 @@ void Delete_delete_2nd_of_3(void);
 void Delete_delete_2_of_3(void);
 void Delete_delete_3_of_3(void);
 void Delete_delete_w_on_remove(void);
+void Delete_recycle_id(void);
+void Delete_is_alive(void);
+void Delete_is_alive_after_delete(void);
+void Delete_is_alive_after_recycle(void);
+void Delete_get_after_recycle(void);
+void Delete_delete_stale_handle(void);
+void Delete_recycle_in_progress(void);
 
 // Testsuite 'Delete_w_filter'
 void Delete_w_filter_delete_1(void);
@@ -237,6 +251,17 @@ void Lookup_lookup_w_null_id(void);
 void Lookup_get_id(void);
 void Lookup_get_id_no_id(void);
 void Lookup_get_id_from_empty(void);
+void Lookup_lookup_after_rename(void);
+void Lookup_lookup_after_delete(void);
+void Lookup_lookup_after_remove_id(void);
+void Lookup_lookup_child_after_orphan(void);
+void Lookup_lookup_child_many_parents(void);
+void Lookup_lookup_after_snapshot_restore(void);
+void Lookup_lookup_after_clone(void);
+void Lookup_lookup_after_merge(void);
+void Lookup_lookup_path(void);
+void Lookup_lookup_path_not_found(void);
+void Lookup_lookup_name_index_bounded(void);
 
 // Testsuite 'Singleton'
 void Singleton_set(void);
@@ -301,6 +326,17 @@ void SystemMisc_status_disable_after_new(void);
 void SystemMisc_status_disable_after_disable(void);
 void SystemMisc_status_activate_after_new(void);
 void SystemMisc_status_deactivate_after_delete(void);
+void SystemMisc_match_rare_component(void);
+void SystemMisc_match_inherited_component(void);
+void SystemMisc_match_inherited_component_after_system(void);
+void SystemMisc_match_owned_component(void);
+void SystemMisc_match_or_column_after_system(void);
+void SystemMisc_match_child_of_component(void);
+void SystemMisc_rematch_after_add_to_prefab(void);
+void SystemMisc_rematch_after_add_to_container(void);
+void SystemMisc_rematch_after_add_to_container_prefab(void);
+void SystemMisc_rematch_after_add_to_base_prefab(void);
+void SystemMisc_rematch_unmatch_match(void);
 
 // Testsuite 'SystemOnAdd'
 void SystemOnAdd_new_match_1_of_1(void);
@@ -602,6 +638,20 @@ void System_w_FromEntity_2_column_1_from_entity(void);
 void System_w_FromEntity_task_from_entity(void);
 void System_w_FromEntity_task_not_from_entity(void);
 
+// Testsuite 'System_w_Changed'
+void System_w_Changed_run_first_frame(void);
+void System_w_Changed_skip_unchanged(void);
+void System_w_Changed_run_after_set(void);
+void System_w_Changed_skip_after_set_other(void);
+void System_w_Changed_run_after_new(void);
+void System_w_Changed_run_after_delete(void);
+void System_w_Changed_run_after_system_write(void);
+void System_w_Changed_skip_after_system_read(void);
+void System_w_Changed_skip_own_write(void);
+void System_w_Changed_run_after_staged_set(void);
+void System_w_Changed_run_after_restore(void);
+void System_w_Changed_multithread(void);
+
 // Testsuite 'World'
 void World_progress_w_0(void);
 void World_progress_w_t(void);
@@ -636,6 +686,15 @@ void World_init_w_args_enable_dbg(void);
 void World_no_threading(void);
 void World_no_time(void);
 void World_is_entity_enabled(void);
+void World_table_arena_aligned(void);
+void World_table_arena_grow(void);
+void World_table_arena_dim(void);
+void World_table_arena_remove(void);
+void World_table_arena_snapshot(void);
+void World_stage_arena_alloc_stats(void);
+void World_os_aligned_alloc(void);
+void World_custom_allocator(void);
+void World_alloc_stats_per_world(void);
 
 // Testsuite 'Type'
 void Type_type_of_1_tostr(void);
@@ -711,6 +770,7 @@ void Run_run_w_container_filter(void);
 void Run_run_comb_10_entities_1_type(void);
 void Run_run_comb_10_entities_2_types(void);
 void Run_run_w_interrupt(void);
+void Run_run_w_param_w_system_ctx(void);
 
 // Testsuite 'MultiThread'
 void MultiThread_2_thread_1_entity(void);
@@ -747,6 +807,19 @@ void MultiThread_change_thread_count(void);
 void MultiThread_multithread_quit(void);
 void MultiThread_schedule_w_tasks(void);
 void MultiThread_reactive_system(void);
+void MultiThread_2_thread_job_size_1(void);
+void MultiThread_4_thread_job_size_7(void);
+void MultiThread_2_thread_job_size_larger_than_rows(void);
+void MultiThread_4_thread_skewed_workload(void);
+void MultiThread_task_on_main_thread(void);
+void MultiThread_2_thread_spin(void);
+void MultiThread_4_thread_spin_multiple_phases(void);
+void MultiThread_change_thread_count_w_spin(void);
+void MultiThread_4_thread_write_then_read(void);
+void MultiThread_4_thread_read_then_write(void);
+void MultiThread_4_thread_disjoint_writes(void);
+void MultiThread_4_thread_shared_reads(void);
+void MultiThread_4_thread_write_read_write(void);
 
 // Testsuite 'SingleThreadStaging'
 void SingleThreadStaging_new_empty(void);
@@ -814,6 +887,10 @@ void SingleThreadStaging_merge_table_w_container_added_on_set_reverse(void);
 void SingleThreadStaging_merge_after_tasks(void);
 void SingleThreadStaging_override_after_remove_in_progress(void);
 void SingleThreadStaging_get_parent_in_progress(void);
+void SingleThreadStaging_merge_many_add(void);
+void SingleThreadStaging_merge_many_set_existing(void);
+void SingleThreadStaging_merge_many_remove_w_on_remove(void);
+void SingleThreadStaging_merge_many_different_groups(void);
 
 // Testsuite 'MultiThreadStaging'
 void MultiThreadStaging_2_threads_add_to_current(void);
@@ -844,6 +921,17 @@ void Snapshot_snapshot_activate_table_w_filter(void);
 void Snapshot_snapshot_copy(void);
 void Snapshot_snapshot_copy_filtered(void);
 void Snapshot_snapshot_copy_w_filter(void);
+void Snapshot_shared_snapshot(void);
+void Snapshot_shared_snapshot_after_new(void);
+void Snapshot_shared_snapshot_after_delete(void);
+void Snapshot_shared_snapshot_after_add(void);
+void Snapshot_shared_snapshot_w_system(void);
+void Snapshot_shared_snapshot_w_threads(void);
+void Snapshot_shared_snapshot_free(void);
+void Snapshot_shared_snapshot_copy(void);
+void Snapshot_shared_snapshot_w_arena(void);
+void Snapshot_ring_rollback(void);
+void Snapshot_ring_overflow(void);
 
 // Testsuite 'ReaderWriter'
 void ReaderWriter_simple(void);
@@ -869,6 +957,25 @@ void ReaderWriter_component_size_conflict(void);
 void ReaderWriter_read_zero_size(void);
 void ReaderWriter_write_zero_size(void);
 void ReaderWriter_invalid_header(void);
+void ReaderWriter_large_id(void);
+void ReaderWriter_large_table(void);
+void ReaderWriter_invalid_version(void);
+void ReaderWriter_save_load_file(void);
+void ReaderWriter_load_file_modify(void);
+void ReaderWriter_load_file_large_table(void);
+void ReaderWriter_load_file_w_system(void);
+void ReaderWriter_load_file_w_writer(void);
+void ReaderWriter_load_file_not_found(void);
+void ReaderWriter_delta_set(void);
+void ReaderWriter_delta_new(void);
+void ReaderWriter_delta_delete(void);
+void ReaderWriter_delta_remove_all(void);
+void ReaderWriter_delta_move(void);
+void ReaderWriter_delta_unchanged(void);
+void ReaderWriter_delta_chunks(void);
+void ReaderWriter_delta_shared_snapshot(void);
+void ReaderWriter_delta_twice(void);
+void ReaderWriter_invalid_component_size(void);
 
 // Testsuite 'FilterIter'
 void FilterIter_iter_one_table(void);
@@ -878,6 +985,16 @@ void FilterIter_iter_snapshot_one_table(void);
 void FilterIter_iter_snapshot_two_tables(void);
 void FilterIter_iter_snapshot_two_comps(void);
 void FilterIter_iter_snapshot_filtered_table(void);
+void FilterIter_iter_w_inherited_component(void);
+void FilterIter_iter_match_any(void);
+void FilterIter_iter_w_many_components(void);
+void FilterIter_run(void);
+void FilterIter_run_w_threads(void);
+void FilterIter_run_w_threads_w_job_size(void);
+void FilterIter_run_no_match(void);
+void FilterIter_run_set(void);
+void FilterIter_run_w_threads_set(void);
+void FilterIter_run_w_threads_from_system(void);
 
 // Testsuite 'Modules'
 void Modules_simple_module(void);
@@ -908,6 +1025,29 @@ void Error_log_log(void);
 void Error_log_warning(void);
 void Error_log_error(void);
 
+// Testsuite 'ComponentLifecycle'
+void ComponentLifecycle_ctor_on_add(void);
+void ComponentLifecycle_ctor_on_new_w_count(void);
+void ComponentLifecycle_zero_init_wo_ctor(void);
+void ComponentLifecycle_dtor_on_remove(void);
+void ComponentLifecycle_dtor_on_delete(void);
+void ComponentLifecycle_dtor_on_delete_w_filter(void);
+void ComponentLifecycle_dtor_on_fini(void);
+void ComponentLifecycle_move_on_add(void);
+void ComponentLifecycle_move_on_delete(void);
+void ComponentLifecycle_move_on_grow(void);
+void ComponentLifecycle_copy_on_set(void);
+void ComponentLifecycle_copy_on_clone(void);
+void ComponentLifecycle_copy_on_override(void);
+void ComponentLifecycle_staged_add(void);
+void ComponentLifecycle_staged_set(void);
+void ComponentLifecycle_owned_resource(void);
+void ComponentLifecycle_owned_resource_w_arena(void);
+void ComponentLifecycle_dtor_on_remove_w_filter(void);
+void ComponentLifecycle_owned_resource_w_filter(void);
+void ComponentLifecycle_owned_resource_w_filter_w_arena(void);
+void ComponentLifecycle_dtor_on_arena_grow(void);
+
 static bake_test_suite suites[] = {
     {
         .id = "New",
@@ -1157,7 +1297,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Add",
-        .testcase_count = 31,
+        .testcase_count = 34,
         .testcases = (bake_test_case[]){
             {
                 .id = "zero",
@@ -1282,6 +1422,18 @@ static bake_test_suite suites[] = {
             {
                 .id = "remove_entity",
                 .function = Add_remove_entity
+            },
+            {
+                .id = "add_remove_tag_again",
+                .function = Add_add_remove_tag_again
+            },
+            {
+                .id = "add_remove_hi_component",
+                .function = Add_add_remove_hi_component
+            },
+            {
+                .id = "add_again_in_progress",
+                .function = Add_add_again_in_progress
             }
         }
     },
@@ -1353,7 +1505,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Add_remove_w_filter",
-        .testcase_count = 12,
+        .testcase_count = 16,
         .testcases = (bake_test_case[]){
             {
                 .id = "remove_1_no_filter",
@@ -1402,6 +1554,22 @@ static bake_test_suite suites[] = {
             {
                 .id = "add_2",
                 .function = Add_remove_w_filter_add_2
+            },
+            {
+                .id = "add_remove_values",
+                .function = Add_remove_w_filter_add_remove_values
+            },
+            {
+                .id = "add_remove_values_w_arena",
+                .function = Add_remove_w_filter_add_remove_values_w_arena
+            },
+            {
+                .id = "add_remove_same_table",
+                .function = Add_remove_w_filter_add_remove_same_table
+            },
+            {
+                .id = "add_activates_system",
+                .function = Add_remove_w_filter_add_activates_system
             }
         }
     },
@@ -1601,7 +1769,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Delete",
-        .testcase_count = 9,
+        .testcase_count = 16,
         .testcases = (bake_test_case[]){
             {
                 .id = "delete_1",
@@ -1638,6 +1806,34 @@ static bake_test_suite suites[] = {
             {
                 .id = "delete_w_on_remove",
                 .function = Delete_delete_w_on_remove
+            },
+            {
+                .id = "recycle_id",
+                .function = Delete_recycle_id
+            },
+            {
+                .id = "is_alive",
+                .function = Delete_is_alive
+            },
+            {
+                .id = "is_alive_after_delete",
+                .function = Delete_is_alive_after_delete
+            },
+            {
+                .id = "is_alive_after_recycle",
+                .function = Delete_is_alive_after_recycle
+            },
+            {
+                .id = "get_after_recycle",
+                .function = Delete_get_after_recycle
+            },
+            {
+                .id = "delete_stale_handle",
+                .function = Delete_delete_stale_handle
+            },
+            {
+                .id = "recycle_in_progress",
+                .function = Delete_recycle_in_progress
             }
         }
     },
@@ -1755,7 +1951,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Lookup",
-        .testcase_count = 11,
+        .testcase_count = 22,
         .testcases = (bake_test_case[]){
             {
                 .id = "lookup",
@@ -1800,6 +1996,50 @@ static bake_test_suite suites[] = {
             {
                 .id = "get_id_from_empty",
                 .function = Lookup_get_id_from_empty
+            },
+            {
+                .id = "lookup_after_rename",
+                .function = Lookup_lookup_after_rename
+            },
+            {
+                .id = "lookup_after_delete",
+                .function = Lookup_lookup_after_delete
+            },
+            {
+                .id = "lookup_after_remove_id",
+                .function = Lookup_lookup_after_remove_id
+            },
+            {
+                .id = "lookup_child_after_orphan",
+                .function = Lookup_lookup_child_after_orphan
+            },
+            {
+                .id = "lookup_child_many_parents",
+                .function = Lookup_lookup_child_many_parents
+            },
+            {
+                .id = "lookup_after_snapshot_restore",
+                .function = Lookup_lookup_after_snapshot_restore
+            },
+            {
+                .id = "lookup_after_clone",
+                .function = Lookup_lookup_after_clone
+            },
+            {
+                .id = "lookup_after_merge",
+                .function = Lookup_lookup_after_merge
+            },
+            {
+                .id = "lookup_path",
+                .function = Lookup_lookup_path
+            },
+            {
+                .id = "lookup_path_not_found",
+                .function = Lookup_lookup_path_not_found
+            },
+            {
+                .id = "lookup_name_index_bounded",
+                .function = Lookup_lookup_name_index_bounded
             }
         }
     },
@@ -1901,7 +2141,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "SystemMisc",
-        .testcase_count = 37,
+        .testcase_count = 48,
         .testcases = (bake_test_case[]){
             {
                 .id = "invalid_not_without_id",
@@ -2050,6 +2290,50 @@ static bake_test_suite suites[] = {
             {
                 .id = "status_deactivate_after_delete",
                 .function = SystemMisc_status_deactivate_after_delete
+            },
+            {
+                .id = "match_rare_component",
+                .function = SystemMisc_match_rare_component
+            },
+            {
+                .id = "match_inherited_component",
+                .function = SystemMisc_match_inherited_component
+            },
+            {
+                .id = "match_inherited_component_after_system",
+                .function = SystemMisc_match_inherited_component_after_system
+            },
+            {
+                .id = "match_owned_component",
+                .function = SystemMisc_match_owned_component
+            },
+            {
+                .id = "match_or_column_after_system",
+                .function = SystemMisc_match_or_column_after_system
+            },
+            {
+                .id = "match_child_of_component",
+                .function = SystemMisc_match_child_of_component
+            },
+            {
+                .id = "rematch_after_add_to_prefab",
+                .function = SystemMisc_rematch_after_add_to_prefab
+            },
+            {
+                .id = "rematch_after_add_to_container",
+                .function = SystemMisc_rematch_after_add_to_container
+            },
+            {
+                .id = "rematch_after_add_to_container_prefab",
+                .function = SystemMisc_rematch_after_add_to_container_prefab
+            },
+            {
+                .id = "rematch_after_add_to_base_prefab",
+                .function = SystemMisc_rematch_after_add_to_base_prefab
+            },
+            {
+                .id = "rematch_unmatch_match",
+                .function = SystemMisc_rematch_unmatch_match
             }
         }
     },
@@ -3225,9 +3509,63 @@ static bake_test_suite suites[] = {
             }
         }
     },
+    {
+        .id = "System_w_Changed",
+        .testcase_count = 12,
+        .testcases = (bake_test_case[]){
+            {
+                .id = "run_first_frame",
+                .function = System_w_Changed_run_first_frame
+            },
+            {
+                .id = "skip_unchanged",
+                .function = System_w_Changed_skip_unchanged
+            },
+            {
+                .id = "run_after_set",
+                .function = System_w_Changed_run_after_set
+            },
+            {
+                .id = "skip_after_set_other",
+                .function = System_w_Changed_skip_after_set_other
+            },
+            {
+                .id = "run_after_new",
+                .function = System_w_Changed_run_after_new
+            },
+            {
+                .id = "run_after_delete",
+                .function = System_w_Changed_run_after_delete
+            },
+            {
+                .id = "run_after_system_write",
+                .function = System_w_Changed_run_after_system_write
+            },
+            {
+                .id = "skip_after_system_read",
+                .function = System_w_Changed_skip_after_system_read
+            },
+            {
+                .id = "skip_own_write",
+                .function = System_w_Changed_skip_own_write
+            },
+            {
+                .id = "run_after_staged_set",
+                .function = System_w_Changed_run_after_staged_set
+            },
+            {
+                .id = "run_after_restore",
+                .function = System_w_Changed_run_after_restore
+            },
+            {
+                .id = "multithread",
+                .function = System_w_Changed_multithread
+            }
+        }
+    },
     {
         .id = "World",
-        .testcase_count = 33,
+        .testcase_count = 42,
         .testcases = (bake_test_case[]){
             {
                 .id = "progress_w_0",
@@ -3360,6 +3698,42 @@ static bake_test_suite suites[] = {
             {
                 .id = "is_entity_enabled",
                 .function = World_is_entity_enabled
+            },
+            {
+                .id = "table_arena_aligned",
+                .function = World_table_arena_aligned
+            },
+            {
+                .id = "table_arena_grow",
+                .function = World_table_arena_grow
+            },
+            {
+                .id = "table_arena_dim",
+                .function = World_table_arena_dim
+            },
+            {
+                .id = "table_arena_remove",
+                .function = World_table_arena_remove
+            },
+            {
+                .id = "table_arena_snapshot",
+                .function = World_table_arena_snapshot
+            },
+            {
+                .id = "stage_arena_alloc_stats",
+                .function = World_stage_arena_alloc_stats
+            },
+            {
+                .id = "os_aligned_alloc",
+                .function = World_os_aligned_alloc
+            },
+            {
+                .id = "custom_allocator",
+                .function = World_custom_allocator
+            },
+            {
+                .id = "alloc_stats_per_world",
+                .function = World_alloc_stats_per_world
             }
         }
     },
@@ -3563,7 +3937,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Run",
-        .testcase_count = 23,
+        .testcase_count = 24,
         .testcases = (bake_test_case[]){
             {
                 .id = "run",
@@ -3656,12 +4030,16 @@ static bake_test_suite suites[] = {
             {
                 .id = "run_w_interrupt",
                 .function = Run_run_w_interrupt
+            },
+            {
+                .id = "run_w_param_w_system_ctx",
+                .function = Run_run_w_param_w_system_ctx
             }
         }
     },
     {
         .id = "MultiThread",
-        .testcase_count = 34,
+        .testcase_count = 47,
         .testcases = (bake_test_case[]){
             {
                 .id = "2_thread_1_entity",
@@ -3798,12 +4176,64 @@ static bake_test_suite suites[] = {
             {
                 .id = "reactive_system",
                 .function = MultiThread_reactive_system
+            },
+            {
+                .id = "2_thread_job_size_1",
+                .function = MultiThread_2_thread_job_size_1
+            },
+            {
+                .id = "4_thread_job_size_7",
+                .function = MultiThread_4_thread_job_size_7
+            },
+            {
+                .id = "2_thread_job_size_larger_than_rows",
+                .function = MultiThread_2_thread_job_size_larger_than_rows
+            },
+            {
+                .id = "4_thread_skewed_workload",
+                .function = MultiThread_4_thread_skewed_workload
+            },
+            {
+                .id = "task_on_main_thread",
+                .function = MultiThread_task_on_main_thread
+            },
+            {
+                .id = "2_thread_spin",
+                .function = MultiThread_2_thread_spin
+            },
+            {
+                .id = "4_thread_spin_multiple_phases",
+                .function = MultiThread_4_thread_spin_multiple_phases
+            },
+            {
+                .id = "change_thread_count_w_spin",
+                .function = MultiThread_change_thread_count_w_spin
+            },
+            {
+                .id = "4_thread_write_then_read",
+                .function = MultiThread_4_thread_write_then_read
+            },
+            {
+                .id = "4_thread_read_then_write",
+                .function = MultiThread_4_thread_read_then_write
+            },
+            {
+                .id = "4_thread_disjoint_writes",
+                .function = MultiThread_4_thread_disjoint_writes
+            },
+            {
+                .id = "4_thread_shared_reads",
+                .function = MultiThread_4_thread_shared_reads
+            },
+            {
+                .id = "4_thread_write_read_write",
+                .function = MultiThread_4_thread_write_read_write
             }
         }
     },
     {
         .id = "SingleThreadStaging",
-        .testcase_count = 65,
+        .testcase_count = 69,
         .testcases = (bake_test_case[]){
             {
                 .id = "new_empty",
@@ -4064,6 +4494,22 @@ static bake_test_suite suites[] = {
             {
                 .id = "get_parent_in_progress",
                 .function = SingleThreadStaging_get_parent_in_progress
+            },
+            {
+                .id = "merge_many_add",
+                .function = SingleThreadStaging_merge_many_add
+            },
+            {
+                .id = "merge_many_set_existing",
+                .function = SingleThreadStaging_merge_many_set_existing
+            },
+            {
+                .id = "merge_many_remove_w_on_remove",
+                .function = SingleThreadStaging_merge_many_remove_w_on_remove
+            },
+            {
+                .id = "merge_many_different_groups",
+                .function = SingleThreadStaging_merge_many_different_groups
             }
         }
     },
@@ -4111,7 +4557,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Snapshot",
-        .testcase_count = 17,
+        .testcase_count = 28,
         .testcases = (bake_test_case[]){
             {
                 .id = "simple_snapshot",
@@ -4180,12 +4626,56 @@ static bake_test_suite suites[] = {
             {
                 .id = "snapshot_copy_w_filter",
                 .function = Snapshot_snapshot_copy_w_filter
+            },
+            {
+                .id = "shared_snapshot",
+                .function = Snapshot_shared_snapshot
+            },
+            {
+                .id = "shared_snapshot_after_new",
+                .function = Snapshot_shared_snapshot_after_new
+            },
+            {
+                .id = "shared_snapshot_after_delete",
+                .function = Snapshot_shared_snapshot_after_delete
+            },
+            {
+                .id = "shared_snapshot_after_add",
+                .function = Snapshot_shared_snapshot_after_add
+            },
+            {
+                .id = "shared_snapshot_w_system",
+                .function = Snapshot_shared_snapshot_w_system
+            },
+            {
+                .id = "shared_snapshot_w_threads",
+                .function = Snapshot_shared_snapshot_w_threads
+            },
+            {
+                .id = "shared_snapshot_free",
+                .function = Snapshot_shared_snapshot_free
+            },
+            {
+                .id = "shared_snapshot_copy",
+                .function = Snapshot_shared_snapshot_copy
+            },
+            {
+                .id = "shared_snapshot_w_arena",
+                .function = Snapshot_shared_snapshot_w_arena
+            },
+            {
+                .id = "ring_rollback",
+                .function = Snapshot_ring_rollback
+            },
+            {
+                .id = "ring_overflow",
+                .function = Snapshot_ring_overflow
             }
         }
     },
     {
         .id = "ReaderWriter",
-        .testcase_count = 23,
+        .testcase_count = 42,
         .testcases = (bake_test_case[]){
             {
                 .id = "simple",
@@ -4278,12 +4768,88 @@ static bake_test_suite suites[] = {
             {
                 .id = "invalid_header",
                 .function = ReaderWriter_invalid_header
+            },
+            {
+                .id = "large_id",
+                .function = ReaderWriter_large_id
+            },
+            {
+                .id = "large_table",
+                .function = ReaderWriter_large_table
+            },
+            {
+                .id = "invalid_version",
+                .function = ReaderWriter_invalid_version
+            },
+            {
+                .id = "save_load_file",
+                .function = ReaderWriter_save_load_file
+            },
+            {
+                .id = "load_file_modify",
+                .function = ReaderWriter_load_file_modify
+            },
+            {
+                .id = "load_file_large_table",
+                .function = ReaderWriter_load_file_large_table
+            },
+            {
+                .id = "load_file_w_system",
+                .function = ReaderWriter_load_file_w_system
+            },
+            {
+                .id = "load_file_w_writer",
+                .function = ReaderWriter_load_file_w_writer
+            },
+            {
+                .id = "load_file_not_found",
+                .function = ReaderWriter_load_file_not_found
+            },
+            {
+                .id = "delta_set",
+                .function = ReaderWriter_delta_set
+            },
+            {
+                .id = "delta_new",
+                .function = ReaderWriter_delta_new
+            },
+            {
+                .id = "delta_delete",
+                .function = ReaderWriter_delta_delete
+            },
+            {
+                .id = "delta_remove_all",
+                .function = ReaderWriter_delta_remove_all
+            },
+            {
+                .id = "delta_move",
+                .function = ReaderWriter_delta_move
+            },
+            {
+                .id = "delta_unchanged",
+                .function = ReaderWriter_delta_unchanged
+            },
+            {
+                .id = "delta_chunks",
+                .function = ReaderWriter_delta_chunks
+            },
+            {
+                .id = "delta_shared_snapshot",
+                .function = ReaderWriter_delta_shared_snapshot
+            },
+            {
+                .id = "delta_twice",
+                .function = ReaderWriter_delta_twice
+            },
+            {
+                .id = "invalid_component_size",
+                .function = ReaderWriter_invalid_component_size
             }
         }
     },
     {
         .id = "FilterIter",
-        .testcase_count = 7,
+        .testcase_count = 17,
         .testcases = (bake_test_case[]){
             {
                 .id = "iter_one_table",
@@ -4312,6 +4878,46 @@ static bake_test_suite suites[] = {
             {
                 .id = "iter_snapshot_filtered_table",
                 .function = FilterIter_iter_snapshot_filtered_table
+            },
+            {
+                .id = "iter_w_inherited_component",
+                .function = FilterIter_iter_w_inherited_component
+            },
+            {
+                .id = "iter_match_any",
+                .function = FilterIter_iter_match_any
+            },
+            {
+                .id = "iter_w_many_components",
+                .function = FilterIter_iter_w_many_components
+            },
+            {
+                .id = "run",
+                .function = FilterIter_run
+            },
+            {
+                .id = "run_w_threads",
+                .function = FilterIter_run_w_threads
+            },
+            {
+                .id = "run_w_threads_w_job_size",
+                .function = FilterIter_run_w_threads_w_job_size
+            },
+            {
+                .id = "run_no_match",
+                .function = FilterIter_run_no_match
+            },
+            {
+                .id = "run_set",
+                .function = FilterIter_run_set
+            },
+            {
+                .id = "run_w_threads_set",
+                .function = FilterIter_run_w_threads_set
+            },
+            {
+                .id = "run_w_threads_from_system",
+                .function = FilterIter_run_w_threads_from_system
             }
         }
     },
@@ -4421,10 +5027,100 @@ static bake_test_suite suites[] = {
                 .function = Error_log_error
             }
         }
+    },
+    {
+        .id = "ComponentLifecycle",
+        .testcase_count = 21,
+        .testcases = (bake_test_case[]){
+            {
+                .id = "ctor_on_add",
+                .function = ComponentLifecycle_ctor_on_add
+            },
+            {
+                .id = "ctor_on_new_w_count",
+                .function = ComponentLifecycle_ctor_on_new_w_count
+            },
+            {
+                .id = "zero_init_wo_ctor",
+                .function = ComponentLifecycle_zero_init_wo_ctor
+            },
+            {
+                .id = "dtor_on_remove",
+                .function = ComponentLifecycle_dtor_on_remove
+            },
+            {
+                .id = "dtor_on_delete",
+                .function = ComponentLifecycle_dtor_on_delete
+            },
+            {
+                .id = "dtor_on_delete_w_filter",
+                .function = ComponentLifecycle_dtor_on_delete_w_filter
+            },
+            {
+                .id = "dtor_on_fini",
+                .function = ComponentLifecycle_dtor_on_fini
+            },
+            {
+                .id = "move_on_add",
+                .function = ComponentLifecycle_move_on_add
+            },
+            {
+                .id = "move_on_delete",
+                .function = ComponentLifecycle_move_on_delete
+            },
+            {
+                .id = "move_on_grow",
+                .function = ComponentLifecycle_move_on_grow
+            },
+            {
+                .id = "copy_on_set",
+                .function = ComponentLifecycle_copy_on_set
+            },
+            {
+                .id = "copy_on_clone",
+                .function = ComponentLifecycle_copy_on_clone
+            },
+            {
+                .id = "copy_on_override",
+                .function = ComponentLifecycle_copy_on_override
+            },
+            {
+                .id = "staged_add",
+                .function = ComponentLifecycle_staged_add
+            },
+            {
+                .id = "staged_set",
+                .function = ComponentLifecycle_staged_set
+            },
+            {
+                .id = "owned_resource",
+                .function = ComponentLifecycle_owned_resource
+            },
+            {
+                .id = "owned_resource_w_arena",
+                .function = ComponentLifecycle_owned_resource_w_arena
+            },
+            {
+                .id = "dtor_on_remove_w_filter",
+                .function = ComponentLifecycle_dtor_on_remove_w_filter
+            },
+            {
+                .id = "owned_resource_w_filter",
+                .function = ComponentLifecycle_owned_resource_w_filter
+            },
+            {
+                .id = "owned_resource_w_filter_w_arena",
+                .function = ComponentLifecycle_owned_resource_w_filter_w_arena
+            },
+            {
+                .id = "dtor_on_arena_grow",
+                .function = ComponentLifecycle_dtor_on_arena_grow
+            }
+        }
     }
 };
 
 int main(int argc, char *argv[]) {
     ut_init(argv[0]);
-    return bake_test_run("api", argc, argv, suites, 42);
+    return bake_test_run("api", argc, argv, suites, 44);
 }
@@ -0,0 +1,57 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/* This generated file contains includes for project dependencies */
+#include <bench/bake_config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of measured frames per benchmark */
+#define BENCH_FRAMES (200)
+
+/* Frame times measured by a benchmark, in seconds */
+typedef struct bench_frames_t {
+    double t[BENCH_FRAMES];
+    uint32_t count;
+} bench_frames_t;
+
+/* Install OS API functions that benchmarks need when not running under bake */
+void bench_set_os_api(void);
+
+/* Report mean, 99th percentile and max frame time of a benchmark */
+void bench_report(
+    const char *name,
+    bench_frames_t *frames);
+
+/* Report a measurement of a benchmark that is not a time, like allocations */
+void bench_report_value(
+    const char *name,
+    double value,
+    const char *unit);
+
+/* Benchmarks */
+void bench_jobs(void);
+void bench_barrier(void);
+void bench_batches(void);
+void bench_merge(void);
+void bench_serialize(void);
+void bench_load(void);
+void bench_snapshot(void);
+void bench_delta(void);
+void bench_changed(void);
+void bench_match(void);
+void bench_rematch(void);
+void bench_filter(void);
+void bench_lookup(void);
+void bench_staging(void);
+void bench_map(void);
+void bench_entity(void);
+void bench_iter(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
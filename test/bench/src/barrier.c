@@ -0,0 +1,61 @@
+#include <bench.h>
+
+#define ENTITIES (1000)
+#define THREADS (4)
+
+typedef struct Value {
+    float x;
+} Value;
+
+static
+void Work(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Value, value, 1);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        value[i].x ++;
+    }
+}
+
+/* Measure frames with four threaded phases that do very little work, so that
+ * the frame time is dominated by starting and finishing the phases */
+static
+void run(
+    const char *name,
+    uint32_t spin_count)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Value);
+    ecs_new_system(world, "PreUpdate", EcsPreUpdate, "Value", Work);
+    ecs_new_system(world, "OnUpdate", EcsOnUpdate, "Value", Work);
+    ecs_new_system(world, "OnValidate", EcsOnValidate, "Value", Work);
+    ecs_new_system(world, "PostUpdate", EcsPostUpdate, "Value", Work);
+
+    ecs_new_w_count(world, Value, ENTITIES);
+
+    ecs_set_thread_spin(world, spin_count);
+    ecs_set_threads(world, THREADS);
+
+    uint32_t i;
+    for (i = 0; i < 10; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_progress(world, 0);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report(name, &frames);
+
+    ecs_fini(world);
+}
+
+void bench_barrier(void) {
+    run("barrier/block", 0);
+    run("barrier/spin_10000", 10000);
+}
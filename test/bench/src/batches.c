@@ -0,0 +1,86 @@
+#include <bench.h>
+
+#define ENTITIES (10000)
+#define THREADS (4)
+#define SYSTEMS (8)
+
+typedef struct Value {
+    float x;
+} Value;
+
+/* Entity names are not copied, so they must outlive the world */
+static
+const char *component_ids[SYSTEMS] = {
+    "Value0", "Value1", "Value2", "Value3",
+    "Value4", "Value5", "Value6", "Value7"
+};
+
+static
+const char *system_ids[SYSTEMS] = {
+    "Work0", "Work1", "Work2", "Work3",
+    "Work4", "Work5", "Work6", "Work7"
+};
+
+static
+void Work(ecs_rows_t *rows) {
+    Value *value = ecs_column(rows, Value, 1);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        value[i].x = value[i].x * 0.999f + 1.0f;
+    }
+}
+
+/* Run a frame with many small systems that either all write the same
+ * component (each system needs its own barrier) or each write a different
+ * component (systems run concurrently in a single batch) */
+static
+void run(
+    const char *name,
+    bool disjoint)
+{
+    ecs_world_t *world = ecs_init();
+    ecs_entity_t components[SYSTEMS];
+
+    uint32_t i, s;
+    for (s = 0; s < SYSTEMS; s ++) {
+        components[s] = ecs_new_component(
+            world, component_ids[s], sizeof(Value));
+    }
+
+    for (s = 0; s < SYSTEMS; s ++) {
+        const char *sig = component_ids[disjoint ? s : 0];
+        ecs_new_system(world, system_ids[s], EcsOnUpdate, sig, Work);
+    }
+
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_entity_t e = ecs_new(world, 0);
+        for (s = 0; s < SYSTEMS; s ++) {
+            ecs_add_entity(world, e, components[s]);
+        }
+    }
+
+    ecs_set_threads(world, THREADS);
+
+    /* Warm up */
+    for (i = 0; i < 10; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_progress(world, 0);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report(name, &frames);
+
+    ecs_fini(world);
+}
+
+void bench_batches(void) {
+    run("batches/same_component", false);
+    run("batches/disjoint_components", true);
+}
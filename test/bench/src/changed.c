@@ -0,0 +1,74 @@
+#include <bench.h>
+
+#define TABLES (1000)
+#define ENTITIES_PER_TABLE (500)
+#define CHANGED_TABLES (10)
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+static
+void Sync(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    float *sum = rows->param;
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        *sum += p[i].x;
+    }
+}
+
+/* Run a system that synchronizes data of a world in which only a few tables
+ * change every frame, with and without the [changed] annotation */
+static
+void run(
+    const char *name,
+    const char *sig)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t sync = ecs_new_system(world, "Sync", EcsOnUpdate, sig, Sync);
+    float sum = 0;
+    ecs_set_system_context(world, sync, &sum);
+
+    ecs_entity_t first[TABLES];
+    uint32_t i, j;
+    for (i = 0; i < TABLES; i ++) {
+        /* Add a different tag to the entities of each table */
+        ecs_entity_t tag = ecs_new(world, 0);
+        ecs_type_t type = ecs_type_add(world, ecs_type(Position), tag);
+        first[i] = _ecs_new_w_count(world, type, ENTITIES_PER_TABLE);
+
+        for (j = 0; j < ENTITIES_PER_TABLE; j ++) {
+            ecs_set(world, first[i] + j, Position, {j, j});
+        }
+    }
+
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        for (j = 0; j < CHANGED_TABLES; j ++) {
+            uint32_t table = (i * CHANGED_TABLES + j) % TABLES;
+            ecs_set(world, first[table], Position, {i, i});
+        }
+
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_progress(world, 0);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report(name, &frames);
+
+    ecs_fini(world);
+}
+
+/* Measure the frame time of a system that reads all tables and of a system that
+ * only reads tables that changed */
+void bench_changed(void) {
+    run("changed/all", "[in] Position");
+    run("changed/changed", "[in, changed] Position");
+}
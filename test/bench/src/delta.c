@@ -0,0 +1,118 @@
+#include <bench.h>
+#include <string.h>
+
+#define ENTITIES (10000)
+#define STATIC_ENTITIES (490000)
+#define BUFFER_SIZE (64 * 1024)
+#define FRAMES (50)
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Velocity {
+    float x, y;
+} Velocity;
+
+static
+void Move(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN(rows, Velocity, v, 2);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        p[i].x += v[i].x;
+        p[i].y += v[i].y;
+    }
+}
+
+/* Copy serialized data from a reader to the writer of another world */
+static
+size_t replicate(
+    ecs_reader_t *reader,
+    ecs_world_t *dst,
+    char *buffer)
+{
+    ecs_writer_t writer = ecs_writer_init(dst);
+    size_t read, total = 0;
+
+    while ((read = ecs_reader_read(buffer, BUFFER_SIZE, reader))) {
+        ecs_writer_write(buffer, read, &writer);
+        total += read;
+    }
+
+    return total;
+}
+
+/* Replicate a world in which a small part of the entities change every frame
+ * to another world, by serializing a snapshot of the world every frame or by
+ * serializing the delta with the snapshot of the previous frame */
+static
+void run(
+    const char *name,
+    bool delta)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position, [in] Velocity);
+
+    uint32_t i;
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i});
+        ecs_set(world, e, Velocity, {1, 1});
+    }
+
+    for (i = 0; i < STATIC_ENTITIES; i ++) {
+        ecs_set(world, 0, Position, {i, i});
+    }
+
+    char *buffer = ecs_os_malloc(BUFFER_SIZE);
+    ecs_world_t *dst = ecs_init();
+
+    ecs_snapshot_t *s = ecs_snapshot_take_shared(world, NULL);
+    ecs_reader_t reader = ecs_snapshot_reader_init(world, s);
+    replicate(&reader, dst, buffer);
+
+    bench_frames_t frames = {.count = FRAMES};
+    size_t total = 0;
+
+    for (i = 0; i < FRAMES; i ++) {
+        ecs_progress(world, 0);
+
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+
+        if (delta) {
+            reader = ecs_delta_reader_init(world, s);
+        } else {
+            ecs_snapshot_free(world, s);
+            s = ecs_snapshot_take_shared(world, NULL);
+            reader = ecs_snapshot_reader_init(world, s);
+        }
+
+        total += replicate(&reader, dst, buffer);
+
+        if (delta) {
+            ecs_snapshot_free(world, s);
+            s = ecs_snapshot_take_shared(world, NULL);
+        }
+
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report(name, &frames);
+    bench_report_value(name, (double)(total / FRAMES), "bytes per frame");
+
+    ecs_snapshot_free(world, s);
+    ecs_os_free(buffer);
+    ecs_fini(dst);
+    ecs_fini(world);
+}
+
+/* Measure the time and bandwidth it takes to replicate a world */
+void bench_delta(void) {
+    run("delta/full", false);
+    run("delta/delta", true);
+}
@@ -0,0 +1,115 @@
+#include <bench.h>
+
+#define ENTITIES (10000)
+#define FRAMES (50)
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Velocity {
+    float x, y;
+} Velocity;
+
+/* Measure creating entities in a new world, in bulk and one at a time */
+static
+void run_new(
+    const char *name,
+    bool bulk)
+{
+    bench_frames_t frames = {.count = FRAMES};
+
+    uint32_t i;
+    for (i = 0; i < FRAMES; i ++) {
+        ecs_world_t *world = ecs_init();
+
+        ECS_COMPONENT(world, Position);
+        ECS_COMPONENT(world, Velocity);
+        ECS_TYPE(world, Movable, Position, Velocity);
+
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+
+        if (bulk) {
+            ecs_new_w_count(world, Movable, ENTITIES);
+        } else {
+            uint32_t e;
+            for (e = 0; e < ENTITIES; e ++) {
+                ecs_new(world, Movable);
+            }
+        }
+
+        frames.t[i] = ecs_time_measure(&t);
+
+        ecs_fini(world);
+    }
+
+    bench_report(name, &frames);
+}
+
+/* Measure operations on individual entities, which all go through commit and
+ * the entity index */
+void bench_entity(void) {
+    run_new("entity/new_w_count", true);
+    run_new("entity/new", false);
+
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t first = ecs_new_w_count(world, Position, ENTITIES);
+
+    bench_frames_t add_remove = {.count = FRAMES};
+    bench_frames_t set = {.count = FRAMES};
+    bench_frames_t get = {.count = FRAMES};
+    bench_frames_t add_remove_w_filter = {.count = FRAMES};
+    float sum = 0;
+
+    uint32_t i, e;
+    for (i = 0; i < FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        for (e = 0; e < ENTITIES; e ++) {
+            ecs_add(world, first + e, Velocity);
+        }
+        for (e = 0; e < ENTITIES; e ++) {
+            ecs_remove(world, first + e, Velocity);
+        }
+        add_remove.t[i] = ecs_time_measure(&t);
+
+        ecs_time_measure(&t);
+        for (e = 0; e < ENTITIES; e ++) {
+            ecs_set(world, first + e, Position, {e, i});
+        }
+        set.t[i] = ecs_time_measure(&t);
+
+        ecs_time_measure(&t);
+        for (e = 0; e < ENTITIES; e ++) {
+            Position *p = ecs_get_ptr(world, first + e, Position);
+            sum += p->x;
+        }
+        get.t[i] = ecs_time_measure(&t);
+
+        ecs_time_measure(&t);
+        ecs_add_remove_w_filter(world, Velocity, 0, &(ecs_filter_t){
+            .include = ecs_type(Position)
+        });
+        ecs_add_remove_w_filter(world, 0, Velocity, &(ecs_filter_t){
+            .include = ecs_type(Position)
+        });
+        add_remove_w_filter.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("entity/add_remove", &add_remove);
+    bench_report("entity/set", &set);
+    bench_report("entity/get", &get);
+    bench_report("entity/add_remove_w_filter", &add_remove_w_filter);
+
+    /* Prevent the compiler from removing lookups */
+    if (!sum) {
+        fprintf(stderr, "entity: no values\n");
+    }
+
+    ecs_fini(world);
+}
@@ -0,0 +1,84 @@
+#include <bench.h>
+
+#define TABLES (20000)
+#define VELOCITY_TABLES (10)
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Velocity {
+    float x, y;
+} Velocity;
+
+static
+void Iter(ecs_rows_t *rows) {
+    (void)rows;
+}
+
+/* Create a new table with a component and a tag that isn't used yet */
+static
+void new_table(
+    ecs_world_t *world,
+    ecs_type_t component)
+{
+    ecs_entity_t tag = ecs_new(world, 0);
+    _ecs_new(world, ecs_type_add(world, component, tag));
+}
+
+/* Measure the time it takes to evaluate a filter against many tables, of which
+ * only a few match the filter */
+void bench_filter(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TYPE(world, Movable, Position, Velocity);
+
+    ECS_SYSTEM(world, Iter, EcsManual, Position);
+
+    uint32_t i;
+    for (i = 0; i < TABLES; i ++) {
+        new_table(world, ecs_type(Position));
+    }
+
+    for (i = 0; i < VELOCITY_TABLES; i ++) {
+        new_table(world, ecs_type(Movable));
+    }
+
+    /* Match the system with the new tables */
+    ecs_progress(world, 0);
+
+    ecs_filter_t filter = {.include = ecs_type(Movable)};
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_count_w_filter(world, &filter);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("filter/count", &frames);
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_filter_iter_t it = ecs_filter_iter(world, &filter);
+        while (ecs_filter_next(&it)) { }
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("filter/iter", &frames);
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_run_w_filter(world, Iter, 0, 0, 0, Velocity, NULL);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("filter/run_w_filter", &frames);
+
+    ecs_fini(world);
+}
@@ -0,0 +1,185 @@
+#include <bench.h>
+
+#define ENTITIES (100000)
+#define THREADS (4)
+
+typedef struct C1 { float v; } C1;
+typedef struct C2 { float v; } C2;
+typedef struct C3 { float v; } C3;
+typedef struct C4 { float v; } C4;
+typedef struct C5 { float v; } C5;
+typedef struct C6 { float v; } C6;
+typedef struct C7 { float v; } C7;
+typedef struct C8 { float v; } C8;
+
+static
+void Iter1(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, C1, c1, 1);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        c1[i].v += 1;
+    }
+}
+
+static
+void Iter2(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, C1, c1, 1);
+    ECS_COLUMN(rows, C2, c2, 2);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        c1[i].v += c2[i].v;
+    }
+}
+
+static
+void Iter4(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, C1, c1, 1);
+    ECS_COLUMN(rows, C2, c2, 2);
+    ECS_COLUMN(rows, C3, c3, 3);
+    ECS_COLUMN(rows, C4, c4, 4);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        c1[i].v += c2[i].v + c3[i].v + c4[i].v;
+    }
+}
+
+static
+void Iter8(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, C1, c1, 1);
+    ECS_COLUMN(rows, C2, c2, 2);
+    ECS_COLUMN(rows, C3, c3, 3);
+    ECS_COLUMN(rows, C4, c4, 4);
+    ECS_COLUMN(rows, C5, c5, 5);
+    ECS_COLUMN(rows, C6, c6, 6);
+    ECS_COLUMN(rows, C7, c7, 7);
+    ECS_COLUMN(rows, C8, c8, 8);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        c1[i].v += c2[i].v + c3[i].v + c4[i].v + c5[i].v + c6[i].v +
+            c7[i].v + c8[i].v;
+    }
+}
+
+/* Measure the frame time of a system that iterates entities with a number of
+ * components, on the main thread or on worker threads */
+static
+void run(
+    const char *name,
+    uint32_t columns,
+    uint32_t threads)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, C1);
+    ECS_COMPONENT(world, C2);
+    ECS_COMPONENT(world, C3);
+    ECS_COMPONENT(world, C4);
+    ECS_COMPONENT(world, C5);
+    ECS_COMPONENT(world, C6);
+    ECS_COMPONENT(world, C7);
+    ECS_COMPONENT(world, C8);
+    ECS_TYPE(world, Type, C1, C2, C3, C4, C5, C6, C7, C8);
+
+    if (columns == 1) {
+        ECS_SYSTEM(world, Iter1, EcsOnUpdate, C1);
+    } else if (columns == 2) {
+        ECS_SYSTEM(world, Iter2, EcsOnUpdate, C1, C2);
+    } else if (columns == 4) {
+        ECS_SYSTEM(world, Iter4, EcsOnUpdate, C1, C2, C3, C4);
+    } else {
+        ECS_SYSTEM(world, Iter8, EcsOnUpdate, C1, C2, C3, C4, C5, C6, C7, C8);
+    }
+
+    ecs_new_w_count(world, Type, ENTITIES);
+
+    if (threads) {
+        ecs_set_threads(world, threads);
+    }
+
+    /* Warm up */
+    uint32_t i;
+    for (i = 0; i < 10; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_progress(world, 0);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report(name, &frames);
+
+    ecs_fini(world);
+}
+
+static
+void FilterIter1(ecs_rows_t *rows) {
+    C1 *c1 = ecs_table_column(rows, 0);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        c1[i].v += 1;
+    }
+}
+
+/* Measure running a callback for the tables matched by a filter, on the main
+ * thread or on worker threads */
+static
+void run_filter(
+    const char *name,
+    uint32_t threads)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, C1);
+    ECS_COMPONENT(world, C2);
+
+    ecs_new_w_count(world, C1, ENTITIES);
+
+    if (threads) {
+        ecs_set_threads(world, threads);
+    }
+
+    ecs_filter_t filter = {
+        .include = ecs_type(C1)
+    };
+
+    uint32_t i;
+    for (i = 0; i < 10; i ++) {
+        ecs_filter_run(world, &filter, FilterIter1, NULL);
+    }
+
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_filter_run(world, &filter, FilterIter1, NULL);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report(name, &frames);
+
+    ecs_fini(world);
+}
+
+void bench_iter(void) {
+    run("iter/1_component", 1, 0);
+    run("iter/2_components", 2, 0);
+    run("iter/4_components", 4, 0);
+    run("iter/8_components", 8, 0);
+
+    run("iter/1_component/4_threads", 1, THREADS);
+    run("iter/2_components/4_threads", 2, THREADS);
+    run("iter/4_components/4_threads", 4, THREADS);
+    run("iter/8_components/4_threads", 8, THREADS);
+
+    run_filter("iter/filter_run", 0);
+    run_filter("iter/filter_run/4_threads", THREADS);
+}
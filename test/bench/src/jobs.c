@@ -0,0 +1,88 @@
+#include <bench.h>
+
+#define ENTITIES (20000)
+#define THREADS (4)
+
+typedef struct Cost {
+    uint32_t iterations;
+} Cost;
+
+typedef struct Value {
+    float x;
+} Value;
+
+static
+void Work(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Cost, cost, 1);
+    ECS_COLUMN(rows, Value, value, 2);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        float v = value[i].x;
+        uint32_t j, iterations = cost[i].iterations;
+        for (j = 0; j < iterations; j ++) {
+            v = v * 0.999f + 1.0f;
+        }
+        value[i].x = v;
+    }
+}
+
+/* Run a frame where the first tenth of the entities is expensive (skewed) or
+ * where all entities are equally expensive (uniform) */
+static
+void run(
+    const char *name,
+    bool skewed,
+    uint32_t job_size)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Cost);
+    ECS_COMPONENT(world, Value);
+    ECS_SYSTEM(world, Work, EcsOnUpdate, Cost, Value);
+
+    uint32_t i;
+    for (i = 0; i < ENTITIES; i ++) {
+        uint32_t iterations = 20;
+        if (skewed) {
+            iterations = i < ENTITIES / 10 ? 200 : 0;
+        }
+
+        ecs_entity_t e = ecs_set(world, 0, Cost, {iterations});
+        ecs_set(world, e, Value, {0});
+    }
+
+    ecs_set_threads(world, THREADS);
+    ecs_set_job_size(world, job_size);
+
+    /* Warm up */
+    for (i = 0; i < 10; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_progress(world, 0);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report(name, &frames);
+
+    ecs_fini(world);
+}
+
+void bench_jobs(void) {
+    /* A job size of ENTITIES / THREADS creates one job per thread, which is
+     * equivalent to scheduling without stealing */
+    uint32_t one_per_thread = ENTITIES / THREADS;
+
+    run("jobs/uniform/one_per_thread", false, one_per_thread);
+    run("jobs/uniform/auto", false, 0);
+    run("jobs/uniform/size_256", false, 256);
+
+    run("jobs/skewed/one_per_thread", true, one_per_thread);
+    run("jobs/skewed/auto", true, 0);
+    run("jobs/skewed/size_256", true, 256);
+}
@@ -0,0 +1,82 @@
+#include <bench.h>
+
+#define ENTITIES (1000000)
+#define BUFFER_SIZE (64 * 1024)
+#define FRAMES (10)
+#define FILENAME "bench_load.flecs"
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Velocity {
+    float x, y;
+} Velocity;
+
+typedef struct Transform {
+    float m[16];
+} Transform;
+
+/* Deserialize a file by copying it into a world with a writer */
+static
+void stream_load(
+    ecs_world_t *world,
+    char *buffer)
+{
+    FILE *file = fopen(FILENAME, "rb");
+    ecs_writer_t writer = ecs_writer_init(world);
+    size_t read;
+
+    while ((read = fread(buffer, 1, BUFFER_SIZE, file))) {
+        ecs_writer_write(buffer, read, &writer);
+    }
+
+    fclose(file);
+}
+
+/* Measure how long it takes to restore a world from a file, when data is copied
+ * into the world and when the file is mapped into the world */
+void bench_load(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Transform);
+
+    uint32_t i;
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i});
+        ecs_set(world, e, Velocity, {i, i});
+        ecs_set(world, e, Transform, {{i}});
+    }
+
+    ecs_save_file(world, FILENAME);
+    ecs_fini(world);
+
+    char *buffer = ecs_os_malloc(BUFFER_SIZE);
+
+    bench_frames_t stream_frames = {.count = FRAMES};
+    bench_frames_t map_frames = {.count = FRAMES};
+
+    for (i = 0; i < FRAMES; i ++) {
+        ecs_time_t t = {0};
+
+        world = ecs_init();
+        ecs_time_measure(&t);
+        stream_load(world, buffer);
+        stream_frames.t[i] = ecs_time_measure(&t);
+        ecs_fini(world);
+
+        world = ecs_init();
+        ecs_time_measure(&t);
+        ecs_load_file(world, FILENAME);
+        map_frames.t[i] = ecs_time_measure(&t);
+        ecs_fini(world);
+    }
+
+    bench_report("load/stream", &stream_frames);
+    bench_report("load/map", &map_frames);
+
+    ecs_os_free(buffer);
+    remove(FILENAME);
+}
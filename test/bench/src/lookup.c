@@ -0,0 +1,67 @@
+#include <bench.h>
+
+#define TABLES (1000)
+#define ENTITIES_PER_TABLE (20)
+#define LOOKUPS (100)
+
+/* Measure the time it takes to lookup entities by name in a world with many
+ * named entities, spread out over many tables */
+void bench_lookup(void) {
+    ecs_world_t *world = ecs_init();
+
+    static char names[TABLES * ENTITIES_PER_TABLE][16];
+    ecs_entity_t parent = ecs_set(world, 0, EcsId, {"Parent"});
+
+    uint32_t i, j;
+    for (i = 0; i < TABLES; i ++) {
+        /* Each table has a tag that isn't used yet */
+        ecs_entity_t tag = ecs_new(world, 0);
+        ecs_type_t type = ecs_type_add(world, NULL, tag);
+        type = ecs_type_add(world, type, parent | ECS_CHILDOF);
+
+        for (j = 0; j < ENTITIES_PER_TABLE; j ++) {
+            char *name = names[i * ENTITIES_PER_TABLE + j];
+            sprintf(name, "e_%u", i * ENTITIES_PER_TABLE + j);
+            ecs_entity_t e = _ecs_new(world, type);
+            ecs_set(world, e, EcsId, {name});
+        }
+    }
+
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        for (j = 0; j < LOOKUPS; j ++) {
+            ecs_lookup(world, names[(i * LOOKUPS + j) % (TABLES * ENTITIES_PER_TABLE)]);
+        }
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("lookup/lookup_x100", &frames);
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        for (j = 0; j < LOOKUPS; j ++) {
+            ecs_lookup(world, "not_found");
+        }
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("lookup/not_found_x100", &frames);
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        for (j = 0; j < LOOKUPS; j ++) {
+            ecs_lookup_child(world, parent, 
+                names[(i * LOOKUPS + j) % (TABLES * ENTITIES_PER_TABLE)]);
+        }
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("lookup/lookup_child_x100", &frames);
+
+    ecs_fini(world);
+}
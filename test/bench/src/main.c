@@ -0,0 +1,165 @@
+#include <bench.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct bench_t {
+    const char *id;
+    void (*function)(void);
+} bench_t;
+
+static
+bench_t benchmarks[] = {
+    {"jobs", bench_jobs},
+    {"barrier", bench_barrier},
+    {"batches", bench_batches},
+    {"merge", bench_merge},
+    {"serialize", bench_serialize},
+    {"load", bench_load},
+    {"snapshot", bench_snapshot},
+    {"delta", bench_delta},
+    {"changed", bench_changed},
+    {"match", bench_match},
+    {"rematch", bench_rematch},
+    {"filter", bench_filter},
+    {"lookup", bench_lookup},
+    {"staging", bench_staging},
+    {"map", bench_map},
+    {"entity", bench_entity},
+    {"iter", bench_iter}
+};
+
+/* When set, results are written as JSON in the format of Google Benchmark, so
+ * that existing tools can compare results between runs */
+static bool json_output = false;
+static uint32_t json_count = 0;
+
+static
+void json_begin(void) {
+    time_t now = time(NULL);
+    char date[64];
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", gmtime(&now));
+
+    printf("{\n");
+    printf("  \"context\": {\n");
+    printf("    \"date\": \"%s\",\n", date);
+    printf("    \"library\": \"flecs\",\n");
+#ifdef NDEBUG
+    printf("    \"library_build_type\": \"release\",\n");
+#else
+    printf("    \"library_build_type\": \"debug\",\n");
+#endif
+    printf("    \"frames\": %d\n", BENCH_FRAMES);
+    printf("  },\n");
+    printf("  \"benchmarks\": [");
+}
+
+static
+void json_end(void) {
+    printf("\n  ]\n}\n");
+}
+
+static
+void json_next(void) {
+    printf("%s\n    {", json_count ? "," : "");
+    json_count ++;
+}
+
+static
+int compare_time(
+    const void *p1,
+    const void *p2)
+{
+    double t1 = *(double*)p1;
+    double t2 = *(double*)p2;
+    return (t1 > t2) - (t1 < t2);
+}
+
+void bench_report(
+    const char *name,
+    bench_frames_t *frames)
+{
+    uint32_t i, count = frames->count;
+    double total = 0;
+
+    for (i = 0; i < count; i ++) {
+        total += frames->t[i];
+    }
+
+    qsort(frames->t, count, sizeof(double), compare_time);
+
+    double mean = total / count * 1000000.0;
+    double p99 = frames->t[(count * 99) / 100] * 1000000.0;
+    double max = frames->t[count - 1] * 1000000.0;
+
+    if (json_output) {
+        json_next();
+        printf("\"name\": \"%s\", \"run_type\": \"iteration\", "
+            "\"iterations\": %u, \"real_time\": %.3f, \"p99_time\": %.3f, "
+            "\"max_time\": %.3f, \"time_unit\": \"us\"}",
+            name, count, mean, p99, max);
+    } else {
+        printf("%-40s mean %9.1f us  p99 %9.1f us  max %9.1f us\n", name,
+            mean, p99, max);
+    }
+
+    fflush(stdout);
+}
+
+void bench_report_value(
+    const char *name,
+    double value,
+    const char *unit)
+{
+    if (json_output) {
+        json_next();
+        printf("\"name\": \"%s\", \"run_type\": \"value\", "
+            "\"value\": %.3f, \"unit\": \"%s\"}", name, value, unit);
+    } else {
+        printf("%-40s %9.1f %s\n", name, value, unit);
+    }
+
+    fflush(stdout);
+}
+
+/* Usage: flecs_bench [--json] [benchmark...] */
+int main(int argc, char *argv[]) {
+    uint32_t i, count = sizeof(benchmarks) / sizeof(bench_t);
+    int a, filter_count = 0;
+
+    for (a = 1; a < argc; a ++) {
+        if (!strcmp(argv[a], "--json")) {
+            json_output = true;
+        } else {
+            filter_count ++;
+        }
+    }
+
+    bench_set_os_api();
+
+    if (json_output) {
+        json_begin();
+    }
+
+    for (i = 0; i < count; i ++) {
+        /* Optionally only run the benchmarks that are passed as arguments */
+        if (filter_count) {
+            for (a = 1; a < argc; a ++) {
+                if (!strcmp(argv[a], benchmarks[i].id)) {
+                    break;
+                }
+            }
+
+            if (a == argc) {
+                continue;
+            }
+        }
+
+        benchmarks[i].function();
+    }
+
+    if (json_output) {
+        json_end();
+    }
+
+    return 0;
+}
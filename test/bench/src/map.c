@@ -0,0 +1,186 @@
+#include <bench.h>
+
+#define KEYS (100000)
+#define OPS (10000)
+
+/* Keys are spread out like entity ids that are used as map keys: mostly
+ * sequential, with gaps and some ids that have flags in the upper bits */
+static
+uint64_t bench_key(
+    uint32_t i)
+{
+    uint64_t key = i * 3 + 1000;
+    if (!(i % 7)) {
+        key |= (uint64_t)1 << 62;
+    }
+    return key;
+}
+
+static
+uint64_t bench_hashed_key(
+    uint32_t i)
+{
+    uint64_t key = i + 0x9E3779B97F4A7C15ull;
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+    return key ^ (key >> 31);
+}
+
+/* Measure inserts, lookups, removes and iteration of a map with many keys */
+void bench_map(void) {
+    ecs_map_t *map = ecs_map_new(0, sizeof(uint64_t));
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+    uint64_t sum = 0;
+    uint32_t i, j;
+
+    for (i = 0; i < KEYS; i ++) {
+        ecs_map_set(map, bench_key(i), &(uint64_t){i});
+    }
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_map_t *m = ecs_map_new(0, sizeof(uint64_t));
+        for (j = 0; j < OPS; j ++) {
+            ecs_map_set(m, bench_key(j), &(uint64_t){j});
+        }
+        frames.t[i] = ecs_time_measure(&t);
+        ecs_map_free(m);
+    }
+
+    bench_report("map/insert_x10000", &frames);
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_map_t *m = ecs_map_new(OPS, sizeof(uint64_t));
+        for (j = 0; j < OPS; j ++) {
+            ecs_map_set(m, bench_key(j), &(uint64_t){j});
+        }
+        frames.t[i] = ecs_time_measure(&t);
+        ecs_map_free(m);
+    }
+
+    bench_report("map/insert_reserved_x10000", &frames);
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        for (j = 0; j < OPS; j ++) {
+            uint32_t index = (uint32_t)(i * OPS + j) * 2654435761u % KEYS;
+            uint64_t *value = ecs_map_get_ptr(map, bench_key(index));
+            sum += *value;
+        }
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("map/lookup_x10000", &frames);
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        for (j = 0; j < OPS; j ++) {
+            uint32_t index = (uint32_t)(i * OPS + j) * 2654435761u % KEYS;
+            sum += ecs_map_has(map, bench_key(index) + 1, NULL);
+        }
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("map/lookup_miss_x10000", &frames);
+
+    /* Keys that are hashes or pointers, like the keys of the type index */
+    ecs_map_t *hashed = ecs_map_new(0, sizeof(uint64_t));
+    for (i = 0; i < KEYS; i ++) {
+        ecs_map_set(hashed, bench_hashed_key(i), &(uint64_t){i});
+    }
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        for (j = 0; j < OPS; j ++) {
+            uint32_t index = (uint32_t)(i * OPS + j) * 2654435761u % KEYS;
+            uint64_t *value = ecs_map_get_ptr(hashed, bench_hashed_key(index));
+            sum += *value;
+        }
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("map/lookup_hashed_x10000", &frames);
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        for (j = 0; j < OPS; j ++) {
+            uint32_t index = (uint32_t)(i * OPS + j) * 2654435761u % KEYS;
+            sum += ecs_map_has(hashed, bench_hashed_key(index + KEYS), NULL);
+        }
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("map/lookup_hashed_miss_x10000", &frames);
+
+    ecs_map_free(hashed);
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        for (j = 0; j < OPS; j ++) {
+            uint32_t index = (uint32_t)(i * OPS + j) % KEYS;
+            ecs_map_remove(map, bench_key(index));
+        }
+        frames.t[i] = ecs_time_measure(&t);
+
+        /* Restore removed keys */
+        for (j = 0; j < OPS; j ++) {
+            uint32_t index = (uint32_t)(i * OPS + j) % KEYS;
+            ecs_map_set(map, bench_key(index), &(uint64_t){index});
+        }
+    }
+
+    bench_report("map/remove_x10000", &frames);
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_map_iter_t it = ecs_map_iter(map);
+        while (ecs_map_hasnext(&it)) {
+            sum += *(uint64_t*)ecs_map_next(&it);
+        }
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("map/iter_x100000", &frames);
+
+    /* Small map with pointer keys, like the table index of a stage */
+    ecs_map_t *small = ecs_map_new(0, sizeof(uint64_t));
+    uint64_t *ptrs[8];
+    for (i = 0; i < 8; i ++) {
+        ptrs[i] = ecs_os_malloc(48);
+        ecs_map_set(small, (uintptr_t)ptrs[i], &(uint64_t){i});
+    }
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        for (j = 0; j < OPS; j ++) {
+            uint64_t *value = ecs_map_get_ptr(small, (uintptr_t)ptrs[j % 8]);
+            sum += *value;
+        }
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("map/lookup_small_x10000", &frames);
+
+    for (i = 0; i < 8; i ++) {
+        ecs_os_free(ptrs[i]);
+    }
+
+    ecs_map_free(small);
+
+    /* Prevent the compiler from removing lookups */
+    if (!sum) {
+        fprintf(stderr, "map: no values\n");
+    }
+
+    ecs_map_free(map);
+}
@@ -0,0 +1,73 @@
+#include <bench.h>
+
+#define TABLES (20000)
+#define VELOCITY_TABLES (10)
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Velocity {
+    float x, y;
+} Velocity;
+
+static
+void Move(ecs_rows_t *rows) {
+    (void)rows;
+}
+
+/* Create a new table with a component and a tag that isn't used yet */
+static
+void new_table(
+    ecs_world_t *world,
+    ecs_type_t component)
+{
+    ecs_entity_t tag = ecs_new(world, 0);
+    _ecs_new(world, ecs_type_add(world, component, tag));
+}
+
+/* Measure the time it takes to create systems and tables in a world with many
+ * tables, of which only a few can be matched with the systems */
+void bench_match(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TYPE(world, Movable, Position, Velocity);
+
+    uint32_t i;
+    for (i = 0; i < TABLES; i ++) {
+        new_table(world, ecs_type(Position));
+    }
+
+    for (i = 0; i < VELOCITY_TABLES; i ++) {
+        new_table(world, ecs_type(Movable));
+    }
+
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+
+    char names[BENCH_FRAMES][16];
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        sprintf(names[i], "Move_%u", i);
+
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_new_system(
+            world, names[i], EcsOnUpdate, "Position, Velocity", Move);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("match/new_system", &frames);
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        new_table(world, ecs_type(Position));
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("match/new_table", &frames);
+
+    ecs_fini(world);
+}
@@ -0,0 +1,64 @@
+#include <bench.h>
+
+#define ENTITIES (100000)
+#define FRAMES (20)
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Velocity {
+    float x, y;
+} Velocity;
+
+static
+void AddVelocity(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_set(rows->world, rows->entities[i], Velocity, {1, 1});
+    }
+}
+
+static
+void RemoveVelocity(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_remove(rows->world, rows->entities[i], Velocity);
+    }
+}
+
+/* Measure frames in which all entities move to another table, which is
+ * dominated by merging the stage at the end of the frame */
+void bench_merge(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, AddVelocity, EcsOnUpdate, Position, !Velocity);
+    ECS_SYSTEM(world, RemoveVelocity, EcsOnUpdate, Position, Velocity);
+
+    uint32_t i;
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_set(world, 0, Position, {i, i});
+    }
+
+    /* Warm up */
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+
+    bench_frames_t frames = {.count = FRAMES};
+    for (i = 0; i < FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_progress(world, 0);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("merge/move_all_entities", &frames);
+
+    ecs_fini(world);
+}
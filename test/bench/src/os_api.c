@@ -0,0 +1,127 @@
+#include <bench.h>
+
+/* When running under bake, the default OS API already provides threading */
+#if !defined(__BAKE__) && !defined(_WIN32)
+#include <pthread.h>
+
+static
+ecs_os_thread_t bench_thread_new(
+    ecs_os_thread_callback_t callback,
+    void *param)
+{
+    pthread_t *thread = ecs_os_malloc(sizeof(pthread_t));
+    if (pthread_create(thread, NULL, callback, param)) {
+        ecs_os_free(thread);
+        return 0;
+    }
+    return (ecs_os_thread_t)(uintptr_t)thread;
+}
+
+static
+void* bench_thread_join(
+    ecs_os_thread_t thread)
+{
+    void *result = NULL;
+    pthread_t *t = (pthread_t*)(uintptr_t)thread;
+    pthread_join(*t, &result);
+    ecs_os_free(t);
+    return result;
+}
+
+static
+ecs_os_mutex_t bench_mutex_new(void) {
+    pthread_mutex_t *mutex = ecs_os_malloc(sizeof(pthread_mutex_t));
+    pthread_mutex_init(mutex, NULL);
+    return (ecs_os_mutex_t)(uintptr_t)mutex;
+}
+
+static
+void bench_mutex_free(
+    ecs_os_mutex_t m)
+{
+    pthread_mutex_t *mutex = (pthread_mutex_t*)(uintptr_t)m;
+    pthread_mutex_destroy(mutex);
+    ecs_os_free(mutex);
+}
+
+static
+void bench_mutex_lock(
+    ecs_os_mutex_t m)
+{
+    pthread_mutex_lock((pthread_mutex_t*)(uintptr_t)m);
+}
+
+static
+void bench_mutex_unlock(
+    ecs_os_mutex_t m)
+{
+    pthread_mutex_unlock((pthread_mutex_t*)(uintptr_t)m);
+}
+
+static
+ecs_os_cond_t bench_cond_new(void) {
+    pthread_cond_t *cond = ecs_os_malloc(sizeof(pthread_cond_t));
+    pthread_cond_init(cond, NULL);
+    return (ecs_os_cond_t)(uintptr_t)cond;
+}
+
+static
+void bench_cond_free(
+    ecs_os_cond_t c)
+{
+    pthread_cond_t *cond = (pthread_cond_t*)(uintptr_t)c;
+    pthread_cond_destroy(cond);
+    ecs_os_free(cond);
+}
+
+static
+void bench_cond_signal(
+    ecs_os_cond_t c)
+{
+    pthread_cond_signal((pthread_cond_t*)(uintptr_t)c);
+}
+
+static
+void bench_cond_broadcast(
+    ecs_os_cond_t c)
+{
+    pthread_cond_broadcast((pthread_cond_t*)(uintptr_t)c);
+}
+
+static
+void bench_cond_wait(
+    ecs_os_cond_t c,
+    ecs_os_mutex_t m)
+{
+    pthread_cond_wait(
+        (pthread_cond_t*)(uintptr_t)c, (pthread_mutex_t*)(uintptr_t)m);
+}
+
+void bench_set_os_api(void) {
+    ecs_os_set_api_defaults();
+    ecs_os_api_t os_api = ecs_os_api;
+
+    if (!os_api.thread_new) {
+        os_api.thread_new = bench_thread_new;
+        os_api.thread_join = bench_thread_join;
+        os_api.mutex_new = bench_mutex_new;
+        os_api.mutex_free = bench_mutex_free;
+        os_api.mutex_lock = bench_mutex_lock;
+        os_api.mutex_unlock = bench_mutex_unlock;
+        os_api.cond_new = bench_cond_new;
+        os_api.cond_free = bench_cond_free;
+        os_api.cond_signal = bench_cond_signal;
+        os_api.cond_broadcast = bench_cond_broadcast;
+        os_api.cond_wait = bench_cond_wait;
+    }
+
+    ecs_os_set_api(&os_api);
+}
+
+#else
+
+void bench_set_os_api(void) {
+    ecs_os_set_api_defaults();
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include <bench.h>
+
+#define TABLES (5000)
+#define CHILD_TABLES (10)
+#define SYSTEMS (100)
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef float Mass;
+
+static
+void Move(ecs_rows_t *rows) {
+    (void)rows;
+}
+
+/* Measure the frame time after a component is added to or removed from a
+ * container, in a world with many tables and systems */
+void bench_rematch(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Mass);
+
+    uint32_t i;
+    for (i = 0; i < TABLES; i ++) {
+        ecs_entity_t tag = ecs_new(world, 0);
+        _ecs_new(world, ecs_type_add(world, ecs_type(Position), tag));
+    }
+
+    /* Keep container alive when Mass is removed */
+    ecs_entity_t parent = ecs_new(world, Position);
+    for (i = 0; i < CHILD_TABLES; i ++) {
+        ecs_entity_t tag = ecs_new(world, 0);
+        ecs_entity_t child = _ecs_new(
+            world, ecs_type_add(world, ecs_type(Position), tag));
+        ecs_adopt(world, child, parent);
+    }
+
+    char names[SYSTEMS][16];
+    for (i = 0; i < SYSTEMS; i ++) {
+        sprintf(names[i], "Move_%u", i);
+        ecs_new_system(
+            world, names[i], EcsOnUpdate, "CONTAINER.Mass, Position", Move);
+    }
+
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        if (i % 2) {
+            ecs_remove(world, parent, Mass);
+        } else {
+            ecs_add(world, parent, Mass);
+        }
+
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_progress(world, 0);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report("rematch/container", &frames);
+
+    ecs_fini(world);
+}
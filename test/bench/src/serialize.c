@@ -0,0 +1,90 @@
+#include <bench.h>
+#include <string.h>
+
+#define ENTITIES (1000000)
+#define BUFFER_SIZE (64 * 1024)
+#define FRAMES (10)
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Velocity {
+    float x, y;
+} Velocity;
+
+/* Measure how long it takes to serialize a world into a buffer and to
+ * deserialize the buffer into a new world */
+static
+void run(
+    const char *read_name,
+    const char *write_name,
+    bool named)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    uint32_t i;
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i});
+        ecs_set(world, e, Velocity, {i, i});
+        if (named) {
+            ecs_set(world, e, EcsId, {"Entity"});
+        }
+    }
+
+    char *buffer = ecs_os_malloc(BUFFER_SIZE);
+    char *data = NULL;
+    size_t data_size = 0;
+
+    bench_frames_t read_frames = {.count = FRAMES};
+    bench_frames_t write_frames = {.count = FRAMES};
+
+    for (i = 0; i < FRAMES; i ++) {
+        ecs_reader_t reader = ecs_reader_init(world);
+        size_t read, total = 0;
+
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        while ((read = ecs_reader_read(buffer, BUFFER_SIZE, &reader))) {
+            if (total + read > data_size) {
+                data_size = (total + read) * 2;
+                data = ecs_os_realloc(data, data_size);
+            }
+            memcpy(&data[total], buffer, read);
+            total += read;
+        }
+        read_frames.t[i] = ecs_time_measure(&t);
+
+        ecs_world_t *dst = ecs_init();
+        ecs_writer_t writer = ecs_writer_init(dst);
+        size_t written = 0;
+
+        ecs_time_measure(&t);
+        while (written < total) {
+            size_t size = total - written;
+            if (size > BUFFER_SIZE) {
+                size = BUFFER_SIZE;
+            }
+            ecs_writer_write(&data[written], size, &writer);
+            written += size;
+        }
+        write_frames.t[i] = ecs_time_measure(&t);
+
+        ecs_fini(dst);
+    }
+
+    bench_report(read_name, &read_frames);
+    bench_report(write_name, &write_frames);
+
+    ecs_os_free(data);
+    ecs_os_free(buffer);
+    ecs_fini(world);
+}
+
+void bench_serialize(void) {
+    run("serialize/read", "serialize/write", false);
+    run("serialize/read_w_names", "serialize/write_w_names", true);
+}
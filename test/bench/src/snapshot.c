@@ -0,0 +1,133 @@
+#include <bench.h>
+
+#define ENTITIES (100000)
+#define STATIC_ENTITIES (400000)
+#define RING_SIZE (8)
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Velocity {
+    float x, y;
+} Velocity;
+
+typedef struct Transform {
+    float m[16];
+} Transform;
+
+static
+void Move(ecs_rows_t *rows) {
+    ECS_COLUMN(rows, Position, p, 1);
+    ECS_COLUMN(rows, Velocity, v, 2);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        p[i].x += v[i].x;
+        p[i].y += v[i].y;
+    }
+}
+
+/* Run frames of a world in which a system moves entities, and take a snapshot
+ * before each frame like a game that supports rollback. Most of the data in the
+ * world does not change between frames. */
+static
+void run_frames(
+    const char *name,
+    bool shared)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Transform);
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position, [in] Velocity);
+
+    uint32_t i;
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i});
+        ecs_set(world, e, Velocity, {1, 1});
+    }
+
+    for (i = 0; i < STATIC_ENTITIES; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i});
+        ecs_set(world, e, Transform, {{i}});
+    }
+
+    ecs_snapshot_t *ring[RING_SIZE] = {0};
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+
+        uint32_t index = i % RING_SIZE;
+        if (ring[index]) {
+            ecs_snapshot_free(world, ring[index]);
+        }
+
+        if (shared) {
+            ring[index] = ecs_snapshot_take_shared(world, NULL);
+        } else {
+            ring[index] = ecs_snapshot_take(world, NULL);
+        }
+
+        ecs_progress(world, 0);
+
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    for (i = 0; i < RING_SIZE; i ++) {
+        if (ring[i]) {
+            ecs_snapshot_free(world, ring[i]);
+        }
+    }
+
+    bench_report(name, &frames);
+
+    ecs_fini(world);
+}
+
+/* Take a snapshot, run a frame and restore the world to the snapshot, like a
+ * game that predicts a frame and then rolls it back */
+static
+void run_restore(
+    const char *name)
+{
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position, [in] Velocity);
+
+    uint32_t i;
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {i, i});
+        ecs_set(world, e, Velocity, {1, 1});
+    }
+
+    bench_frames_t frames = {.count = BENCH_FRAMES};
+
+    for (i = 0; i < BENCH_FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+
+        ecs_snapshot_t *s = ecs_snapshot_take(world, NULL);
+        ecs_progress(world, 0);
+        ecs_snapshot_restore(world, s);
+
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    bench_report(name, &frames);
+
+    ecs_fini(world);
+}
+
+/* Measure the frame time of a world that takes a snapshot every frame, when
+ * snapshots copy all data and when snapshots share data with the world */
+void bench_snapshot(void) {
+    run_frames("snapshot/copy", false);
+    run_frames("snapshot/shared", true);
+    run_restore("snapshot/take_restore");
+}
@@ -0,0 +1,85 @@
+#include <bench.h>
+
+#define ENTITIES (10000)
+#define TAGS (256)
+#define FRAMES (100)
+
+typedef struct Position {
+    float x, y;
+} Position;
+
+typedef struct Velocity {
+    float x, y;
+} Velocity;
+
+/* Tags that are added with Velocity, so that entities are staged in as many
+ * tables as there are tags */
+static ecs_entity_t tags[TAGS];
+
+static
+void AddVelocity(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_entity_t e = rows->entities[i];
+        ecs_set(rows->world, e, Velocity, {1, 1});
+        ecs_add_entity(rows->world, e, tags[e % TAGS]);
+    }
+}
+
+static
+void RemoveVelocity(ecs_rows_t *rows) {
+    ECS_COLUMN_COMPONENT(rows, Velocity, 2);
+
+    uint32_t i;
+    for (i = 0; i < rows->count; i ++) {
+        ecs_entity_t e = rows->entities[i];
+        ecs_remove(rows->world, e, Velocity);
+        ecs_remove_entity(rows->world, e, tags[e % TAGS]);
+    }
+}
+
+/* Measure frames in which entities move to many different tables, which stages
+ * columns for each of the tables */
+void bench_staging(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, AddVelocity, EcsOnUpdate, Position, !Velocity);
+    ECS_SYSTEM(world, RemoveVelocity, EcsOnUpdate, Position, Velocity);
+
+    uint32_t i;
+    for (i = 0; i < TAGS; i ++) {
+        tags[i] = ecs_new(world, 0);
+    }
+
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_set(world, 0, Position, {i, i});
+    }
+
+    /* Warm up */
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+
+    uint64_t malloc_count = ecs_os_api_malloc_count + 
+        ecs_os_api_calloc_count + ecs_os_api_realloc_count;
+
+    bench_frames_t frames = {.count = FRAMES};
+    for (i = 0; i < FRAMES; i ++) {
+        ecs_time_t t = {0};
+        ecs_time_measure(&t);
+        ecs_progress(world, 0);
+        frames.t[i] = ecs_time_measure(&t);
+    }
+
+    malloc_count = ecs_os_api_malloc_count + ecs_os_api_calloc_count + 
+        ecs_os_api_realloc_count - malloc_count;
+
+    bench_report("staging/move_many_tables", &frames);
+    bench_report_value("staging/move_many_tables", 
+        (double)malloc_count / FRAMES, "allocations per frame");
+
+    ecs_fini(world);
+}
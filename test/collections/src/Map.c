@@ -75,14 +75,14 @@ void Map_set_rehash() {
     ecs_map_t *map = ecs_map_new(8, sizeof(char*));
     fill_map(map);
 
-    test_int(ecs_map_bucket_count(map), 10);
+    test_int(ecs_map_bucket_count(map), 16);
 
     int i;
-    for (i = 5; i < 10; i ++) {
+    for (i = 5; i < 20; i ++) {
         ecs_map_set(map, i, &(char*){"zzz"});
     }
 
-    test_int(ecs_map_bucket_count(map), 20);
+    test_int(ecs_map_bucket_count(map), 48);
     test_str(*(char**)ecs_map_get_ptr(map, 1), "hello");
     test_str(*(char**)ecs_map_get_ptr(map, 2), "world");
     test_str(*(char**)ecs_map_get_ptr(map, 3), "foo");
@@ -90,6 +90,8 @@ void Map_set_rehash() {
     test_str(*(char**)ecs_map_get_ptr(map, 5), "zzz");
     test_str(*(char**)ecs_map_get_ptr(map, 6), "zzz");
     test_str(*(char**)ecs_map_get_ptr(map, 7), "zzz");
+    test_str(*(char**)ecs_map_get_ptr(map, 19), "zzz");
+    test_int(ecs_map_count(map), 19);
 
     ecs_map_free(map);
 }
@@ -149,20 +151,26 @@ void Map_iter() {
     ecs_map_t *map = ecs_map_new(16, sizeof(char*));
     fill_map(map);
 
-    ecs_map_iter_t it = ecs_map_iter(map);
-    test_assert(ecs_map_hasnext(&it) == true);
-    test_str(*(char**)ecs_map_next(&it), "hello");
-
-    test_assert(ecs_map_hasnext(&it) == true);
-    test_str(*(char**)ecs_map_next(&it), "world");
+    /* Elements are not returned in insertion order */
+    bool found[4] = {false};
+    int i, count = 0;
 
-    test_assert(ecs_map_hasnext(&it) == true);
-    test_str(*(char**)ecs_map_next(&it), "foo");
+    ecs_map_iter_t it = ecs_map_iter(map);
+    while (ecs_map_hasnext(&it)) {
+        char *value = *(char**)ecs_map_next(&it);
+        for (i = 0; i < 4; i ++) {
+            if (!strcmp(value, elems[i].value)) {
+                test_assert(!found[i]);
+                found[i] = true;
+            }
+        }
+        count ++;
+    }
 
-    test_assert(ecs_map_hasnext(&it) == true);
-    test_str(*(char**)ecs_map_next(&it), "bar");
+    test_int(count, 4);
+    test_assert(found[0] && found[1] && found[2] && found[3]);
 
-    test_assert(ecs_map_hasnext(&it) == false);
+    ecs_map_free(map);
 }
 
 void Map_iter_empty() {
@@ -222,7 +230,230 @@ void Map_grow() {
 
     test_int(malloc_count, 0);
 
-    ecs_map_set(map, i, &v);
+    /* Map may have reserved more than 10 elements, but the next resize should
+     * allocate all storage at once */
+    while (!malloc_count) {
+        ecs_map_set(map, i, &v);
+        i ++;
+    }
+
+    test_int(malloc_count, 1);
+    test_int(ecs_map_count(map), i);
+
+    ecs_map_free(map);
+}
+
+void Map_set_many() {
+    ecs_map_t *map = ecs_map_new(0, sizeof(uint64_t));
+
+    uint64_t i;
+    for (i = 0; i < 10000; i ++) {
+        ecs_map_set(map, i * 3, &(uint64_t){i});
+    }
+
+    test_int(ecs_map_count(map), 10000);
+
+    for (i = 0; i < 10000; i ++) {
+        uint64_t *value = ecs_map_get_ptr(map, i * 3);
+        test_assert(value != NULL);
+        test_assert(*value == i);
+        test_assert(ecs_map_get_ptr(map, i * 3 + 1) == NULL);
+    }
+
+    ecs_map_free(map);
+}
+
+void Map_set_colliding_keys() {
+    ecs_map_t *map = ecs_map_new(0, sizeof(uint64_t));
+
+    /* Keys that only differ in their upper bits */
+    uint64_t i;
+    for (i = 0; i < 100; i ++) {
+        ecs_map_set(map, i << 40, &(uint64_t){i});
+    }
+
+    test_int(ecs_map_count(map), 100);
+
+    for (i = 0; i < 100; i ++) {
+        uint64_t *value = ecs_map_get_ptr(map, i << 40);
+        test_assert(value != NULL);
+        test_assert(*value == i);
+    }
+
+    ecs_map_free(map);
+}
 
-    test_int(malloc_count, 2);
+void Map_set_zero_key() {
+    ecs_map_t *map = ecs_map_new(16, sizeof(char*));
+    test_assert(ecs_map_get_ptr(map, 0) == NULL);
+
+    ecs_map_set(map, 0, &(char*){"hello"});
+    test_int(ecs_map_count(map), 1);
+    test_str(*(char**)ecs_map_get_ptr(map, 0), "hello");
+
+    test_assert(ecs_map_remove(map, 0) == 0);
+    test_assert(ecs_map_get_ptr(map, 0) == NULL);
+    test_int(ecs_map_count(map), 0);
+
+    ecs_map_free(map);
+}
+
+void Map_set_large_data() {
+    typedef struct large_t {
+        uint64_t a;
+        char b[37];
+    } large_t;
+
+    ecs_map_t *map = ecs_map_new(0, sizeof(large_t));
+
+    uint64_t i;
+    for (i = 0; i < 100; i ++) {
+        large_t value = {.a = i};
+        memset(value.b, (char)i, sizeof(value.b));
+        ecs_map_set(map, i, &value);
+    }
+
+    for (i = 0; i < 100; i ++) {
+        large_t *value = ecs_map_get_ptr(map, i);
+        test_assert(value != NULL);
+        test_assert(value->a == i);
+        test_int(value->b[0], (char)i);
+        test_int(value->b[36], (char)i);
+    }
+
+    ecs_map_free(map);
+}
+
+void Map_remove_reinsert() {
+    ecs_map_t *map = ecs_map_new(16, sizeof(uint64_t));
+
+    /* Removing and adding elements should not grow the map */
+    uint64_t i, j;
+    for (i = 0; i < 10; i ++) {
+        ecs_map_set(map, i, &i);
+    }
+
+    uint32_t bucket_count = ecs_map_bucket_count(map);
+
+    for (j = 0; j < 1000; j ++) {
+        test_assert(ecs_map_remove(map, j) == 0);
+        ecs_map_set(map, j + 10, &j);
+        test_int(ecs_map_count(map), 10);
+    }
+
+    test_int(ecs_map_bucket_count(map), bucket_count);
+
+    for (i = 0; i < 1000; i ++) {
+        test_assert(ecs_map_get_ptr(map, i) == NULL);
+    }
+
+    for (i = 1000; i < 1010; i ++) {
+        uint64_t *value = ecs_map_get_ptr(map, i);
+        test_assert(value != NULL);
+        test_assert(*value == i - 10);
+    }
+
+    ecs_map_free(map);
+}
+
+void Map_remove_in_iter() {
+    ecs_map_t *map = ecs_map_new(0, sizeof(uint64_t));
+
+    uint64_t i;
+    for (i = 0; i < 100; i ++) {
+        ecs_map_set(map, i, &i);
+    }
+
+    /* Remove odd keys while iterating */
+    int count = 0;
+    ecs_map_iter_t it = ecs_map_iter(map);
+    while (ecs_map_hasnext(&it)) {
+        uint64_t key;
+        uint64_t *value = ecs_map_next_w_key(&it, &key);
+        test_assert(*value == key);
+        if (key % 2) {
+            test_assert(ecs_map_remove(map, key) == 0);
+        }
+        count ++;
+    }
+
+    test_int(count, 100);
+    test_int(ecs_map_count(map), 50);
+
+    for (i = 0; i < 100; i ++) {
+        test_assert((ecs_map_get_ptr(map, i) == NULL) == (i % 2));
+    }
+
+    ecs_map_free(map);
+}
+
+void Map_clear() {
+    ecs_map_t *map = ecs_map_new(16, sizeof(char*));
+    fill_map(map);
+
+    uint32_t bucket_count = ecs_map_bucket_count(map);
+
+    ecs_map_clear(map);
+    test_int(ecs_map_count(map), 0);
+    test_int(ecs_map_bucket_count(map), bucket_count);
+    test_assert(ecs_map_get_ptr(map, 1) == NULL);
+
+    ecs_map_iter_t it = ecs_map_iter(map);
+    test_assert(!ecs_map_hasnext(&it));
+
+    fill_map(map);
+    test_int(ecs_map_count(map), 4);
+    test_str(*(char**)ecs_map_get_ptr(map, 4), "bar");
+
+    ecs_map_free(map);
+}
+
+void Map_copy() {
+    ecs_map_t *map = ecs_map_new(16, sizeof(char*));
+    fill_map(map);
+
+    ecs_map_t *copy = ecs_map_copy(map);
+    ecs_map_set(map, 1, &(char*){"foobar"});
+    ecs_map_remove(map, 2);
+
+    test_int(ecs_map_count(copy), 4);
+    test_str(*(char**)ecs_map_get_ptr(copy, 1), "hello");
+    test_str(*(char**)ecs_map_get_ptr(copy, 2), "world");
+    test_str(*(char**)ecs_map_get_ptr(copy, 3), "foo");
+    test_str(*(char**)ecs_map_get_ptr(copy, 4), "bar");
+
+    ecs_map_free(map);
+    ecs_map_free(copy);
+}
+
+void Map_copy_empty() {
+    ecs_map_t *map = ecs_map_new(0, sizeof(char*));
+    ecs_map_t *copy = ecs_map_copy(map);
+
+    test_int(ecs_map_count(copy), 0);
+    ecs_map_set(copy, 1, &(char*){"hello"});
+    test_str(*(char**)ecs_map_get_ptr(copy, 1), "hello");
+    test_int(ecs_map_count(map), 0);
+
+    ecs_map_free(map);
+    ecs_map_free(copy);
+}
+
+void Map_iter_w_key() {
+    ecs_map_t *map = ecs_map_new(16, sizeof(char*));
+    fill_map(map);
+
+    int count = 0;
+    ecs_map_iter_t it = ecs_map_iter(map);
+    while (ecs_map_hasnext(&it)) {
+        uint64_t key;
+        char *value = *(char**)ecs_map_next_w_key(&it, &key);
+        test_assert(key >= 1 && key <= 4);
+        test_str(value, elems[key - 1].value);
+        count ++;
+    }
+
+    test_int(count, 4);
+
+    ecs_map_free(map);
 }
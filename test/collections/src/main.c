@@ -52,6 +52,16 @@ void Map_remove(void);
 void Map_remove_empty(void);
 void Map_remove_unknown(void);
 void Map_grow(void);
+void Map_set_many(void);
+void Map_set_colliding_keys(void);
+void Map_set_zero_key(void);
+void Map_set_large_data(void);
+void Map_remove_reinsert(void);
+void Map_remove_in_iter(void);
+void Map_clear(void);
+void Map_copy(void);
+void Map_copy_empty(void);
+void Map_iter_w_key(void);
 
 // Testsuite 'Chunked'
 void Chunked_setup(void);
@@ -173,7 +183,7 @@ static bake_test_suite suites[] = {
     },
     {
         .id = "Map",
-        .testcase_count = 16,
+        .testcase_count = 26,
         .setup = Map_setup,
         .testcases = (bake_test_case[]){
             {
@@ -239,6 +249,46 @@ static bake_test_suite suites[] = {
             {
                 .id = "grow",
                 .function = Map_grow
+            },
+            {
+                .id = "set_many",
+                .function = Map_set_many
+            },
+            {
+                .id = "set_colliding_keys",
+                .function = Map_set_colliding_keys
+            },
+            {
+                .id = "set_zero_key",
+                .function = Map_set_zero_key
+            },
+            {
+                .id = "set_large_data",
+                .function = Map_set_large_data
+            },
+            {
+                .id = "remove_reinsert",
+                .function = Map_remove_reinsert
+            },
+            {
+                .id = "remove_in_iter",
+                .function = Map_remove_in_iter
+            },
+            {
+                .id = "clear",
+                .function = Map_clear
+            },
+            {
+                .id = "copy",
+                .function = Map_copy
+            },
+            {
+                .id = "copy_empty",
+                .function = Map_copy_empty
+            },
+            {
+                .id = "iter_w_key",
+                .function = Map_iter_w_key
             }
         }
     },